@@ -0,0 +1,125 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "Benchmark.hpp"
+
+#include "oatpp/base/Log.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#ifndef OATPP_BENCHMARK_BUILD_TYPE
+  #define OATPP_BENCHMARK_BUILD_TYPE ""
+#endif
+
+namespace oatpp { namespace benchmark {
+
+Runner::Runner(const Config& config)
+  : m_config(config)
+  , m_report(Report::createShared())
+{
+  if(m_config.repetitions < 1) {
+    m_config.repetitions = 1;
+  }
+  if(m_config.scale <= 0) {
+    m_config.scale = 1.0;
+  }
+}
+
+bool Runner::isSelected(const char* name) const {
+  return !m_config.filter || std::strstr(name, m_config.filter->c_str()) != nullptr;
+}
+
+v_int64 Runner::getScaledIterations(v_int64 iterations) const {
+  auto result = static_cast<v_int64>(static_cast<v_float64>(iterations) * m_config.scale);
+  return result > 0 ? result : 1;
+}
+
+void Runner::addResult(const char* name, v_int64 iterations, v_int64 bytesPerOp, std::vector<v_float64>& samples) {
+
+  std::sort(samples.begin(), samples.end());
+
+  v_float64 sum = 0;
+  for(auto s : samples) {
+    sum += s;
+  }
+  v_float64 mean = sum / static_cast<v_float64>(samples.size());
+
+  v_float64 variance = 0;
+  for(auto s : samples) {
+    variance += (s - mean) * (s - mean);
+  }
+  variance /= static_cast<v_float64>(samples.size());
+
+  auto mid = samples.size() / 2;
+  v_float64 median = samples.size() % 2 == 0 ? (samples[mid - 1] + samples[mid]) / 2 : samples[mid];
+
+  auto result = CaseResult::createShared();
+  result->name = name;
+  result->iterations = iterations;
+  result->repetitions = m_config.repetitions;
+  result->nsPerOpMin = samples.front();
+  result->nsPerOpMedian = median;
+  result->nsPerOpMean = mean;
+  result->nsPerOpMax = samples.back();
+  result->nsPerOpStdDev = std::sqrt(variance);
+  result->opsPerSec = median > 0 ? 1e9 / median : 0;
+  result->bytesPerSec = median > 0 ? static_cast<v_float64>(bytesPerOp) * 1e9 / median : 0;
+
+  m_report->results->push_back(result);
+
+  OATPP_LOGi("Benchmark", "{}: median={}ns/op, min={}ns/op, ops/sec={}",
+             name, *result->nsPerOpMedian, *result->nsPerOpMin, static_cast<v_int64>(*result->opsPerSec))
+
+}
+
+oatpp::Object<Report> Runner::getReport() const {
+
+#if defined(__clang__)
+  const char* compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+  const char* compiler = "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+  const char* compiler = "msvc";
+#else
+  const char* compiler = "unknown";
+#endif
+
+  m_report->oatppVersion = OATPP_VERSION;
+  m_report->compiler = compiler;
+  m_report->buildType = OATPP_BENCHMARK_BUILD_TYPE;
+  m_report->hardwareConcurrency = static_cast<v_int32>(std::thread::hardware_concurrency());
+  v_int64 timestamp = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+  m_report->timestamp = timestamp;
+  m_report->repetitions = m_config.repetitions;
+  m_report->scale = m_config.scale;
+  m_report->filter = m_config.filter;
+
+  return m_report;
+
+}
+
+}}
@@ -0,0 +1,183 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_benchmark_Benchmark_hpp
+#define oatpp_benchmark_Benchmark_hpp
+
+#include "Report.hpp"
+
+#include "oatpp/Environment.hpp"
+
+#include <chrono>
+#include <vector>
+
+namespace oatpp { namespace benchmark {
+
+/**
+ * Prevent compiler from optimizing away computation of the value.
+ * @tparam T
+ * @param value
+ */
+template<typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static const void* volatile sink;
+  sink = &value;
+#endif
+}
+
+/**
+ * Runs benchmark cases and collects their results into &id:oatpp::benchmark::Report;.
+ */
+class Runner {
+public:
+
+  /**
+   * Runner config.
+   */
+  struct Config {
+
+    /**
+     * Number of measured repetitions of each case.
+     */
+    v_int32 repetitions = 5;
+
+    /**
+     * Multiplier applied to the number of iterations of each case.
+     */
+    v_float64 scale = 1.0;
+
+    /**
+     * Run only cases which name contains this substring. `nullptr` - run all cases.
+     */
+    oatpp::String filter;
+
+  };
+
+private:
+  Config m_config;
+  oatpp::Object<Report> m_report;
+private:
+  bool isSelected(const char* name) const;
+  v_int64 getScaledIterations(v_int64 iterations) const;
+  void addResult(const char* name, v_int64 iterations, v_int64 bytesPerOp, std::vector<v_float64>& samples);
+public:
+
+  /**
+   * Constructor.
+   * @param config - &l:Runner::Config;.
+   */
+  Runner(const Config& config);
+
+  /**
+   * Measure operation.
+   * Operation is called `iterations / 10` times to warm up, then `iterations` times for each of the configured repetitions.
+   * @tparam F - operation type.
+   * @param name - case name. Ex.: `"encoding.base64.encode"`.
+   * @param iterations - number of times to call operation per repetition (before scaling).
+   * @param bytesPerOp - number of bytes processed by one operation call. `0` - not applicable.
+   * @param op - operation.
+   */
+  template<typename F>
+  void measure(const char* name, v_int64 iterations, v_int64 bytesPerOp, const F& op) {
+
+    if(!isSelected(name)) {
+      return;
+    }
+
+    iterations = getScaledIterations(iterations);
+
+    for(v_int64 i = 0; i < iterations / 10 + 1; i ++) {
+      op();
+    }
+
+    std::vector<v_float64> samples;
+    samples.reserve(static_cast<size_t>(m_config.repetitions));
+
+    for(v_int32 r = 0; r < m_config.repetitions; r ++) {
+      auto start = std::chrono::steady_clock::now();
+      for(v_int64 i = 0; i < iterations; i ++) {
+        op();
+      }
+      std::chrono::duration<v_float64, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+      samples.push_back(elapsed.count() / static_cast<v_float64>(iterations));
+    }
+
+    addResult(name, iterations, bytesPerOp, samples);
+
+  }
+
+  /**
+   * Run benchmark.
+   * @tparam T - &l:Benchmark; type.
+   * @param args - benchmark constructor arguments.
+   */
+  template<class T, typename ... Args>
+  void run(Args&&... args) {
+    T benchmark(std::forward<Args>(args)...);
+    benchmark.onRun(*this);
+  }
+
+  /**
+   * Get collected results.
+   * @return - &id:oatpp::benchmark::Report;.
+   */
+  oatpp::Object<Report> getReport() const;
+
+};
+
+/**
+ * Base class for benchmarks.
+ */
+class Benchmark {
+protected:
+  const char* const TAG;
+public:
+
+  /**
+   * Constructor.
+   * @param tag - tag used for logs.
+   */
+  Benchmark(const char* tag)
+    : TAG(tag)
+  {}
+
+  /**
+   * Default virtual destructor.
+   */
+  virtual ~Benchmark() = default;
+
+  /**
+   * Override this method. It should measure benchmark cases with &l:Runner::measure ();.
+   * @param runner - &l:Runner;.
+   */
+  virtual void onRun(Runner& runner) = 0;
+
+};
+
+}}
+
+#endif // oatpp_benchmark_Benchmark_hpp
@@ -0,0 +1,83 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_benchmark_Report_hpp
+#define oatpp_benchmark_Report_hpp
+
+#include "oatpp/macro/codegen.hpp"
+#include "oatpp/Types.hpp"
+
+namespace oatpp { namespace benchmark {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+/**
+ * Result of one benchmark case.
+ */
+class CaseResult : public oatpp::DTO {
+
+  DTO_INIT(CaseResult, DTO)
+
+  DTO_FIELD(String, name);
+
+  DTO_FIELD(Int64, iterations);
+  DTO_FIELD(Int32, repetitions);
+
+  DTO_FIELD(Float64, nsPerOpMin, "ns_per_op_min");
+  DTO_FIELD(Float64, nsPerOpMedian, "ns_per_op_median");
+  DTO_FIELD(Float64, nsPerOpMean, "ns_per_op_mean");
+  DTO_FIELD(Float64, nsPerOpMax, "ns_per_op_max");
+  DTO_FIELD(Float64, nsPerOpStdDev, "ns_per_op_stddev");
+
+  DTO_FIELD(Float64, opsPerSec, "ops_per_sec");
+  DTO_FIELD(Float64, bytesPerSec, "bytes_per_sec");
+
+};
+
+/**
+ * Benchmarks run report.
+ */
+class Report : public oatpp::DTO {
+
+  DTO_INIT(Report, DTO)
+
+  DTO_FIELD(String, oatppVersion, "oatpp_version");
+  DTO_FIELD(String, compiler);
+  DTO_FIELD(String, buildType, "build_type");
+  DTO_FIELD(Int32, hardwareConcurrency, "hardware_concurrency");
+  DTO_FIELD(Int64, timestamp);
+
+  DTO_FIELD(Int32, repetitions);
+  DTO_FIELD(Float64, scale);
+  DTO_FIELD(String, filter);
+
+  DTO_FIELD(List<Object<CaseResult>>, results) = List<Object<CaseResult>>::createShared();
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+}}
+
+#endif // oatpp_benchmark_Report_hpp
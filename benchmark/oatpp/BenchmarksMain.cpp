@@ -0,0 +1,99 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "oatpp/micro/ParserBenchmark.hpp"
+#include "oatpp/micro/RouterBenchmark.hpp"
+#include "oatpp/micro/JsonBenchmark.hpp"
+#include "oatpp/micro/EncodingBenchmark.hpp"
+#include "oatpp/micro/StreamBenchmark.hpp"
+
+#include "oatpp/macro/HttpBenchmark.hpp"
+
+#include "oatpp/json/ObjectMapper.hpp"
+#include "oatpp/base/CommandLineArguments.hpp"
+#include "oatpp/base/Log.hpp"
+#include "oatpp/Environment.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+/*
+ * Usage: oatppBenchmarks [--filter <substring>] [--repetitions <n>] [--scale <factor>] [--output <file.json>]
+ * Results are written as JSON to the output file or to stdout if no output file is specified.
+ */
+oatpp::String runBenchmarks(const oatpp::base::CommandLineArguments& args) {
+
+  oatpp::benchmark::Runner::Config config;
+
+  config.repetitions = std::atoi(args.getNamedArgumentValue("--repetitions", "5"));
+  config.scale = std::atof(args.getNamedArgumentValue("--scale", "1"));
+
+  auto filter = args.getNamedArgumentValue("--filter");
+  if(filter) {
+    config.filter = filter;
+  }
+
+  oatpp::benchmark::Runner runner(config);
+
+  runner.run<oatpp::benchmark::micro::ParserBenchmark>();
+  runner.run<oatpp::benchmark::micro::RouterBenchmark>();
+  runner.run<oatpp::benchmark::micro::JsonBenchmark>();
+  runner.run<oatpp::benchmark::micro::EncodingBenchmark>();
+  runner.run<oatpp::benchmark::micro::StreamBenchmark>();
+
+  runner.run<oatpp::benchmark::macro::HttpBenchmark>();
+
+  oatpp::json::ObjectMapper mapper;
+  mapper.serializerConfig().json.useBeautifier = true;
+
+  return mapper.writeToString(runner.getReport());
+
+}
+
+}
+
+int main(int argc, const char* argv[]) {
+
+  oatpp::Environment::init();
+
+  oatpp::base::CommandLineArguments args(argc, argv);
+
+  auto json = runBenchmarks(args);
+
+  auto output = args.getNamedArgumentValue("--output");
+  if(output) {
+    std::ofstream file(output);
+    file << *json << "\n";
+    OATPP_LOGi("Benchmark", "Results written to '{}'", output)
+  } else {
+    std::cout << *json << "\n";
+  }
+
+  oatpp::Environment::destroy();
+
+  return 0;
+}
@@ -0,0 +1,172 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "HttpBenchmark.hpp"
+
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/web/server/HttpRouter.hpp"
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+
+#include "oatpp/network/virtual_/client/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/server/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/Interface.hpp"
+#include "oatpp/network/Server.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace oatpp { namespace benchmark { namespace macro {
+
+namespace {
+
+class StaticBodyHandler : public oatpp::web::server::HttpRequestHandler {
+private:
+
+  class StaticBodyCoroutine : public oatpp::async::CoroutineWithResult<StaticBodyCoroutine, const std::shared_ptr<OutgoingResponse>&> {
+  private:
+    oatpp::String m_body;
+  public:
+
+    StaticBodyCoroutine(const oatpp::String& body)
+      : m_body(body)
+    {}
+
+    Action act() override {
+      return _return(ResponseFactory::createResponse(Status::CODE_200, m_body));
+    }
+
+  };
+
+private:
+  oatpp::String m_body;
+public:
+
+  StaticBodyHandler(const oatpp::String& body)
+    : m_body(body)
+  {}
+
+  std::shared_ptr<OutgoingResponse> handle(const std::shared_ptr<IncomingRequest>& request) override {
+    (void) request;
+    return ResponseFactory::createResponse(Status::CODE_200, m_body);
+  }
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&>
+  handleAsync(const std::shared_ptr<IncomingRequest>& request) override {
+    (void) request;
+    return StaticBodyCoroutine::startForResult(m_body);
+  }
+
+};
+
+std::shared_ptr<oatpp::web::server::HttpRouter> createRouter() {
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->route("GET", "/plaintext", std::make_shared<StaticBodyHandler>("Hello, World!"));
+  router->route("GET", "/body/4k", std::make_shared<StaticBodyHandler>(std::string(4096, 'x')));
+  return router;
+}
+
+void measureServer(Runner& runner,
+                   const std::string& prefix,
+                   const std::shared_ptr<oatpp::network::virtual_::Interface>& _interface,
+                   const std::shared_ptr<oatpp::network::ConnectionHandler>& connectionHandler)
+{
+
+  auto serverConnectionProvider = oatpp::network::virtual_::server::ConnectionProvider::createShared(_interface);
+  auto clientConnectionProvider = oatpp::network::virtual_::client::ConnectionProvider::createShared(_interface);
+
+  auto server = std::make_shared<oatpp::network::Server>(serverConnectionProvider, connectionHandler);
+
+  std::atomic<bool> running(true);
+  std::thread serverThread([&server, &running]{
+    server->run([&running]() noexcept {
+      return running.load();
+    });
+  });
+
+  {
+
+    auto requestExecutor = oatpp::web::client::HttpRequestExecutor::createShared(clientConnectionProvider);
+    oatpp::web::protocol::http::Headers headers;
+
+    auto connection = requestExecutor->getConnection();
+
+    runner.measure((prefix + ".plaintext.keepAlive").c_str(), 20000, 0, [&]{
+      auto response = requestExecutor->execute("GET", "/plaintext", headers, nullptr, connection);
+      auto body = response->readBodyToString();
+      doNotOptimize(body);
+    });
+
+    runner.measure((prefix + ".body4k.keepAlive").c_str(), 20000, 4096, [&]{
+      auto response = requestExecutor->execute("GET", "/body/4k", headers, nullptr, connection);
+      auto body = response->readBodyToString();
+      doNotOptimize(body);
+    });
+
+    connection.reset();
+
+    oatpp::web::protocol::http::Headers closeHeaders;
+    closeHeaders.put("Connection", "close");
+
+    runner.measure((prefix + ".plaintext.newConnection").c_str(), 5000, 0, [&]{
+      auto response = requestExecutor->execute("GET", "/plaintext", closeHeaders, nullptr, nullptr);
+      auto body = response->readBodyToString();
+      doNotOptimize(body);
+    });
+
+  }
+
+  running = false;
+  connectionHandler->stop();
+  serverConnectionProvider->stop();
+  clientConnectionProvider->stop();
+  serverThread.join();
+
+}
+
+}
+
+void HttpBenchmark::onRun(Runner& runner) {
+
+  auto router = createRouter();
+
+  {
+    auto _interface = oatpp::network::virtual_::Interface::obtainShared("oatpp.benchmark.sync");
+    auto connectionHandler = oatpp::web::server::HttpConnectionHandler::createShared(router);
+    measureServer(runner, "http.sync", _interface, connectionHandler);
+  }
+
+  {
+    auto _interface = oatpp::network::virtual_::Interface::obtainShared("oatpp.benchmark.async");
+    auto executor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+    auto connectionHandler = oatpp::web::server::AsyncHttpConnectionHandler::createShared(router, executor);
+    measureServer(runner, "http.async", _interface, connectionHandler);
+    executor->waitTasksFinished();
+    executor->stop();
+    executor->join();
+  }
+
+}
+
+}}}
@@ -0,0 +1,93 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "EncodingBenchmark.hpp"
+
+#include "oatpp/encoding/Base64.hpp"
+#include "oatpp/encoding/Url.hpp"
+
+#include <random>
+
+namespace oatpp { namespace benchmark { namespace micro {
+
+namespace {
+
+oatpp::String createRandomData(v_buff_size size, v_uint32 seed) {
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<v_int32> distribution(0, 255);
+  std::string result(static_cast<size_t>(size), '\0');
+  for(auto& c : result) {
+    c = static_cast<char>(distribution(generator));
+  }
+  return result;
+}
+
+oatpp::String createQueryText(v_buff_size size) {
+  const char* const sample = "name=John Doe&city=Kyiv&q=c++ \"async\" web/framework?x=1;y=2#top ";
+  std::string result;
+  while(static_cast<v_buff_size>(result.size()) < size) {
+    result += sample;
+  }
+  result.resize(static_cast<size_t>(size));
+  return result;
+}
+
+}
+
+void EncodingBenchmark::onRun(Runner& runner) {
+
+  {
+    auto data = createRandomData(4096, 42);
+    auto encoded = oatpp::encoding::Base64::encode(data);
+
+    runner.measure("encoding.base64.encode.4k", 100000, static_cast<v_int64>(data->size()), [&]{
+      auto result = oatpp::encoding::Base64::encode(data);
+      doNotOptimize(result);
+    });
+
+    runner.measure("encoding.base64.decode.4k", 100000, static_cast<v_int64>(encoded->size()), [&]{
+      auto result = oatpp::encoding::Base64::decode(encoded);
+      doNotOptimize(result);
+    });
+  }
+
+  {
+    oatpp::encoding::Url::Config config;
+    auto text = createQueryText(1024);
+    auto encoded = oatpp::encoding::Url::encode(text, config);
+
+    runner.measure("encoding.url.encode.1k", 200000, static_cast<v_int64>(text->size()), [&]{
+      auto result = oatpp::encoding::Url::encode(text, config);
+      doNotOptimize(result);
+    });
+
+    runner.measure("encoding.url.decode.1k", 200000, static_cast<v_int64>(encoded->size()), [&]{
+      auto result = oatpp::encoding::Url::decode(encoded);
+      doNotOptimize(result);
+    });
+  }
+
+}
+
+}}}
@@ -0,0 +1,116 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "JsonBenchmark.hpp"
+
+#include "oatpp/json/ObjectMapper.hpp"
+#include "oatpp/macro/codegen.hpp"
+
+namespace oatpp { namespace benchmark { namespace micro {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class AddressDto : public oatpp::DTO {
+
+  DTO_INIT(AddressDto, DTO)
+
+  DTO_FIELD(String, street);
+  DTO_FIELD(String, city);
+  DTO_FIELD(String, zip);
+
+};
+
+class UserDto : public oatpp::DTO {
+
+  DTO_INIT(UserDto, DTO)
+
+  DTO_FIELD(Int64, id);
+  DTO_FIELD(String, name);
+  DTO_FIELD(String, email);
+  DTO_FIELD(Boolean, active);
+  DTO_FIELD(Float64, rating);
+  DTO_FIELD(List<String>, roles);
+  DTO_FIELD(Object<AddressDto>, address);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::List<oatpp::Object<UserDto>> createUsers(v_int32 count) {
+
+  auto users = oatpp::List<oatpp::Object<UserDto>>::createShared();
+
+  for(v_int32 i = 0; i < count; i ++) {
+    auto user = UserDto::createShared();
+    user->id = 1000000 + i;
+    user->name = "User Name " + std::to_string(i);
+    user->email = "user" + std::to_string(i) + "@example.com";
+    user->active = i % 3 != 0;
+    user->rating = i * 0.37;
+    user->roles = {"reader", "writer"};
+    user->address = AddressDto::createShared();
+    user->address->street = "Street \"" + std::to_string(i) + "\"\n";
+    user->address->city = "Kyiv";
+    user->address->zip = "01001";
+    users->push_back(user);
+  }
+
+  return users;
+
+}
+
+void measureList(Runner& runner, oatpp::json::ObjectMapper& mapper, v_int32 count, v_int64 iterations) {
+
+  auto users = createUsers(count);
+  auto json = mapper.writeToString(users);
+  auto size = static_cast<v_int64>(json->size());
+  auto prefix = "json.users." + std::to_string(count);
+
+  runner.measure((prefix + ".serialize").c_str(), iterations, size, [&]{
+    auto result = mapper.writeToString(users);
+    doNotOptimize(result);
+  });
+
+  runner.measure((prefix + ".deserialize").c_str(), iterations, size, [&]{
+    auto result = mapper.readFromString<oatpp::List<oatpp::Object<UserDto>>>(json);
+    doNotOptimize(result);
+  });
+
+}
+
+}
+
+void JsonBenchmark::onRun(Runner& runner) {
+
+  oatpp::json::ObjectMapper mapper;
+
+  measureList(runner, mapper, 1, 200000);
+  measureList(runner, mapper, 100, 1000);
+  measureList(runner, mapper, 1000, 100);
+
+}
+
+}}}
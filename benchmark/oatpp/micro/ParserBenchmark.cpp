@@ -0,0 +1,95 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "ParserBenchmark.hpp"
+
+#include "oatpp/web/protocol/http/Http.hpp"
+
+#include <cstring>
+
+namespace oatpp { namespace benchmark { namespace micro {
+
+namespace {
+
+const char* const SHORT_REQUEST =
+  "GET /api/users/42 HTTP/1.1\r\n"
+  "Host: localhost:8000\r\n"
+  "Accept: */*\r\n"
+  "\r\n";
+
+const char* const BROWSER_REQUEST =
+  "GET /static/js/application.bundle.js?v=1.4.0 HTTP/1.1\r\n"
+  "Host: www.example.com\r\n"
+  "Connection: keep-alive\r\n"
+  "Cache-Control: max-age=0\r\n"
+  "sec-ch-ua: \"Chromium\";v=\"118\", \"Google Chrome\";v=\"118\", \"Not=A?Brand\";v=\"99\"\r\n"
+  "sec-ch-ua-mobile: ?0\r\n"
+  "sec-ch-ua-platform: \"Linux\"\r\n"
+  "Upgrade-Insecure-Requests: 1\r\n"
+  "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/118.0.0.0 Safari/537.36\r\n"
+  "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,*/*;q=0.8\r\n"
+  "Sec-Fetch-Site: same-origin\r\n"
+  "Sec-Fetch-Mode: no-cors\r\n"
+  "Sec-Fetch-Dest: script\r\n"
+  "Referer: https://www.example.com/index.html\r\n"
+  "Accept-Encoding: gzip, deflate, br\r\n"
+  "Accept-Language: en-US,en;q=0.9,uk;q=0.8\r\n"
+  "Cookie: session=7f3a9c2e1b4d8f6a0c5e3b7d9f1a2c4e; theme=dark; _ga=GA1.1.123456789.1697000000\r\n"
+  "If-None-Match: \"5f2b-18b3c4d5e6f\"\r\n"
+  "\r\n";
+
+void measureRequest(Runner& runner, const char* name, const char* request, v_int64 iterations) {
+
+  auto size = static_cast<v_buff_size>(std::strlen(request));
+
+  runner.measure(name, iterations, size, [request, size]{
+    oatpp::utils::parser::Caret caret(request, size);
+    oatpp::web::protocol::http::RequestStartingLine line;
+    oatpp::web::protocol::http::Headers headers;
+    oatpp::web::protocol::http::Status status;
+    oatpp::web::protocol::http::Parser::parseRequestStartingLine(line, nullptr, caret, status);
+    oatpp::web::protocol::http::Parser::parseHeaders(headers, nullptr, caret, status);
+    doNotOptimize(headers);
+  });
+
+}
+
+}
+
+void ParserBenchmark::onRun(Runner& runner) {
+
+  measureRequest(runner, "http.parser.request.short", SHORT_REQUEST, 1000000);
+  measureRequest(runner, "http.parser.request.browser", BROWSER_REQUEST, 200000);
+
+  oatpp::data::share::StringKeyLabel acceptValue("text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,*/*;q=0.8");
+
+  runner.measure("http.parser.headerValueData", 500000, acceptValue.getSize(), [&acceptValue]{
+    oatpp::web::protocol::http::HeaderValueData data;
+    oatpp::web::protocol::http::Parser::parseHeaderValueData(data, acceptValue, ',');
+    doNotOptimize(data);
+  });
+
+}
+
+}}}
@@ -0,0 +1,45 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_benchmark_micro_ParserBenchmark_hpp
+#define oatpp_benchmark_micro_ParserBenchmark_hpp
+
+#include "oatpp-benchmark/Benchmark.hpp"
+
+namespace oatpp { namespace benchmark { namespace micro {
+
+/**
+ * HTTP starting line and headers parsing with &id:oatpp::utils::parser::Caret;.
+ */
+class ParserBenchmark : public Benchmark {
+public:
+
+  ParserBenchmark() : Benchmark("BENCHMARK[micro::ParserBenchmark]") {}
+  void onRun(Runner& runner) override;
+
+};
+
+}}}
+
+#endif // oatpp_benchmark_micro_ParserBenchmark_hpp
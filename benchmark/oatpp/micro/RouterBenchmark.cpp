@@ -0,0 +1,101 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "RouterBenchmark.hpp"
+
+#include "oatpp/web/server/HttpRouter.hpp"
+#include "oatpp/web/url/mapping/TreeRouter.hpp"
+
+namespace oatpp { namespace benchmark { namespace micro {
+
+namespace {
+
+const char* const RESOURCES[] = {
+  "users", "groups", "projects", "issues", "comments", "files", "tags", "teams",
+  "orders", "products", "invoices", "payments", "reviews", "sessions", "tokens", "events"
+};
+
+template<class HttpRouter>
+std::shared_ptr<HttpRouter> createRouter() {
+
+  auto router = HttpRouter::createShared();
+  v_int32 endpoint = 0;
+
+  for(const char* resource : RESOURCES) {
+    oatpp::String base = oatpp::String("/api/v1/") + resource;
+    router->route("GET", base, endpoint ++);
+    router->route("POST", base, endpoint ++);
+    router->route("GET", base + "/{id}", endpoint ++);
+    router->route("PUT", base + "/{id}", endpoint ++);
+    router->route("DELETE", base + "/{id}", endpoint ++);
+    router->route("GET", base + "/{id}/history/{version}", endpoint ++);
+  }
+
+  router->route("GET", "/static/*", endpoint ++);
+
+  return router;
+
+}
+
+template<class HttpRouter>
+void measureRouter(Runner& runner, const std::string& prefix) {
+
+  auto router = createRouter<HttpRouter>();
+
+  oatpp::data::share::StringKeyLabel get("GET");
+  oatpp::data::share::StringKeyLabel firstStatic("/api/v1/users");
+  oatpp::data::share::StringKeyLabel lastParams("/api/v1/events/1234567/history/42");
+  oatpp::data::share::StringKeyLabel wildcard("/static/js/application.bundle.js");
+  oatpp::data::share::StringKeyLabel notFound("/api/v2/users");
+
+  runner.measure((prefix + ".firstStatic").c_str(), 1000000, 0, [&]{
+    auto route = router->getRoute(get, firstStatic);
+    doNotOptimize(route);
+  });
+
+  runner.measure((prefix + ".lastWithParams").c_str(), 500000, 0, [&]{
+    auto route = router->getRoute(get, lastParams);
+    doNotOptimize(route);
+  });
+
+  runner.measure((prefix + ".wildcard").c_str(), 500000, 0, [&]{
+    auto route = router->getRoute(get, wildcard);
+    doNotOptimize(route);
+  });
+
+  runner.measure((prefix + ".notFound").c_str(), 500000, 0, [&]{
+    auto route = router->getRoute(get, notFound);
+    doNotOptimize(route);
+  });
+
+}
+
+}
+
+void RouterBenchmark::onRun(Runner& runner) {
+  measureRouter<oatpp::web::server::HttpRouterTemplate<v_int32>>(runner, "router.linear");
+  measureRouter<oatpp::web::server::HttpRouterTemplate<v_int32, oatpp::web::url::mapping::TreeRouter<v_int32>>>(runner, "router.tree");
+}
+
+}}}
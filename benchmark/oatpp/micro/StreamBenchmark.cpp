@@ -0,0 +1,84 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "StreamBenchmark.hpp"
+
+#include "oatpp/data/buffer/FIFOBuffer.hpp"
+#include "oatpp/data/stream/BufferStream.hpp"
+
+#include <cstring>
+
+namespace oatpp { namespace benchmark { namespace micro {
+
+void StreamBenchmark::onRun(Runner& runner) {
+
+  {
+    const v_buff_size fifoSize = 64 * 1024;
+    const v_buff_size chunkSize = 1500;
+    const v_buff_size dataSize = 1024 * 1024;
+
+    std::unique_ptr<v_char8[]> fifoMemory(new v_char8[fifoSize]);
+    std::unique_ptr<v_char8[]> chunk(new v_char8[chunkSize]);
+    std::memset(chunk.get(), 'x', chunkSize);
+
+    oatpp::data::buffer::FIFOBuffer fifo(fifoMemory.get(), fifoSize);
+
+    runner.measure("stream.fifoBuffer.writeRead.1m", 2000, dataSize, [&]{
+      v_buff_size transferred = 0;
+      while(transferred < dataSize) {
+        transferred += fifo.write(chunk.get(), chunkSize);
+        if(fifo.availableToWrite() < chunkSize) {
+          while(fifo.availableToRead() > 0) {
+            fifo.read(chunk.get(), chunkSize);
+          }
+        }
+      }
+      while(fifo.availableToRead() > 0) {
+        fifo.read(chunk.get(), chunkSize);
+      }
+      doNotOptimize(transferred);
+    });
+  }
+
+  {
+    const v_buff_size dataSize = 1024 * 1024;
+    const v_buff_size bufferSize = 16 * 1024;
+
+    oatpp::String data(std::string(static_cast<size_t>(dataSize), 'x'));
+    std::unique_ptr<v_char8[]> buffer(new v_char8[bufferSize]);
+
+    oatpp::data::stream::BufferInputStream inStream(data);
+    oatpp::data::stream::BufferOutputStream outStream(dataSize);
+
+    runner.measure("stream.transfer.buffer.1m", 2000, dataSize, [&]{
+      inStream.setCurrentPosition(0);
+      outStream.setCurrentPosition(0);
+      auto transferred = oatpp::data::stream::transfer(&inStream, &outStream, 0, buffer.get(), bufferSize);
+      doNotOptimize(transferred);
+    });
+  }
+
+}
+
+}}}
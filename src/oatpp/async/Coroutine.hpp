@@ -26,6 +26,7 @@
 #ifndef oatpp_async_Coroutine_hpp
 #define oatpp_async_Coroutine_hpp
 
+#include "./CoroutineMemoryPool.hpp"
 #include "./Error.hpp"
 
 #include "oatpp/async/utils/FastQueue.hpp"
@@ -427,6 +428,17 @@ private:
   FunctionPtr _FP; // Function pointer
   oatpp::async::Action _SCH_A; // Scheduled action
   CoroutineHandle* _ref; // pointer to next coroutine handle in list
+public:
+
+  static void* operator new(std::size_t sz) {
+    return CoroutineMemoryPool::allocate(sz);
+  }
+
+  static void operator delete(void* ptr, std::size_t sz) {
+    (void)sz;
+    CoroutineMemoryPool::deallocate(ptr);
+  }
+
 public:
 
   CoroutineHandle(Processor* processor, AbstractCoroutine* rootCoroutine);
@@ -598,12 +610,12 @@ public:
 public:
 
   static void* operator new(std::size_t sz) {
-    return ::operator new(sz);
+    return CoroutineMemoryPool::allocate(sz);
   }
 
   static void operator delete(void* ptr, std::size_t sz) {
     (void)sz;
-    ::operator delete(ptr);
+    CoroutineMemoryPool::deallocate(ptr);
   }
 
 public:
@@ -754,12 +766,12 @@ public:
 public:
 
   static void* operator new(std::size_t sz) {
-    return ::operator new(sz);
+    return CoroutineMemoryPool::allocate(sz);
   }
 
   static void operator delete(void* ptr, std::size_t sz) {
     (void)sz;
-    ::operator delete(ptr);
+    CoroutineMemoryPool::deallocate(ptr);
   }
 public:
 
@@ -0,0 +1,269 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "CoroutineMemoryPool.hpp"
+
+#include <mutex>
+#include <new>
+
+namespace oatpp { namespace async {
+
+std::atomic<bool> CoroutineMemoryPool::ENABLED(true);
+
+#ifndef OATPP_DISABLE_COROUTINE_POOL
+
+namespace {
+  thread_local CoroutineMemoryPool* CURRENT_POOL = nullptr;
+}
+
+#endif
+
+CoroutineMemoryPool::CoroutineMemoryPool()
+  : m_hits(0)
+  , m_misses(0)
+  , m_outstanding(0)
+  , m_remoteFree(nullptr)
+  , m_hasRemoteFree(false)
+  , m_orphaned(false)
+{
+  for(v_buff_size i = 0; i < SIZE_CLASSES_COUNT; i ++) {
+    m_free[i] = nullptr;
+    m_freeCount[i] = 0;
+  }
+}
+
+CoroutineMemoryPool* CoroutineMemoryPool::create() {
+  return new CoroutineMemoryPool();
+}
+
+void* CoroutineMemoryPool::allocateUnpooled(std::size_t size) {
+  auto header = static_cast<Header*>(::operator new(sizeof(Header) + size));
+  header->pool = nullptr;
+  header->sizeClass = -1;
+  return header + 1;
+}
+
+void* CoroutineMemoryPool::allocateLocal(v_int64 sizeClass) {
+
+  if(m_free[sizeClass] == nullptr && m_hasRemoteFree.load(std::memory_order_acquire)) {
+    collectRemoteFree();
+  }
+
+  Header* header;
+  auto block = m_free[sizeClass];
+
+  if(block != nullptr) {
+    m_free[sizeClass] = block->next;
+    m_freeCount[sizeClass] --;
+    header = reinterpret_cast<Header*>(block) - 1;
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    header = static_cast<Header*>(::operator new(sizeof(Header) + static_cast<std::size_t>((sizeClass + 1) * SIZE_CLASS_STEP)));
+    header->pool = this;
+    header->sizeClass = sizeClass;
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  m_outstanding.fetch_add(1, std::memory_order_relaxed);
+  return header + 1;
+
+}
+
+void CoroutineMemoryPool::freeLocal(Header* header) {
+  m_outstanding.fetch_sub(1, std::memory_order_relaxed);
+  auto sizeClass = header->sizeClass;
+  if(m_freeCount[sizeClass] < MAX_FREE_BLOCKS) {
+    auto block = reinterpret_cast<FreeBlock*>(header + 1);
+    block->next = m_free[sizeClass];
+    m_free[sizeClass] = block;
+    m_freeCount[sizeClass] ++;
+  } else {
+    ::operator delete(header);
+  }
+}
+
+void CoroutineMemoryPool::freeRemote(Header* header) {
+
+  bool deletePool = false;
+
+  {
+    std::lock_guard<concurrency::SpinLock> lock(m_remoteLock);
+    if(m_orphaned) {
+      ::operator delete(header);
+      deletePool = (m_outstanding.fetch_sub(1, std::memory_order_acq_rel) == 1);
+    } else {
+      auto block = reinterpret_cast<FreeBlock*>(header + 1);
+      block->next = m_remoteFree;
+      m_remoteFree = block;
+      m_hasRemoteFree.store(true, std::memory_order_release);
+      m_outstanding.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  if(deletePool) {
+    delete this;
+  }
+
+}
+
+void CoroutineMemoryPool::collectRemoteFree() {
+
+  FreeBlock* list;
+  {
+    std::lock_guard<concurrency::SpinLock> lock(m_remoteLock);
+    list = m_remoteFree;
+    m_remoteFree = nullptr;
+    m_hasRemoteFree.store(false, std::memory_order_relaxed);
+  }
+
+  while(list != nullptr) {
+    auto block = list;
+    list = list->next;
+    auto header = reinterpret_cast<Header*>(block) - 1;
+    auto sizeClass = header->sizeClass;
+    if(m_freeCount[sizeClass] < MAX_FREE_BLOCKS) {
+      block->next = m_free[sizeClass];
+      m_free[sizeClass] = block;
+      m_freeCount[sizeClass] ++;
+    } else {
+      ::operator delete(header);
+    }
+  }
+
+}
+
+void CoroutineMemoryPool::freeAll() {
+
+  for(v_buff_size i = 0; i < SIZE_CLASSES_COUNT; i ++) {
+    auto block = m_free[i];
+    while(block != nullptr) {
+      auto next = block->next;
+      ::operator delete(reinterpret_cast<Header*>(block) - 1);
+      block = next;
+    }
+    m_free[i] = nullptr;
+    m_freeCount[i] = 0;
+  }
+
+  auto block = m_remoteFree;
+  while(block != nullptr) {
+    auto next = block->next;
+    ::operator delete(reinterpret_cast<Header*>(block) - 1);
+    block = next;
+  }
+  m_remoteFree = nullptr;
+  m_hasRemoteFree.store(false, std::memory_order_relaxed);
+
+}
+
+void CoroutineMemoryPool::orphan() {
+
+  bool deletePool;
+
+  {
+    std::lock_guard<concurrency::SpinLock> lock(m_remoteLock);
+    m_orphaned = true;
+    freeAll();
+    deletePool = (m_outstanding.load(std::memory_order_acquire) == 0);
+  }
+
+  if(deletePool) {
+    delete this;
+  }
+
+}
+
+CoroutineMemoryPool::Statistics CoroutineMemoryPool::getStatistics() const {
+  Statistics stats;
+  stats.hits = m_hits.load(std::memory_order_relaxed);
+  stats.misses = m_misses.load(std::memory_order_relaxed);
+  stats.outstanding = m_outstanding.load(std::memory_order_relaxed);
+  return stats;
+}
+
+CoroutineMemoryPool* CoroutineMemoryPool::setCurrent(CoroutineMemoryPool* pool) {
+#ifndef OATPP_DISABLE_COROUTINE_POOL
+  auto previous = CURRENT_POOL;
+  CURRENT_POOL = pool;
+  return previous;
+#else
+  (void) pool;
+  return nullptr;
+#endif
+}
+
+void CoroutineMemoryPool::setEnabled(bool enabled) {
+  ENABLED.store(enabled, std::memory_order_relaxed);
+}
+
+void* CoroutineMemoryPool::allocate(std::size_t size) {
+
+#ifndef OATPP_DISABLE_COROUTINE_POOL
+
+  auto pool = CURRENT_POOL;
+  if(pool != nullptr && ENABLED.load(std::memory_order_relaxed)) {
+    auto sizeClass = (static_cast<v_int64>(size) + SIZE_CLASS_STEP - 1) / SIZE_CLASS_STEP - 1;
+    if(sizeClass < 0) {
+      sizeClass = 0;
+    }
+    if(sizeClass < SIZE_CLASSES_COUNT) {
+      return pool->allocateLocal(sizeClass);
+    }
+  }
+
+  return allocateUnpooled(size);
+
+#else
+  return ::operator new(size);
+#endif
+
+}
+
+void CoroutineMemoryPool::deallocate(void* ptr) {
+
+  if(ptr == nullptr) {
+    return;
+  }
+
+#ifndef OATPP_DISABLE_COROUTINE_POOL
+
+  auto header = static_cast<Header*>(ptr) - 1;
+  auto pool = header->pool;
+
+  if(pool == nullptr) {
+    ::operator delete(header);
+  } else if(pool == CURRENT_POOL) {
+    pool->freeLocal(header);
+  } else {
+    pool->freeRemote(header);
+  }
+
+#else
+  ::operator delete(ptr);
+#endif
+
+}
+
+}}
@@ -0,0 +1,201 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_async_CoroutineMemoryPool_hpp
+#define oatpp_async_CoroutineMemoryPool_hpp
+
+#include "oatpp/concurrency/SpinLock.hpp"
+#include "oatpp/Environment.hpp"
+
+#include <atomic>
+#include <cstddef>
+
+#if !defined(OATPP_DISABLE_COROUTINE_POOL) && defined(OATPP_COMPAT_BUILD_NO_THREAD_LOCAL)
+  #define OATPP_DISABLE_COROUTINE_POOL
+#endif
+
+namespace oatpp { namespace async {
+
+/**
+ * Memory pool for coroutines and coroutine handles. <br>
+ * Each &id:oatpp::async::Processor; owns one pool. While processor iterates, its pool is current for the thread,
+ * and coroutine objects allocated on this thread are taken from per-size-class free lists of the pool. <br>
+ * Objects freed by the processor thread go back to the free lists without locking.
+ * Objects freed by other threads are returned via the lock-protected list and are picked up by the owner later. <br>
+ * Objects allocated when no pool is current are allocated with global `operator new`. <br>
+ * Define `OATPP_DISABLE_COROUTINE_POOL` to disable pooling at compile time.
+ */
+class CoroutineMemoryPool {
+public:
+
+  /**
+   * Size class step in bytes.
+   */
+  static constexpr v_buff_size SIZE_CLASS_STEP = 16;
+
+  /**
+   * Number of size classes. Objects larger than `SIZE_CLASS_STEP * SIZE_CLASSES_COUNT` are not pooled.
+   */
+  static constexpr v_buff_size SIZE_CLASSES_COUNT = 64;
+
+  /**
+   * Max number of free blocks kept per size class.
+   */
+  static constexpr v_int64 MAX_FREE_BLOCKS = 1024;
+
+public:
+
+  /**
+   * Pool statistics.
+   */
+  struct Statistics {
+
+    /**
+     * Number of allocations served from free lists.
+     */
+    v_int64 hits;
+
+    /**
+     * Number of allocations served by global `operator new`.
+     */
+    v_int64 misses;
+
+    /**
+     * Number of allocated blocks which are not freed yet.
+     */
+    v_int64 outstanding;
+
+  };
+
+private:
+
+  struct alignas(alignof(std::max_align_t)) Header {
+    CoroutineMemoryPool* pool;
+    v_int64 sizeClass;
+  };
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+private:
+  static void* allocateUnpooled(std::size_t size);
+  static std::atomic<bool> ENABLED;
+private:
+  FreeBlock* m_free[SIZE_CLASSES_COUNT];
+  v_int64 m_freeCount[SIZE_CLASSES_COUNT];
+  std::atomic<v_int64> m_hits;
+  std::atomic<v_int64> m_misses;
+  std::atomic<v_int64> m_outstanding;
+private:
+  concurrency::SpinLock m_remoteLock;
+  FreeBlock* m_remoteFree;
+  std::atomic<bool> m_hasRemoteFree;
+  bool m_orphaned;
+private:
+  void* allocateLocal(v_int64 sizeClass);
+  void freeLocal(Header* header);
+  void freeRemote(Header* header);
+  void collectRemoteFree();
+  void freeAll();
+private:
+  CoroutineMemoryPool();
+  ~CoroutineMemoryPool() = default;
+public:
+
+  CoroutineMemoryPool(const CoroutineMemoryPool&) = delete;
+  CoroutineMemoryPool& operator=(const CoroutineMemoryPool&) = delete;
+
+  /**
+   * Create new pool.
+   * @return
+   */
+  static CoroutineMemoryPool* create();
+
+  /**
+   * Release pool by the owner. <br>
+   * Free blocks are deleted immediately. The pool object itself is deleted when all outstanding blocks are freed.
+   */
+  void orphan();
+
+  /**
+   * Get pool statistics.
+   * @return - &l:CoroutineMemoryPool::Statistics;.
+   */
+  Statistics getStatistics() const;
+
+public:
+
+  /**
+   * Set pool current for the calling thread.
+   * @param pool - pool to make current or `nullptr`.
+   * @return - previously current pool.
+   */
+  static CoroutineMemoryPool* setCurrent(CoroutineMemoryPool* pool);
+
+  /**
+   * Enable/Disable pooling at runtime. Pooling is enabled by default.
+   * @param enabled
+   */
+  static void setEnabled(bool enabled);
+
+  /**
+   * Allocate memory for coroutine object.
+   * @param size
+   * @return
+   */
+  static void* allocate(std::size_t size);
+
+  /**
+   * Free memory previously allocated with &l:CoroutineMemoryPool::allocate ();.
+   * @param ptr
+   */
+  static void deallocate(void* ptr);
+
+public:
+
+  /**
+   * Makes pool current for the scope.
+   */
+  class ScopedCurrent {
+  private:
+    CoroutineMemoryPool* m_previous;
+  public:
+
+    ScopedCurrent(CoroutineMemoryPool* pool)
+      : m_previous(setCurrent(pool))
+    {}
+
+    ~ScopedCurrent() {
+      setCurrent(m_previous);
+    }
+
+  };
+
+};
+
+}}
+
+#endif // oatpp_async_CoroutineMemoryPool_hpp
@@ -25,6 +25,7 @@
 #include "Executor.hpp"
 
 #include "oatpp/async/worker/IOEventWorker.hpp"
+#include "oatpp/async/worker/IOUringWorker.hpp"
 #include "oatpp/async/worker/IOWorker.hpp"
 #include "oatpp/async/worker/TimerWorker.hpp"
 
@@ -35,9 +36,12 @@ namespace oatpp { namespace async {
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Executor::SubmissionProcessor
 
-Executor::SubmissionProcessor::SubmissionProcessor()
+Executor::SubmissionProcessor::SubmissionProcessor(bool workStealing)
   : worker::Worker(worker::Worker::Type::PROCESSOR)
   , m_isRunning(true)
+  , m_workStealing(workStealing)
+  , m_stealingPeers(nullptr)
+  , m_stealingBalancer(0)
 {
   m_thread = std::thread(&Executor::SubmissionProcessor::run, this);
 }
@@ -46,10 +50,50 @@ oatpp::async::Processor& Executor::SubmissionProcessor::getProcessor() {
   return m_processor;
 }
 
+void Executor::SubmissionProcessor::setStealingPeers(std::vector<std::shared_ptr<SubmissionProcessor>>* peers) {
+  m_stealingPeers.store(peers, std::memory_order_release);
+}
+
+v_int32 Executor::SubmissionProcessor::stealTasks(const std::vector<std::shared_ptr<SubmissionProcessor>>& peers) {
+
+  auto size = static_cast<v_uint32>(peers.size());
+
+  for(v_uint32 i = 0; i < size; i ++) {
+    auto& peer = peers[(m_stealingBalancer + i) % size];
+    if(peer.get() != this) {
+      auto count = m_processor.stealTasks(peer->getProcessor());
+      if(count > 0) {
+        m_stealingBalancer += i;
+        return count;
+      }
+    }
+  }
+
+  m_stealingBalancer ++;
+  return 0;
+
+}
+
+void Executor::SubmissionProcessor::waitForTasksOrSteal() {
+  while(m_isRunning) {
+    auto peers = m_stealingPeers.load(std::memory_order_acquire);
+    if(peers != nullptr && stealTasks(*peers) > 0) {
+      return;
+    }
+    if(m_processor.waitForTasks(std::chrono::microseconds(WORK_STEALING_POLL_INTERVAL_MICROSECONDS))) {
+      return;
+    }
+  }
+}
+
 void Executor::SubmissionProcessor::run() {
   
   while(m_isRunning) {
-    m_processor.waitForTasks();
+    if(m_workStealing) {
+      waitForTasksOrSteal();
+    } else {
+      m_processor.waitForTasks();
+    }
     while (m_processor.iterate(100)) {}
   }
   
@@ -81,7 +125,11 @@ void Executor::SubmissionProcessor::detach() {
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Executor
 
-Executor::Executor(v_int32 processorWorkersCount, v_int32 ioWorkersCount, v_int32 timerWorkersCount, v_int32 ioWorkerType)
+Executor::Executor(v_int32 processorWorkersCount,
+                   v_int32 ioWorkersCount,
+                   v_int32 timerWorkersCount,
+                   v_int32 ioWorkerType,
+                   bool workStealing)
   : m_balancer(0)
 {
 
@@ -90,8 +138,10 @@ Executor::Executor(v_int32 processorWorkersCount, v_int32 ioWorkersCount, v_int3
   timerWorkersCount = chooseTimerWorkersCount(timerWorkersCount);
   ioWorkerType = chooseIOWorkerType(ioWorkerType);
 
+  workStealing = workStealing && processorWorkersCount > 1;
+
   for(v_int32 i = 0; i < processorWorkersCount; i ++) {
-    m_processorWorkers.push_back(std::make_shared<SubmissionProcessor>());
+    m_processorWorkers.push_back(std::make_shared<SubmissionProcessor>(workStealing));
   }
 
   m_allWorkers.insert(m_allWorkers.end(), m_processorWorkers.begin(), m_processorWorkers.end());
@@ -114,6 +164,13 @@ Executor::Executor(v_int32 processorWorkersCount, v_int32 ioWorkersCount, v_int3
       break;
     }
 
+    case IO_WORKER_TYPE_URING: {
+      for (v_int32 i = 0; i < ioWorkersCount; i++) {
+        ioWorkers.push_back(std::make_shared<worker::IOUringWorker>());
+      }
+      break;
+    }
+
     default:
       throw std::runtime_error("[oatpp::async::Executor::Executor()]: Error. Unknown IO worker type.");
 
@@ -129,6 +186,12 @@ Executor::Executor(v_int32 processorWorkersCount, v_int32 ioWorkersCount, v_int3
 
   linkWorkers(timerWorkers);
 
+  if(workStealing) {
+    for(auto& p : m_processorWorkers) {
+      p->setStealingPeers(&m_processorWorkers);
+    }
+  }
+
 }
 
 v_int32 Executor::chooseProcessorWorkersCount(v_int32 processorWorkersCount) {
@@ -248,6 +311,19 @@ v_int32 Executor::getTasksCount() {
 
 }
 
+std::vector<Processor::WorkStealingStatistics> Executor::getWorkStealingStatistics() {
+
+  std::vector<Processor::WorkStealingStatistics> result;
+  result.reserve(m_processorWorkers.size());
+
+  for(const auto& procWorker : m_processorWorkers) {
+    result.push_back(procWorker->getProcessor().getWorkStealingStatistics());
+  }
+
+  return result;
+
+}
+
 void Executor::waitTasksFinished(const std::chrono::duration<v_int64, std::micro>& timeout) {
 
   auto startTime = std::chrono::system_clock::now();
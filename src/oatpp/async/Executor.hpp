@@ -50,10 +50,17 @@ private:
     oatpp::async::Processor m_processor;
   private:
     std::atomic<bool> m_isRunning;
+  private:
+    bool m_workStealing;
+    std::atomic<std::vector<std::shared_ptr<SubmissionProcessor>>*> m_stealingPeers;
+    v_uint32 m_stealingBalancer;
   private:
     std::thread m_thread;
+  private:
+    v_int32 stealTasks(const std::vector<std::shared_ptr<SubmissionProcessor>>& peers);
+    void waitForTasksOrSteal();
   public:
-    SubmissionProcessor();
+    SubmissionProcessor(bool workStealing);
   public:
 
     template<typename CoroutineType, typename ... Args>
@@ -63,6 +70,8 @@ private:
 
     oatpp::async::Processor& getProcessor();
 
+    void setStealingPeers(std::vector<std::shared_ptr<SubmissionProcessor>>* peers);
+
     void pushTasks(utils::FastQueue<CoroutineHandle>& tasks) override GPP_ATTRIBUTE(noreturn);
 
     void pushOneTask(CoroutineHandle* task) override GPP_ATTRIBUTE(noreturn);
@@ -93,6 +102,16 @@ public:
    * IO Worker type event.
    */
   static constexpr const v_int32 IO_WORKER_TYPE_EVENT = 1;
+
+  /**
+   * IO Worker type io_uring (Linux only). See &id:oatpp::async::worker::IOUringWorker;.
+   */
+  static constexpr const v_int32 IO_WORKER_TYPE_URING = 2;
+
+  /**
+   * How often idle processor checks other processors for coroutines to steal when work stealing is enabled.
+   */
+  static constexpr const v_int64 WORK_STEALING_POLL_INTERVAL_MICROSECONDS = 1000;
 private:
   std::atomic<v_uint32> m_balancer;
 private:
@@ -111,12 +130,14 @@ public:
    * @param processorWorkersCount - number of data processing workers.
    * @param ioWorkersCount - number of I/O processing workers.
    * @param timerWorkersCount - number of timer processing workers.
-   * @param IOWorkerType
+   * @param ioWorkerType - one of `IO_WORKER_TYPE_NAIVE`, `IO_WORKER_TYPE_EVENT`, `IO_WORKER_TYPE_URING`.
+   * @param workStealing - if `true`, idle processors will steal runnable coroutines from busy processors.
    */
   Executor(v_int32 processorWorkersCount = VALUE_SUGGESTED,
            v_int32 ioWorkersCount = VALUE_SUGGESTED,
            v_int32 timerWorkersCount = VALUE_SUGGESTED,
-           v_int32 ioWorkerType = VALUE_SUGGESTED);
+           v_int32 ioWorkerType = VALUE_SUGGESTED,
+           bool workStealing = false);
 
   /**
    * Non-virtual Destructor.
@@ -151,12 +172,40 @@ public:
     processor->execute<CoroutineType, Args...>(params...);
   }
 
+  /**
+   * Execute Coroutine on the specific processor. <br>
+   * Use it to keep related work (ex.: connections accepted by the same listener) on the same processor.
+   * @tparam CoroutineType - type of coroutine to execute.
+   * @tparam Args - types of arguments to be passed to Coroutine constructor.
+   * @param processorIndex - index of the processor. Taken modulo &l:Executor::getProcessorsCount ();.
+   * @param params - actual arguments to be passed to Coroutine constructor.
+   */
+  template<typename CoroutineType, typename ... Args>
+  void executeOn(v_uint32 processorIndex, Args... params) {
+    auto& processor = m_processorWorkers[processorIndex % m_processorWorkers.size()];
+    processor->execute<CoroutineType, Args...>(params...);
+  }
+
+  /**
+   * Get number of data processing workers (processors).
+   * @return - number of processors.
+   */
+  v_int32 getProcessorsCount() const {
+    return static_cast<v_int32>(m_processorWorkers.size());
+  }
+
   /**
    * Get number of all not finished tasks.
    * @return - number of all not finished tasks.
    */
   v_int32 getTasksCount();
 
+  /**
+   * Get work stealing statistics of each processor.
+   * @return - vector of &id:oatpp::async::Processor::WorkStealingStatistics;. One entry per processor.
+   */
+  std::vector<Processor::WorkStealingStatistics> getWorkStealingStatistics();
+
   /**
    * Wait until all tasks are finished.
    * @param timeout
@@ -29,6 +29,12 @@
 
 namespace oatpp { namespace async {
 
+Processor::~Processor() {
+  reclaimSharedTasks();
+  m_queue.clear();
+  m_memoryPool->orphan();
+}
+
 void Processor::addWorker(const std::shared_ptr<worker::Worker>& worker) {
 
   switch(worker->getType()) {
@@ -137,6 +143,72 @@ void Processor::waitForTasks() {
 
 }
 
+bool Processor::waitForTasks(const std::chrono::duration<v_int64, std::micro>& timeout) {
+
+  std::unique_lock<oatpp::concurrency::SpinLock> lock(m_taskLock);
+  if (m_pushList.first == nullptr && m_taskList.empty() && m_running) {
+    m_taskCondition.wait_for(lock, timeout);
+  }
+  return m_pushList.first != nullptr || !m_taskList.empty();
+
+}
+
+void Processor::shareTasks() {
+
+  v_int32 count = m_queue.count / 2;
+
+  while(count > 0) {
+    auto CP = m_queue.popFront();
+    if(!m_sharedQueue.push(CP)) {
+      m_queue.pushFront(CP);
+      break;
+    }
+    count --;
+  }
+
+  m_sharedTimestamp = oatpp::Environment::getMicroTickCount();
+
+}
+
+void Processor::reclaimSharedTasks() {
+  CoroutineHandle* CP;
+  while((CP = m_sharedQueue.pop()) != nullptr) {
+    m_queue.pushBack(CP);
+  }
+}
+
+v_int32 Processor::stealTasks(Processor& victim) {
+
+  auto available = victim.m_sharedQueue.size();
+  if(available == 0) {
+    victim.m_shareRequested.store(true, std::memory_order_relaxed);
+    return 0;
+  }
+
+  v_int32 count = 0;
+  v_int64 maxCount = (available + 1) / 2;
+
+  while(count < maxCount) {
+    auto CP = victim.m_sharedQueue.steal();
+    if(CP == nullptr) {
+      break;
+    }
+    CP->_PP = this;
+    m_queue.pushBack(CP);
+    count ++;
+  }
+
+  if(count > 0) {
+    m_tasksCounter += count;
+    victim.m_tasksCounter -= count;
+    m_stolenCounter.fetch_add(count, std::memory_order_relaxed);
+    victim.m_givenAwayCounter.fetch_add(count, std::memory_order_relaxed);
+  }
+
+  return count;
+
+}
+
 void Processor::popTasks() {
 
   for(size_t i = 0; i < m_ioWorkers.size(); i++) {
@@ -177,13 +249,16 @@ void Processor::pushQueues() {
 }
 
 void Processor::putCoroutineToSleep(CoroutineHandle* ch) {
-  if(ch->_SCH_A.m_data.waitListData.timePointMicroseconds == 0) {
+  auto timePoint = ch->_SCH_A.m_data.waitListData.timePointMicroseconds;
+  if(timePoint == 0) {
     std::lock_guard<std::mutex> lock(m_sleepMutex);
     m_sleepNoTimeSet.insert(ch);
   } else {
     std::lock_guard<std::mutex> lock(m_sleepMutex);
-    m_sleepTimeSet.insert(ch);
-    m_sleepCV.notify_one();
+    m_sleepTimeWheel.add(ch, timePoint);
+    if(timePoint < m_sleepWakeupTimePoint) {
+      m_sleepCV.notify_one();
+    }
   }
 }
 
@@ -193,43 +268,57 @@ void Processor::wakeCoroutine(CoroutineHandle* ch) {
     m_sleepNoTimeSet.erase(ch);
   } else {
     std::lock_guard<std::mutex> lock(m_sleepMutex);
-    m_sleepTimeSet.erase(ch);
+    m_sleepTimeWheel.remove(ch);
   }
   ch->_SCH_A = Action::createActionByType(Action::TYPE_NONE);
   pushOneTask(ch);
 }
 
 void Processor::checkCoroutinesSleep() {
+
+  std::unique_lock<std::mutex> lock{m_sleepMutex};
+
   while (m_running) {
-    {
-      std::unique_lock<std::mutex> lock{m_sleepMutex};
-      while (m_running && m_sleepTimeSet.empty()) {
-        m_sleepCV.wait(lock);
-      }
 
-      auto now = oatpp::Environment::getMicroTickCount();
-      for(auto it = m_sleepTimeSet.begin(); it != m_sleepTimeSet.end();) {
-        auto ch = *it;
-        if(ch->_SCH_A.m_data.waitListData.timePointMicroseconds < now) {
-          it = m_sleepTimeSet.erase(it);
-          ch->_SCH_A.m_data.waitListData.waitList->forgetCoroutine(ch);
-          ch->_SCH_A = Action::createActionByType(Action::TYPE_NONE);
-          pushOneTask(ch);
-        } else {
-          it ++;
-        }
-      }
+    auto now = oatpp::Environment::getMicroTickCount();
+    m_sleepTimeWheel.advance(now, [this](CoroutineHandle* ch) {
+      ch->_SCH_A.m_data.waitListData.waitList->forgetCoroutine(ch);
+      ch->_SCH_A = Action::createActionByType(Action::TYPE_NONE);
+      pushOneTask(ch);
+    });
 
+    m_sleepWakeupTimePoint = m_sleepTimeWheel.getNextTimePointMicroseconds();
+    if(!m_running) {
+      break;
+    }
+    if(m_sleepTimeWheel.empty()) {
+      m_sleepCV.wait(lock);
+    } else if(m_sleepWakeupTimePoint > now) {
+      m_sleepCV.wait_for(lock, std::chrono::microseconds(m_sleepWakeupTimePoint - now));
     }
+    m_sleepWakeupTimePoint = 0;
 
-    if(m_running) std::this_thread::sleep_for(std::chrono::milliseconds{100});
   }
+
 }
 
 bool Processor::iterate(v_int32 numIterations) {
 
+  CoroutineMemoryPool::ScopedCurrent currentPool(m_memoryPool);
+
   pushQueues();
 
+  if(!m_sharedQueue.empty() &&
+     (m_queue.first == nullptr ||
+      oatpp::Environment::getMicroTickCount() - m_sharedTimestamp > SHARED_TASKS_RECLAIM_TIMEOUT_MICROSECONDS))
+  {
+    reclaimSharedTasks();
+  }
+
+  if(m_shareRequested.load(std::memory_order_relaxed) && m_shareRequested.exchange(false)) {
+    shareTasks();
+  }
+
   for(v_int32 i = 0; i < numIterations; i++) {
 
     auto CP = m_queue.first;
@@ -275,7 +364,7 @@ bool Processor::iterate(v_int32 numIterations) {
   popTasks();
 
   std::lock_guard<oatpp::concurrency::SpinLock> lock(m_taskLock);
-  return m_queue.first != nullptr || m_pushList.first != nullptr || !m_taskList.empty();
+  return m_queue.first != nullptr || m_pushList.first != nullptr || !m_taskList.empty() || !m_sharedQueue.empty();
   
 }
 
@@ -285,6 +374,10 @@ void Processor::stop() {
     m_running = false;
   }
   m_taskCondition.notify_one();
+
+  {
+    std::lock_guard<std::mutex> lock(m_sleepMutex);
+  }
   m_sleepCV.notify_one();
 
   m_sleepSetTask.join();
@@ -295,4 +388,15 @@ v_int32 Processor::getTasksCount() {
   return m_tasksCounter.load();
 }
 
+CoroutineMemoryPool::Statistics Processor::getMemoryPoolStatistics() const {
+  return m_memoryPool->getStatistics();
+}
+
+Processor::WorkStealingStatistics Processor::getWorkStealingStatistics() const {
+  WorkStealingStatistics stats;
+  stats.stolen = m_stolenCounter.load(std::memory_order_relaxed);
+  stats.givenAway = m_givenAwayCounter.load(std::memory_order_relaxed);
+  return stats;
+}
+
 }}
@@ -27,8 +27,11 @@
 #define oatpp_async_Processor_hpp
 
 #include "./Coroutine.hpp"
+#include "./CoroutineMemoryPool.hpp"
 #include "./CoroutineWaitList.hpp"
 #include "oatpp/async/utils/FastQueue.hpp"
+#include "oatpp/async/utils/TimingWheel.hpp"
+#include "oatpp/async/utils/WorkStealingDeque.hpp"
 #include "oatpp/concurrency/SpinLock.hpp"
 
 #include <thread>
@@ -47,6 +50,35 @@ namespace oatpp { namespace async {
  */
 class Processor {
     friend class CoroutineWaitList;
+public:
+
+  /**
+   * Max time shared coroutines wait to be stolen before processor takes them back.
+   */
+  static constexpr v_int64 SHARED_TASKS_RECLAIM_TIMEOUT_MICROSECONDS = 10000;
+
+  /**
+   * Resolution of the timer which wakes coroutines waiting on &id:oatpp::async::CoroutineWaitList; with timeout.
+   */
+  static constexpr v_int64 SLEEP_TIMER_RESOLUTION_MICROSECONDS = 1000;
+
+  /**
+   * Work stealing statistics.
+   */
+  struct WorkStealingStatistics {
+
+    /**
+     * Number of coroutines this processor has stolen from other processors.
+     */
+    v_int64 stolen;
+
+    /**
+     * Number of coroutines other processors have stolen from this processor.
+     */
+    v_int64 givenAway;
+
+  };
+
 private:
 
   class TaskSubmission {
@@ -104,12 +136,11 @@ private:
 private:
 
   std::unordered_set<CoroutineHandle*> m_sleepNoTimeSet;
-  std::unordered_set<CoroutineHandle*> m_sleepTimeSet;
+  utils::TimingWheel<CoroutineHandle> m_sleepTimeWheel{SLEEP_TIMER_RESOLUTION_MICROSECONDS, oatpp::Environment::getMicroTickCount()};
+  v_int64 m_sleepWakeupTimePoint = 0;
   std::mutex m_sleepMutex;
   std::condition_variable m_sleepCV;
 
-  std::thread m_sleepSetTask{&Processor::checkCoroutinesSleep, this};
-
 private:
 
   oatpp::concurrency::SpinLock m_taskLock;
@@ -121,10 +152,22 @@ private:
 
   utils::FastQueue<CoroutineHandle> m_queue;
 
+private:
+  utils::WorkStealingDeque<CoroutineHandle> m_sharedQueue;
+  std::atomic<bool> m_shareRequested{false};
+  v_int64 m_sharedTimestamp = 0;
+  std::atomic<v_int64> m_stolenCounter{0};
+  std::atomic<v_int64> m_givenAwayCounter{0};
+
+private:
+  CoroutineMemoryPool* m_memoryPool = CoroutineMemoryPool::create();
 private:
   std::atomic_bool m_running{true};
   std::atomic<v_int32> m_tasksCounter{0};
 private:
+  /* Must be the last member - the thread uses all of the above */
+  std::thread m_sleepSetTask{&Processor::checkCoroutinesSleep, this};
+private:
 
   void popIOTask(CoroutineHandle* coroutine);
   void popTimerTask(CoroutineHandle* coroutine);
@@ -134,6 +177,9 @@ private:
   void popTasks();
   void pushQueues();
 
+  void shareTasks();
+  void reclaimSharedTasks();
+
   void putCoroutineToSleep(CoroutineHandle* ch);
   void wakeCoroutine(CoroutineHandle* ch);
   void checkCoroutinesSleep();
@@ -142,6 +188,11 @@ public:
 
   Processor() = default;
 
+  /**
+   * Non-virtual destructor.
+   */
+  ~Processor();
+
   /**
    * Add dedicated co-worker to processor.
    * @param worker - &id:oatpp::async::worker::Worker;.
@@ -182,6 +233,22 @@ public:
    */
   void waitForTasks();
 
+  /**
+   * Sleep and wait for tasks not longer than timeout.
+   * @param timeout
+   * @return - `true` if there are tasks to process.
+   */
+  bool waitForTasks(const std::chrono::duration<v_int64, std::micro>& timeout);
+
+  /**
+   * Steal runnable coroutines from another processor. <br>
+   * Must be called from the thread which iterates this processor. <br>
+   * If victim has no coroutines shared, the victim is asked to share some on its next iteration.
+   * @param victim - processor to steal from.
+   * @return - number of stolen coroutines.
+   */
+  v_int32 stealTasks(Processor& victim);
+
   /**
    * Iterate Coroutines.
    * @param numIterations - number of iterations.
@@ -200,6 +267,18 @@ public:
    */
   v_int32 getTasksCount();
 
+  /**
+   * Get statistics of processor's coroutine memory pool.
+   * @return - &id:oatpp::async::CoroutineMemoryPool::Statistics;.
+   */
+  CoroutineMemoryPool::Statistics getMemoryPoolStatistics() const;
+
+  /**
+   * Get work stealing statistics.
+   * @return - &l:Processor::WorkStealingStatistics;.
+   */
+  WorkStealingStatistics getWorkStealingStatistics() const;
+
   
 };
   
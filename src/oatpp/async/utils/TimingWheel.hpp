@@ -0,0 +1,358 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_async_utils_TimingWheel_hpp
+#define oatpp_async_utils_TimingWheel_hpp
+
+#include "oatpp/Environment.hpp"
+
+#include <limits>
+#include <list>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace oatpp { namespace async { namespace utils {
+
+/**
+ * Hierarchical timing wheel. <br>
+ * Entries are bucketed by their expiration tick into `LEVELS` wheels of `SLOTS` slots each.
+ * Add and remove are O(1), advancing the wheel costs O(expired entries + cascaded entries)
+ * regardless of how many entries are still waiting. <br>
+ * Entries never expire early and expire not later than one tick (resolution) after their time point. <br>
+ * Not thread-safe. The owner is responsible for synchronization.
+ * @tparam T - type of entries. Wheel stores pointers to `T`.
+ */
+template<typename T>
+class TimingWheel {
+public:
+
+  /**
+   * Number of bits of slot index.
+   */
+  static constexpr v_int32 SLOT_BITS = 6;
+
+  /**
+   * Number of slots in each level.
+   */
+  static constexpr v_int64 SLOTS = v_int64(1) << SLOT_BITS;
+
+  /**
+   * Number of levels. <br>
+   * Levels span `SLOTS^LEVELS` ticks. Entries further in the future are parked in the top level and re-cascaded.
+   */
+  static constexpr v_int32 LEVELS = 4;
+
+private:
+
+  struct Entry {
+    T* item;
+    v_int64 expireTick;
+  };
+
+  typedef std::list<Entry> Slot;
+
+  struct Location {
+    v_int32 level;
+    v_int64 slot;
+    typename Slot::iterator iterator;
+  };
+
+private:
+
+  static v_int64 levelShift(v_int32 level) {
+    return v_int64(level) * SLOT_BITS;
+  }
+
+  static v_int64 levelMask(v_int32 level) {
+    return (v_int64(1) << levelShift(level)) - 1;
+  }
+
+private:
+  v_int64 m_resolution;
+  v_int64 m_currentTick;
+  std::vector<Slot> m_slots;
+  v_int64 m_levelCounts[LEVELS];
+  std::unordered_map<T*, Location> m_locations;
+private:
+
+  Slot& getSlot(v_int32 level, v_int64 slot) {
+    return m_slots[static_cast<size_t>(level * SLOTS + slot)];
+  }
+
+  const Slot& getSlot(v_int32 level, v_int64 slot) const {
+    return m_slots[static_cast<size_t>(level * SLOTS + slot)];
+  }
+
+  void locate(v_int64 expireTick, v_int32& level, v_int64& slot) const {
+    v_int64 delta = expireTick - m_currentTick;
+    level = 0;
+    while(level < LEVELS - 1 && delta >= (v_int64(1) << levelShift(level + 1))) {
+      level ++;
+    }
+    if(level == LEVELS - 1 && delta >= (v_int64(1) << levelShift(LEVELS))) {
+      /* too far in the future - park in the furthest slot and re-cascade later */
+      expireTick = m_currentTick + (v_int64(1) << levelShift(LEVELS)) - 1;
+    }
+    slot = (expireTick >> levelShift(level)) & (SLOTS - 1);
+  }
+
+  /*
+   * Move entry, pointed by location, from its current slot to the slot matching its expiration tick.
+   */
+  void place(Slot& from, Location& location) {
+    v_int32 level;
+    v_int64 slot;
+    locate(location.iterator->expireTick, level, slot);
+    getSlot(level, slot).splice(getSlot(level, slot).end(), from, location.iterator);
+    m_levelCounts[location.level] --;
+    m_levelCounts[level] ++;
+    location.level = level;
+    location.slot = slot;
+  }
+
+  void cascade(v_int32 level, v_int64 slotIndex) {
+    Slot& slot = getSlot(level, slotIndex);
+    while(!slot.empty()) {
+      place(slot, m_locations.at(slot.front().item));
+    }
+  }
+
+  void expire(v_int64 slotIndex, std::vector<T*>& expired) {
+    Slot& slot = getSlot(0, slotIndex);
+    for(auto& entry : slot) {
+      expired.push_back(entry.item);
+      m_locations.erase(entry.item);
+    }
+    m_levelCounts[0] -= static_cast<v_int64>(slot.size());
+    slot.clear();
+  }
+
+public:
+
+  /**
+   * Constructor.
+   * @param resolutionMicroseconds - duration of one tick in microseconds.
+   * @param nowMicroseconds - current time point in microseconds. Time points passed to the wheel must use the same clock.
+   */
+  TimingWheel(v_int64 resolutionMicroseconds, v_int64 nowMicroseconds)
+    : m_resolution(resolutionMicroseconds)
+    , m_currentTick(0)
+    , m_slots(static_cast<size_t>(LEVELS * SLOTS))
+    , m_levelCounts{}
+  {
+    if(m_resolution <= 0) {
+      throw std::runtime_error("[oatpp::async::utils::TimingWheel::TimingWheel()]: Error. Resolution must be positive.");
+    }
+    m_currentTick = nowMicroseconds / m_resolution;
+  }
+
+  TimingWheel(const TimingWheel&) = delete;
+  TimingWheel& operator=(const TimingWheel&) = delete;
+
+  /**
+   * Schedule entry. If entry is already scheduled it is rescheduled.
+   * @param item - entry.
+   * @param timePointMicroseconds - time point after which entry expires.
+   */
+  void add(T* item, v_int64 timePointMicroseconds) {
+
+    remove(item);
+
+    v_int64 expireTick = timePointMicroseconds / m_resolution + 1;
+    if(expireTick < m_currentTick) {
+      expireTick = m_currentTick;
+    }
+
+    v_int32 level;
+    v_int64 slotIndex;
+    locate(expireTick, level, slotIndex);
+
+    Slot& slot = getSlot(level, slotIndex);
+    slot.push_back({item, expireTick});
+    m_locations[item] = {level, slotIndex, std::prev(slot.end())};
+    m_levelCounts[level] ++;
+
+  }
+
+  /**
+   * Unschedule entry.
+   * @param item - entry.
+   * @return - `true` if entry was scheduled.
+   */
+  bool remove(T* item) {
+    auto it = m_locations.find(item);
+    if(it == m_locations.end()) {
+      return false;
+    }
+    getSlot(it->second.level, it->second.slot).erase(it->second.iterator);
+    m_levelCounts[it->second.level] --;
+    m_locations.erase(it);
+    return true;
+  }
+
+  /**
+   * Check if entry is scheduled.
+   * @param item - entry.
+   * @return - `true` if entry is scheduled.
+   */
+  bool contains(T* item) const {
+    return m_locations.find(item) != m_locations.end();
+  }
+
+  /**
+   * Advance wheel to the given time point and expire entries. <br>
+   * Expired entries are removed from the wheel before `onExpired` is called,
+   * so `onExpired` may schedule them again.
+   * @tparam F - callable `void(T*)`.
+   * @param nowMicroseconds - current time point.
+   * @param onExpired - called for each expired entry.
+   */
+  template<typename F>
+  void advance(v_int64 nowMicroseconds, F&& onExpired) {
+
+    v_int64 nowTick = nowMicroseconds / m_resolution;
+    std::vector<T*> expired;
+
+    while(m_currentTick <= nowTick) {
+
+      if(m_locations.empty()) {
+        m_currentTick = nowTick + 1;
+        break;
+      }
+
+      v_int64 tick = m_currentTick;
+
+      for(v_int32 level = LEVELS - 1; level > 0; level --) {
+        if(m_levelCounts[level] > 0 && (tick & levelMask(level)) == 0) {
+          cascade(level, (tick >> levelShift(level)) & (SLOTS - 1));
+        }
+      }
+
+      if(m_levelCounts[0] > 0) {
+        expire(tick & (SLOTS - 1), expired);
+        m_currentTick = tick + 1;
+      } else {
+        /* nothing can happen before the next cascade of the lowest non-empty level */
+        v_int32 level = 1;
+        while(level < LEVELS - 1 && m_levelCounts[level] == 0) {
+          level ++;
+        }
+        v_int64 nextTick = ((tick >> levelShift(level)) + 1) << levelShift(level);
+        m_currentTick = nextTick < nowTick + 1 ? nextTick : nowTick + 1;
+      }
+
+    }
+
+    for(auto item : expired) {
+      onExpired(item);
+    }
+
+  }
+
+  /**
+   * Get time point at which the wheel should be advanced next. <br>
+   * Never later than the nearest expiration. May be earlier when far entries have to be cascaded.
+   * @return - time point in microseconds or `std::numeric_limits<v_int64>::max()` if wheel is empty.
+   */
+  v_int64 getNextTimePointMicroseconds() const {
+
+    v_int64 result = std::numeric_limits<v_int64>::max();
+
+    for(v_int32 level = 0; level < LEVELS; level ++) {
+
+      if(m_levelCounts[level] == 0) {
+        continue;
+      }
+
+      v_int64 index = m_currentTick >> levelShift(level);
+      v_int64 start = (level == 0 || (m_currentTick & levelMask(level)) == 0) ? 0 : 1;
+
+      for(v_int64 i = start; i < start + SLOTS; i ++) {
+        if(!getSlot(level, (index + i) & (SLOTS - 1)).empty()) {
+          v_int64 tick = (index + i) << levelShift(level);
+          if(tick < m_currentTick) {
+            tick = m_currentTick;
+          }
+          if(tick * m_resolution < result) {
+            result = tick * m_resolution;
+          }
+          break;
+        }
+      }
+
+    }
+
+    return result;
+
+  }
+
+  /**
+   * Remove all entries.
+   * @tparam F - callable `void(T*)`.
+   * @param onEntry - called for each removed entry.
+   */
+  template<typename F>
+  void clear(F&& onEntry) {
+    for(auto& slot : m_slots) {
+      for(auto& entry : slot) {
+        onEntry(entry.item);
+      }
+      slot.clear();
+    }
+    for(v_int32 level = 0; level < LEVELS; level ++) {
+      m_levelCounts[level] = 0;
+    }
+    m_locations.clear();
+  }
+
+  /**
+   * Get number of scheduled entries.
+   * @return
+   */
+  v_int64 size() const {
+    return static_cast<v_int64>(m_locations.size());
+  }
+
+  /**
+   * Check if wheel has no scheduled entries.
+   * @return
+   */
+  bool empty() const {
+    return m_locations.empty();
+  }
+
+  /**
+   * Get duration of one tick.
+   * @return - microseconds.
+   */
+  v_int64 getResolutionMicroseconds() const {
+    return m_resolution;
+  }
+
+};
+
+}}}
+
+#endif // oatpp_async_utils_TimingWheel_hpp
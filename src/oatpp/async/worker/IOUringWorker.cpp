@@ -0,0 +1,503 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "IOUringWorker.hpp"
+
+#include "oatpp/async/Processor.hpp"
+#include "oatpp/base/Log.hpp"
+
+#ifdef OATPP_IO_URING_SUPPORTED
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// io_uring based implementation
+
+#include <cstring>
+
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+namespace oatpp { namespace async { namespace worker {
+
+namespace {
+
+int sys_io_uring_setup(unsigned entries, io_uring_params* params) {
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int sys_io_uring_enter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+  return static_cast<int>(::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+}
+
+struct IOUringWorker::Ring {
+
+  int fd = -1;
+
+  void* sqPtr = MAP_FAILED;
+  size_t sqSize = 0;
+  void* cqPtr = MAP_FAILED;
+  size_t cqSize = 0;
+  io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+  size_t sqesSize = 0;
+
+  unsigned* sqHead = nullptr;
+  unsigned* sqTail = nullptr;
+  unsigned* sqMask = nullptr;
+  unsigned* sqEntries = nullptr;
+  unsigned* sqArray = nullptr;
+
+  unsigned* cqHead = nullptr;
+  unsigned* cqTail = nullptr;
+  unsigned* cqMask = nullptr;
+  io_uring_cqe* cqes = nullptr;
+
+};
+
+IOUringWorker::IOUringWorker(v_uint32 queueDepth)
+  : Worker(Type::IO)
+  , m_running(true)
+  , m_ring(new Ring())
+  , m_wakeupTrigger(INVALID_IO_HANDLE)
+  , m_wakeupArmed(false)
+  , m_pendingSubmissions(0)
+{
+  initRing(queueDepth);
+  m_thread = std::thread(&IOUringWorker::run, this);
+}
+
+IOUringWorker::~IOUringWorker() {
+  destroyRing();
+}
+
+bool IOUringWorker::isSupported() {
+  io_uring_params params;
+  std::memset(&params, 0, sizeof(io_uring_params));
+  int fd = sys_io_uring_setup(2, &params);
+  if(fd < 0) {
+    return false;
+  }
+  ::close(fd);
+  return true;
+}
+
+void IOUringWorker::initRing(v_uint32 queueDepth) {
+
+  io_uring_params params;
+  std::memset(&params, 0, sizeof(io_uring_params));
+
+  m_ring->fd = sys_io_uring_setup(queueDepth, &params);
+  if(m_ring->fd < 0) {
+    OATPP_LOGe("[oatpp::async::worker::IOUringWorker::initRing()]", "Error. Call to io_uring_setup() failed. errno={}", errno)
+    throw std::runtime_error("[oatpp::async::worker::IOUringWorker::initRing()]: Error. Call to io_uring_setup() failed.");
+  }
+
+  m_ring->sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  m_ring->cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+  bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if(singleMmap) {
+    m_ring->sqSize = std::max(m_ring->sqSize, m_ring->cqSize);
+    m_ring->cqSize = m_ring->sqSize;
+  }
+
+  m_ring->sqPtr = ::mmap(nullptr, m_ring->sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring->fd, IORING_OFF_SQ_RING);
+  if(m_ring->sqPtr == MAP_FAILED) {
+    destroyRing();
+    throw std::runtime_error("[oatpp::async::worker::IOUringWorker::initRing()]: Error. Can't map submission queue ring.");
+  }
+
+  if(singleMmap) {
+    m_ring->cqPtr = m_ring->sqPtr;
+  } else {
+    m_ring->cqPtr = ::mmap(nullptr, m_ring->cqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring->fd, IORING_OFF_CQ_RING);
+    if(m_ring->cqPtr == MAP_FAILED) {
+      destroyRing();
+      throw std::runtime_error("[oatpp::async::worker::IOUringWorker::initRing()]: Error. Can't map completion queue ring.");
+    }
+  }
+
+  m_ring->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+  m_ring->sqes = static_cast<io_uring_sqe*>(::mmap(nullptr, m_ring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring->fd, IORING_OFF_SQES));
+  if(m_ring->sqes == MAP_FAILED) {
+    destroyRing();
+    throw std::runtime_error("[oatpp::async::worker::IOUringWorker::initRing()]: Error. Can't map submission queue entries.");
+  }
+
+  auto sq = static_cast<v_char8*>(m_ring->sqPtr);
+  m_ring->sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  m_ring->sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  m_ring->sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  m_ring->sqEntries = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_entries);
+  m_ring->sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+  auto cq = static_cast<v_char8*>(m_ring->cqPtr);
+  m_ring->cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  m_ring->cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  m_ring->cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  m_ring->cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+  m_wakeupTrigger = ::eventfd(0, EFD_NONBLOCK);
+  if(m_wakeupTrigger == -1) {
+    OATPP_LOGe("[oatpp::async::worker::IOUringWorker::initRing()]", "Error. Call to ::eventfd() failed. errno={}", errno)
+    destroyRing();
+    throw std::runtime_error("[oatpp::async::worker::IOUringWorker::initRing()]: Error. Call to ::eventfd() failed.");
+  }
+
+}
+
+void IOUringWorker::destroyRing() {
+
+  if(m_ring->sqes != MAP_FAILED) {
+    ::munmap(m_ring->sqes, m_ring->sqesSize);
+    m_ring->sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+  }
+
+  if(m_ring->cqPtr != MAP_FAILED && m_ring->cqPtr != m_ring->sqPtr) {
+    ::munmap(m_ring->cqPtr, m_ring->cqSize);
+  }
+  m_ring->cqPtr = MAP_FAILED;
+
+  if(m_ring->sqPtr != MAP_FAILED) {
+    ::munmap(m_ring->sqPtr, m_ring->sqSize);
+    m_ring->sqPtr = MAP_FAILED;
+  }
+
+  if(m_ring->fd >= 0) {
+    ::close(m_ring->fd);
+    m_ring->fd = -1;
+  }
+
+  if(m_wakeupTrigger >= 0) {
+    ::close(m_wakeupTrigger);
+    m_wakeupTrigger = INVALID_IO_HANDLE;
+  }
+
+}
+
+void IOUringWorker::triggerWakeup() {
+  eventfd_write(m_wakeupTrigger, 1);
+}
+
+void IOUringWorker::armWakeupTrigger() {
+  m_wakeupArmed = queuePoll(m_wakeupTrigger, POLLIN, this);
+}
+
+void IOUringWorker::armCoroutine(CoroutineHandle* coroutine) {
+
+  auto& action = getCoroutineScheduledAction(coroutine);
+
+  switch(action.getType()) {
+
+    case Action::TYPE_IO_WAIT: break;
+    case Action::TYPE_IO_REPEAT: break;
+
+    default:
+      OATPP_LOGe("[oatpp::async::worker::IOUringWorker::armCoroutine()]", "Error. Unknown Action. action.getType()=={}", action.getType())
+      throw std::runtime_error("[oatpp::async::worker::IOUringWorker::armCoroutine()]: Error. Unknown Action.");
+
+  }
+
+  bool queued;
+
+  switch(action.getIOEventType()) {
+
+    case Action::IOEventType::IO_EVENT_READ:
+      queued = queuePoll(action.getIOHandle(), POLLIN, coroutine);
+      break;
+
+    case Action::IOEventType::IO_EVENT_WRITE:
+      queued = queuePoll(action.getIOHandle(), POLLOUT, coroutine);
+      break;
+
+    default:
+      throw std::runtime_error("[oatpp::async::worker::IOUringWorker::armCoroutine()]: Error. Unknown Action Event Type.");
+
+  }
+
+  if(!queued) {
+    // submission queue is full - retry on the next loop iteration after completions are reaped
+    m_parked.pushBack(coroutine);
+  }
+
+}
+
+bool IOUringWorker::queuePoll(oatpp::v_io_handle handle, v_uint32 events, void* userData) {
+
+  unsigned tail = *m_ring->sqTail;
+  if(tail - __atomic_load_n(m_ring->sqHead, __ATOMIC_ACQUIRE) >= *m_ring->sqEntries) {
+    submit(false);
+    if(tail - __atomic_load_n(m_ring->sqHead, __ATOMIC_ACQUIRE) >= *m_ring->sqEntries) {
+      // the kernel refused to take more entries (completion queue is backed up)
+      return false;
+    }
+  }
+
+  unsigned index = tail & *m_ring->sqMask;
+  io_uring_sqe* sqe = &m_ring->sqes[index];
+  std::memset(sqe, 0, sizeof(io_uring_sqe));
+
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = handle;
+  sqe->poll_events = static_cast<__u16>(events);
+  sqe->user_data = reinterpret_cast<__u64>(userData);
+
+  m_ring->sqArray[index] = index;
+  __atomic_store_n(m_ring->sqTail, tail + 1, __ATOMIC_RELEASE);
+  ++ m_pendingSubmissions;
+
+  return true;
+
+}
+
+void IOUringWorker::submit(bool waitForCompletion) {
+
+  unsigned flags = 0;
+  unsigned minComplete = 0;
+  if(waitForCompletion) {
+    flags = IORING_ENTER_GETEVENTS;
+    minComplete = 1;
+  }
+
+  while(true) {
+
+    int res = sys_io_uring_enter(m_ring->fd, m_pendingSubmissions, minComplete, flags);
+
+    if(res >= 0) {
+      m_pendingSubmissions -= std::min(m_pendingSubmissions, static_cast<v_uint32>(res));
+      if(m_pendingSubmissions == 0 || waitForCompletion) {
+        return;
+      }
+      continue;
+    }
+
+    if(errno == EINTR) {
+      if(waitForCompletion) {
+        return;
+      }
+      continue;
+    }
+
+    if(errno == EAGAIN || errno == EBUSY) {
+      // completion queue is backed up - let the caller reap completions first
+      return;
+    }
+
+    OATPP_LOGe("[oatpp::async::worker::IOUringWorker::submit()]", "Error. Call to io_uring_enter() failed. errno={}", errno)
+    throw std::runtime_error("[oatpp::async::worker::IOUringWorker::submit()]: Error. Call to io_uring_enter() failed.");
+
+  }
+
+}
+
+void IOUringWorker::consumeBacklog() {
+
+  utils::FastQueue<CoroutineHandle> backlog;
+
+  {
+    std::lock_guard<oatpp::concurrency::SpinLock> lock(m_backlogLock);
+    utils::FastQueue<CoroutineHandle>::moveAll(m_backlog, backlog);
+  }
+
+  /* arm outside of the lock - armCoroutine() may call io_uring_enter() when the SQ is full */
+  while(backlog.first != nullptr) {
+    armCoroutine(backlog.popFront());
+  }
+
+}
+
+void IOUringWorker::rearmParked() {
+
+  if(!m_wakeupArmed) {
+    armWakeupTrigger();
+  }
+
+  utils::FastQueue<CoroutineHandle> parked(std::move(m_parked));
+  while(parked.first != nullptr) {
+    armCoroutine(parked.popFront());
+  }
+
+}
+
+void IOUringWorker::reapCompletions() {
+
+  unsigned head = *m_ring->cqHead;
+  unsigned tail = __atomic_load_n(m_ring->cqTail, __ATOMIC_ACQUIRE);
+
+  while(head != tail) {
+
+    io_uring_cqe* cqe = &m_ring->cqes[head & *m_ring->cqMask];
+    void* dataPtr = reinterpret_cast<void*>(cqe->user_data);
+    v_int32 res = cqe->res;
+    ++ head;
+
+    if(dataPtr == this) {
+
+      if(res < 0) {
+        OATPP_LOGe("[oatpp::async::worker::IOUringWorker::reapCompletions()]", "Error. Wakeup trigger poll failed. res={}", res)
+      } else {
+        eventfd_t value;
+        eventfd_read(m_wakeupTrigger, &value);
+      }
+      armWakeupTrigger();
+
+    } else if(dataPtr != nullptr && res < 0) {
+
+      // poll failed (ex.: -EBADF) - don't resume the coroutine as if the handle was ready, pass it the error instead
+      auto coroutine = reinterpret_cast<CoroutineHandle*>(dataPtr);
+      setCoroutineScheduledAction(coroutine, new Error("[oatpp::async::worker::IOUringWorker::reapCompletions()]: Error. Poll failed. errno=" + std::to_string(-res)));
+      getCoroutineProcessor(coroutine)->pushOneTask(coroutine);
+
+    } else if(dataPtr != nullptr) {
+
+      auto coroutine = reinterpret_cast<CoroutineHandle*>(dataPtr);
+
+      Action action = coroutine->iterate();
+
+      switch(action.getType()) {
+
+        case Action::TYPE_IO_WAIT:
+        case Action::TYPE_IO_REPEAT:
+          setCoroutineScheduledAction(coroutine, std::move(action));
+          armCoroutine(coroutine);
+          break;
+
+        default:
+          setCoroutineScheduledAction(coroutine, std::move(action));
+          getCoroutineProcessor(coroutine)->pushOneTask(coroutine);
+
+      }
+
+    }
+
+    // release the slot early so that the kernel may post more completions while we iterate
+    __atomic_store_n(m_ring->cqHead, head, __ATOMIC_RELEASE);
+    tail = __atomic_load_n(m_ring->cqTail, __ATOMIC_ACQUIRE);
+
+  }
+
+}
+
+void IOUringWorker::run() {
+
+  armWakeupTrigger();
+
+  while(m_running) {
+    rearmParked();
+    consumeBacklog();
+    submit(true);
+    reapCompletions();
+  }
+
+}
+
+}}}
+
+#else
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// stub implementation
+
+namespace oatpp { namespace async { namespace worker {
+
+struct IOUringWorker::Ring {};
+
+IOUringWorker::IOUringWorker(v_uint32 queueDepth)
+  : Worker(Type::IO)
+  , m_running(false)
+  , m_wakeupTrigger(INVALID_IO_HANDLE)
+  , m_wakeupArmed(false)
+  , m_pendingSubmissions(0)
+{
+  (void) queueDepth;
+  throw std::runtime_error("[IOUringWorker for Target OS is NOT IMPLEMENTED! Use IOEventWorker instead.]");
+}
+
+IOUringWorker::~IOUringWorker() = default;
+
+bool IOUringWorker::isSupported() {
+  return false;
+}
+
+void IOUringWorker::initRing(v_uint32 queueDepth) { (void) queueDepth; }
+void IOUringWorker::destroyRing() {}
+void IOUringWorker::triggerWakeup() {}
+void IOUringWorker::armWakeupTrigger() {}
+void IOUringWorker::armCoroutine(CoroutineHandle* coroutine) { (void) coroutine; }
+bool IOUringWorker::queuePoll(oatpp::v_io_handle handle, v_uint32 events, void* userData) { (void) handle; (void) events; (void) userData; return false; }
+void IOUringWorker::submit(bool waitForCompletion) { (void) waitForCompletion; }
+void IOUringWorker::consumeBacklog() {}
+void IOUringWorker::rearmParked() {}
+void IOUringWorker::reapCompletions() {}
+void IOUringWorker::run() {}
+
+}}}
+
+#endif // #ifdef OATPP_IO_URING_SUPPORTED
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// common
+
+namespace oatpp { namespace async { namespace worker {
+
+void IOUringWorker::pushTasks(utils::FastQueue<CoroutineHandle> &tasks) {
+  if (tasks.first != nullptr) {
+    {
+      std::lock_guard<oatpp::concurrency::SpinLock> guard(m_backlogLock);
+      utils::FastQueue<CoroutineHandle>::moveAll(tasks, m_backlog);
+    }
+    triggerWakeup();
+  }
+}
+
+void IOUringWorker::pushOneTask(CoroutineHandle *task) {
+  {
+    std::lock_guard<oatpp::concurrency::SpinLock> guard(m_backlogLock);
+    m_backlog.pushBack(task);
+  }
+  triggerWakeup();
+}
+
+void IOUringWorker::stop() {
+  {
+    std::lock_guard<oatpp::concurrency::SpinLock> lock(m_backlogLock);
+    m_running = false;
+  }
+  triggerWakeup();
+}
+
+void IOUringWorker::join() {
+  m_thread.join();
+}
+
+void IOUringWorker::detach() {
+  m_thread.detach();
+}
+
+}}}
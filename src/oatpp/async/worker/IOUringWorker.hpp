@@ -0,0 +1,145 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_async_worker_IOUringWorker_hpp
+#define oatpp_async_worker_IOUringWorker_hpp
+
+#include "./Worker.hpp"
+#include "oatpp/concurrency/SpinLock.hpp"
+
+#include <thread>
+#include <mutex>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(OATPP_DISABLE_IO_URING) && (defined(__linux__) || defined(linux) || defined(__linux))
+  #if defined(__has_include)
+    #if __has_include(<linux/io_uring.h>)
+      #define OATPP_IO_URING_SUPPORTED
+    #endif
+  #endif
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace oatpp { namespace async { namespace worker {
+
+/**
+ * `io_uring` based implementation of I/O worker (Linux only). <br>
+ * Readiness polls of all waiting coroutines are queued as submission queue entries
+ * and are submitted to the kernel with a single `io_uring_enter` call per loop iteration.
+ * Completions are reaped in bulk. Polls are one-shot, so there is no need to re-arm or
+ * remove I/O handles with a separate syscall as it is done with `epoll_ctl`. <br>
+ * Unlike &id:oatpp::async::worker::IOEventWorker; one worker serves both read and write events.
+ */
+class IOUringWorker : public Worker {
+public:
+  /**
+   * Default number of submission queue entries.
+   */
+  static constexpr const v_uint32 DEFAULT_QUEUE_DEPTH = 4096;
+private:
+  struct Ring; // FWD
+private:
+  std::atomic<bool> m_running;
+  utils::FastQueue<CoroutineHandle> m_backlog;
+  oatpp::concurrency::SpinLock m_backlogLock;
+private:
+  std::unique_ptr<Ring> m_ring;
+  oatpp::v_io_handle m_wakeupTrigger;
+  bool m_wakeupArmed;
+  v_uint32 m_pendingSubmissions;
+  /* coroutines which didn't fit the submission queue - accessed by the worker thread only */
+  utils::FastQueue<CoroutineHandle> m_parked;
+private:
+  std::thread m_thread;
+private:
+  void initRing(v_uint32 queueDepth);
+  void destroyRing();
+  void triggerWakeup();
+  void armWakeupTrigger();
+  void armCoroutine(CoroutineHandle* coroutine);
+  bool queuePoll(oatpp::v_io_handle handle, v_uint32 events, void* userData);
+  void submit(bool waitForCompletion);
+  void consumeBacklog();
+  void rearmParked();
+  void reapCompletions();
+public:
+
+  /**
+   * Constructor.
+   * @param queueDepth - number of submission queue entries.
+   * @throws - `std::runtime_error` if `io_uring` is not supported or can't be initialized.
+   */
+  IOUringWorker(v_uint32 queueDepth = DEFAULT_QUEUE_DEPTH);
+
+  /**
+   * Virtual destructor.
+   */
+  ~IOUringWorker() override;
+
+  /**
+   * Check if `io_uring` is available at runtime - compiled in and permitted by the running kernel.
+   * @return - `true` if `io_uring` can be used.
+   */
+  static bool isSupported();
+
+  /**
+   * Push list of tasks to worker.
+   * @param tasks - &id:oatpp::async::utils::FastQueue; of &id:oatpp::async::CoroutineHandle;.
+   */
+  void pushTasks(utils::FastQueue<CoroutineHandle>& tasks) override;
+
+  /**
+   * Push one task to worker.
+   * @param task - &id:CoroutineHandle;.
+   */
+  void pushOneTask(CoroutineHandle* task) override;
+
+  /**
+   * Run worker.
+   */
+  void run();
+
+  /**
+   * Break run loop.
+   */
+  void stop() override;
+
+  /**
+   * Join all worker-threads.
+   */
+  void join() override;
+
+  /**
+   * Detach all worker-threads.
+   */
+  void detach() override;
+
+};
+
+}}}
+
+#endif //oatpp_async_worker_IOUringWorker_hpp
@@ -33,11 +33,17 @@ namespace oatpp { namespace async { namespace worker {
 TimerWorker::TimerWorker(const std::chrono::duration<v_int64, std::micro>& granularity)
   : Worker(Type::TIMER)
   , m_running(true)
-  , m_granularity(granularity)
+  , m_wheel(granularity.count() > 0 ? granularity.count() : 1, oatpp::Environment::getMicroTickCount())
 {
   m_thread = std::thread(&TimerWorker::run, this);
 }
 
+TimerWorker::~TimerWorker() {
+  m_wheel.clear([](CoroutineHandle* coroutine) {
+    delete coroutine;
+  });
+}
+
 void TimerWorker::pushTasks(utils::FastQueue<CoroutineHandle>& tasks) {
   {
     std::lock_guard<oatpp::concurrency::SpinLock> guard(m_backlogLock);
@@ -48,11 +54,28 @@ void TimerWorker::pushTasks(utils::FastQueue<CoroutineHandle>& tasks) {
 
 void TimerWorker::consumeBacklog() {
 
-  std::unique_lock<oatpp::concurrency::SpinLock> lock(m_backlogLock);
-  while (m_backlog.first == nullptr && m_queue.first == nullptr && m_running) {
-    m_backlogCondition.wait(lock);
+  utils::FastQueue<CoroutineHandle> backlog;
+
+  {
+    std::unique_lock<oatpp::concurrency::SpinLock> lock(m_backlogLock);
+    while (m_backlog.first == nullptr && m_running) {
+      if(m_wheel.empty()) {
+        m_backlogCondition.wait(lock);
+      } else {
+        auto waitTime = m_wheel.getNextTimePointMicroseconds() - oatpp::Environment::getMicroTickCount();
+        if(waitTime <= 0) {
+          break;
+        }
+        m_backlogCondition.wait_for(lock, std::chrono::microseconds(waitTime));
+      }
+    }
+    utils::FastQueue<CoroutineHandle>::moveAll(m_backlog, backlog);
+  }
+
+  while(backlog.first != nullptr) {
+    auto coroutine = backlog.popFront();
+    m_wheel.add(coroutine, getCoroutineScheduledAction(coroutine).getTimePointMicroseconds());
   }
-  utils::FastQueue<CoroutineHandle>::moveAll(m_backlog, m_queue);
 
 }
 
@@ -64,57 +87,40 @@ void TimerWorker::pushOneTask(CoroutineHandle* task) {
   m_backlogCondition.notify_one();
 }
 
-void TimerWorker::run() {
-
-  while(m_running) {
-
-    consumeBacklog();
-    auto curr = m_queue.first;
-    CoroutineHandle* prev = nullptr;
-
-    auto startTime = std::chrono::system_clock::now();
-    std::chrono::microseconds ms = std::chrono::duration_cast<std::chrono::microseconds>(startTime.time_since_epoch());
-    v_int64 tick = ms.count();
-
-    while(curr != nullptr) {
-
-      auto next = nextCoroutine(curr);
+void TimerWorker::processCoroutine(CoroutineHandle* coroutine) {
 
-      const Action& schA = getCoroutineScheduledAction(curr);
+  Action action = coroutine->iterate();
 
-      if(schA.getTimePointMicroseconds() < tick) {
+  switch(action.getType()) {
 
-        Action action = curr->iterate();
+    case Action::TYPE_WAIT_REPEAT:
+      m_wheel.add(coroutine, action.getTimePointMicroseconds());
+      setCoroutineScheduledAction(coroutine, std::move(action));
+      break;
 
-        switch(action.getType()) {
+    case Action::TYPE_IO_WAIT:
+      setCoroutineScheduledAction(coroutine, oatpp::async::Action::createWaitRepeatAction(0));
+      m_wheel.add(coroutine, 0);
+      break;
 
-          case Action::TYPE_WAIT_REPEAT:
-            setCoroutineScheduledAction(curr, std::move(action));
-            break;
+    default:
+      setCoroutineScheduledAction(coroutine, std::move(action));
+      getCoroutineProcessor(coroutine)->pushOneTask(coroutine);
+      break;
 
-          case Action::TYPE_IO_WAIT:
-            setCoroutineScheduledAction(curr, oatpp::async::Action::createWaitRepeatAction(0));
-            break;
+  }
 
-          default:
-            m_queue.cutEntry(curr, prev);
-            setCoroutineScheduledAction(curr, std::move(action));
-            getCoroutineProcessor(curr)->pushOneTask(curr);
-            curr = prev;
-            break;
+}
 
-        }
+void TimerWorker::run() {
 
-      }
+  while(m_running) {
 
-      prev = curr;
-      curr = next;
-    }
+    consumeBacklog();
 
-    auto elapsed = std::chrono::system_clock::now() - startTime;
-    if(elapsed < m_granularity) {
-      std::this_thread::sleep_for(m_granularity - elapsed);
-    }
+    m_wheel.advance(oatpp::Environment::getMicroTickCount(), [this](CoroutineHandle* coroutine) {
+      processCoroutine(coroutine);
+    });
 
   }
 
@@ -26,6 +26,7 @@
 #define oatpp_async_worker_TimerWorker_hpp
 
 #include "./Worker.hpp"
+#include "oatpp/async/utils/TimingWheel.hpp"
 #include "oatpp/concurrency/SpinLock.hpp"
 
 #include <thread>
@@ -36,29 +37,35 @@ namespace oatpp { namespace async { namespace worker {
 
 /**
  * Timer worker.
- * Used to wait for timer-scheduled coroutines.
+ * Used to wait for timer-scheduled coroutines. <br>
+ * Coroutines are kept in &id:oatpp::async::utils::TimingWheel;, so waiting coroutines cost nothing per tick
+ * and the worker sleeps until the nearest time point or until new coroutines are pushed.
  */
 class TimerWorker : public Worker {
 private:
   std::atomic<bool> m_running;
   utils::FastQueue<CoroutineHandle> m_backlog;
-  utils::FastQueue<CoroutineHandle> m_queue;
+  utils::TimingWheel<CoroutineHandle> m_wheel;
   oatpp::concurrency::SpinLock m_backlogLock;
   std::condition_variable_any m_backlogCondition;
-private:
-  std::chrono::duration<v_int64, std::micro> m_granularity;
 private:
   std::thread m_thread;
 private:
   void consumeBacklog();
+  void processCoroutine(CoroutineHandle* coroutine);
 public:
 
   /**
    * Constructor.
-   * @param granularity - minimum possible time to wait.
+   * @param granularity - minimum possible time to wait. Resolution of the timing wheel.
    */
   TimerWorker(const std::chrono::duration<v_int64, std::micro>& granularity = std::chrono::milliseconds(100));
 
+  /**
+   * Virtual destructor. Deletes coroutines which are still waiting.
+   */
+  ~TimerWorker() override;
+
   /**
    * Push list of tasks to worker.
    * @param tasks - &id:oatpp::aysnc::utils::FastQueue; of &id:oatpp::async::CoroutineHandle;.
@@ -0,0 +1,506 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "AsyncLogger.hpp"
+
+#include <cstring>
+#include <ctime>
+
+#if defined(WIN32) || defined(_WIN32)
+  #include <io.h>
+#else
+  #include <sys/uio.h>
+  #include <unistd.h>
+  #include <cerrno>
+#endif
+
+namespace oatpp { namespace base {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// AsyncLogger::Ring
+
+AsyncLogger::Ring::Ring(v_buff_size capacity)
+  : m_entries(static_cast<size_t>(capacity))
+  , m_mask(static_cast<v_uint64>(capacity - 1))
+  , m_head(0)
+  , m_tail(0)
+  , abandoned(false)
+  , closed(false)
+{}
+
+v_uint64 AsyncLogger::Ring::push(v_uint32 priority, v_int64 micros, const std::string& tag, const std::string& message) {
+
+  v_uint64 tail = m_tail.load(std::memory_order_relaxed);
+  v_uint64 size = tail - m_head.load(std::memory_order_acquire);
+  if(size > m_mask) {
+    return 0;
+  }
+
+  auto& entry = m_entries[tail & m_mask];
+  entry.priority = priority;
+  entry.micros = micros;
+  entry.tag.assign(tag);
+  entry.message.assign(message);
+
+  m_tail.store(tail + 1, std::memory_order_release);
+  return size + 1;
+
+}
+
+v_uint64 AsyncLogger::Ring::peek(Entry** entries, v_uint64 maxCount) {
+  v_uint64 head = m_head.load(std::memory_order_relaxed);
+  v_uint64 count = m_tail.load(std::memory_order_acquire) - head;
+  if(count > maxCount) {
+    count = maxCount;
+  }
+  for(v_uint64 i = 0; i < count; i ++) {
+    entries[i] = &m_entries[(head + i) & m_mask];
+  }
+  return count;
+}
+
+void AsyncLogger::Ring::release(v_uint64 count) {
+  m_head.store(m_head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+}
+
+bool AsyncLogger::Ring::empty() const {
+  return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// AsyncLogger::ThreadRings
+
+class AsyncLogger::ThreadRings {
+public:
+
+  struct Item {
+    v_uint64 loggerId;
+    std::shared_ptr<Ring> ring;
+  };
+
+public:
+
+  std::vector<Item> items;
+
+  ~ThreadRings() {
+    for(auto& item : items) {
+      item.ring->abandoned.store(true, std::memory_order_release);
+    }
+  }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// AsyncLogger
+
+std::atomic<v_uint64> AsyncLogger::NEXT_LOGGER_ID(0);
+
+#ifndef OATPP_COMPAT_BUILD_NO_THREAD_LOCAL
+thread_local AsyncLogger::ThreadRings AsyncLogger::THREAD_RINGS;
+#endif
+
+AsyncLogger::AsyncLogger(const Config& config)
+  : m_config(config)
+  , m_id(++ NEXT_LOGGER_ID)
+  , m_droppedCount(0)
+  , m_sleeping(false)
+  , m_flushRequested(0)
+  , m_flushDone(0)
+  , m_running(true)
+  , m_cachedSeconds(-1)
+  , m_lines(BATCH_SIZE)
+{
+
+  if(m_config.ringCapacity < 2 || (m_config.ringCapacity & (m_config.ringCapacity - 1)) != 0) {
+    throw std::runtime_error("[oatpp::base::AsyncLogger::AsyncLogger()]: Error. Ring capacity must be a power of two.");
+  }
+
+#ifdef OATPP_COMPAT_BUILD_NO_THREAD_LOCAL
+  m_sharedRing = std::make_shared<Ring>(m_config.ringCapacity);
+  m_rings.push_back(m_sharedRing);
+#endif
+
+  m_thread = std::thread(&AsyncLogger::run, this);
+
+}
+
+AsyncLogger::~AsyncLogger() {
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_running = false;
+  }
+  m_cv.notify_one();
+  m_thread.join();
+
+  std::lock_guard<concurrency::SpinLock> lock(m_ringsLock);
+  for(auto& ring : m_rings) {
+    ring->closed.store(true, std::memory_order_release);
+  }
+
+}
+
+AsyncLogger::Ring* AsyncLogger::getThreadRing() {
+
+#ifndef OATPP_COMPAT_BUILD_NO_THREAD_LOCAL
+
+  auto& items = THREAD_RINGS.items;
+
+  for(auto& item : items) {
+    if(item.loggerId == m_id) {
+      return item.ring.get();
+    }
+  }
+
+  /* first message from this thread - forget rings of destroyed loggers and register a new ring */
+
+  for(auto it = items.begin(); it != items.end();) {
+    if(it->ring->closed.load(std::memory_order_acquire)) {
+      it = items.erase(it);
+    } else {
+      ++ it;
+    }
+  }
+
+  auto ring = std::make_shared<Ring>(m_config.ringCapacity);
+  {
+    std::lock_guard<concurrency::SpinLock> lock(m_ringsLock);
+    m_rings.push_back(ring);
+  }
+  items.push_back({m_id, ring});
+  return ring.get();
+
+#else
+  return m_sharedRing.get();
+#endif
+
+}
+
+void AsyncLogger::log(v_uint32 priority, const std::string& tag, const std::string& message) {
+
+  auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::system_clock::now().time_since_epoch()
+  ).count();
+
+  auto ring = getThreadRing();
+
+#ifdef OATPP_COMPAT_BUILD_NO_THREAD_LOCAL
+  std::lock_guard<concurrency::SpinLock> lock(m_sharedRingLock);
+#endif
+
+  auto size = ring->push(priority, micros, tag, message);
+
+  if(size == 0) {
+    m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /* wake up the writer early only if the ring is getting full - otherwise let messages batch up */
+  if((size == 0 || size == static_cast<v_uint64>(m_config.ringCapacity / 2)) && m_sleeping.load(std::memory_order_relaxed)) {
+    m_cv.notify_one();
+  }
+
+}
+
+void AsyncLogger::flush() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if(!m_running) {
+    return;
+  }
+  v_uint64 ticket = ++ m_flushRequested;
+  m_cv.notify_one();
+  m_flushCv.wait(lock, [this, ticket]{ return m_flushDone >= ticket || !m_running; });
+}
+
+v_int64 AsyncLogger::getDroppedCount() const {
+  return m_droppedCount.load(std::memory_order_relaxed);
+}
+
+void AsyncLogger::run() {
+
+  while(true) {
+
+    v_uint64 flushTarget;
+    bool running;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      flushTarget = m_flushRequested;
+      running = m_running;
+    }
+
+    while(drainOnce()) {}
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_flushDone = flushTarget;
+    m_flushCv.notify_all();
+
+    if(!running) {
+      break;
+    }
+
+    if(m_running && m_flushRequested == flushTarget) {
+      m_sleeping.store(true, std::memory_order_relaxed);
+      m_cv.wait_for(lock, m_config.flushInterval);
+      m_sleeping.store(false, std::memory_order_relaxed);
+    }
+
+  }
+
+}
+
+bool AsyncLogger::drainOnce() {
+
+  std::vector<std::shared_ptr<Ring>> rings;
+  {
+    std::lock_guard<concurrency::SpinLock> lock(m_ringsLock);
+    rings.reserve(m_rings.size());
+    for(auto it = m_rings.begin(); it != m_rings.end();) {
+      auto& ring = *it;
+      if(ring->abandoned.load(std::memory_order_acquire) && ring->empty()) {
+        it = m_rings.erase(it);
+      } else {
+        rings.push_back(ring);
+        ++ it;
+      }
+    }
+  }
+
+  Entry* entries[BATCH_SIZE];
+  v_uint64 batchCount = 0;
+  bool drained = false;
+
+  for(auto& ring : rings) {
+    while(true) {
+      v_uint64 count = ring->peek(entries, BATCH_SIZE - batchCount);
+      if(count == 0) {
+        break;
+      }
+      for(v_uint64 i = 0; i < count; i ++) {
+        formatEntry(*entries[i], m_lines[batchCount + i]);
+      }
+      ring->release(count);
+      batchCount += count;
+      drained = true;
+      if(batchCount == BATCH_SIZE) {
+        writeBatch(batchCount);
+        batchCount = 0;
+      }
+    }
+  }
+
+  if(batchCount > 0) {
+    writeBatch(batchCount);
+  }
+
+  return drained;
+
+}
+
+void AsyncLogger::formatTime(v_int64 micros) {
+
+  time_t seconds = micros / 1000000;
+  if(seconds == m_cachedSeconds) {
+    return;
+  }
+
+  tm now;
+#if defined(WIN32) || defined(_WIN32)
+  localtime_s(&now, &seconds);
+#else
+  localtime_r(&seconds, &now);
+#endif
+
+  char buffer[128];
+  auto size = strftime(buffer, sizeof(buffer), m_config.timeFormat, &now);
+  m_cachedTime.assign(buffer, size);
+  m_cachedSeconds = seconds;
+
+}
+
+namespace {
+
+  void appendQuoted(std::string& out, const std::string& value) {
+    out.push_back('"');
+    for(char c : value) {
+      switch(c) {
+        case '"': out.append("\\\""); break;
+        case '\\': out.append("\\\\"); break;
+        case '\n': out.append("\\n"); break;
+        case '\r': out.append("\\r"); break;
+        case '\t': out.append("\\t"); break;
+        default: out.push_back(c);
+      }
+    }
+    out.push_back('"');
+  }
+
+}
+
+void AsyncLogger::formatEntry(const Entry& entry, std::string& out) {
+
+  out.clear();
+
+  if(m_config.format == Format::KEY_VALUE) {
+
+    if(m_config.timeFormat) {
+      formatTime(entry.micros);
+      out.append("time=");
+      appendQuoted(out, m_cachedTime);
+      out.push_back(' ');
+    }
+
+    if(m_config.printTicks) {
+      out.append("ticks=");
+      out.append(std::to_string(entry.micros));
+      out.push_back(' ');
+    }
+
+    out.append("level=");
+    switch (entry.priority) {
+      case PRIORITY_V: out.push_back('V'); break;
+      case PRIORITY_D: out.push_back('D'); break;
+      case PRIORITY_I: out.push_back('I'); break;
+      case PRIORITY_W: out.push_back('W'); break;
+      case PRIORITY_E: out.push_back('E'); break;
+      default: out.append(std::to_string(entry.priority));
+    }
+
+    out.append(" tag=");
+    appendQuoted(out, entry.tag);
+    out.append(" msg=");
+    appendQuoted(out, entry.message);
+    out.push_back('\n');
+    return;
+
+  }
+
+  switch (entry.priority) {
+    case PRIORITY_V: out.append("\033[0m V \033[0m|"); break;
+    case PRIORITY_D: out.append("\033[34m D \033[0m|"); break;
+    case PRIORITY_I: out.append("\033[32m I \033[0m|"); break;
+    case PRIORITY_W: out.append("\033[45m W \033[0m|"); break;
+    case PRIORITY_E: out.append("\033[41m E \033[0m|"); break;
+    default:
+      out.push_back(' ');
+      out.append(std::to_string(entry.priority));
+      out.append(" |");
+  }
+
+  bool indent = false;
+
+  if(m_config.timeFormat) {
+    formatTime(entry.micros);
+    out.append(m_cachedTime);
+    indent = true;
+  }
+
+  if(m_config.printTicks) {
+    if(indent) {
+      out.push_back(' ');
+    }
+    out.append(std::to_string(entry.micros));
+    indent = true;
+  }
+
+  if(indent) {
+    out.push_back('|');
+  }
+
+  out.push_back(' ');
+  out.append(entry.tag);
+  if(!entry.message.empty()) {
+    out.push_back(':');
+    out.append(entry.message);
+  }
+  out.push_back('\n');
+
+}
+
+void AsyncLogger::writeBatch(v_uint64 count) {
+
+#if defined(WIN32) || defined(_WIN32)
+
+  for(v_uint64 i = 0; i < count; i ++) {
+    const auto& line = m_lines[i];
+    _write(m_config.outputHandle, line.data(), static_cast<unsigned int>(line.size()));
+  }
+
+#else
+
+  iovec iov[BATCH_SIZE];
+  for(v_uint64 i = 0; i < count; i ++) {
+    iov[i].iov_base = m_lines[i].data();
+    iov[i].iov_len = m_lines[i].size();
+  }
+
+  v_uint64 index = 0;
+  while(index < count) {
+
+    auto res = ::writev(m_config.outputHandle, &iov[index], static_cast<int>(count - index));
+    if(res < 0) {
+      if(errno == EINTR) {
+        continue;
+      }
+      return;
+    }
+
+    auto written = static_cast<size_t>(res);
+    while(index < count && written >= iov[index].iov_len) {
+      written -= iov[index].iov_len;
+      index ++;
+    }
+
+    if(index < count) {
+      iov[index].iov_base = static_cast<char*>(iov[index].iov_base) + written;
+      iov[index].iov_len -= written;
+    }
+
+  }
+
+#endif
+
+}
+
+void AsyncLogger::enablePriority(v_uint32 priority) {
+  if (priority > PRIORITY_E) {
+    return;
+  }
+  m_config.logMask |= (1U << priority);
+}
+
+void AsyncLogger::disablePriority(v_uint32 priority) {
+  if (priority > PRIORITY_E) {
+    return;
+  }
+  m_config.logMask &= ~(1U << priority);
+}
+
+bool AsyncLogger::isLogPriorityEnabled(v_uint32 priority) {
+  if (priority > PRIORITY_E) {
+    return true;
+  }
+  return m_config.logMask & (1U << priority);
+}
+
+}}
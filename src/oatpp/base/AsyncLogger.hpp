@@ -0,0 +1,265 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_base_AsyncLogger_hpp
+#define oatpp_base_AsyncLogger_hpp
+
+#include "oatpp/Environment.hpp"
+#include "oatpp/concurrency/SpinLock.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace oatpp { namespace base {
+
+/**
+ * Asynchronous &id:oatpp::Logger;. <br>
+ * Log messages are pushed into the per-thread lock-free ring buffer and are formatted and written
+ * by the background thread with batched `writev` calls. Logging threads never wait for the output. <br>
+ * If the ring buffer of the thread is full the message is dropped and the dropped messages counter is incremented.
+ */
+class AsyncLogger : public Logger {
+public:
+
+  /**
+   * Output format.
+   */
+  enum class Format : v_int32 {
+
+    /**
+     * Same format as &id:oatpp::DefaultLogger;.
+     */
+    TEXT = 0,
+
+    /**
+     * Structured `key=value` (logfmt) format. <br>
+     * Example: `time="2024-01-01 10:00:00" ticks=1704103200000000 level=D tag="MyTag" msg="Hello"`.
+     */
+    KEY_VALUE = 1
+
+  };
+
+  /**
+   * AsyncLogger config.
+   */
+  struct Config {
+
+    /**
+     * Constructor.
+     */
+    Config()
+      : timeFormat("%Y-%m-%d %H:%M:%S")
+      , printTicks(true)
+      , logMask((1 << PRIORITY_V) | (1 << PRIORITY_D) | (1 << PRIORITY_I) | (1 << PRIORITY_W) | (1 << PRIORITY_E))
+      , format(Format::TEXT)
+      , ringCapacity(1024)
+      , outputHandle(1)
+      , flushInterval(std::chrono::milliseconds(10))
+    {}
+
+    /**
+     * Time format of the log message.
+     * If nullptr then do not print time.
+     */
+    const char* timeFormat;
+
+    /**
+     * Print micro-ticks in the log message.
+     */
+    bool printTicks;
+
+    /**
+     * Log mask to enable/disable certain priorities
+     */
+    v_uint32 logMask;
+
+    /**
+     * Output format. &l:AsyncLogger::Format;.
+     */
+    Format format;
+
+    /**
+     * Capacity of the per-thread ring buffer (number of messages). Must be a power of two.
+     */
+    v_buff_size ringCapacity;
+
+    /**
+     * File descriptor to write log to. Default - `1` (stdout).
+     */
+    int outputHandle;
+
+    /**
+     * Max time between a message is logged and it is written to the output.
+     */
+    std::chrono::duration<v_int64, std::micro> flushInterval;
+
+  };
+
+private:
+
+  struct Entry {
+    v_uint32 priority;
+    v_int64 micros;
+    std::string tag;
+    std::string message;
+  };
+
+  /*
+   * Single-producer / single-consumer ring.
+   * Slots are reused so that in steady state pushing a message doesn't allocate.
+   */
+  class Ring {
+  private:
+    std::vector<Entry> m_entries;
+    v_uint64 m_mask;
+    alignas(64) std::atomic<v_uint64> m_head;
+    alignas(64) std::atomic<v_uint64> m_tail;
+  public:
+
+    /*
+     * Set when the owner thread exits.
+     */
+    std::atomic<bool> abandoned;
+
+    /*
+     * Set when the logger is destroyed.
+     */
+    std::atomic<bool> closed;
+
+    explicit Ring(v_buff_size capacity);
+
+    /*
+     * Returns number of messages in the ring after push or `0` if the ring is full.
+     */
+    v_uint64 push(v_uint32 priority, v_int64 micros, const std::string& tag, const std::string& message);
+
+    v_uint64 peek(Entry** entries, v_uint64 maxCount);
+    void release(v_uint64 count);
+
+    bool empty() const;
+
+  };
+
+  class ThreadRings;
+
+private:
+  static constexpr v_uint64 BATCH_SIZE = 64;
+private:
+  static std::atomic<v_uint64> NEXT_LOGGER_ID;
+#ifndef OATPP_COMPAT_BUILD_NO_THREAD_LOCAL
+  static thread_local ThreadRings THREAD_RINGS;
+#endif
+private:
+  Ring* getThreadRing();
+  void run();
+  bool drainOnce();
+  void formatEntry(const Entry& entry, std::string& out);
+  void formatTime(v_int64 micros);
+  void writeBatch(v_uint64 count);
+private:
+  Config m_config;
+  v_uint64 m_id;
+  std::atomic<v_int64> m_droppedCount;
+private:
+  concurrency::SpinLock m_ringsLock;
+  std::list<std::shared_ptr<Ring>> m_rings;
+#ifdef OATPP_COMPAT_BUILD_NO_THREAD_LOCAL
+  concurrency::SpinLock m_sharedRingLock;
+  std::shared_ptr<Ring> m_sharedRing;
+#endif
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::condition_variable m_flushCv;
+  std::atomic<bool> m_sleeping;
+  v_uint64 m_flushRequested;
+  v_uint64 m_flushDone;
+  bool m_running;
+  std::thread m_thread;
+private:
+  /* owned by the writer thread */
+  v_int64 m_cachedSeconds;
+  std::string m_cachedTime;
+  std::vector<std::string> m_lines;
+public:
+
+  /**
+   * Constructor. Starts the writer thread.
+   * @param config - &l:AsyncLogger::Config;.
+   */
+  AsyncLogger(const Config& config = Config());
+
+  /**
+   * Virtual destructor. Writes all pending messages and stops the writer thread.
+   */
+  ~AsyncLogger() override;
+
+  /**
+   * Push message to the ring buffer of the calling thread.
+   * @param priority - log-priority channel of the message.
+   * @param tag - tag of the log message.
+   * @param message - message.
+   */
+  void log(v_uint32 priority, const std::string& tag, const std::string& message) override;
+
+  /**
+   * Block until all messages logged before this call are written to the output.
+   */
+  void flush();
+
+  /**
+   * Get number of messages dropped because of the ring buffer overflow.
+   * @return - number of dropped messages.
+   */
+  v_int64 getDroppedCount() const;
+
+  /**
+   * Enables logging of a priorities for this instance
+   * @param priority - the priority level to enable
+   */
+  void enablePriority(v_uint32 priority);
+
+  /**
+   * Disables logging of a priority for this instance
+   * @param priority - the priority level to disable
+   */
+  void disablePriority(v_uint32 priority);
+
+  /**
+   * Returns wether or not a priority should be logged/printed
+   * @param priority
+   * @return - true if given priority should be logged
+   */
+  bool isLogPriorityEnabled(v_uint32 priority) override;
+
+};
+
+}}
+
+#endif /* oatpp_base_AsyncLogger_hpp */
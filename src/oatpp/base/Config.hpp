@@ -62,8 +62,12 @@
  */
 //#define OATPP_COMPAT_BUILD_NO_THREAD_LOCAL 1
 
+/**
+ * Default `snprintf` format to convert floats to strings. <br>
+ * `nullptr` - use shortest representation which parses back to the same value (`std::to_chars`).
+ */
 #ifndef OATPP_FLOAT_STRING_FORMAT
-  #define OATPP_FLOAT_STRING_FORMAT "%.16g"
+  #define OATPP_FLOAT_STRING_FORMAT nullptr
 #endif
 
 /**
@@ -0,0 +1,187 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "BufferPool.hpp"
+
+#include "oatpp/utils/Binary.hpp"
+
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace oatpp { namespace data{ namespace buffer {
+
+BufferPool::BufferPool(v_buff_size blockSize, v_buff_size maxBlocksPerShard, v_uint32 shardsCount)
+  : m_blockSize(blockSize)
+  , m_maxBlocksPerShard(maxBlocksPerShard)
+  , m_inUse(0)
+  , m_highWaterMark(0)
+{
+
+  if(shardsCount == 0) {
+    shardsCount = std::thread::hardware_concurrency();
+    if(shardsCount == 0) {
+      shardsCount = 1;
+    }
+  }
+
+  shardsCount = static_cast<v_uint32>(utils::Binary::nextP2(static_cast<v_int64>(shardsCount)));
+  m_shardsMask = shardsCount - 1;
+  m_shards.reset(new AlignedShard[shardsCount]);
+
+}
+
+BufferPool::~BufferPool() {
+  for(v_uint32 i = 0; i <= m_shardsMask; i ++) {
+    for(auto block : m_shards[i].blocks) {
+      delete [] block;
+    }
+  }
+}
+
+v_uint32 BufferPool::getThreadIndex() {
+#ifndef OATPP_COMPAT_BUILD_NO_THREAD_LOCAL
+  static std::atomic<v_uint32> threadCounter(0);
+  static thread_local v_uint32 threadIndex = threadCounter.fetch_add(1, std::memory_order_relaxed);
+  return threadIndex;
+#else
+  return static_cast<v_uint32>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+#endif
+}
+
+void BufferPool::onObtained() {
+  auto inUse = m_inUse.fetch_add(1, std::memory_order_relaxed) + 1;
+  auto highWaterMark = m_highWaterMark.load(std::memory_order_relaxed);
+  while(inUse > highWaterMark && !m_highWaterMark.compare_exchange_weak(highWaterMark, inUse, std::memory_order_relaxed)) {}
+}
+
+p_char8 BufferPool::obtain() {
+
+  auto index = getThreadIndex() & m_shardsMask;
+  auto& shard = m_shards[index];
+
+  {
+    std::lock_guard<concurrency::SpinLock> guard(shard.lock);
+    if(!shard.blocks.empty()) {
+      auto block = shard.blocks.back();
+      shard.blocks.pop_back();
+      shard.hits ++;
+      onObtained();
+      return block;
+    }
+  }
+
+  /* own shard is empty - look into other shards without waiting on their locks */
+
+  for(v_uint32 i = 1; i <= m_shardsMask; i ++) {
+    auto& other = m_shards[(index + i) & m_shardsMask];
+    std::unique_lock<concurrency::SpinLock> guard(other.lock, std::try_to_lock);
+    if(guard.owns_lock() && !other.blocks.empty()) {
+      auto block = other.blocks.back();
+      other.blocks.pop_back();
+      other.hits ++;
+      onObtained();
+      return block;
+    }
+  }
+
+  {
+    std::lock_guard<concurrency::SpinLock> guard(shard.lock);
+    shard.misses ++;
+  }
+
+  onObtained();
+  return new v_char8[static_cast<size_t>(m_blockSize)];
+
+}
+
+void BufferPool::release(p_char8 block) {
+
+  m_inUse.fetch_sub(1, std::memory_order_relaxed);
+
+  auto& shard = m_shards[getThreadIndex() & m_shardsMask];
+
+  {
+    std::lock_guard<concurrency::SpinLock> guard(shard.lock);
+    if(static_cast<v_buff_size>(shard.blocks.size()) < m_maxBlocksPerShard) {
+      shard.blocks.push_back(block);
+      shard.returns ++;
+      return;
+    }
+    shard.drops ++;
+  }
+
+  delete [] block;
+
+}
+
+v_buff_size BufferPool::getBlockSize() const {
+  return m_blockSize;
+}
+
+v_uint32 BufferPool::getShardsCount() const {
+  return m_shardsMask + 1;
+}
+
+BufferPool::Statistics BufferPool::getStatistics() const {
+
+  Statistics stats{};
+
+  for(v_uint32 i = 0; i <= m_shardsMask; i ++) {
+    auto& shard = m_shards[i];
+    std::lock_guard<concurrency::SpinLock> guard(shard.lock);
+    stats.hits += shard.hits;
+    stats.misses += shard.misses;
+    stats.returns += shard.returns;
+    stats.drops += shard.drops;
+    stats.pooled += static_cast<v_int64>(shard.blocks.size());
+  }
+
+  stats.inUse = m_inUse.load(std::memory_order_relaxed);
+  stats.highWaterMark = m_highWaterMark.load(std::memory_order_relaxed);
+
+  return stats;
+
+}
+
+BufferPool& BufferPool::getShared(v_buff_size blockSize) {
+
+  /* pools are never deleted - blocks may be released by threads running after static destruction */
+  static std::mutex* mutex = new std::mutex();
+  static auto* pools = new std::unordered_map<v_buff_size, BufferPool*>();
+
+  std::lock_guard<std::mutex> lock(*mutex);
+
+  auto& pool = (*pools)[blockSize];
+  if(pool == nullptr) {
+    pool = new BufferPool(blockSize);
+  }
+
+  return *pool;
+
+}
+
+}}}
@@ -0,0 +1,177 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_data_buffer_BufferPool_hpp
+#define oatpp_data_buffer_BufferPool_hpp
+
+#include "oatpp/concurrency/SpinLock.hpp"
+#include "oatpp/Environment.hpp"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace oatpp { namespace data{ namespace buffer {
+
+/**
+ * Pool of fixed-size memory blocks. <br>
+ * Pool is split into shards. Each thread is bound to one shard, so threads rarely compete for the same lock. <br>
+ * When thread's shard is empty, other shards are checked before allocating a new block. <br>
+ * Blocks released into a full shard are deleted.
+ */
+class BufferPool {
+public:
+
+  /**
+   * Pool statistics.
+   */
+  struct Statistics {
+
+    /**
+     * Number of blocks obtained from the pool.
+     */
+    v_int64 hits;
+
+    /**
+     * Number of blocks allocated because the pool was empty.
+     */
+    v_int64 misses;
+
+    /**
+     * Number of blocks returned to the pool.
+     */
+    v_int64 returns;
+
+    /**
+     * Number of blocks deleted because the pool was full.
+     */
+    v_int64 drops;
+
+    /**
+     * Number of blocks currently in use.
+     */
+    v_int64 inUse;
+
+    /**
+     * Maximum number of blocks that were in use at the same time.
+     */
+    v_int64 highWaterMark;
+
+    /**
+     * Number of free blocks currently held by the pool.
+     */
+    v_int64 pooled;
+
+  };
+
+private:
+
+  struct Shard {
+    concurrency::SpinLock lock;
+    std::vector<p_char8> blocks;
+    v_int64 hits = 0;
+    v_int64 misses = 0;
+    v_int64 returns = 0;
+    v_int64 drops = 0;
+  };
+
+  /*
+   * Keep shards on separate cache lines.
+   */
+  struct alignas(64) AlignedShard : public Shard {};
+
+private:
+  static v_uint32 getThreadIndex();
+private:
+  v_buff_size m_blockSize;
+  v_buff_size m_maxBlocksPerShard;
+  v_uint32 m_shardsMask;
+  std::unique_ptr<AlignedShard[]> m_shards;
+  std::atomic<v_int64> m_inUse;
+  std::atomic<v_int64> m_highWaterMark;
+private:
+  void onObtained();
+public:
+
+  /**
+   * Constructor.
+   * @param blockSize - size of the memory block in bytes.
+   * @param maxBlocksPerShard - maximum number of free blocks kept by one shard.
+   * @param shardsCount - number of shards. Rounded up to the power of 2. `0` - choose based on number of CPUs.
+   */
+  BufferPool(v_buff_size blockSize, v_buff_size maxBlocksPerShard = 64, v_uint32 shardsCount = 0);
+
+  BufferPool(const BufferPool&) = delete;
+  BufferPool& operator=(const BufferPool&) = delete;
+
+  /**
+   * Destructor. Deletes all free blocks. <br>
+   * *Blocks which are in use must not be released after the pool is destroyed.*
+   */
+  ~BufferPool();
+
+  /**
+   * Obtain block of &l:BufferPool::getBlockSize (); bytes.
+   * @return - pointer to memory block.
+   */
+  p_char8 obtain();
+
+  /**
+   * Return block to the pool.
+   * @param block - block previously obtained from this pool.
+   */
+  void release(p_char8 block);
+
+  /**
+   * Get size of the memory block.
+   * @return
+   */
+  v_buff_size getBlockSize() const;
+
+  /**
+   * Get number of shards.
+   * @return
+   */
+  v_uint32 getShardsCount() const;
+
+  /**
+   * Get pool statistics.
+   * @return - &l:BufferPool::Statistics;.
+   */
+  Statistics getStatistics() const;
+
+  /**
+   * Get process-wide pool for blocks of given size. <br>
+   * Shared pools are created on demand and live until the process exits.
+   * @param blockSize
+   * @return
+   */
+  static BufferPool& getShared(v_buff_size blockSize);
+
+};
+
+}}}
+
+#endif // oatpp_data_buffer_BufferPool_hpp
@@ -29,15 +29,20 @@ namespace oatpp { namespace data { namespace buffer {
 const v_buff_size IOBuffer::BUFFER_SIZE = 4096;
 
 IOBuffer::IOBuffer()
-  : m_entry(new v_char8[BUFFER_SIZE])
+  : m_entry(getPool().obtain())
 {}
 
+BufferPool& IOBuffer::getPool() {
+  static BufferPool& pool = BufferPool::getShared(BUFFER_SIZE);
+  return pool;
+}
+
 std::shared_ptr<IOBuffer> IOBuffer::createShared(){
   return std::make_shared<IOBuffer>();
 }
 
 IOBuffer::~IOBuffer() {
-  delete [] m_entry;
+  getPool().release(m_entry);
 }
 
 void* IOBuffer::getData(){
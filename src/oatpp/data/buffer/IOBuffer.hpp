@@ -25,13 +25,15 @@
 #ifndef oatpp_data_buffer_IOBuffer_hpp
 #define oatpp_data_buffer_IOBuffer_hpp
 
+#include "./BufferPool.hpp"
+
 #include "oatpp/base/Countable.hpp"
 
 namespace oatpp { namespace data{ namespace buffer {
 
 /**
  * Predefined buffer implementation for I/O operations.
- * Allocates buffer bytes using &id:oatpp::base::memory::ThreadDistributedMemoryPool;.
+ * Obtains buffer bytes from shared &id:oatpp::data::buffer::BufferPool; - see &l:IOBuffer::getPool ();.
  */
 class IOBuffer : public oatpp::base::Countable {
 public:
@@ -48,6 +50,12 @@ public:
   IOBuffer();
 public:
 
+  /**
+   * Get pool used to allocate IOBuffer bytes.
+   * @return - &id:oatpp::data::buffer::BufferPool;.
+   */
+  static BufferPool& getPool();
+
   /**
    * Create shared IOBuffer.
    * @return
@@ -63,6 +63,9 @@ ObjectToTreeMapper::ObjectToTreeMapper() {
   setMapperMethod(data::type::__class::AbstractPairList::CLASS_ID, &ObjectToTreeMapper::mapMap);
   setMapperMethod(data::type::__class::AbstractUnorderedMap::CLASS_ID, &ObjectToTreeMapper::mapMap);
 
+  /* built-in methods are not custom */
+  m_customMethods.assign(m_methods.size(), false);
+
 }
 
 void ObjectToTreeMapper::setMapperMethod(const data::type::ClassId& classId, MapperMethod method) {
@@ -70,7 +73,16 @@ void ObjectToTreeMapper::setMapperMethod(const data::type::ClassId& classId, Map
   if(id >= m_methods.size()) {
     m_methods.resize(id + 1, nullptr);
   }
+  if(id >= m_customMethods.size()) {
+    m_customMethods.resize(id + 1, false);
+  }
   m_methods[id] = method;
+  m_customMethods[id] = true;
+}
+
+bool ObjectToTreeMapper::hasCustomMapperMethod(const data::type::ClassId& classId) const {
+  const auto id = static_cast<v_uint32>(classId.id);
+  return id < m_customMethods.size() && m_customMethods[id];
 }
 
 void ObjectToTreeMapper::map(State& state, const oatpp::Void& polymorph) const
@@ -83,12 +83,20 @@ public:
 
 private:
   std::vector<MapperMethod> m_methods;
+  std::vector<bool> m_customMethods;
 public:
 
   ObjectToTreeMapper();
 
   void setMapperMethod(const data::type::ClassId& classId, MapperMethod method);
 
+  /**
+   * Check if mapper method for the class was set after construction (overrides or adds to the built-in methods).
+   * @param classId
+   * @return - `true` if method is custom.
+   */
+  bool hasCustomMapperMethod(const data::type::ClassId& classId) const;
+
   void map(State& state, const oatpp::Void& polymorph) const;
 
 };
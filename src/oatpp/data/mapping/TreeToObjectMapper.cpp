@@ -63,6 +63,9 @@ TreeToObjectMapper::TreeToObjectMapper() {
   setMapperMethod(data::type::__class::AbstractPairList::CLASS_ID, &TreeToObjectMapper::mapMap);
   setMapperMethod(data::type::__class::AbstractUnorderedMap::CLASS_ID, &TreeToObjectMapper::mapMap);
 
+  /* built-in methods are not custom */
+  m_customMethods.assign(m_methods.size(), false);
+
 }
 
 void TreeToObjectMapper::setMapperMethod(const data::type::ClassId& classId, MapperMethod method) {
@@ -70,7 +73,16 @@ void TreeToObjectMapper::setMapperMethod(const data::type::ClassId& classId, Map
   if(id >= m_methods.size()) {
     m_methods.resize(id + 1, nullptr);
   }
+  if(id >= m_customMethods.size()) {
+    m_customMethods.resize(id + 1, false);
+  }
   m_methods[id] = method;
+  m_customMethods[id] = true;
+}
+
+bool TreeToObjectMapper::hasCustomMapperMethod(const data::type::ClassId& classId) const {
+  const auto id = static_cast<v_uint32>(classId.id);
+  return id < m_customMethods.size() && m_customMethods[id];
 }
 
 TreeToObjectMapper::GuessedPrimitiveType TreeToObjectMapper::guessedPrimitiveType(const oatpp::String& text) {
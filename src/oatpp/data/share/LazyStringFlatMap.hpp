@@ -0,0 +1,487 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_data_share_LazyStringFlatMap_hpp
+#define oatpp_data_share_LazyStringFlatMap_hpp
+
+#include "./MemoryLabel.hpp"
+
+#include <vector>
+
+namespace oatpp { namespace data { namespace share {
+
+/**
+ * Flat multimap which keeps keys and values as memory labels. <br>
+ * Same lazy semantics as &id:oatpp::data::share::LazyStringMapTemplate; -
+ * once value is requested by user, the value is copied to its own memory block. <br>
+ * Entries are stored in insertion order in a flat array. The first `InlineCapacity` entries are stored inline,
+ * so there are no allocations for the typical number of entries. Key hash is computed once on insertion. <br>
+ * *Not thread-safe* - the map is meant to be owned by one task at a time (ex.: headers of a request or a response).
+ * @tparam Key - one of: &id:oatpp::data::share::MemoryLabel;, &id:oatpp::data::share::StringKeyLabel;, &id:oatpp::data::share::StringKeyLabelCI;.
+ * @tparam Value - value type. Default &id:oatpp::data::share::StringKeyLabel;.
+ * @tparam InlineCapacity - number of entries stored without heap allocation.
+ */
+template<typename Key, typename Value = StringKeyLabel, v_buff_size InlineCapacity = 16>
+class LazyStringFlatMultimap {
+public:
+  typedef oatpp::data::type::String String;
+public:
+
+  /**
+   * Map entry.
+   */
+  struct Entry {
+
+    /**
+     * Key.
+     */
+    Key first;
+
+    /**
+     * Value.
+     */
+    Value second;
+
+    /**
+     * Hash of the key.
+     */
+    v_uint64 hash;
+
+  };
+
+  typedef const Entry* const_iterator;
+  typedef const Entry* iterator;
+
+private:
+  Entry m_inline[static_cast<std::size_t>(InlineCapacity)];
+  std::vector<Entry> m_heap;
+  v_buff_size m_size;
+  bool m_onHeap;
+  mutable bool m_fullyInitialized;
+private:
+
+  static v_uint64 hashKey(const Key& key) {
+    return static_cast<v_uint64>(std::hash<Key>{}(key));
+  }
+
+  Entry* data() {
+    return m_onHeap ? m_heap.data() : m_inline;
+  }
+
+  const Entry* data() const {
+    return m_onHeap ? m_heap.data() : m_inline;
+  }
+
+  const Entry* find(const Key& key, v_uint64 hash) const {
+    auto entries = data();
+    for(v_buff_size i = 0; i < m_size; i ++) {
+      if(entries[i].hash == hash && entries[i].first == key) {
+        return &entries[i];
+      }
+    }
+    return nullptr;
+  }
+
+  void insert(const Key& key, const Value& value, v_uint64 hash) {
+
+    if(!m_onHeap) {
+
+      if(m_size < InlineCapacity) {
+        m_inline[m_size] = {key, value, hash};
+        m_size ++;
+        m_fullyInitialized = false;
+        return;
+      }
+
+      m_heap.reserve(static_cast<size_t>(InlineCapacity * 2));
+      for(v_buff_size i = 0; i < m_size; i ++) {
+        m_heap.push_back(std::move(m_inline[i]));
+        m_inline[i] = Entry();
+      }
+      m_onHeap = true;
+
+    }
+
+    m_heap.push_back({key, value, hash});
+    m_size ++;
+    m_fullyInitialized = false;
+
+  }
+
+  bool erase(const Key& key, v_uint64 hash) {
+
+    auto entries = data();
+    v_buff_size newSize = 0;
+
+    for(v_buff_size i = 0; i < m_size; i ++) {
+      if(entries[i].hash == hash && entries[i].first == key) {
+        continue;
+      }
+      if(newSize != i) {
+        entries[newSize] = std::move(entries[i]);
+      }
+      newSize ++;
+    }
+
+    if(newSize == m_size) {
+      return false;
+    }
+
+    if(m_onHeap) {
+      m_heap.resize(static_cast<size_t>(newSize));
+    } else {
+      for(v_buff_size i = newSize; i < m_size; i ++) {
+        m_inline[i] = Entry();
+      }
+    }
+
+    m_size = newSize;
+    return true;
+
+  }
+
+  void assign(const LazyStringFlatMultimap& other) {
+    clear();
+    auto entries = other.data();
+    for(v_buff_size i = 0; i < other.m_size; i ++) {
+      insert(entries[i].first, entries[i].second, entries[i].hash);
+    }
+    m_fullyInitialized = other.m_fullyInitialized;
+  }
+
+  void assign(LazyStringFlatMultimap&& other) {
+    clear();
+    if(other.m_onHeap) {
+      m_heap = std::move(other.m_heap);
+      m_onHeap = true;
+    } else {
+      for(v_buff_size i = 0; i < other.m_size; i ++) {
+        m_inline[i] = std::move(other.m_inline[i]);
+        other.m_inline[i] = Entry();
+      }
+    }
+    m_size = other.m_size;
+    m_fullyInitialized = other.m_fullyInitialized;
+    other.m_heap.clear();
+    other.m_onHeap = false;
+    other.m_size = 0;
+    other.m_fullyInitialized = true;
+  }
+
+public:
+
+  /**
+   * Constructor.
+   */
+  LazyStringFlatMultimap()
+    : m_size(0)
+    , m_onHeap(false)
+    , m_fullyInitialized(true)
+  {}
+
+  /**
+   * Copy-constructor.
+   * @param other
+   */
+  LazyStringFlatMultimap(const LazyStringFlatMultimap& other)
+    : LazyStringFlatMultimap()
+  {
+    assign(other);
+  }
+
+  /**
+   * Move constructor.
+   * @param other
+   */
+  LazyStringFlatMultimap(LazyStringFlatMultimap&& other)
+    : LazyStringFlatMultimap()
+  {
+    assign(std::move(other));
+  }
+
+  LazyStringFlatMultimap& operator = (const LazyStringFlatMultimap& other) {
+    if(this != &other) {
+      assign(other);
+    }
+    return *this;
+  }
+
+  LazyStringFlatMultimap& operator = (LazyStringFlatMultimap&& other) {
+    if(this != &other) {
+      assign(std::move(other));
+    }
+    return *this;
+  }
+
+  /**
+   * Put value to map.
+   * @param key
+   * @param value
+   */
+  void put(const Key& key, const StringKeyLabel& value) {
+    insert(key, value, hashKey(key));
+  }
+
+  /**
+   * Same as &l:LazyStringFlatMultimap::put ();. Kept for compatibility with &id:oatpp::data::share::LazyStringMapTemplate;.
+   * @param key
+   * @param value
+   */
+  void put_LockFree(const Key& key, const StringKeyLabel& value) {
+    insert(key, value, hashKey(key));
+  }
+
+  /**
+   * Put value to map if not already exists.
+   * @param key
+   * @param value
+   * @return
+   */
+  bool putIfNotExists(const Key& key, const StringKeyLabel& value) {
+    auto hash = hashKey(key);
+    if(find(key, hash) == nullptr) {
+      insert(key, value, hash);
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Same as &l:LazyStringFlatMultimap::putIfNotExists ();. Kept for compatibility with &id:oatpp::data::share::LazyStringMapTemplate;.
+   * @param key
+   * @param value
+   * @return
+   */
+  bool putIfNotExists_LockFree(const Key& key, const StringKeyLabel& value) {
+    return putIfNotExists(key, value);
+  }
+
+  /**
+   * Erases all occurrences of key and replaces them with a new entry
+   * @param key
+   * @param value
+   * @return - true if an entry was replaced, false if entry was only inserted.
+   */
+  bool putOrReplace(const Key& key, const StringKeyLabel& value) {
+    auto hash = hashKey(key);
+    bool replaced = erase(key, hash);
+    insert(key, value, hash);
+    return replaced;
+  }
+
+  /**
+   * Same as &l:LazyStringFlatMultimap::putOrReplace ();. Kept for compatibility with &id:oatpp::data::share::LazyStringMapTemplate;.
+   * @param key
+   * @param value
+   * @return - `true` if an entry was replaced, `false` if entry was only inserted.
+   */
+  bool putOrReplace_LockFree(const Key& key, const StringKeyLabel& value) {
+    return putOrReplace(key, value);
+  }
+
+  /**
+   * Erase all occurrences of key.
+   * @param key
+   * @return - `true` if at least one entry was erased.
+   */
+  bool erase(const Key& key) {
+    return erase(key, hashKey(key));
+  }
+
+  /**
+   * Remove all entries.
+   */
+  void clear() {
+    if(!m_onHeap) {
+      for(v_buff_size i = 0; i < m_size; i ++) {
+        m_inline[i] = Entry();
+      }
+    }
+    m_heap.clear();
+    m_onHeap = false;
+    m_size = 0;
+    m_fullyInitialized = true;
+  }
+
+  /**
+   * Get value as &id:oatpp::String;.
+   * @param key
+   * @return
+   */
+  String get(const Key& key) const {
+
+    auto entry = find(key, hashKey(key));
+
+    if(entry != nullptr) {
+      entry->second.captureToOwnMemory();
+      return entry->second.getMemoryHandle();
+    }
+
+    return nullptr;
+
+  }
+
+  /**
+   * Get value as a memory label.
+   * @tparam T - one of: &id:oatpp::data::share::MemoryLabel;, &id:oatpp::data::share::StringKeyLabel;, &id:oatpp::data::share::StringKeyLabelCI;.
+   * @param key
+   * @return
+   */
+  template<class T>
+  T getAsMemoryLabel(const Key& key) const {
+
+    auto entry = find(key, hashKey(key));
+
+    if(entry != nullptr) {
+      entry->second.captureToOwnMemory();
+      const auto& label = entry->second;
+      return T(label.getMemoryHandle(), reinterpret_cast<const char*>(label.getData()), label.getSize());
+    }
+
+    return T(nullptr, nullptr, 0);
+
+  }
+
+  /**
+   * Get value as a memory label without allocating memory for value.
+   * @tparam T - one of: &id:oatpp::data::share::MemoryLabel;, &id:oatpp::data::share::StringKeyLabel;, &id:oatpp::data::share::StringKeyLabelCI;.
+   * @param key
+   * @return
+   */
+  template<class T>
+  T getAsMemoryLabel_Unsafe(const Key& key) const {
+
+    auto entry = find(key, hashKey(key));
+
+    if(entry != nullptr) {
+      const auto& label = entry->second;
+      return T(label.getMemoryHandle(), reinterpret_cast<const char*>(label.getData()), label.getSize());
+    }
+
+    return T(nullptr, nullptr, 0);
+
+  }
+
+  /**
+   * Get all entries. Keys and values are copied to their own memory.
+   * @return - this map.
+   */
+  const LazyStringFlatMultimap& getAll() const {
+
+    if(!m_fullyInitialized) {
+
+      auto entries = data();
+      for(v_buff_size i = 0; i < m_size; i ++) {
+        entries[i].first.captureToOwnMemory();
+        entries[i].second.captureToOwnMemory();
+      }
+
+      m_fullyInitialized = true;
+    }
+
+    return *this;
+
+  }
+
+  /**
+   * Get all entries without allocating memory for those keys/values.
+   * @return - this map.
+   */
+  const LazyStringFlatMultimap& getAll_Unsafe() const {
+    return *this;
+  }
+
+  /**
+   * Get number of entries in the map.
+   * @return
+   */
+  v_int32 getSize() const {
+    return static_cast<v_int32>(m_size);
+  }
+
+  /**
+   * Iterator to the first entry. Entries are iterated in insertion order.
+   * @return
+   */
+  const_iterator begin() const {
+    return data();
+  }
+
+  /**
+   * Iterator past the last entry.
+   * @return
+   */
+  const_iterator end() const {
+    return data() + m_size;
+  }
+
+  /**
+   * Find first entry with the key.
+   * @param key
+   * @return - iterator to the entry or &l:LazyStringFlatMultimap::end ();.
+   */
+  const_iterator find(const Key& key) const {
+    auto entry = find(key, hashKey(key));
+    return entry != nullptr ? entry : end();
+  }
+
+  /**
+   * Count entries with the key.
+   * @param key
+   * @return
+   */
+  v_buff_size count(const Key& key) const {
+    auto hash = hashKey(key);
+    auto entries = data();
+    v_buff_size result = 0;
+    for(v_buff_size i = 0; i < m_size; i ++) {
+      if(entries[i].hash == hash && entries[i].first == key) {
+        result ++;
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Get number of entries.
+   * @return
+   */
+  v_buff_size size() const {
+    return m_size;
+  }
+
+  /**
+   * Check if the map is empty.
+   * @return
+   */
+  bool empty() const {
+    return m_size == 0;
+  }
+
+};
+
+}}}
+
+#endif //oatpp_data_share_LazyStringFlatMap_hpp
@@ -39,12 +39,48 @@ BufferOutputStream::BufferOutputStream(v_buff_size initialCapacity, const std::s
   , m_position(0)
   , m_maxCapacity(-1)
   , m_ioMode(IOMode::ASYNCHRONOUS)
+  , m_pool(nullptr)
+  , m_pooledData(false)
   , m_capturedData(captureData)
 {}
 
+BufferOutputStream::BufferOutputStream(v_buff_size initialCapacity, buffer::BufferPool* pool, const std::shared_ptr<void>& captureData)
+  : m_data(nullptr)
+  , m_capacity(0)
+  , m_position(0)
+  , m_maxCapacity(-1)
+  , m_ioMode(IOMode::ASYNCHRONOUS)
+  , m_pool(pool)
+  , m_pooledData(false)
+  , m_capturedData(captureData)
+{
+  allocateData(initialCapacity);
+}
+
 BufferOutputStream::~BufferOutputStream() {
   m_capturedData.reset(); // reset capture data before deleting data.
-  delete [] m_data;
+  freeData();
+}
+
+void BufferOutputStream::allocateData(v_buff_size capacity) {
+  if(m_pool && capacity <= m_pool->getBlockSize()) {
+    m_data = m_pool->obtain();
+    m_capacity = m_pool->getBlockSize();
+    m_pooledData = true;
+  } else {
+    m_data = new v_char8[static_cast<unsigned long>(capacity)];
+    m_capacity = capacity;
+    m_pooledData = false;
+  }
+}
+
+void BufferOutputStream::freeData() {
+  if(m_pooledData) {
+    m_pool->release(m_data);
+  } else {
+    delete [] m_data;
+  }
+  m_data = nullptr;
 }
 
 v_io_size BufferOutputStream::write(const void *data, v_buff_size count, async::Action& action) {
@@ -88,12 +124,20 @@ void BufferOutputStream::reserveBytesUpfront(v_buff_size count) {
       throw std::runtime_error("[oatpp::data::stream::BufferOutputStream::reserveBytesUpfront()]: Error. Unable to allocate requested memory.");
     }
 
-    auto newData = new v_char8[static_cast<unsigned long>(newCapacity)];
+    auto oldData = m_data;
+    auto oldPooled = m_pooledData;
 
-    std::memcpy(newData, m_data, static_cast<size_t>(m_position));
-    delete [] m_data;
-    m_data = newData;
+    m_data = new v_char8[static_cast<unsigned long>(newCapacity)];
     m_capacity = newCapacity;
+    m_pooledData = false;
+
+    std::memcpy(m_data, oldData, static_cast<size_t>(m_position));
+
+    if(oldPooled) {
+      m_pool->release(oldData);
+    } else {
+      delete [] oldData;
+    }
 
   }
 
@@ -119,9 +163,8 @@ void BufferOutputStream::setCurrentPosition(v_buff_size position) {
 }
 
 void BufferOutputStream::reset(v_buff_size initialCapacity) {
-  delete [] m_data;
-  m_data = new v_char8[static_cast<unsigned long>(initialCapacity)];
-  m_capacity = initialCapacity;
+  freeData();
+  allocateData(initialCapacity);
   m_position = 0;
 }
 
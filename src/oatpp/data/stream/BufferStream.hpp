@@ -41,8 +41,13 @@ private:
   v_buff_size m_position;
   v_buff_size m_maxCapacity;
   IOMode m_ioMode;
+  buffer::BufferPool* m_pool;
+  bool m_pooledData;
 private:
   std::shared_ptr<void> m_capturedData;
+private:
+  void allocateData(v_buff_size capacity);
+  void freeData();
 public:
 
   /**
@@ -52,6 +57,16 @@ public:
    */
   BufferOutputStream(v_buff_size initialCapacity = 2048, const std::shared_ptr<void>& captureData = nullptr);
 
+  /**
+   * Constructor. <br>
+   * Buffers of capacity not greater than pool block size are obtained from the pool.
+   * Larger buffers (after the stream grows) are allocated with `new`.
+   * @param initialCapacity
+   * @param pool - &id:oatpp::data::buffer::BufferPool;. May be `nullptr`.
+   * @param captureData - capture auxiliary data to not get deleted until it's done with the stream.
+   */
+  BufferOutputStream(v_buff_size initialCapacity, buffer::BufferPool* pool, const std::shared_ptr<void>& captureData = nullptr);
+
   /**
    * Virtual destructor.
    */
@@ -130,6 +130,102 @@ async::CoroutineStarter WriteCallback::writeExactSizeDataAsync(const void* data,
 
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// OutputStream
+
+namespace {
+
+  v_int32 skipWrittenBuffers(data::buffer::InlineWriteData* buffers, v_int32 count, v_int32 index) {
+    while(index < count && buffers[index].bytesLeft == 0) {
+      index ++;
+    }
+    return index;
+  }
+
+  void incBuffers(data::buffer::InlineWriteData* buffers, v_int32 count, v_io_size amount) {
+    for(v_int32 i = 0; i < count && amount > 0; i ++) {
+      auto& buffer = buffers[i];
+      if(amount >= buffer.bytesLeft) {
+        amount -= buffer.bytesLeft;
+        buffer.setEof();
+      } else {
+        buffer.inc(amount);
+        amount = 0;
+      }
+    }
+  }
+
+}
+
+v_io_size OutputStream::writev(const data::buffer::InlineWriteData* buffers, v_int32 count, async::Action& action) {
+  for(v_int32 i = 0; i < count; i ++) {
+    if(buffers[i].bytesLeft > 0) {
+      return write(buffers[i].currBufferPtr, buffers[i].bytesLeft, action);
+    }
+  }
+  return 0;
+}
+
+v_io_size OutputStream::writevExactSizeDataSimple(data::buffer::InlineWriteData* buffers, v_int32 count) {
+  v_io_size total = 0;
+  v_int32 index = skipWrittenBuffers(buffers, count, 0);
+  while(index < count) {
+    async::Action action;
+    auto res = writev(&buffers[index], count - index, action);
+    if(!action.isNone()) {
+      OATPP_LOGe("[oatpp::data::stream::OutputStream::writevExactSizeDataSimple()]", "Error. writevExactSizeDataSimple() is called on a stream in Async mode.")
+      throw std::runtime_error("[oatpp::data::stream::OutputStream::writevExactSizeDataSimple()]: Error. writevExactSizeDataSimple() is called on a stream in Async mode.");
+    }
+    if(res > 0) {
+      total += res;
+      incBuffers(&buffers[index], count - index, res);
+      index = skipWrittenBuffers(buffers, count, index);
+    } else if(res == IOError::BROKEN_PIPE || res == IOError::ZERO_VALUE) {
+      break;
+    }
+  }
+  return total;
+}
+
+async::Action OutputStream::writevExactSizeDataAsyncInline(data::buffer::InlineWriteData* buffers, v_int32 count, async::Action&& nextAction) {
+
+  v_int32 index = skipWrittenBuffers(buffers, count, 0);
+
+  if(index < count) {
+
+    async::Action action;
+    auto res = writev(&buffers[index], count - index, action);
+
+    if (!action.isNone()) {
+      return action;
+    }
+
+    if (res > 0) {
+      incBuffers(&buffers[index], count - index, res);
+      return async::Action::createActionByType(async::Action::TYPE_REPEAT);
+    } else {
+      switch (res) {
+        case IOError::BROKEN_PIPE:
+          return new AsyncIOError(IOError::BROKEN_PIPE);
+        case IOError::ZERO_VALUE:
+          break;
+        case IOError::RETRY_READ:
+          return async::Action::createActionByType(async::Action::TYPE_REPEAT);
+        case IOError::RETRY_WRITE:
+          return async::Action::createActionByType(async::Action::TYPE_REPEAT);
+        default:
+          OATPP_LOGe("[oatpp::data::stream::writevExactSizeDataAsyncInline()]", "Error. Unknown IO result.")
+          return new async::Error(
+            "[oatpp::data::stream::writevExactSizeDataAsyncInline()]: Error. Unknown IO result.");
+      }
+    }
+
+  }
+
+  return std::forward<async::Action>(nextAction);
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // ReadCallback
 
@@ -282,6 +282,38 @@ public:
    */
   virtual Context& getOutputStreamContext() = 0;
 
+  /**
+   * Vectored (scatter-gather) write. Write data from several buffers in one call. <br>
+   * Default implementation writes only the first non-empty buffer with &l:WriteCallback::write ();.
+   * Streams with native support of vectored output (ex.: &id:oatpp::network::tcp::Connection;) override this method. <br>
+   * *Buffers are NOT modified. Use &l:OutputStream::writevExactSizeDataSimple (); to write all data.*
+   * @param buffers - array of &id:oatpp::data::buffer::InlineWriteData;.
+   * @param count - number of buffers in the array.
+   * @param action - async specific action. If action is NOT &id:oatpp::async::Action::TYPE_NONE;, then
+   * caller MUST return this action on coroutine iteration.
+   * @return - actual number of bytes written (in total across buffers). &id:oatpp::v_io_size;.
+   */
+  virtual v_io_size writev(const data::buffer::InlineWriteData* buffers, v_int32 count, async::Action& action);
+
+  /**
+   * Write all data from all buffers using &l:OutputStream::writev ();. <br>
+   * Buffers are advanced by the number of bytes written.
+   * @param buffers - array of &id:oatpp::data::buffer::InlineWriteData;.
+   * @param count - number of buffers in the array.
+   * @return - actual number of bytes written (in total across buffers). &id:oatpp::v_io_size;.
+   */
+  v_io_size writevExactSizeDataSimple(data::buffer::InlineWriteData* buffers, v_int32 count);
+
+  /**
+   * Write all data from all buffers using &l:OutputStream::writev (); in Async manner. <br>
+   * Buffers are advanced by the number of bytes written, so they must stay valid until `nextAction` is reached.
+   * @param buffers - array of &id:oatpp::data::buffer::InlineWriteData;.
+   * @param count - number of buffers in the array.
+   * @param nextAction - action to return when all data is written.
+   * @return - &id:oatpp::async::Action;.
+   */
+  async::Action writevExactSizeDataAsyncInline(data::buffer::InlineWriteData* buffers, v_int32 count, async::Action&& nextAction);
+
 };
 
 /**
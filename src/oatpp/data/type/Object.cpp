@@ -24,6 +24,9 @@
 
 #include "./Object.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 namespace oatpp { namespace data { namespace type {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -69,6 +72,53 @@ void BaseObject::Properties::pushFrontAll(Properties* properties) {
   m_list.insert(m_list.begin(), properties->m_list.begin(), properties->m_list.end());
 }
 
+void BaseObject::Properties::buildIndexes() {
+  buildIndex(m_map, m_index, false);
+  buildIndex(m_unqualifiedMap, m_unqualifiedIndex, true);
+}
+
+void BaseObject::Properties::buildIndex(const std::unordered_map<std::string, Property*>& map, std::vector<Property*>& index, bool unqualified) {
+
+  index.clear();
+  index.reserve(map.size());
+  for(auto& pair : map) {
+    index.push_back(pair.second);
+  }
+
+  std::sort(index.begin(), index.end(), [unqualified](Property* a, Property* b) {
+    const std::string& nameA = unqualified ? a->unqualifiedName : a->name;
+    const std::string& nameB = unqualified ? b->unqualifiedName : b->name;
+    if(nameA.size() != nameB.size()) {
+      return nameA.size() < nameB.size();
+    }
+    return std::memcmp(nameA.data(), nameB.data(), nameA.size()) < 0;
+  });
+
+}
+
+BaseObject::Property* BaseObject::Properties::findInIndex(const std::vector<Property*>& index, const char* name, v_buff_size size, bool unqualified) {
+
+  const auto nameSize = static_cast<size_t>(size);
+
+  auto it = std::lower_bound(index.begin(), index.end(), name, [unqualified, nameSize](Property* p, const char* key) {
+    const std::string& pName = unqualified ? p->unqualifiedName : p->name;
+    if(pName.size() != nameSize) {
+      return pName.size() < nameSize;
+    }
+    return std::memcmp(pName.data(), key, nameSize) < 0;
+  });
+
+  if(it != index.end()) {
+    const std::string& pName = unqualified ? (*it)->unqualifiedName : (*it)->name;
+    if(pName.size() == nameSize && std::memcmp(pName.data(), name, nameSize) == 0) {
+      return *it;
+    }
+  }
+
+  return nullptr;
+
+}
+
 const std::unordered_map<std::string, BaseObject::Property*>& BaseObject::Properties::getMap() const {
   return m_map;
 }
@@ -81,6 +131,24 @@ const std::list<BaseObject::Property*>& BaseObject::Properties::getList() const
   return m_list;
 }
 
+BaseObject::Property* BaseObject::Properties::findProperty(const char* name, v_buff_size size, bool unqualified) const {
+
+  const auto& map = unqualified ? m_unqualifiedMap : m_map;
+  const auto& index = unqualified ? m_unqualifiedIndex : m_index;
+
+  /* properties were added after buildIndexes() - fallback to the map */
+  if(index.size() != map.size()) {
+    auto it = map.find(std::string(name, static_cast<size_t>(size)));
+    if(it != map.end()) {
+      return it->second;
+    }
+    return nullptr;
+  }
+
+  return findInIndex(index, name, size, unqualified);
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // BaseObject::Property
 
@@ -181,6 +181,11 @@ public:
     std::unordered_map<std::string, Property*> m_map;
     std::unordered_map<std::string, Property*> m_unqualifiedMap;
     std::list<Property*> m_list;
+    std::vector<Property*> m_index;
+    std::vector<Property*> m_unqualifiedIndex;
+  private:
+    static void buildIndex(const std::unordered_map<std::string, Property*>& map, std::vector<Property*>& index, bool unqualified);
+    static Property* findInIndex(const std::vector<Property*>& index, const char* name, v_buff_size size, bool unqualified);
   public:
 
     /**
@@ -195,6 +200,12 @@ public:
      */
     void pushFrontAll(Properties* properties);
 
+    /**
+     * Build sorted tables used by &l:BaseObject::Properties::findProperty ();. <br>
+     * Called once all properties are registered.
+     */
+    void buildIndexes();
+
     /**
      * Get properties as unordered map for random access.
      * @return reference to std::unordered_map of std::string to &id:oatpp::data::type::BaseObject::Property;*.
@@ -213,6 +224,16 @@ public:
      */
     const std::list<Property*>& getList() const;
 
+    /**
+     * Find property by name. Uses table of properties sorted by name length and name. <br>
+     * Doesn't require `std::string` key - name can point directly into parsed data.
+     * @param name - pointer to name.
+     * @param size - size of the name.
+     * @param unqualified - search by unqualified names.
+     * @return - &id:oatpp::data::type::BaseObject::Property;* or `nullptr` if not found.
+     */
+    Property* findProperty(const char* name, v_buff_size size, bool unqualified = false) const;
+
   };
 
 private:
@@ -292,6 +313,9 @@ namespace __class {
       /* extend parent properties */
       T::Z__CLASS_EXTEND(T::Z__CLASS::Z__CLASS_GET_FIELDS_MAP(), T::Z__CLASS_EXTENDED::Z__CLASS_GET_FIELDS_MAP());
 
+      /* all properties are registered - build lookup tables once */
+      T::Z__CLASS::Z__CLASS_GET_FIELDS_MAP()->buildIndexes();
+
       return T::Z__CLASS::Z__CLASS_GET_FIELDS_MAP();
 
     }
@@ -0,0 +1,443 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ObjectDeserializer.hpp"
+
+#include "oatpp/utils/Conversion.hpp"
+
+#include <cstring>
+
+namespace oatpp { namespace json {
+
+ObjectDeserializer::ObjectDeserializer() {
+
+  m_methods.resize(static_cast<size_t>(data::type::ClassId::getClassCount()), nullptr);
+
+  setDeserializerMethod(data::type::__class::String::CLASS_ID, &ObjectDeserializer::deserializeString);
+
+  setDeserializerMethod(data::type::__class::Int8::CLASS_ID, &ObjectDeserializer::deserializePrimitive<oatpp::Int8>);
+  setDeserializerMethod(data::type::__class::UInt8::CLASS_ID, &ObjectDeserializer::deserializePrimitive<oatpp::UInt8>);
+
+  setDeserializerMethod(data::type::__class::Int16::CLASS_ID, &ObjectDeserializer::deserializePrimitive<oatpp::Int16>);
+  setDeserializerMethod(data::type::__class::UInt16::CLASS_ID, &ObjectDeserializer::deserializePrimitive<oatpp::UInt16>);
+
+  setDeserializerMethod(data::type::__class::Int32::CLASS_ID, &ObjectDeserializer::deserializePrimitive<oatpp::Int32>);
+  setDeserializerMethod(data::type::__class::UInt32::CLASS_ID, &ObjectDeserializer::deserializePrimitive<oatpp::UInt32>);
+
+  setDeserializerMethod(data::type::__class::Int64::CLASS_ID, &ObjectDeserializer::deserializePrimitive<oatpp::Int64>);
+  setDeserializerMethod(data::type::__class::UInt64::CLASS_ID, &ObjectDeserializer::deserializePrimitive<oatpp::UInt64>);
+
+  setDeserializerMethod(data::type::__class::Float32::CLASS_ID, &ObjectDeserializer::deserializePrimitive<oatpp::Float32>);
+  setDeserializerMethod(data::type::__class::Float64::CLASS_ID, &ObjectDeserializer::deserializePrimitive<oatpp::Float64>);
+  setDeserializerMethod(data::type::__class::Boolean::CLASS_ID, &ObjectDeserializer::deserializePrimitive<oatpp::Boolean>);
+
+  setDeserializerMethod(data::type::__class::AbstractObject::CLASS_ID, &ObjectDeserializer::deserializeObject);
+  setDeserializerMethod(data::type::__class::AbstractEnum::CLASS_ID, &ObjectDeserializer::deserializeEnum);
+
+  setDeserializerMethod(data::type::__class::AbstractVector::CLASS_ID, &ObjectDeserializer::deserializeCollection);
+  setDeserializerMethod(data::type::__class::AbstractList::CLASS_ID, &ObjectDeserializer::deserializeCollection);
+  setDeserializerMethod(data::type::__class::AbstractUnorderedSet::CLASS_ID, &ObjectDeserializer::deserializeCollection);
+
+  setDeserializerMethod(data::type::__class::AbstractPairList::CLASS_ID, &ObjectDeserializer::deserializeMap);
+  setDeserializerMethod(data::type::__class::AbstractUnorderedMap::CLASS_ID, &ObjectDeserializer::deserializeMap);
+
+}
+
+void ObjectDeserializer::setDeserializerMethod(const data::type::ClassId& classId, DeserializerMethod method) {
+  const auto id = static_cast<v_uint32>(classId.id);
+  if(id >= m_methods.size()) {
+    m_methods.resize(id + 1, nullptr);
+  }
+  m_methods[id] = method;
+}
+
+bool ObjectDeserializer::isAtNull(State& state) {
+  return state.caret->isAtText("null", true);
+}
+
+bool ObjectDeserializer::isAtNumber(State& state) {
+  return state.caret->isAtChar('-') || state.caret->isAtDigitChar();
+}
+
+bool ObjectDeserializer::parseTree(State& state, data::mapping::Tree& tree) const {
+  Deserializer::State jsonState;
+  jsonState.caret = state.caret;
+  jsonState.config = state.jsonConfig;
+  jsonState.tree = &tree;
+  Deserializer::deserialize(jsonState);
+  if(!jsonState.errorStack.empty()) {
+    state.errorStack.splice(jsonState.errorStack);
+    return false;
+  }
+  return true;
+}
+
+oatpp::Void ObjectDeserializer::mapTree(State& state, const data::mapping::Tree& tree, const Type* type) const {
+  data::mapping::TreeToObjectMapper::State mapperState;
+  mapperState.config = state.mapperConfig;
+  mapperState.tree = &tree;
+  const auto& result = state.treeMapper->map(mapperState, type);
+  if(!mapperState.errorStack.empty()) {
+    state.errorStack.splice(mapperState.errorStack);
+    return nullptr;
+  }
+  return result;
+}
+
+oatpp::Void ObjectDeserializer::deserializeViaTree(State& state, const Type* type) const {
+
+  data::mapping::Tree tree;
+  if(!parseTree(state, tree)) {
+    return nullptr;
+  }
+
+  if(type == oatpp::Tree::Class::getType()) {
+    return oatpp::Tree(std::move(tree));
+  }
+
+  if(state.treeMapper == nullptr) {
+    state.errorStack.push("[oatpp::json::ObjectDeserializer::deserializeViaTree()]: "
+                          "Error. No deserialize method for type '" + std::string(type->classId.name) + "'");
+    return nullptr;
+  }
+
+  return mapTree(state, tree, type);
+
+}
+
+oatpp::Void ObjectDeserializer::deserialize(State& state, const Type* type) const {
+
+  state.caret->skipBlankChars();
+
+  /* methods overridden on the tree mapper take precedence over the direct ones */
+  bool overridden = state.treeMapper != nullptr && state.treeMapper->hasCustomMapperMethod(type->classId);
+  auto id = static_cast<v_uint32>(type->classId.id);
+  if(!overridden && id < m_methods.size() && m_methods[id] != nullptr) {
+    return (*m_methods[id])(this, state, type);
+  }
+
+  return deserializeViaTree(state, type);
+
+}
+
+oatpp::Void ObjectDeserializer::deserializeString(const ObjectDeserializer* deserializer, State& state, const Type* type) {
+
+  if(state.caret->isAtChar('"')) {
+    return Utils::parseString(*state.caret);
+  }
+
+  if(isAtNull(state)) {
+    return oatpp::Void(String::Class::getType());
+  }
+
+  return deserializer->deserializeViaTree(state, type);
+
+}
+
+oatpp::Void ObjectDeserializer::deserializeEnum(const ObjectDeserializer* deserializer, State& state, const Type* type) {
+
+  auto polymorphicDispatcher = static_cast<const data::type::__class::AbstractEnum::PolymorphicDispatcher*>(
+    type->polymorphicDispatcher
+  );
+
+  data::type::EnumInterpreterError e = data::type::EnumInterpreterError::OK;
+  const auto& value = deserializer->deserialize(state, polymorphicDispatcher->getInterpretationType());
+  if(!state.errorStack.empty()) {
+    state.errorStack.push("[oatpp::json::ObjectDeserializer::deserializeEnum()]");
+    return nullptr;
+  }
+  const auto& result = polymorphicDispatcher->fromInterpretation(value, state.mapperConfig->useUnqualifiedEnumNames, e);
+
+  if(e == data::type::EnumInterpreterError::OK) {
+    return result;
+  }
+
+  switch(e) {
+    case data::type::EnumInterpreterError::CONSTRAINT_NOT_NULL:
+      state.errorStack.push("[oatpp::json::ObjectDeserializer::deserializeEnum()]: Error. Enum constraint violated - 'NotNull'.");
+      break;
+    case data::type::EnumInterpreterError::OK:
+    case data::type::EnumInterpreterError::TYPE_MISMATCH_ENUM:
+    case data::type::EnumInterpreterError::TYPE_MISMATCH_ENUM_VALUE:
+    case data::type::EnumInterpreterError::ENTRY_NOT_FOUND:
+    default:
+      state.errorStack.push("[oatpp::json::ObjectDeserializer::deserializeEnum()]: Error. Can't map Enum.");
+  }
+
+  return nullptr;
+
+}
+
+oatpp::Void ObjectDeserializer::deserializeCollection(const ObjectDeserializer* deserializer, State& state, const Type* type) {
+
+  if(isAtNull(state)) {
+    return oatpp::Void(type);
+  }
+
+  if(!state.caret->canContinueAtChar('[', 1)) {
+    return deserializer->deserializeViaTree(state, type);
+  }
+
+  auto dispatcher = static_cast<const data::type::__class::Collection::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+  auto collection = dispatcher->createObject();
+  auto itemType = dispatcher->getItemType();
+
+  state.caret->skipBlankChars();
+
+  v_int64 index = 0;
+
+  while(!state.caret->isAtChar(']') && state.caret->canContinue()){
+
+    auto item = deserializer->deserialize(state, itemType);
+
+    if(!state.errorStack.empty()) {
+      state.errorStack.push("[oatpp::json::ObjectDeserializer::deserializeCollection()]: index=" + utils::Conversion::int64ToStr(index));
+      return nullptr;
+    }
+
+    dispatcher->addItem(collection, item);
+
+    state.caret->skipBlankChars();
+    state.caret->canContinueAtChar(',', 1);
+
+    index ++;
+
+  }
+
+  if(!state.caret->canContinueAtChar(']', 1)){
+    state.errorStack.push("[oatpp::json::ObjectDeserializer::deserializeCollection()]: ']' expected");
+    return nullptr;
+  }
+
+  return collection;
+
+}
+
+oatpp::Void ObjectDeserializer::deserializeMap(const ObjectDeserializer* deserializer, State& state, const Type* type) {
+
+  if(isAtNull(state)) {
+    return oatpp::Void(type);
+  }
+
+  if(!state.caret->isAtChar('{')) {
+    return deserializer->deserializeViaTree(state, type);
+  }
+
+  auto dispatcher = static_cast<const data::type::__class::Map::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+
+  auto keyType = dispatcher->getKeyType();
+  if(keyType->classId != oatpp::String::Class::CLASS_ID){
+    state.errorStack.push("[oatpp::json::ObjectDeserializer::deserializeMap()]: Invalid map key. Key should be String");
+    return nullptr;
+  }
+  auto valueType = dispatcher->getValueType();
+
+  auto map = dispatcher->createObject();
+
+  state.caret->canContinueAtChar('{', 1);
+  state.caret->skipBlankChars();
+
+  while (!state.caret->isAtChar('}') && state.caret->canContinue()) {
+
+    state.caret->skipBlankChars();
+
+    auto key = Utils::parseString(*state.caret);
+    if(state.caret->hasError()){
+      state.errorStack.push("[oatpp::json::ObjectDeserializer::deserializeMap()]: Item key name expected");
+      return nullptr;
+    }
+
+    state.caret->skipBlankChars();
+    if(!state.caret->canContinueAtChar(':', 1)){
+      state.errorStack.push("[oatpp::json::ObjectDeserializer::deserializeMap()]: ':' expected");
+      return nullptr;
+    }
+
+    auto item = deserializer->deserialize(state, valueType);
+
+    if(!state.errorStack.empty()) {
+      state.errorStack.push("[oatpp::json::ObjectDeserializer::deserializeMap()]: key='" + key + "'");
+      return nullptr;
+    }
+
+    dispatcher->addItem(map, key, item);
+
+    state.caret->skipBlankChars();
+    state.caret->canContinueAtChar(',', 1);
+
+  }
+
+  if(!state.caret->canContinueAtChar('}', 1)){
+    state.errorStack.push("[oatpp::json::ObjectDeserializer::deserializeMap()]: '}' expected");
+    return nullptr;
+  }
+
+  return map;
+
+}
+
+oatpp::Void ObjectDeserializer::deserializeObject(const ObjectDeserializer* deserializer, State& state, const Type* type) {
+
+  if(isAtNull(state)) {
+    return oatpp::Void(type);
+  }
+
+  if(!state.caret->isAtChar('{')) {
+    return deserializer->deserializeViaTree(state, type);
+  }
+
+  auto dispatcher = static_cast<const oatpp::data::type::__class::AbstractObject::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+  auto properties = dispatcher->getProperties();
+  auto object = dispatcher->createObject();
+  auto baseObject = static_cast<oatpp::BaseObject *>(object.get());
+
+  std::vector<std::pair<oatpp::BaseObject::Property*, data::mapping::Tree>> polymorphs;
+
+  state.caret->canContinueAtChar('{', 1);
+  state.caret->skipBlankChars();
+
+  while (!state.caret->isAtChar('}') && state.caret->canContinue()) {
+
+    state.caret->skipBlankChars();
+
+    /* resolve key directly from the parsed data if it has no escaped chars */
+
+    v_buff_size keyStart = state.caret->getPosition();
+    v_buff_size keySize;
+    const char* keyData = Utils::preparseString(*state.caret, keySize);
+    if(keyData == nullptr){
+      state.errorStack.push("[oatpp::json::ObjectDeserializer::deserializeObject()]: Item key name expected");
+      return nullptr;
+    }
+
+    oatpp::BaseObject::Property* field;
+    oatpp::String unescapedKey;
+
+    if(std::memchr(keyData, '\\', static_cast<size_t>(keySize)) == nullptr) {
+      state.caret->setPosition(state.caret->getPosition() + keySize + 1);
+      field = properties->findProperty(keyData, keySize, state.mapperConfig->useUnqualifiedFieldNames);
+    } else {
+      state.caret->setPosition(keyStart);
+      unescapedKey = Utils::parseString(*state.caret);
+      if(state.caret->hasError()){
+        state.errorStack.push("[oatpp::json::ObjectDeserializer::deserializeObject()]: Item key name expected");
+        return nullptr;
+      }
+      field = properties->findProperty(unescapedKey->data(), static_cast<v_buff_size>(unescapedKey->size()), state.mapperConfig->useUnqualifiedFieldNames);
+    }
+
+    state.caret->skipBlankChars();
+    if(!state.caret->canContinueAtChar(':', 1)){
+      state.errorStack.push("[oatpp::json::ObjectDeserializer::deserializeObject()]: ':' expected");
+      return nullptr;
+    }
+
+    if(field != nullptr) {
+
+      if(field->info.typeSelector && field->type == oatpp::Any::Class::getType()) {
+
+        /* store polymorphs for later processing. */
+        polymorphs.emplace_back(field, data::mapping::Tree());
+        state.caret->skipBlankChars();
+        if(!deserializer->parseTree(state, polymorphs.back().second)) {
+          state.errorStack.push("[oatpp::json::ObjectDeserializer::deserializeObject()]: field='" + field->name + "'");
+          return nullptr;
+        }
+
+      } else {
+
+        auto value = deserializer->deserialize(state, field->type);
+
+        if(!state.errorStack.empty()) {
+          state.errorStack.push("[oatpp::json::ObjectDeserializer::deserializeObject()]: field='" + field->name + "'");
+          return nullptr;
+        }
+
+        if(field->info.required && value == nullptr) {
+          state.errorStack.push("[oatpp::json::ObjectDeserializer::deserializeObject()]: Error. " +
+                                oatpp::String(type->nameQualifier) + "::" +
+                                oatpp::String(field->name) + " is required!");
+          return nullptr;
+        }
+
+        field->set(baseObject, value);
+
+      }
+
+    } else {
+
+      if(!state.mapperConfig->allowUnknownFields) {
+        std::string key = unescapedKey ? *unescapedKey : std::string(keyData, static_cast<size_t>(keySize));
+        state.errorStack.push("[oatpp::json::ObjectDeserializer::deserializeObject()]: Error. Unknown field '" + key + "'");
+        return nullptr;
+      }
+
+      /* skip value of unknown field */
+      data::mapping::Tree tree;
+      state.caret->skipBlankChars();
+      if(!deserializer->parseTree(state, tree)) {
+        return nullptr;
+      }
+
+    }
+
+    state.caret->skipBlankChars();
+    state.caret->canContinueAtChar(',', 1);
+
+  }
+
+  if(!state.caret->canContinueAtChar('}', 1)){
+    state.errorStack.push("[oatpp::json::ObjectDeserializer::deserializeObject()]: '}' expected");
+    return nullptr;
+  }
+
+  for(auto& p : polymorphs) {
+
+    auto selectedType = p.first->info.typeSelector->selectType(baseObject);
+
+    auto value = deserializer->mapTree(state, p.second, selectedType);
+
+    if(!state.errorStack.empty()) {
+      state.errorStack.push("[oatpp::json::ObjectDeserializer::deserializeObject()]: field='" + oatpp::String(p.first->name) + "'");
+      return nullptr;
+    }
+
+    if(p.first->info.required && value == nullptr) {
+      state.errorStack.push("[oatpp::json::ObjectDeserializer::deserializeObject()]: Error. " +
+                            oatpp::String(type->nameQualifier) + "::" +
+                            oatpp::String(p.first->name) + " is required!");
+      return nullptr;
+    }
+
+    oatpp::Any any(value);
+    p.first->set(baseObject, oatpp::Void(any.getPtr(), p.first->type));
+
+  }
+
+  return object;
+
+}
+
+}}
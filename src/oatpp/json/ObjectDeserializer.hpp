@@ -0,0 +1,138 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_json_ObjectDeserializer_hpp
+#define oatpp_json_ObjectDeserializer_hpp
+
+#include "./Deserializer.hpp"
+
+#include "oatpp/data/mapping/TreeToObjectMapper.hpp"
+
+namespace oatpp { namespace json {
+
+/**
+ * Direct JSON-to-Object deserializer. <br>
+ * Parses JSON with &id:oatpp::utils::parser::Caret; straight into DTO fields
+ * without building intermediate &id:oatpp::data::mapping::Tree;. <br>
+ * Object fields are resolved with &id:oatpp::data::type::BaseObject::Properties::findProperty; directly from parsed data. <br>
+ * Values which can't be parsed directly (`Any`, `Tree`, custom types, interpretations, lexical casting)
+ * and values of classes whose mapper method was overridden on `State::treeMapper`
+ * are parsed to &id:oatpp::data::mapping::Tree; and mapped with `State::treeMapper`.
+ */
+class ObjectDeserializer : public base::Countable {
+public:
+
+  /**
+   * Deserializer state.
+   */
+  struct State {
+
+    const data::mapping::TreeToObjectMapper::Config* mapperConfig;
+    const Deserializer::Config* jsonConfig;
+    const data::mapping::TreeToObjectMapper* treeMapper;
+    utils::parser::Caret* caret;
+
+    data::mapping::ErrorStack errorStack;
+
+  };
+
+public:
+  typedef oatpp::Void (*DeserializerMethod)(const ObjectDeserializer*, State&, const Type*);
+private:
+  static bool isAtNull(State& state);
+  static bool isAtNumber(State& state);
+public:
+
+  template<class T>
+  static oatpp::Void deserializePrimitive(const ObjectDeserializer* deserializer, State& state, const Type* type){
+
+    if(isAtNumber(state)) {
+      if (!Utils::findDecimalSeparatorInCurrentNumber(*state.caret)) {
+        return T(static_cast<typename T::UnderlyingType>(state.caret->parseInt()));
+      }
+      return T(static_cast<typename T::UnderlyingType>(state.caret->parseFloat64()));
+    }
+
+    if(state.caret->isAtText("true", true)) {
+      return T(static_cast<typename T::UnderlyingType>(true));
+    }
+
+    if(state.caret->isAtText("false", true)) {
+      return T(static_cast<typename T::UnderlyingType>(false));
+    }
+
+    if(isAtNull(state)) {
+      return oatpp::Void(T::Class::getType());
+    }
+
+    return deserializer->deserializeViaTree(state, type);
+
+  }
+
+  static oatpp::Void deserializeString(const ObjectDeserializer* deserializer, State& state, const Type* type);
+  static oatpp::Void deserializeEnum(const ObjectDeserializer* deserializer, State& state, const Type* type);
+
+  static oatpp::Void deserializeCollection(const ObjectDeserializer* deserializer, State& state, const Type* type);
+  static oatpp::Void deserializeMap(const ObjectDeserializer* deserializer, State& state, const Type* type);
+
+  static oatpp::Void deserializeObject(const ObjectDeserializer* deserializer, State& state, const Type* type);
+
+private:
+  std::vector<DeserializerMethod> m_methods;
+private:
+  bool parseTree(State& state, data::mapping::Tree& tree) const;
+  oatpp::Void mapTree(State& state, const data::mapping::Tree& tree, const Type* type) const;
+public:
+
+  ObjectDeserializer();
+
+  /**
+   * Set deserializer method for class.
+   * @param classId
+   * @param method
+   */
+  void setDeserializerMethod(const data::type::ClassId& classId, DeserializerMethod method);
+
+  /**
+   * Parse value at caret to &id:oatpp::data::mapping::Tree; and map it to object of type with `State::treeMapper`.
+   * @param state
+   * @param type
+   * @return
+   */
+  oatpp::Void deserializeViaTree(State& state, const Type* type) const;
+
+  /**
+   * Deserialize value of type from `state.caret`.
+   * @param state
+   * @param type
+   * @return
+   */
+  oatpp::Void deserialize(State& state, const Type* type) const;
+
+};
+
+}}
+
+#endif // oatpp_json_ObjectDeserializer_hpp
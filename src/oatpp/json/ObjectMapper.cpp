@@ -43,6 +43,33 @@ void ObjectMapper::writeTree(data::stream::ConsistentOutputStream* stream, const
   }
 }
 
+void ObjectMapper::writeDirect(data::stream::ConsistentOutputStream* stream, const oatpp::Void& variant, data::mapping::ErrorStack& errorStack) const {
+
+  ObjectSerializer::State state;
+
+  if(m_serializerConfig.json.useBeautifier) {
+    json::Beautifier beautifier(stream, "  ", "\n");
+    initObjectSerializerState(state, &beautifier);
+    m_objectSerializer.serialize(state, variant);
+  } else {
+    initObjectSerializerState(state, stream);
+    m_objectSerializer.serialize(state, variant);
+  }
+
+  if(!state.errorStack.empty()) {
+    errorStack = std::move(state.errorStack);
+    return;
+  }
+
+}
+
+void ObjectMapper::initObjectSerializerState(ObjectSerializer::State& state, data::stream::ConsistentOutputStream* stream) const {
+  state.mapperConfig = &m_serializerConfig.mapper;
+  state.jsonConfig = &m_serializerConfig.json;
+  state.treeMapper = &m_objectToTreeMapper;
+  state.stream = stream;
+}
+
 void ObjectMapper::write(data::stream::ConsistentOutputStream* stream, const oatpp::Void& variant, data::mapping::ErrorStack& errorStack) const {
 
   /* if variant is Tree - we can serialize it right away */
@@ -52,6 +79,11 @@ void ObjectMapper::write(data::stream::ConsistentOutputStream* stream, const oat
     return;
   }
 
+  if(m_serializerConfig.streaming) {
+    writeDirect(stream, variant, errorStack);
+    return;
+  }
+
   data::mapping::Tree tree;
   data::mapping::ObjectToTreeMapper::State state;
 
@@ -68,8 +100,30 @@ void ObjectMapper::write(data::stream::ConsistentOutputStream* stream, const oat
 
 }
 
+oatpp::Void ObjectMapper::readDirect(utils::parser::Caret& caret, const data::type::Type* type, data::mapping::ErrorStack& errorStack) const {
+
+  ObjectDeserializer::State state;
+  state.mapperConfig = &m_deserializerConfig.mapper;
+  state.jsonConfig = &m_deserializerConfig.json;
+  state.treeMapper = &m_treeToObjectMapper;
+  state.caret = &caret;
+
+  const auto& result = m_objectDeserializer.deserialize(state, type);
+  if(!state.errorStack.empty()) {
+    errorStack = std::move(state.errorStack);
+    return nullptr;
+  }
+
+  return result;
+
+}
+
 oatpp::Void ObjectMapper::read(utils::parser::Caret& caret, const data::type::Type* type, data::mapping::ErrorStack& errorStack) const {
 
+  if(m_deserializerConfig.streaming) {
+    return readDirect(caret, type, errorStack);
+  }
+
   data::mapping::Tree tree;
 
   {
@@ -119,6 +173,22 @@ data::mapping::TreeToObjectMapper& ObjectMapper::treeToObjectMapper() {
   return m_treeToObjectMapper;
 }
 
+const ObjectSerializer& ObjectMapper::objectSerializer() const {
+  return m_objectSerializer;
+}
+
+ObjectSerializer& ObjectMapper::objectSerializer() {
+  return m_objectSerializer;
+}
+
+const ObjectDeserializer& ObjectMapper::objectDeserializer() const {
+  return m_objectDeserializer;
+}
+
+ObjectDeserializer& ObjectMapper::objectDeserializer() {
+  return m_objectDeserializer;
+}
+
 const ObjectMapper::SerializerConfig& ObjectMapper::serializerConfig() const {
   return m_serializerConfig;
 }
@@ -26,7 +26,9 @@
 #define oatpp_json_ObjectMapper_hpp
 
 #include "./Serializer.hpp"
+#include "./ObjectSerializer.hpp"
 #include "./Deserializer.hpp"
+#include "./ObjectDeserializer.hpp"
 
 #include "oatpp/data/mapping/ObjectToTreeMapper.hpp"
 #include "oatpp/data/mapping/TreeToObjectMapper.hpp"
@@ -48,27 +50,55 @@ private:
 public:
 
   class DeserializerConfig {
+  public:
+
+    DeserializerConfig()
+      : streaming(false)
+    {}
+
   public:
     data::mapping::TreeToObjectMapper::Config mapper;
     Deserializer::Config json;
+
+    /**
+     * Deserialize objects with &id:oatpp::json::ObjectDeserializer; parsing JSON directly into object fields
+     * instead of building &id:oatpp::data::mapping::Tree; first.
+     */
+    bool streaming;
   };
 
 public:
 
   class SerializerConfig {
+  public:
+
+    SerializerConfig()
+      : streaming(false)
+    {}
+
   public:
     data::mapping::ObjectToTreeMapper::Config mapper;
     Serializer::Config json;
+
+    /**
+     * Serialize objects with &id:oatpp::json::ObjectSerializer; writing JSON directly to the stream
+     * instead of mapping them to &id:oatpp::data::mapping::Tree; first. Output is the same.
+     */
+    bool streaming;
   };
 
 private:
   void writeTree(data::stream::ConsistentOutputStream* stream, const data::mapping::Tree& tree, data::mapping::ErrorStack& errorStack) const;
+  void writeDirect(data::stream::ConsistentOutputStream* stream, const oatpp::Void& variant, data::mapping::ErrorStack& errorStack) const;
+  oatpp::Void readDirect(oatpp::utils::parser::Caret& caret, const oatpp::Type* type, data::mapping::ErrorStack& errorStack) const;
 private:
   SerializerConfig m_serializerConfig;
   DeserializerConfig m_deserializerConfig;
 private:
   data::mapping::ObjectToTreeMapper m_objectToTreeMapper;
   data::mapping::TreeToObjectMapper m_treeToObjectMapper;
+  ObjectSerializer m_objectSerializer;
+  ObjectDeserializer m_objectDeserializer;
 public:
 
   ObjectMapper(const SerializerConfig& serializerConfig = {}, const DeserializerConfig& deserializerConfig = {});
@@ -77,12 +107,25 @@ public:
 
   oatpp::Void read(oatpp::utils::parser::Caret& caret, const oatpp::Type* type, data::mapping::ErrorStack& errorStack) const override;
 
+  /**
+   * Fill state for &id:oatpp::json::ObjectSerializer; with configs and mappers of this ObjectMapper.
+   * @param state
+   * @param stream
+   */
+  void initObjectSerializerState(ObjectSerializer::State& state, data::stream::ConsistentOutputStream* stream) const;
+
   const data::mapping::ObjectToTreeMapper& objectToTreeMapper() const;
   const data::mapping::TreeToObjectMapper& treeToObjectMapper() const;
 
   data::mapping::ObjectToTreeMapper& objectToTreeMapper();
   data::mapping::TreeToObjectMapper& treeToObjectMapper();
 
+  const ObjectSerializer& objectSerializer() const;
+  ObjectSerializer& objectSerializer();
+
+  const ObjectDeserializer& objectDeserializer() const;
+  ObjectDeserializer& objectDeserializer();
+
   const SerializerConfig& serializerConfig() const;
   const DeserializerConfig& deserializerConfig() const;
 
@@ -0,0 +1,384 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ObjectSerializer.hpp"
+
+#include "oatpp/utils/Conversion.hpp"
+
+namespace oatpp { namespace json {
+
+bool ObjectSerializer::Resolved::isNull() const {
+  if(isTree) {
+    return tree.isNull();
+  }
+  if(!value) {
+    return true;
+  }
+  if(value.getValueType()->classId == data::type::__class::Tree::CLASS_ID) {
+    return static_cast<data::mapping::Tree*>(value.get())->isNull();
+  }
+  return false;
+}
+
+ObjectSerializer::ObjectSerializer() {
+
+  m_methods.resize(static_cast<size_t>(data::type::ClassId::getClassCount()), nullptr);
+
+  setSerializerMethod(data::type::__class::String::CLASS_ID, &ObjectSerializer::serializeString);
+  setSerializerMethod(data::type::__class::Tree::CLASS_ID, &ObjectSerializer::serializeTree);
+
+  setSerializerMethod(data::type::__class::Int8::CLASS_ID, &ObjectSerializer::serializePrimitive<oatpp::Int8>);
+  setSerializerMethod(data::type::__class::UInt8::CLASS_ID, &ObjectSerializer::serializePrimitive<oatpp::UInt8>);
+
+  setSerializerMethod(data::type::__class::Int16::CLASS_ID, &ObjectSerializer::serializePrimitive<oatpp::Int16>);
+  setSerializerMethod(data::type::__class::UInt16::CLASS_ID, &ObjectSerializer::serializePrimitive<oatpp::UInt16>);
+
+  setSerializerMethod(data::type::__class::Int32::CLASS_ID, &ObjectSerializer::serializePrimitive<oatpp::Int32>);
+  setSerializerMethod(data::type::__class::UInt32::CLASS_ID, &ObjectSerializer::serializePrimitive<oatpp::UInt32>);
+
+  setSerializerMethod(data::type::__class::Int64::CLASS_ID, &ObjectSerializer::serializePrimitive<oatpp::Int64>);
+  setSerializerMethod(data::type::__class::UInt64::CLASS_ID, &ObjectSerializer::serializePrimitive<oatpp::UInt64>);
+
+  setSerializerMethod(data::type::__class::Float32::CLASS_ID, &ObjectSerializer::serializePrimitive<oatpp::Float32>);
+  setSerializerMethod(data::type::__class::Float64::CLASS_ID, &ObjectSerializer::serializePrimitive<oatpp::Float64>);
+  setSerializerMethod(data::type::__class::Boolean::CLASS_ID, &ObjectSerializer::serializePrimitive<oatpp::Boolean>);
+
+  setSerializerMethod(data::type::__class::AbstractObject::CLASS_ID, &ObjectSerializer::serializeObject);
+
+  setSerializerMethod(data::type::__class::AbstractVector::CLASS_ID, &ObjectSerializer::serializeCollection);
+  setSerializerMethod(data::type::__class::AbstractList::CLASS_ID, &ObjectSerializer::serializeCollection);
+  setSerializerMethod(data::type::__class::AbstractUnorderedSet::CLASS_ID, &ObjectSerializer::serializeCollection);
+
+  setSerializerMethod(data::type::__class::AbstractPairList::CLASS_ID, &ObjectSerializer::serializeMap);
+  setSerializerMethod(data::type::__class::AbstractUnorderedMap::CLASS_ID, &ObjectSerializer::serializeMap);
+
+}
+
+void ObjectSerializer::setSerializerMethod(const data::type::ClassId& classId, SerializerMethod method) {
+  const auto id = static_cast<v_uint32>(classId.id);
+  if(id >= m_methods.size()) {
+    m_methods.resize(id + 1, nullptr);
+  }
+  m_methods[id] = method;
+}
+
+void ObjectSerializer::resolve(State& state, const oatpp::Void& polymorph, Resolved& result) const {
+
+  oatpp::Void value = polymorph;
+
+  while(true) {
+
+    const auto& classId = value.getValueType()->classId;
+
+    /* methods overridden on the tree mapper take precedence over the direct ones, Any and Enum included */
+    if(state.treeMapper != nullptr && state.treeMapper->hasCustomMapperMethod(classId)) {
+      break;
+    }
+
+    if(classId == data::type::__class::Any::CLASS_ID) {
+      if(!value) {
+        result.value = nullptr;
+        return;
+      }
+      auto anyHandle = static_cast<data::type::AnyHandle*>(value.get());
+      value = oatpp::Void(anyHandle->ptr, anyHandle->type);
+      continue;
+    }
+
+    if(classId == data::type::__class::AbstractEnum::CLASS_ID) {
+
+      auto polymorphicDispatcher = static_cast<const data::type::__class::AbstractEnum::PolymorphicDispatcher*>(
+        value.getValueType()->polymorphicDispatcher
+      );
+
+      data::type::EnumInterpreterError e = data::type::EnumInterpreterError::OK;
+      value = polymorphicDispatcher->toInterpretation(value, state.mapperConfig->useUnqualifiedEnumNames, e);
+
+      if(e == data::type::EnumInterpreterError::CONSTRAINT_NOT_NULL) {
+        state.errorStack.push("[oatpp::json::ObjectSerializer::resolve()]: Error. Enum constraint violated - 'NotNull'.");
+        return;
+      } else if(e != data::type::EnumInterpreterError::OK) {
+        state.errorStack.push("[oatpp::json::ObjectSerializer::resolve()]: Error. Can't serialize Enum.");
+        return;
+      }
+
+      continue;
+
+    }
+
+    auto id = static_cast<v_uint32>(classId.id);
+    if(id < m_methods.size() && m_methods[id] != nullptr) {
+      result.value = value;
+      return;
+    }
+
+    break;
+
+  }
+
+  /* no direct method or overridden one - fallback to the tree mapper (custom mapper methods, interpretations) */
+
+  if(state.treeMapper == nullptr) {
+    state.errorStack.push("[oatpp::json::ObjectSerializer::resolve()]: "
+                          "Error. No serialize method for type '" +
+                          oatpp::String(value.getValueType()->classId.name) + "'");
+    return;
+  }
+
+  data::mapping::ObjectToTreeMapper::State mapperState;
+  mapperState.config = state.mapperConfig;
+  mapperState.tree = &result.tree;
+
+  state.treeMapper->map(mapperState, value);
+  if(!mapperState.errorStack.empty()) {
+    state.errorStack.splice(mapperState.errorStack);
+    return;
+  }
+
+  result.isTree = true;
+
+}
+
+void ObjectSerializer::write(State& state, const Resolved& resolved) const {
+
+  if(resolved.isTree) {
+    Serializer::State jsonState;
+    jsonState.config = state.jsonConfig;
+    jsonState.tree = &resolved.tree;
+    jsonState.stream = state.stream;
+    Serializer::serialize(jsonState);
+    if(!jsonState.errorStack.empty()) {
+      state.errorStack.splice(jsonState.errorStack);
+    }
+    return;
+  }
+
+  if(!resolved.value) {
+    state.stream->writeSimple("null", 4);
+    return;
+  }
+
+  auto id = static_cast<v_uint32>(resolved.value.getValueType()->classId.id);
+  (*m_methods[id])(this, state, resolved.value);
+
+}
+
+bool ObjectSerializer::isDirectCollection(const Resolved& resolved) const {
+  if(resolved.isTree || !resolved.value) {
+    return false;
+  }
+  auto id = static_cast<v_uint32>(resolved.value.getValueType()->classId.id);
+  return m_methods[id] == &ObjectSerializer::serializeCollection;
+}
+
+void ObjectSerializer::serialize(State& state, const oatpp::Void& polymorph) const {
+  Resolved resolved;
+  resolve(state, polymorph, resolved);
+  if(!state.errorStack.empty()) {
+    return;
+  }
+  write(state, resolved);
+}
+
+void ObjectSerializer::serializeCollectionElement(State& state, const oatpp::Void& element, v_int64 elementIndex, v_int64& acceptedCount) const {
+
+  if(!element && !state.mapperConfig->includeNullFields && !state.mapperConfig->alwaysIncludeNullCollectionElements) {
+    return;
+  }
+
+  Resolved resolved;
+  resolve(state, element, resolved);
+
+  if(state.errorStack.empty() && (!resolved.isNull() || state.jsonConfig->includeNullElements)) {
+    if(acceptedCount > 0) state.stream->writeSimple(",", 1);
+    write(state, resolved);
+  }
+
+  if(!state.errorStack.empty()) {
+    state.errorStack.push("[oatpp::json::ObjectSerializer::serializeCollectionElement()]: index=" + utils::Conversion::int64ToStr(elementIndex));
+    return;
+  }
+
+  acceptedCount ++;
+
+}
+
+void ObjectSerializer::serializeString(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph) {
+  (void) serializer;
+  auto str = static_cast<std::string*>(polymorph.get());
+  Serializer::serializeString(state.stream, str->data(), static_cast<v_buff_size>(str->size()), state.jsonConfig->escapeFlags);
+}
+
+void ObjectSerializer::serializeTree(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph) {
+  (void) serializer;
+  Serializer::State jsonState;
+  jsonState.config = state.jsonConfig;
+  jsonState.tree = static_cast<data::mapping::Tree*>(polymorph.get());
+  jsonState.stream = state.stream;
+  Serializer::serialize(jsonState);
+  if(!jsonState.errorStack.empty()) {
+    state.errorStack.splice(jsonState.errorStack);
+  }
+}
+
+void ObjectSerializer::serializeCollection(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph) {
+
+  auto dispatcher = static_cast<const data::type::__class::Collection::PolymorphicDispatcher*>(
+    polymorph.getValueType()->polymorphicDispatcher
+  );
+
+  state.stream->writeCharSimple('[');
+
+  auto iterator = dispatcher->beginIteration(polymorph);
+  v_int64 index = 0;
+  v_int64 acceptedCount = 0;
+
+  while (!iterator->finished()) {
+    serializer->serializeCollectionElement(state, iterator->get(), index, acceptedCount);
+    if(!state.errorStack.empty()) {
+      return;
+    }
+    iterator->next();
+    index ++;
+  }
+
+  state.stream->writeCharSimple(']');
+
+}
+
+void ObjectSerializer::serializeMap(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph) {
+
+  auto dispatcher = static_cast<const data::type::__class::Map::PolymorphicDispatcher*>(
+    polymorph.getValueType()->polymorphicDispatcher
+  );
+
+  auto keyType = dispatcher->getKeyType();
+  if(keyType->classId != oatpp::String::Class::CLASS_ID){
+    state.errorStack.push("[oatpp::json::ObjectSerializer::serializeMap()]: Invalid map key. Key should be String");
+    return;
+  }
+
+  state.stream->writeCharSimple('{');
+
+  auto iterator = dispatcher->beginIteration(polymorph);
+  v_int64 acceptedCount = 0;
+
+  while (!iterator->finished()) {
+
+    const auto& value = iterator->getValue();
+
+    if(value || state.mapperConfig->includeNullFields || state.mapperConfig->alwaysIncludeNullCollectionElements) {
+
+      const auto& untypedKey = iterator->getKey();
+      const auto& key = oatpp::String(std::static_pointer_cast<std::string>(untypedKey.getPtr()));
+
+      Resolved resolved;
+      serializer->resolve(state, value, resolved);
+
+      if(state.errorStack.empty() && (!resolved.isNull() || state.jsonConfig->includeNullElements)) {
+        if(acceptedCount > 0) state.stream->writeSimple(",", 1);
+        Serializer::serializeString(state.stream, key->data(), static_cast<v_buff_size>(key->size()), state.jsonConfig->escapeFlags);
+        state.stream->writeCharSimple(':');
+        serializer->write(state, resolved);
+      }
+
+      if(!state.errorStack.empty()) {
+        state.errorStack.push("[oatpp::json::ObjectSerializer::serializeMap()]: key='" + key + "'");
+        return;
+      }
+
+      acceptedCount ++;
+
+    }
+
+    iterator->next();
+
+  }
+
+  state.stream->writeCharSimple('}');
+
+}
+
+void ObjectSerializer::serializeObject(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph) {
+
+  auto type = polymorph.getValueType();
+  auto dispatcher = static_cast<const oatpp::data::type::__class::AbstractObject::PolymorphicDispatcher*>(
+    type->polymorphicDispatcher
+  );
+  auto fields = dispatcher->getProperties()->getList();
+  auto object = static_cast<oatpp::BaseObject*>(polymorph.get());
+  auto config = state.mapperConfig;
+
+  state.stream->writeCharSimple('{');
+
+  v_int64 acceptedCount = 0;
+
+  for (auto const& field : fields) {
+
+    oatpp::Void value;
+    if(field->info.typeSelector && field->type == oatpp::Any::Class::getType()) {
+      const auto& any = field->get(object).cast<oatpp::Any>();
+      value = any.retrieve(field->info.typeSelector->selectType(object));
+    } else {
+      value = field->get(object);
+    }
+
+    const std::string& key = config->useUnqualifiedFieldNames ? field->unqualifiedName : field->name;
+
+    if(field->info.required && value == nullptr) {
+      state.errorStack.push("[oatpp::json::ObjectSerializer::serializeObject()]: "
+                            "Error. " + std::string(type->nameQualifier) + "::"
+                            + key + " is required!");
+      return;
+    }
+
+    if (value || config->includeNullFields || (field->info.required && config->alwaysIncludeRequired)) {
+
+      Resolved resolved;
+      serializer->resolve(state, value, resolved);
+
+      if(state.errorStack.empty() && (!resolved.isNull() || state.jsonConfig->includeNullElements)) {
+        if(acceptedCount > 0) state.stream->writeSimple(",", 1);
+        Serializer::serializeString(state.stream, key.data(), static_cast<v_buff_size>(key.size()), state.jsonConfig->escapeFlags);
+        state.stream->writeCharSimple(':');
+        serializer->write(state, resolved);
+      }
+
+      if(!state.errorStack.empty()) {
+        state.errorStack.push("[oatpp::json::ObjectSerializer::serializeObject()]: field='" + key + "'");
+        return;
+      }
+
+      acceptedCount ++;
+
+    }
+
+  }
+
+  state.stream->writeCharSimple('}');
+
+}
+
+}}
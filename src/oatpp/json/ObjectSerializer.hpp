@@ -0,0 +1,131 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_json_ObjectSerializer_hpp
+#define oatpp_json_ObjectSerializer_hpp
+
+#include "./Serializer.hpp"
+
+#include "oatpp/data/mapping/ObjectToTreeMapper.hpp"
+
+namespace oatpp { namespace json {
+
+/**
+ * Direct Object-to-JSON serializer. <br>
+ * Walks DTO `Type`/`Property` metadata and writes JSON tokens straight into the output stream
+ * without materializing intermediate &id:oatpp::data::mapping::Tree;. <br>
+ * Produces the same output as &id:oatpp::data::mapping::ObjectToTreeMapper; followed by &id:oatpp::json::Serializer;
+ * given the same configs. <br>
+ * Types which have no serializer method (custom types, interpretations), and types whose mapper method
+ * was overridden on `State::treeMapper`, are mapped with `State::treeMapper` and the resulting sub-tree is serialized.
+ */
+class ObjectSerializer : public base::Countable {
+public:
+
+  /**
+   * Serializer state.
+   */
+  struct State {
+
+    const data::mapping::ObjectToTreeMapper::Config* mapperConfig;
+    const Serializer::Config* jsonConfig;
+    const data::mapping::ObjectToTreeMapper* treeMapper;
+    data::stream::ConsistentOutputStream* stream;
+
+    data::mapping::ErrorStack errorStack;
+
+  };
+
+public:
+  typedef void (*SerializerMethod)(const ObjectSerializer*, State&, const oatpp::Void&);
+private:
+
+  /*
+   * Holds either the value to serialize or the tree it was mapped to.
+   */
+  struct Resolved {
+    oatpp::Void value;
+    data::mapping::Tree tree;
+    bool isTree = false;
+    bool isNull() const;
+  };
+
+public:
+
+  template<class T>
+  static void serializePrimitive(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph){
+    (void) serializer;
+    state.stream->writeAsString(* static_cast<typename T::ObjectType*>(polymorph.get()));
+  }
+
+  static void serializeString(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph);
+  static void serializeTree(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph);
+
+  static void serializeCollection(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph);
+  static void serializeMap(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph);
+
+  static void serializeObject(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph);
+
+private:
+  std::vector<SerializerMethod> m_methods;
+private:
+  void resolve(State& state, const oatpp::Void& polymorph, Resolved& result) const;
+  void write(State& state, const Resolved& resolved) const;
+  bool isDirectCollection(const Resolved& resolved) const;
+private:
+  friend class SerializingReadCallback;
+public:
+
+  ObjectSerializer();
+
+  /**
+   * Set serializer method for class. Method is called for non-null values only.
+   * @param classId
+   * @param method
+   */
+  void setSerializerMethod(const data::type::ClassId& classId, SerializerMethod method);
+
+  /**
+   * Serialize value to `state.stream`. Beautifier is not applied here.
+   * @param state
+   * @param polymorph
+   */
+  void serialize(State& state, const oatpp::Void& polymorph) const;
+
+  /**
+   * Serialize one element of a collection. Used to serialize collections element by element. <br>
+   * Mirrors element filtering of the Tree-based path.
+   * @param state
+   * @param element - collection element.
+   * @param elementIndex - index of the element in the collection (used in error messages).
+   * @param acceptedCount - in/out. Number of elements accepted so far. Used to place separators.
+   */
+  void serializeCollectionElement(State& state, const oatpp::Void& element, v_int64 elementIndex, v_int64& acceptedCount) const;
+
+};
+
+}}
+
+#endif // oatpp_json_ObjectSerializer_hpp
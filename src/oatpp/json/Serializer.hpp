@@ -89,22 +89,32 @@ public:
 
 private:
 
-  
-  static void serializeString(oatpp::data::stream::ConsistentOutputStream* stream,
-                              const char* data,
-                              v_buff_size size,
-                              v_uint32 escapeFlags);
-
   static void serializeNull(State& state);
   static void serializeString(State& state);
   static void serializeArray(State& state);
   static void serializeMap(State& state);
   static void serializePairs(State& state);
 
-  static void serialize(State& state);
-
 public:
 
+  /**
+   * Escape and write string value in quotes.
+   * @param stream - output stream.
+   * @param data - string data.
+   * @param size - string size.
+   * @param escapeFlags - see &id:oatpp::json::Utils::escapeString;.
+   */
+  static void serializeString(oatpp::data::stream::ConsistentOutputStream* stream,
+                              const char* data,
+                              v_buff_size size,
+                              v_uint32 escapeFlags);
+
+  /**
+   * Serialize `state.tree` to `state.stream` as is - no beautifier is applied.
+   * @param state
+   */
+  static void serialize(State& state);
+
   static void serializeToStream(data::stream::ConsistentOutputStream* stream, State& state);
 
 };
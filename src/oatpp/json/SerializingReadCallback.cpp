@@ -0,0 +1,157 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "SerializingReadCallback.hpp"
+
+#include "oatpp/base/Log.hpp"
+
+#include <cstring>
+
+namespace oatpp { namespace json {
+
+SerializingReadCallback::SerializingReadCallback(const std::shared_ptr<ObjectMapper>& objectMapper,
+                                                 const oatpp::Void& object,
+                                                 v_buff_size chunkSize)
+  : m_objectMapper(objectMapper)
+  , m_object(object)
+  , m_chunkSize(chunkSize)
+  , m_buffer(chunkSize + 1024)
+  , m_elementIndex(0)
+  , m_acceptedCount(0)
+  , m_readPosition(0)
+  , m_stage(STAGE_BEGIN)
+{
+  if(m_objectMapper->serializerConfig().json.useBeautifier) {
+    m_beautifier = std::make_unique<Beautifier>(&m_buffer, "  ", "\n");
+    m_objectMapper->initObjectSerializerState(m_state, m_beautifier.get());
+  } else {
+    m_objectMapper->initObjectSerializerState(m_state, &m_buffer);
+  }
+}
+
+bool SerializingReadCallback::fillBuffer() {
+
+  const auto& serializer = m_objectMapper->objectSerializer();
+
+  while(m_stage != STAGE_DONE && m_buffer.getCurrentPosition() < m_chunkSize) {
+
+    switch (m_stage) {
+
+      case STAGE_BEGIN: {
+
+        /* same dispatch as for nested values - Any, Enum and overridden mapper methods are resolved first */
+        ObjectSerializer::Resolved resolved;
+        serializer.resolve(m_state, m_object, resolved);
+        if(!m_state.errorStack.empty()) {
+          break;
+        }
+
+        if(serializer.isDirectCollection(resolved)) {
+          m_object = resolved.value;
+          auto dispatcher = static_cast<const data::type::__class::Collection::PolymorphicDispatcher*>(
+            m_object.getValueType()->polymorphicDispatcher
+          );
+          m_iterator = dispatcher->beginIteration(m_object);
+          m_state.stream->writeCharSimple('[');
+          m_stage = STAGE_ELEMENTS;
+        } else {
+          serializer.write(m_state, resolved);
+          m_stage = STAGE_DONE;
+        }
+        break;
+
+      }
+
+      case STAGE_ELEMENTS: {
+        if(m_iterator->finished()) {
+          m_stage = STAGE_END;
+          break;
+        }
+        serializer.serializeCollectionElement(m_state, m_iterator->get(), m_elementIndex, m_acceptedCount);
+        m_iterator->next();
+        m_elementIndex ++;
+        break;
+      }
+
+      case STAGE_END: {
+        m_state.stream->writeCharSimple(']');
+        m_iterator.reset();
+        m_stage = STAGE_DONE;
+        break;
+      }
+
+      default:
+        break;
+
+    }
+
+    if(!m_state.errorStack.empty()) {
+      return false;
+    }
+
+  }
+
+  return true;
+
+}
+
+v_io_size SerializingReadCallback::read(void *buffer, v_buff_size count, async::Action& action) {
+
+  (void) action;
+
+  if(m_readPosition >= m_buffer.getCurrentPosition()) {
+
+    m_buffer.setCurrentPosition(0);
+    m_readPosition = 0;
+
+    if(m_stage == STAGE_DONE) {
+      return 0;
+    }
+
+    if(!fillBuffer()) {
+      OATPP_LOGe("[oatpp::json::SerializingReadCallback::read()]", "Error. Serialization failed:\n{}", *m_state.errorStack.stacktrace())
+      m_stage = STAGE_DONE;
+      return oatpp::IOError::BROKEN_PIPE;
+    }
+
+    if(m_buffer.getCurrentPosition() == 0) {
+      return 0;
+    }
+
+  }
+
+  v_buff_size size = m_buffer.getCurrentPosition() - m_readPosition;
+  if(size > count) {
+    size = count;
+  }
+
+  std::memcpy(buffer, m_buffer.getData() + m_readPosition, static_cast<size_t>(size));
+  m_readPosition += size;
+
+  return size;
+
+}
+
+}}
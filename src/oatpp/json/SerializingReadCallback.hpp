@@ -0,0 +1,94 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_json_SerializingReadCallback_hpp
+#define oatpp_json_SerializingReadCallback_hpp
+
+#include "./ObjectMapper.hpp"
+
+#include "oatpp/data/stream/BufferStream.hpp"
+
+namespace oatpp { namespace json {
+
+/**
+ * ReadCallback which serializes object to JSON on demand. <br>
+ * Top-level collections are serialized element by element so that large arrays are never fully buffered. <br>
+ * Other values are serialized at once on first read. <br>
+ * Use it with &id:oatpp::web::protocol::http::outgoing::StreamingBody; to send object as chunked body. <br>
+ * Output is the same as of &id:oatpp::json::ObjectMapper::write;.
+ */
+class SerializingReadCallback : public data::stream::ReadCallback {
+public:
+  static constexpr v_buff_size DEFAULT_CHUNK_SIZE = 16 * 1024;
+private:
+
+  enum Stage : v_int32 {
+    STAGE_BEGIN = 0,
+    STAGE_ELEMENTS = 1,
+    STAGE_END = 2,
+    STAGE_DONE = 3
+  };
+
+private:
+  std::shared_ptr<ObjectMapper> m_objectMapper;
+  oatpp::Void m_object;
+  v_buff_size m_chunkSize;
+private:
+  data::stream::BufferOutputStream m_buffer;
+  std::unique_ptr<Beautifier> m_beautifier;
+  ObjectSerializer::State m_state;
+  std::unique_ptr<data::type::__class::Collection::Iterator> m_iterator;
+  v_int64 m_elementIndex;
+  v_int64 m_acceptedCount;
+  v_buff_size m_readPosition;
+  v_int32 m_stage;
+private:
+  bool fillBuffer();
+public:
+
+  /**
+   * Constructor.
+   * @param objectMapper - &id:oatpp::json::ObjectMapper;. Its serializer config is used.
+   * @param object - object to serialize.
+   * @param chunkSize - approximate size of data serialized per iteration.
+   */
+  SerializingReadCallback(const std::shared_ptr<ObjectMapper>& objectMapper,
+                          const oatpp::Void& object,
+                          v_buff_size chunkSize = DEFAULT_CHUNK_SIZE);
+
+  /**
+   * Read next portion of serialized JSON.
+   * @param buffer - pointer to buffer.
+   * @param count - size of the buffer in bytes.
+   * @param action - async specific action. Not used.
+   * @return - actual number of bytes written to buffer. 0 - to indicate end-of-file. &id:oatpp::IOError::BROKEN_PIPE; on serialization error.
+   */
+  v_io_size read(void *buffer, v_buff_size count, async::Action& action) override;
+
+};
+
+}}
+
+#endif // oatpp_json_SerializingReadCallback_hpp
@@ -75,9 +75,17 @@ private:
   static v_buff_size calcEscapedStringSize(const char* data, v_buff_size size, v_buff_size& safeSize, v_uint32 flags);
   static v_buff_size calcUnescapedStringSize(const char* data, v_buff_size size, v_int64& errorCode, v_buff_size& errorPosition);
   static void unescapeStringToBuffer(const char* data, v_buff_size size, p_char8 resultData);
-  static const char* preparseString(ParsingCaret& caret, v_buff_size& size);
 public:
 
+  /**
+   * Find boundaries of the json string at caret without unescaping it. <br>
+   * Caret is moved past the opening quote only.
+   * @param caret - &id:oatpp::utils::parser::Caret;.
+   * @param size - out. Size of the string data in bytes (escaped).
+   * @return - pointer to the string data (right after the opening quote) or `nullptr` on error.
+   */
+  static const char* preparseString(ParsingCaret& caret, v_buff_size& size);
+
   /**
    * Escape string as for json standard. <br>
    * *Note:* if(copyAsOwnData == false && escapedString == initialString) then result string will point to initial data.
@@ -27,6 +27,7 @@
 
 #include "ConnectionProvider.hpp"
 #include "oatpp/provider/Pool.hpp"
+#include "oatpp/provider/ShardedPool.hpp"
 
 namespace oatpp { namespace network {
 
@@ -42,6 +43,7 @@ struct ConnectionAcquisitionProxy : public provider::AcquisitionProxy<data::stre
   {}
 
   v_io_size write(const void *buff, v_buff_size count, async::Action& action) override;
+  v_io_size writev(const data::buffer::InlineWriteData* buffers, v_int32 count, async::Action& action) override;
   v_io_size read(void *buff, v_buff_size count, async::Action& action) override;
 
   void setOutputStreamIOMode(oatpp::data::stream::IOMode ioMode) override;
@@ -67,6 +69,25 @@ typedef oatpp::provider::Pool<
   oatpp::network::ConnectionAcquisitionProxy
 > ServerConnectionPool;
 
+/**
+ * Sharded LIFO pool of client connections - &id:oatpp::provider::ShardedPool;. <br>
+ * Use instead of &l:ClientConnectionPool; when many threads acquire connections concurrently.
+ */
+typedef oatpp::provider::ShardedPool<
+  oatpp::network::ClientConnectionProvider,
+  oatpp::data::stream::IOStream,
+  oatpp::network::ConnectionAcquisitionProxy
+> ShardedClientConnectionPool;
+
+/**
+ * Sharded LIFO pool of server connections - &id:oatpp::provider::ShardedPool;.
+ */
+typedef oatpp::provider::ShardedPool<
+  oatpp::network::ServerConnectionProvider,
+  oatpp::data::stream::IOStream,
+  oatpp::network::ConnectionAcquisitionProxy
+> ShardedServerConnectionPool;
+
 
 }}
 
@@ -0,0 +1,127 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "MultiListenerServer.hpp"
+
+#include "oatpp/concurrency/Utils.hpp"
+#include "oatpp/utils/Conversion.hpp"
+#include "oatpp/base/Log.hpp"
+
+namespace oatpp { namespace network {
+
+const char* const MultiListenerServer::PARAM_LISTENER_INDEX = "listener_index";
+
+const v_int32 MultiListenerServer::STATUS_CREATED = 0;
+const v_int32 MultiListenerServer::STATUS_RUNNING = 1;
+const v_int32 MultiListenerServer::STATUS_STOPPING = 2;
+const v_int32 MultiListenerServer::STATUS_DONE = 3;
+
+MultiListenerServer::MultiListenerServer(const std::vector<std::shared_ptr<ConnectionProvider>>& connectionProviders,
+                                         const std::shared_ptr<ConnectionHandler>& connectionHandler,
+                                         bool pinListenerThreads)
+  : m_status(STATUS_CREATED)
+  , m_connectionHandler(connectionHandler)
+  , m_pinListenerThreads(pinListenerThreads)
+{
+
+  if(connectionProviders.empty()) {
+    throw std::runtime_error("[oatpp::network::MultiListenerServer::MultiListenerServer()]: Error. No connection providers specified.");
+  }
+
+  m_listeners.reserve(connectionProviders.size());
+  for(size_t i = 0; i < connectionProviders.size(); i ++) {
+    auto params = std::make_shared<ConnectionHandler::ParameterMap>();
+    params->insert({PARAM_LISTENER_INDEX, oatpp::utils::Conversion::uint64ToStr(i)});
+    m_listeners.push_back({connectionProviders[i], params});
+  }
+
+}
+
+MultiListenerServer::~MultiListenerServer() {
+  stop();
+}
+
+void MultiListenerServer::listenerLoop(v_uint32 index) {
+
+  const auto& listener = m_listeners[index];
+
+  while (getStatus() == STATUS_RUNNING) {
+
+    auto connectionHandle = listener.provider->get();
+
+    if (connectionHandle) {
+      if (getStatus() == STATUS_RUNNING) {
+        m_connectionHandler->handleConnection(connectionHandle, listener.params);
+      } else {
+        OATPP_LOGd("[oatpp::network::MultiListenerServer::listenerLoop()]", "Error. Server already stopped - closing connection...")
+      }
+    }
+
+  }
+
+}
+
+void MultiListenerServer::run() {
+
+  v_int32 expected = STATUS_CREATED;
+  if(!m_status.compare_exchange_strong(expected, STATUS_RUNNING)) {
+    throw std::runtime_error("[oatpp::network::MultiListenerServer::run()]: Error. Server can be started only once.");
+  }
+
+  v_int32 cpusCount = oatpp::concurrency::Utils::getHardwareConcurrency();
+
+  std::vector<std::thread> threads;
+  threads.reserve(m_listeners.size());
+
+  for(v_uint32 i = 0; i < m_listeners.size(); i ++) {
+    threads.emplace_back(&MultiListenerServer::listenerLoop, this, i);
+    if(m_pinListenerThreads && cpusCount > 0) {
+      v_int32 cpu = static_cast<v_int32>(i % static_cast<v_uint32>(cpusCount));
+      oatpp::concurrency::Utils::setThreadAffinityToOneCpu(threads.back().native_handle(), cpu);
+    }
+  }
+
+  for(auto& thread : threads) {
+    thread.join();
+  }
+
+  m_status.store(STATUS_DONE);
+
+}
+
+void MultiListenerServer::stop() {
+  v_int32 expected = STATUS_RUNNING;
+  m_status.compare_exchange_strong(expected, STATUS_STOPPING);
+}
+
+v_int32 MultiListenerServer::getStatus() {
+  return m_status.load();
+}
+
+v_int32 MultiListenerServer::getListenersCount() const {
+  return static_cast<v_int32>(m_listeners.size());
+}
+
+}}
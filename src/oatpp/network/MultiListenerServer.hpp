@@ -0,0 +1,166 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_network_MultiListenerServer_hpp
+#define oatpp_network_MultiListenerServer_hpp
+
+#include "oatpp/network/ConnectionHandler.hpp"
+#include "oatpp/network/ConnectionProvider.hpp"
+
+#include "oatpp/Types.hpp"
+
+#include "oatpp/base/Countable.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace oatpp { namespace network {
+
+/**
+ * Server with multiple listeners. <br>
+ * Runs a separate accept loop (thread) for each &id:oatpp::network::ConnectionProvider; and passes
+ * obtained connections to the shared &id:oatpp::network::ConnectionHandler;. <br>
+ * Each connection is passed together with the &l:MultiListenerServer::PARAM_LISTENER_INDEX; parameter
+ * so that the connection handler can keep connections accepted by the same listener on the same worker. <br>
+ * Typically used with the group of TCP providers bound with `SO_REUSEPORT` -
+ * see &id:oatpp::network::tcp::server::ConnectionProvider::createSharedGroup;.
+ */
+class MultiListenerServer : public base::Countable {
+public:
+
+  /**
+   * Name of the connection parameter which holds the index of the listener accepted the connection.
+   */
+  static const char* const PARAM_LISTENER_INDEX;
+
+public:
+
+  /**
+   * Status constant.
+   */
+  static const v_int32 STATUS_CREATED;
+
+  /**
+   * Status constant.
+   */
+  static const v_int32 STATUS_RUNNING;
+
+  /**
+   * Status constant.
+   */
+  static const v_int32 STATUS_STOPPING;
+
+  /**
+   * Status constant.
+   */
+  static const v_int32 STATUS_DONE;
+
+private:
+
+  struct Listener {
+    std::shared_ptr<ConnectionProvider> provider;
+    std::shared_ptr<const ConnectionHandler::ParameterMap> params;
+  };
+
+private:
+  void listenerLoop(v_uint32 index);
+private:
+  std::atomic<v_int32> m_status;
+  std::vector<Listener> m_listeners;
+  std::shared_ptr<ConnectionHandler> m_connectionHandler;
+  bool m_pinListenerThreads;
+public:
+
+  /**
+   * Constructor.
+   * @param connectionProviders - listeners. &id:oatpp::network::ConnectionProvider;.
+   * @param connectionHandler - &id:oatpp::network::ConnectionHandler;.
+   * @param pinListenerThreads - if `true` the thread of the listener with index `i` is pinned to
+   * the CPU `i % <number of CPUs>`.
+   */
+  MultiListenerServer(const std::vector<std::shared_ptr<ConnectionProvider>>& connectionProviders,
+                      const std::shared_ptr<ConnectionHandler>& connectionHandler,
+                      bool pinListenerThreads = false);
+
+  /**
+   * Virtual destructor.
+   */
+  virtual ~MultiListenerServer() override;
+
+  /**
+   * Create shared MultiListenerServer.
+   * @tparam ProviderType - type of connection provider.
+   * @param connectionProviders - listeners. &id:oatpp::network::ConnectionProvider;.
+   * @param connectionHandler - &id:oatpp::network::ConnectionHandler;.
+   * @param pinListenerThreads - if `true` the thread of the listener with index `i` is pinned to
+   * the CPU `i % <number of CPUs>`.
+   * @return - `std::shared_ptr` to MultiListenerServer.
+   */
+  template<class ProviderType>
+  static std::shared_ptr<MultiListenerServer> createShared(const std::vector<std::shared_ptr<ProviderType>>& connectionProviders,
+                                                           const std::shared_ptr<ConnectionHandler>& connectionHandler,
+                                                           bool pinListenerThreads = false)
+  {
+    std::vector<std::shared_ptr<ConnectionProvider>> providers(connectionProviders.begin(), connectionProviders.end());
+    return std::make_shared<MultiListenerServer>(providers, connectionHandler, pinListenerThreads);
+  }
+
+  /**
+   * Start accept loops (one thread per listener) and block until all of them are finished. <br>
+   * Accept loops are finished after &l:MultiListenerServer::stop (); is called.
+   */
+  void run();
+
+  /**
+   * Break accept loops. <br>
+   * Note: &l:MultiListenerServer::run (); can still be blocked for a while as listeners
+   * may be waiting for ConnectionProvider to provide connection.
+   */
+  void stop();
+
+  /**
+   * Get server status.
+   * @return - one of:<br>
+   * <ul>
+   *   <li>&l:MultiListenerServer::STATUS_CREATED;</li>
+   *   <li>&l:MultiListenerServer::STATUS_RUNNING;</li>
+   *   <li>&l:MultiListenerServer::STATUS_STOPPING;</li>
+   *   <li>&l:MultiListenerServer::STATUS_DONE;</li>
+   * </ul>
+   */
+  v_int32 getStatus();
+
+  /**
+   * Get number of listeners.
+   * @return - number of listeners.
+   */
+  v_int32 getListenersCount() const;
+
+};
+
+}}
+
+#endif /* oatpp_network_MultiListenerServer_hpp */
@@ -24,6 +24,8 @@
 
 #include "ConnectionInactivityChecker.hpp"
 
+#include <algorithm>
+
 namespace oatpp { namespace network { namespace monitor {
 
 ConnectionInactivityChecker::ConnectionInactivityChecker(const std::chrono::duration<v_int64, std::micro>& lastReadTimeout,
@@ -60,4 +62,22 @@ bool ConnectionInactivityChecker::check(const ConnectionStats& stats, v_int64 cu
   return  goodRead && goodWrite;
 }
 
+v_int64 ConnectionInactivityChecker::getNextCheckTimePoint(const ConnectionStats& stats, v_int64 currMicroTime) {
+
+  (void) currMicroTime;
+
+  v_int64 lastRead = stats.timestampLastRead;
+  if(lastRead == 0) {
+    lastRead = stats.timestampCreated;
+  }
+
+  v_int64 lastWrite = stats.timestampLastWrite;
+  if(lastWrite == 0) {
+    lastWrite = stats.timestampCreated;
+  }
+
+  return std::min(lastRead + m_lastReadTimeout.count(), lastWrite + m_lastWriteTimeout.count());
+
+}
+
 }}}
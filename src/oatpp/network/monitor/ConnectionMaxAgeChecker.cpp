@@ -43,4 +43,9 @@ bool ConnectionMaxAgeChecker::check(const ConnectionStats& stats, v_int64 currMi
   return currMicroTime - stats.timestampCreated < m_maxAge.count();
 }
 
+v_int64 ConnectionMaxAgeChecker::getNextCheckTimePoint(const ConnectionStats& stats, v_int64 currMicroTime) {
+  (void) currMicroTime;
+  return stats.timestampCreated + m_maxAge.count();
+}
+
 }}}
@@ -51,6 +51,8 @@ public:
 
   bool check(const ConnectionStats& stats, v_int64 currMicroTime) override;
 
+  v_int64 getNextCheckTimePoint(const ConnectionStats& stats, v_int64 currMicroTime) override;
+
 };
 
 }}}
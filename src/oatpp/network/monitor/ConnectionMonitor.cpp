@@ -27,6 +27,7 @@
 #include "oatpp/base/Log.hpp"
 
 #include <chrono>
+#include <limits>
 #include <thread>
 
 namespace oatpp { namespace network { namespace monitor {
@@ -71,15 +72,19 @@ ConnectionMonitor::ConnectionProxy::~ConnectionProxy() {
 
 v_io_size ConnectionMonitor::ConnectionProxy::read(void *buffer, v_buff_size count, async::Action& action) {
   auto res = m_connectionHandle.object->read(buffer, count, action);
-  std::lock_guard<std::mutex> lock(m_statsMutex);
-  m_monitor->onConnectionRead(m_stats, res);
+  m_monitor->onConnectionRead(this, res);
   return res;
 }
 
 v_io_size ConnectionMonitor::ConnectionProxy::write(const void *data, v_buff_size count, async::Action& action) {
   auto res = m_connectionHandle.object->write(data, count, action);
-  std::lock_guard<std::mutex> lock(m_statsMutex);
-  m_monitor->onConnectionWrite(m_stats, res);
+  m_monitor->onConnectionWrite(this, res);
+  return res;
+}
+
+v_io_size ConnectionMonitor::ConnectionProxy::writev(const data::buffer::InlineWriteData* buffers, v_int32 count, async::Action& action) {
+  auto res = m_connectionHandle.object->writev(buffers, count, action);
+  m_monitor->onConnectionWrite(this, res);
   return res;
 }
 
@@ -116,31 +121,25 @@ void ConnectionMonitor::Monitor::monitorTask(std::shared_ptr<Monitor> monitor) {
 
   while(monitor->m_running) {
 
-    {
+    v_int64 waitMicroseconds = monitor->m_checkGranularity;
 
+    {
       std::lock_guard<std::mutex> lock(monitor->m_connectionsMutex);
-
       auto currMicroTime = oatpp::Environment::getMicroTickCount();
-
-      for(auto& caddr : monitor->m_connections) {
-
-        auto connection = reinterpret_cast<ConnectionProxy*>(caddr);
-        std::lock_guard<std::mutex> dataLock(connection->m_statsMutex);
-        std::lock_guard<std::mutex> analysersLock(monitor->m_checkMutex);
-
-        for(auto& a : monitor->m_metricsCheckers) {
-          bool res = a->check(connection->m_stats, currMicroTime);
-          if(!res) {
-            connection->invalidate();
-            break;
-          }
-        }
-
+      monitor->m_checkWheel.advance(currMicroTime, [&monitor, currMicroTime](ConnectionProxy* connection) {
+        monitor->checkConnection(connection, currMicroTime);
+      });
+      /* wake up right at the next tick boundary when something is due, so checks are late by at most one tick */
+      auto nextTimePoint = monitor->m_checkWheel.getNextTimePointMicroseconds();
+      if(nextTimePoint - currMicroTime < waitMicroseconds) {
+        waitMicroseconds = nextTimePoint > currMicroTime ? nextTimePoint - currMicroTime : 0;
       }
-
     }
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+    std::unique_lock<std::mutex> runLock(monitor->m_runMutex);
+    monitor->m_runCondition.wait_for(runLock, std::chrono::microseconds(waitMicroseconds), [&monitor]{
+      return !monitor->m_running;
+    });
 
   }
 
@@ -165,8 +164,62 @@ void* ConnectionMonitor::Monitor::createOrGetMetricData(ConnectionStats& stats,
   return data;
 }
 
-std::shared_ptr<ConnectionMonitor::Monitor> ConnectionMonitor::Monitor::createShared() {
-  auto monitor = std::make_shared<Monitor>();
+void ConnectionMonitor::Monitor::updateStatCollectorsSnapshot() {
+  auto collectors = std::make_shared<StatCollectors>();
+  collectors->reserve(m_statCollectors.size());
+  for(auto& pair : m_statCollectors) {
+    collectors->push_back(pair.second);
+  }
+  m_hasStatCollectors = !collectors->empty();
+  std::atomic_store(&m_statCollectorsSnapshot, std::shared_ptr<const StatCollectors>(collectors));
+}
+
+void ConnectionMonitor::Monitor::scheduleCheck(ConnectionProxy* connection, v_int64 currMicroTime) {
+
+  if(m_metricsCheckers.empty()) {
+    return;
+  }
+
+  v_int64 timePoint = std::numeric_limits<v_int64>::max();
+  for(auto& checker : m_metricsCheckers) {
+    auto checkerTimePoint = checker->getNextCheckTimePoint(connection->m_stats, currMicroTime);
+    if(checkerTimePoint < timePoint) {
+      timePoint = checkerTimePoint;
+    }
+  }
+
+  if(timePoint < std::numeric_limits<v_int64>::max()) {
+    m_checkWheel.add(connection, timePoint);
+  }
+
+}
+
+void ConnectionMonitor::Monitor::checkConnection(ConnectionProxy* connection, v_int64 currMicroTime) {
+
+  std::lock_guard<std::mutex> dataLock(connection->m_statsMutex);
+  std::lock_guard<std::mutex> analysersLock(m_checkMutex);
+
+  for(auto& a : m_metricsCheckers) {
+    bool res = a->check(connection->m_stats, currMicroTime);
+    if(!res) {
+      connection->invalidate();
+      return;
+    }
+  }
+
+  /* the connection may have been active since it was scheduled - find out when it's due next */
+  scheduleCheck(connection, currMicroTime);
+
+}
+
+ConnectionMonitor::Monitor::Monitor(v_int64 checkGranularity)
+  : m_checkGranularity(checkGranularity > 0 ? checkGranularity : 1)
+  , m_checkWheel(m_checkGranularity, oatpp::Environment::getMicroTickCount())
+  , m_statCollectorsSnapshot(std::make_shared<StatCollectors>())
+{}
+
+std::shared_ptr<ConnectionMonitor::Monitor> ConnectionMonitor::Monitor::createShared(const std::chrono::duration<v_int64, std::micro>& checkGranularity) {
+  auto monitor = std::make_shared<Monitor>(checkGranularity.count());
   std::thread t([monitor](){
     ConnectionMonitor::Monitor::monitorTask(monitor);
   });
@@ -177,6 +230,8 @@ std::shared_ptr<ConnectionMonitor::Monitor> ConnectionMonitor::Monitor::createSh
 void ConnectionMonitor::Monitor::addConnection(ConnectionProxy* connection) {
   std::lock_guard<std::mutex> lock(m_connectionsMutex);
   m_connections.insert(reinterpret_cast<v_uint64>(connection));
+  std::lock_guard<std::mutex> checkLock(m_checkMutex);
+  scheduleCheck(connection, oatpp::Environment::getMicroTickCount());
 }
 
 void ConnectionMonitor::Monitor::freeConnectionStats(ConnectionStats& stats) {
@@ -198,6 +253,7 @@ void ConnectionMonitor::Monitor::freeConnectionStats(ConnectionStats& stats) {
 void ConnectionMonitor::Monitor::removeConnection(v_uint64 id) {
   std::lock_guard<std::mutex> lock(m_connectionsMutex);
   m_connections.erase(id);
+  m_checkWheel.remove(reinterpret_cast<ConnectionProxy*>(id));
 }
 
 void ConnectionMonitor::Monitor::invalidateAll() {
@@ -211,15 +267,20 @@ void ConnectionMonitor::Monitor::invalidateAll() {
 void ConnectionMonitor::Monitor::addStatCollector(const std::shared_ptr<StatCollector>& collector) {
   std::lock_guard<std::mutex> lock(m_checkMutex);
   m_statCollectors.insert({collector->metricName(), collector});
+  updateStatCollectorsSnapshot();
 }
 
 void ConnectionMonitor::Monitor::removeStatCollector(const oatpp::String& metricName) {
   std::lock_guard<std::mutex> lock(m_checkMutex);
   m_statCollectors.erase(metricName);
+  updateStatCollectorsSnapshot();
 }
 
 void ConnectionMonitor::Monitor::addMetricsChecker(const std::shared_ptr<MetricsChecker>& checker) {
+
+  std::lock_guard<std::mutex> connectionsLock(m_connectionsMutex);
   std::lock_guard<std::mutex> lock(m_checkMutex);
+
   m_metricsCheckers.push_back(checker);
   auto metrics = checker->getMetricsList();
   for(auto& m : metrics) {
@@ -228,11 +289,20 @@ void ConnectionMonitor::Monitor::addMetricsChecker(const std::shared_ptr<Metrics
       m_statCollectors.insert({m, checker->createStatCollector(m)});
     }
   }
+  updateStatCollectorsSnapshot();
+
+  /* existing connections are checked against the new rule on the next tick */
+  auto currMicroTime = oatpp::Environment::getMicroTickCount();
+  for(v_uint64 caddr : m_connections) {
+    m_checkWheel.add(reinterpret_cast<ConnectionProxy*>(caddr), currMicroTime);
+  }
+
 }
 
-void ConnectionMonitor::Monitor::onConnectionRead(ConnectionStats& stats, v_io_size readResult) {
+void ConnectionMonitor::Monitor::onConnectionRead(ConnectionProxy* connection, v_io_size readResult) {
 
   v_int64 currTimestamp = oatpp::Environment::getMicroTickCount();
+  auto& stats = connection->m_stats;
 
   if(readResult > 0) {
     stats.totalRead += readResult;
@@ -240,18 +310,20 @@ void ConnectionMonitor::Monitor::onConnectionRead(ConnectionStats& stats, v_io_s
     stats.timestampLastRead = currTimestamp;
   }
 
-  {
-    std::lock_guard<std::mutex> lock(m_checkMutex);
-    for(auto& pair : m_statCollectors) {
-      pair.second->onRead(createOrGetMetricData(stats, pair.second), readResult, currTimestamp);
+  if(m_hasStatCollectors) {
+    auto collectors = std::atomic_load(&m_statCollectorsSnapshot);
+    std::lock_guard<std::mutex> lock(connection->m_statsMutex);
+    for(auto& collector : *collectors) {
+      collector->onRead(createOrGetMetricData(stats, collector), readResult, currTimestamp);
     }
   }
 
 }
 
-void ConnectionMonitor::Monitor::onConnectionWrite(ConnectionStats& stats, v_io_size writeResult) {
+void ConnectionMonitor::Monitor::onConnectionWrite(ConnectionProxy* connection, v_io_size writeResult) {
 
   v_int64 currTimestamp = oatpp::Environment::getMicroTickCount();
+  auto& stats = connection->m_stats;
 
   if(writeResult > 0) {
     stats.totalWrite += writeResult;
@@ -259,18 +331,20 @@ void ConnectionMonitor::Monitor::onConnectionWrite(ConnectionStats& stats, v_io_
     stats.timestampLastWrite = currTimestamp;
   }
 
-  {
-    std::lock_guard<std::mutex> lock(m_checkMutex);
-    for(auto& pair : m_statCollectors) {
-      pair.second->onWrite(createOrGetMetricData(stats, pair.second), writeResult, currTimestamp);
+  if(m_hasStatCollectors) {
+    auto collectors = std::atomic_load(&m_statCollectorsSnapshot);
+    std::lock_guard<std::mutex> lock(connection->m_statsMutex);
+    for(auto& collector : *collectors) {
+      collector->onWrite(createOrGetMetricData(stats, collector), writeResult, currTimestamp);
     }
   }
 
 }
 
 void ConnectionMonitor::Monitor::stop() {
-  m_running = false;
   std::unique_lock<std::mutex> runLock(m_runMutex);
+  m_running = false;
+  m_runCondition.notify_all();
   while(!m_stopped) {
     m_runCondition.wait(runLock);
   }
@@ -279,9 +353,10 @@ void ConnectionMonitor::Monitor::stop() {
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // ConnectionMonitor
 
-ConnectionMonitor::ConnectionMonitor(const std::shared_ptr<ConnectionProvider>& connectionProvider)
+ConnectionMonitor::ConnectionMonitor(const std::shared_ptr<ConnectionProvider>& connectionProvider,
+                                     const std::chrono::duration<v_int64, std::micro>& checkGranularity)
   : m_invalidator(std::make_shared<ConnectionInvalidator>())
-  , m_monitor(Monitor::createShared())
+  , m_monitor(Monitor::createShared(checkGranularity))
   , m_connectionProvider(connectionProvider)
 {
   m_properties = m_connectionProvider->getProperties();
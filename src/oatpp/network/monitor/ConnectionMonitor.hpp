@@ -29,6 +29,7 @@
 
 #include "oatpp/network/ConnectionProvider.hpp"
 #include "oatpp/data/stream/Stream.hpp"
+#include "oatpp/async/utils/TimingWheel.hpp"
 
 #include <unordered_set>
 #include <condition_variable>
@@ -37,7 +38,9 @@ namespace oatpp { namespace network { namespace monitor {
 
 /**
  * ConnectionMonitor is a middleman who's able to manage provided connections
- * and close those ones that are not satisfy selected rules.
+ * and close those ones that are not satisfy selected rules. <br>
+ * Connections are indexed by their nearest check time point (see &id:oatpp::network::monitor::MetricsChecker::getNextCheckTimePoint;),
+ * so on each tick the monitor visits only connections that are due.
  */
 class ConnectionMonitor : public ClientConnectionProvider, public ServerConnectionProvider {
 private:
@@ -69,6 +72,7 @@ private:
 
     v_io_size read(void *buffer, v_buff_size count, async::Action& action) override;
     v_io_size write(const void *data, v_buff_size count, async::Action& action) override;
+    v_io_size writev(const data::buffer::InlineWriteData* buffers, v_int32 count, async::Action& action) override;
 
     void setInputStreamIOMode(data::stream::IOMode ioMode) override;
     data::stream::IOMode getInputStreamIOMode() override;
@@ -85,6 +89,8 @@ private:
 private:
 
   class Monitor : public oatpp::base::Countable {
+  private:
+    typedef std::vector<std::shared_ptr<StatCollector>> StatCollectors;
   private:
 
     std::mutex m_runMutex;
@@ -92,20 +98,33 @@ private:
     std::atomic<bool> m_running {true};
     bool m_stopped {false};
 
+    v_int64 m_checkGranularity;
+
     std::mutex m_connectionsMutex;
     std::unordered_set<v_uint64> m_connections;
+    async::utils::TimingWheel<ConnectionProxy> m_checkWheel;
 
     std::mutex m_checkMutex;
     std::vector<std::shared_ptr<MetricsChecker>> m_metricsCheckers;
     std::unordered_map<oatpp::String, std::shared_ptr<StatCollector>> m_statCollectors;
 
+    /* copy of m_statCollectors for connection I/O. Accessed via std::atomic_load/std::atomic_store */
+    std::shared_ptr<const StatCollectors> m_statCollectorsSnapshot;
+    std::atomic<bool> m_hasStatCollectors {false};
+
   private:
     static void monitorTask(std::shared_ptr<Monitor> monitor);
   private:
     static void* createOrGetMetricData(ConnectionStats& stats, const std::shared_ptr<StatCollector>& collector);
+  private:
+    void updateStatCollectorsSnapshot();
+    void scheduleCheck(ConnectionProxy* connection, v_int64 currMicroTime);
+    void checkConnection(ConnectionProxy* connection, v_int64 currMicroTime);
   public:
 
-    static std::shared_ptr<Monitor> createShared();
+    Monitor(v_int64 checkGranularity);
+
+    static std::shared_ptr<Monitor> createShared(const std::chrono::duration<v_int64, std::micro>& checkGranularity);
 
     void addConnection(ConnectionProxy* connection);
     void freeConnectionStats(ConnectionStats& stats);
@@ -118,8 +137,8 @@ private:
 
     void addMetricsChecker(const std::shared_ptr<MetricsChecker>& checker);
 
-    void onConnectionRead(ConnectionStats& stats, v_io_size readResult);
-    void onConnectionWrite(ConnectionStats& stats, v_io_size writeResult);
+    void onConnectionRead(ConnectionProxy* connection, v_io_size readResult);
+    void onConnectionWrite(ConnectionProxy* connection, v_io_size writeResult);
 
     void stop();
 
@@ -134,8 +153,11 @@ public:
   /**
    * Constructor.
    * @param connectionProvider - underlying connection provider.
+   * @param checkGranularity - how often the monitor wakes up to check connections that are due.
+   * Connections are closed not later than `checkGranularity` after they stop satisfying the rules.
    */
-  ConnectionMonitor(const std::shared_ptr<ConnectionProvider>& connectionProvider);
+  ConnectionMonitor(const std::shared_ptr<ConnectionProvider>& connectionProvider,
+                    const std::chrono::duration<v_int64, std::micro>& checkGranularity = std::chrono::milliseconds(100));
 
   provider::ResourceHandle<data::stream::IOStream> get() override;
 
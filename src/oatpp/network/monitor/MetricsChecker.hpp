@@ -64,6 +64,20 @@ public:
    */
   virtual bool check(const ConnectionStats& stats, v_int64 currMicroTime) = 0;
 
+  /**
+   * Called by &id:oatpp::network::monitor::ConnectionMonitor; after a successful check
+   * to find out when the connection has to be checked again. <br>
+   * Connections are not visited by the monitor until their nearest check time point comes.
+   * Default implementation returns `currMicroTime` - connection is checked on every monitor tick.
+   * @param stats - &id:oatpp::network::monitor::ConnectionStats;.
+   * @param currMicroTime - current time microseconds.
+   * @return - time point microseconds when the connection may stop satisfying the rule.
+   */
+  virtual v_int64 getNextCheckTimePoint(const ConnectionStats& stats, v_int64 currMicroTime) {
+    (void) stats;
+    return currMicroTime;
+  }
+
 };
 
 }}}
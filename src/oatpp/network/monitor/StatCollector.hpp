@@ -28,10 +28,13 @@
 #include "oatpp/Types.hpp"
 #include "oatpp/IODefinitions.hpp"
 
+#include <atomic>
+
 namespace oatpp { namespace network { namespace monitor {
 
 /**
- * ConnectionStats.
+ * ConnectionStats. <br>
+ * Basic counters are atomic so that connection reads and writes update them without locking.
  */
 struct ConnectionStats {
 
@@ -39,39 +42,39 @@ struct ConnectionStats {
    * Timestamp created microseconds.
    * When connection was created.
    */
-  v_int64 timestampCreated = 0;
+  std::atomic<v_int64> timestampCreated{0};
 
   /**
    * Total bytes read from the connection.
    * Logs all bytes when the `read` method is called.
    */
-  v_io_size totalRead = 0;
+  std::atomic<v_io_size> totalRead{0};
 
   /**
    * Total bytes written to the connection.
    * Logs all bytes when the `write` method is called.
    */
-  v_io_size totalWrite = 0;
+  std::atomic<v_io_size> totalWrite{0};
 
   /**
    * Timestamp microseconds when the last successful read was performed on the connection.
    */
-  v_int64 timestampLastRead = 0;
+  std::atomic<v_int64> timestampLastRead{0};
 
   /**
    * Timestamp microseconds when the last successful write was performed on the connection.
    */
-  v_int64 timestampLastWrite = 0;
+  std::atomic<v_int64> timestampLastWrite{0};
 
   /**
    * Amount of bytes read during the last successful read.
    */
-  v_io_size lastReadSize = 0;
+  std::atomic<v_io_size> lastReadSize{0};
 
   /**
    * Amount of bytes written during the last successful write.
    */
-  v_io_size lastWriteSize = 0;
+  std::atomic<v_io_size> lastWriteSize{0};
 
   /**
    * Data collected by stat-collectors - &l:StatCollector;
@@ -30,8 +30,14 @@
 #else
   #include <unistd.h>
   #include <sys/socket.h>
+  #include <sys/uio.h>
 #endif
 
+#if defined(__linux__)
+  #include <sys/sendfile.h>
+#endif
+
+#include <cstring>
 #include <thread>
 #include <chrono>
 #include <fcntl.h>
@@ -72,6 +78,11 @@ Connection::Connection(v_io_handle handle)
 
 }
 
+Connection::Connection(v_io_handle handle, data::stream::IOMode ioMode)
+  : m_handle(handle)
+  , m_mode(ioMode)
+{}
+
 Connection::~Connection(){
   close();
 }
@@ -147,6 +158,67 @@ v_io_size Connection::write(const void *buff, v_buff_size count, async::Action&
 
 }
 
+v_io_size Connection::writev(const data::buffer::InlineWriteData* buffers, v_int32 count, async::Action& action) {
+
+#if defined(WIN32) || defined(_WIN32)
+
+  return OutputStream::writev(buffers, count, action);
+
+#else
+
+  iovec iov[MAX_WRITEV_BUFFERS];
+  v_int32 iovCount = 0;
+
+  for(v_int32 i = 0; i < count && iovCount < MAX_WRITEV_BUFFERS; i ++) {
+    if(buffers[i].bytesLeft > 0) {
+      iov[iovCount].iov_base = const_cast<void*>(buffers[i].currBufferPtr);
+      iov[iovCount].iov_len = static_cast<size_t>(buffers[i].bytesLeft);
+      iovCount ++;
+    }
+  }
+
+  if(iovCount == 0) {
+    return 0;
+  }
+
+  msghdr message;
+  std::memset(&message, 0, sizeof(message));
+  message.msg_iov = iov;
+  message.msg_iovlen = static_cast<decltype(message.msg_iovlen)>(iovCount);
+
+  errno = 0;
+  v_int32 flags = 0;
+
+#ifdef MSG_NOSIGNAL
+  flags |= MSG_NOSIGNAL;
+#endif
+
+  auto result = ::sendmsg(m_handle, &message, flags);
+
+  if(result < 0) {
+    auto e = errno;
+
+    bool retry = ((e == EAGAIN) || (e == EWOULDBLOCK));
+
+    if(retry){
+      if(m_mode == data::stream::ASYNCHRONOUS) {
+        action = oatpp::async::Action::createIOWaitAction(m_handle, oatpp::async::Action::IOEventType::IO_EVENT_WRITE);
+      }
+      return IOError::RETRY_WRITE; // For async io. In case socket is non-blocking
+    }
+
+    if(e == EINTR) {
+      return IOError::RETRY_WRITE;
+    }
+
+    return IOError::BROKEN_PIPE; // Consider all other errors as a broken pipe.
+  }
+  return result;
+
+#endif
+
+}
+
 #ifdef __GNUC__
 #pragma GCC diagnostic pop
 #endif
@@ -156,6 +228,68 @@ v_io_size Connection::write(const void *buff, v_buff_size count, async::Action&
 #pragma GCC diagnostic ignored "-Wlogical-op"
 #endif
 
+v_io_size Connection::sendFile(v_io_handle fileHandle, v_int64 offset, v_buff_size count, async::Action& action) {
+
+#if defined(__linux__)
+
+  errno = 0;
+  off_t fileOffset = offset;
+  auto result = ::sendfile(m_handle, fileHandle, &fileOffset, static_cast<size_t>(count));
+
+  if(result < 0) {
+    auto e = errno;
+
+    bool retry = ((e == EAGAIN) || (e == EWOULDBLOCK));
+
+    if(retry){
+      if(m_mode == data::stream::ASYNCHRONOUS) {
+        action = oatpp::async::Action::createIOWaitAction(m_handle, oatpp::async::Action::IOEventType::IO_EVENT_WRITE);
+      }
+      return IOError::RETRY_WRITE; // For async io. In case socket is non-blocking
+    }
+
+    if(e == EINTR) {
+      return IOError::RETRY_WRITE;
+    }
+
+    return IOError::BROKEN_PIPE; // Consider all other errors as a broken pipe.
+  }
+
+  if(result == 0 && count > 0) {
+    return IOError::BROKEN_PIPE; // File is shorter than expected
+  }
+
+  return result;
+
+#else
+
+  (void) fileHandle;
+  (void) offset;
+  (void) count;
+  (void) action;
+  return IOError::BROKEN_PIPE;
+
+#endif
+
+}
+
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+
+bool Connection::isSendFileSupported() {
+#if defined(__linux__)
+  return true;
+#else
+  return false;
+#endif
+}
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wlogical-op"
+#endif
+
 v_io_size Connection::read(void *buff, v_buff_size count, async::Action& action){
 
 #if defined(WIN32) || defined(_WIN32)
@@ -249,6 +383,11 @@ void Connection::setStreamIOMode(oatpp::data::stream::IOMode ioMode) {
 #else
 void Connection::setStreamIOMode(oatpp::data::stream::IOMode ioMode) {
 
+  /* handlers set the mode on every connection - don't touch the socket if it's already there */
+  if(ioMode == m_mode) {
+    return;
+  }
+
   auto flags = fcntl(m_handle, F_GETFL);
   if (flags < 0) {
     throw std::runtime_error("[oatpp::network::tcp::Connection::setStreamIOMode()]: Error. Can't get socket flags.");
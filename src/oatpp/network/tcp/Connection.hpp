@@ -35,6 +35,7 @@ namespace oatpp { namespace network { namespace tcp {
 class Connection : public oatpp::base::Countable, public oatpp::data::stream::IOStream {
 private:
   static oatpp::data::stream::DefaultInitializedContext DEFAULT_CONTEXT;
+  static constexpr v_int32 MAX_WRITEV_BUFFERS = 16;
 private:
   v_io_handle m_handle;
   data::stream::IOMode m_mode;
@@ -46,6 +47,15 @@ public:
    * @param handle - file descriptor (socket handle). See &id:oatpp::v_io_handle;.
    */
   Connection(v_io_handle handle);
+
+  /**
+   * Constructor. <br>
+   * Use when the I/O mode of the socket is known - ex.: it was accepted with `accept4()` flags.
+   * Saves a syscall otherwise needed to query the socket flags.
+   * @param handle - file descriptor (socket handle). See &id:oatpp::v_io_handle;.
+   * @param ioMode - current I/O mode of the socket. &id:oatpp::data::stream::IOMode;.
+   */
+  Connection(v_io_handle handle, data::stream::IOMode ioMode);
 public:
 
   /**
@@ -64,6 +74,35 @@ public:
    */
   v_io_size write(const void *buff, v_buff_size count, async::Action& action) override;
 
+  /**
+   * Implementation of &id:oatpp::data::stream::OutputStream::writev;. <br>
+   * Write up to 16 buffers with one `sendmsg` call.
+   * @param buffers - array of &id:oatpp::data::buffer::InlineWriteData;.
+   * @param count - number of buffers in the array.
+   * @param action - async specific action. If action is NOT &id:oatpp::async::Action::TYPE_NONE;, then
+   * caller MUST return this action on coroutine iteration.
+   * @return - actual amount of bytes written. See &id:oatpp::v_io_size;.
+   */
+  v_io_size writev(const data::buffer::InlineWriteData* buffers, v_int32 count, async::Action& action) override;
+
+  /**
+   * Send file data directly to the socket with `sendfile()` - without copying it to the user space. <br>
+   * Supported on Linux only. See &l:Connection::isSendFileSupported ();.
+   * @param fileHandle - file descriptor of the file opened for reading.
+   * @param offset - offset in the file to start sending from. File position is not changed.
+   * @param count - max number of bytes to send.
+   * @param action - async specific action. If action is NOT &id:oatpp::async::Action::TYPE_NONE;, then
+   * caller MUST return this action on coroutine iteration.
+   * @return - actual amount of bytes sent. See &id:oatpp::v_io_size;.
+   */
+  v_io_size sendFile(v_io_handle fileHandle, v_int64 offset, v_buff_size count, async::Action& action);
+
+  /**
+   * Check if &l:Connection::sendFile (); is supported on this platform.
+   * @return - `true` if supported.
+   */
+  static bool isSendFileSupported();
+
   /**
    * Implementation of &id:oatpp::data::stream::IOStream::read;.
    * @param buff - buffer to read data to.
@@ -44,6 +44,20 @@ public:
    * @param connection
    */
   virtual void configure(oatpp::v_io_handle handle) = 0;
+
+  /**
+   * Configure the listening (accept) socket of the server &id:oatpp::network::tcp::server::ConnectionProvider;. <br>
+   * Called once when the configurer is set to the provider. Many socket options (ex.: `TCP_NODELAY`, buffer sizes)
+   * set on the listening socket are inherited by accepted sockets - setting them here instead of in &l:ConnectionConfigurer::configure ();
+   * saves syscalls on every accepted connection.
+   * @param handle - listening socket handle.
+   * @return - `true` if accepted connections inherit all the options and &l:ConnectionConfigurer::configure (); doesn't have to be called for them.
+   * Default implementation does nothing and returns `false`.
+   */
+  virtual bool configureListener(oatpp::v_io_handle handle) {
+    (void) handle;
+    return false;
+  }
 };
 
 }}}
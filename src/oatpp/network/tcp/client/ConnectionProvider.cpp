@@ -40,11 +40,54 @@
   #include <netdb.h>
   #include <arpa/inet.h>
   #include <sys/socket.h>
+  #include <poll.h>
   #include <unistd.h>
 #endif
 
 namespace oatpp { namespace network { namespace tcp { namespace client {
 
+namespace {
+
+void closeSocket(v_io_handle handle) {
+#if defined(WIN32) || defined(_WIN32)
+  ::closesocket(handle);
+#else
+  ::close(handle);
+#endif
+}
+
+v_int32 getLastSocketError() {
+#if defined(WIN32) || defined(_WIN32)
+  return WSAGetLastError();
+#else
+  return errno;
+#endif
+}
+
+bool isConnectInProgress(v_int32 error) {
+#if defined(WIN32) || defined(_WIN32)
+  return error == WSAEWOULDBLOCK || error == WSAEINPROGRESS;
+#else
+  return error == EINPROGRESS;
+#endif
+}
+
+void setNonBlocking(v_io_handle handle, bool nonBlocking) {
+#if defined(WIN32) || defined(_WIN32)
+  u_long flags = nonBlocking ? 1 : 0;
+  ioctlsocket(handle, FIONBIO, &flags);
+#else
+  auto flags = fcntl(handle, F_GETFL);
+  fcntl(handle, F_SETFL, nonBlocking ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK));
+#endif
+}
+
+const sockaddr* getSocketAddress(const Resolver::Endpoint& endpoint) {
+  return reinterpret_cast<const sockaddr*>(endpoint.address);
+}
+
+}
+
 void ConnectionProvider::ConnectionInvalidator::invalidate(const std::shared_ptr<data::stream::IOStream>& connection) {
 
   /************************************************
@@ -70,8 +113,9 @@ void ConnectionProvider::ConnectionInvalidator::invalidate(const std::shared_ptr
 
 }
 
-ConnectionProvider::ConnectionProvider(const network::Address& address)
+ConnectionProvider::ConnectionProvider(const network::Address& address, const std::shared_ptr<Resolver>& resolver)
   : m_invalidator(std::make_shared<ConnectionInvalidator>())
+  , m_resolver(resolver ? resolver : Resolver::getDefault())
   , m_address(address)
 {
   setProperty(PROPERTY_HOST, address.host);
@@ -80,74 +124,123 @@ ConnectionProvider::ConnectionProvider(const network::Address& address)
 
 provider::ResourceHandle<data::stream::IOStream> ConnectionProvider::get() {
 
-  auto portStr = oatpp::utils::Conversion::int32ToStr(m_address.port);
+  std::shared_ptr<const Resolver::Endpoints> endpoints;
+  try {
+    endpoints = m_resolver->resolve(m_address);
+  } catch (const std::runtime_error& e) {
+    throw std::runtime_error(std::string("[oatpp::network::tcp::client::ConnectionProvider::getConnection()]. ") + e.what());
+  }
 
-  addrinfo hints;
+  std::vector<pollfd> attempts;
+  size_t nextEndpoint = 0;
+  v_int64 nextAttemptTime = 0;
+  oatpp::v_io_handle clientHandle = INVALID_IO_HANDLE;
+  v_int32 err = 0;
 
-  memset(&hints, 0, sizeof(addrinfo));
-  hints.ai_socktype = SOCK_STREAM;
-  hints.ai_flags = 0;
-  hints.ai_protocol = 0;
+  while(clientHandle == INVALID_IO_HANDLE) {
 
-  switch(m_address.family) {
-    case Address::IP_4: hints.ai_family = AF_INET; break;
-    case Address::IP_6: hints.ai_family = AF_INET6; break;
-    case Address::UNSPEC:
-    default:
-      hints.ai_family = AF_UNSPEC;
-  }
+    auto now = oatpp::Environment::getMicroTickCount();
+
+    if(nextEndpoint < endpoints->size() && (attempts.empty() || now >= nextAttemptTime)) {
+
+      const auto& endpoint = endpoints->at(nextEndpoint ++);
+
+      auto handle = socket(endpoint.socketFamily, endpoint.socketType, endpoint.protocol);
+      if(!isValidIOHandle(handle)) {
+        err = getLastSocketError();
+        continue;
+      }
+
+      setNonBlocking(handle, true);
+
+      if(connect(handle, getSocketAddress(endpoint), endpoint.addressLength) == 0) {
+        clientHandle = handle;
+        break;
+      }
+
+      auto error = getLastSocketError();
+      if(!isConnectInProgress(error)) {
+        err = error;
+        closeSocket(handle);
+        nextAttemptTime = 0;
+        continue;
+      }
+
+      pollfd attempt;
+      attempt.fd = handle;
+      attempt.events = POLLOUT;
+      attempt.revents = 0;
+      attempts.push_back(attempt);
+      nextAttemptTime = now + CONNECTION_ATTEMPT_DELAY_MICROSECONDS;
+      continue;
+
+    }
 
-  addrinfo* result;
-  auto res = getaddrinfo(m_address.host->c_str(), portStr->c_str(), &hints, &result);
+    if(attempts.empty()) {
+      break;
+    }
+
+    int timeout = -1;
+    if(nextEndpoint < endpoints->size()) {
+      timeout = static_cast<int>((nextAttemptTime - now + 999) / 1000);
+    }
 
-  if (res != 0) {
 #if defined(WIN32) || defined(_WIN32)
-    throw std::runtime_error("[oatpp::network::tcp::client::ConnectionProvider::getConnection()]. "
-                             "Error. Call to getaddrinfo() failed with code " + std::to_string(res));
+    auto res = WSAPoll(attempts.data(), static_cast<ULONG>(attempts.size()), timeout);
 #else
-    std::string errorString = "[oatpp::network::tcp::client::ConnectionProvider::getConnection()]. Error. Call to getaddrinfo() failed: ";
-	  throw std::runtime_error(errorString.append(gai_strerror(res)));
+    auto res = ::poll(attempts.data(), attempts.size(), timeout);
 #endif
-  }
 
-  if (result == nullptr) {
-    throw std::runtime_error("[oatpp::network::tcp::client::ConnectionProvider::getConnection()]. Error. Call to getaddrinfo() returned no results.");
-  }
-
-  addrinfo* currResult = result;
-  oatpp::v_io_handle clientHandle = INVALID_IO_HANDLE;
-  int err = 0;
-
-  while(currResult != nullptr) {
+    if(res < 0) {
+      auto error = getLastSocketError();
+#if !defined(WIN32) && !defined(_WIN32)
+      if(error == EINTR) {
+        continue;
+      }
+#endif
+      err = error;
+      break;
+    }
 
-    clientHandle = socket(currResult->ai_family, currResult->ai_socktype, currResult->ai_protocol);
+    for(auto it = attempts.begin(); it != attempts.end();) {
 
-    if(clientHandle >= 0) {
+      if(it->revents == 0) {
+        it ++;
+        continue;
+      }
 
-      if(connect(clientHandle, currResult->ai_addr, currResult->ai_addrlen) == 0) {
-        break;
-      } else {
-          err = errno;
+      int error = 0;
+      v_sock_size errorSize = sizeof(int);
 #if defined(WIN32) || defined(_WIN32)
-		    ::closesocket(clientHandle);
+      getsockopt(it->fd, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &errorSize);
 #else
-        ::close(clientHandle);
+      getsockopt(it->fd, SOL_SOCKET, SO_ERROR, &error, &errorSize);
 #endif
+
+      if(error == 0 && clientHandle == INVALID_IO_HANDLE) {
+        clientHandle = it->fd;
+      } else {
+        err = error;
+        closeSocket(it->fd);
+        nextAttemptTime = 0;
       }
+      it = attempts.erase(it);
 
     }
 
-    currResult = currResult->ai_next;
-
   }
 
-  freeaddrinfo(result);
+  for(auto& attempt : attempts) {
+    closeSocket(attempt.fd);
+  }
 
-  if(currResult == nullptr) {
+  if(clientHandle == INVALID_IO_HANDLE) {
     throw std::runtime_error("[oatpp::network::tcp::client::ConnectionProvider::getConnection()]: Error. Can't connect: " +
                                  std::string(strerror(err)));
   }
 
+  setNonBlocking(clientHandle, false);
+
 #ifdef SO_NOSIGPIPE
   int yes = 1;
   v_int32 ret = setsockopt(clientHandle, SOL_SOCKET, SO_NOSIGPIPE, &yes, sizeof(int));
@@ -168,67 +261,37 @@ oatpp::async::CoroutineStarterForResult<const provider::ResourceHandle<data::str
   class ConnectCoroutine : public oatpp::async::CoroutineWithResult<ConnectCoroutine, const provider::ResourceHandle<oatpp::data::stream::IOStream>&> {
   private:
     std::shared_ptr<ConnectionInvalidator> m_connectionInvalidator;
+    std::shared_ptr<Resolver> m_resolver;
     network::Address m_address;
     oatpp::v_io_handle m_clientHandle;
   private:
-    addrinfo* m_result;
-    addrinfo* m_currentResult;
+    std::shared_ptr<const Resolver::Endpoints> m_endpoints;
+    size_t m_currentEndpoint;
     bool m_isHandleOpened;
   public:
 
     ConnectCoroutine(const std::shared_ptr<ConnectionInvalidator>& connectionInvalidator,
+                     const std::shared_ptr<Resolver>& resolver,
                      const network::Address& address)
       : m_connectionInvalidator(connectionInvalidator)
+      , m_resolver(resolver)
       , m_address(address)
-      , m_result(nullptr)
-      , m_currentResult(nullptr)
+      , m_clientHandle(INVALID_IO_HANDLE)
+      , m_currentEndpoint(0)
       , m_isHandleOpened(false)
     {}
 
-    ~ConnectCoroutine() override {
-      if(m_result != nullptr) {
-        freeaddrinfo(m_result);
-      }
-    }
-
     Action act() override {
+      return m_resolver->resolveAsync(m_address).callbackTo(&ConnectCoroutine::onResolved);
+    }
 
-      auto portStr = oatpp::utils::Conversion::int32ToStr(m_address.port);
-
-      addrinfo hints;
-
-      memset(&hints, 0, sizeof(addrinfo));
-      hints.ai_socktype = SOCK_STREAM;
-      hints.ai_flags = 0;
-      hints.ai_protocol = 0;
-
-      switch(m_address.family) {
-        case Address::IP_4: hints.ai_family = AF_INET; break;
-        case Address::IP_6: hints.ai_family = AF_INET6; break;
-        case Address::UNSPEC:
-        default:
-          hints.ai_family = AF_UNSPEC;
-      }
-
-      // TODO make call to get addrinfo non-blocking !!!
-      auto res = getaddrinfo(m_address.host->c_str(), portStr->c_str(), &hints, &m_result);
-      if (res != 0) {
-        return error<async::Error>(
-          "[oatpp::network::tcp::client::ConnectionProvider::getConnectionAsync()]. Error. Call to getaddrinfo() failed.");
-      }
-
-      m_currentResult = m_result;
-
-      if (m_result == nullptr) {
-        return error<async::Error>(
-          "[oatpp::network::tcp::client::ConnectionProvider::getConnectionAsync()]. Error. Call to getaddrinfo() returned no results.");
-      }
-
-      return yieldTo(&ConnectCoroutine::iterateAddrInfoResults);
-
+    Action onResolved(const std::shared_ptr<const Resolver::Endpoints>& endpoints) {
+      m_endpoints = endpoints;
+      m_currentEndpoint = 0;
+      return yieldTo(&ConnectCoroutine::iterateEndpoints);
     }
 
-    Action iterateAddrInfoResults() {
+    Action iterateEndpoints() {
 
       /*
        * Close previously opened socket here.
@@ -244,24 +307,16 @@ oatpp::async::CoroutineStarterForResult<const provider::ResourceHandle<data::str
 
       }
 
-      if(m_currentResult != nullptr) {
+      if(m_currentEndpoint < m_endpoints->size()) {
 
-        m_clientHandle = socket(m_currentResult->ai_family, m_currentResult->ai_socktype, m_currentResult->ai_protocol);
+        const auto& endpoint = m_endpoints->at(m_currentEndpoint);
+        m_clientHandle = socket(endpoint.socketFamily, endpoint.socketType, endpoint.protocol);
 
-#if defined(WIN32) || defined(_WIN32)
-        if (m_clientHandle == INVALID_SOCKET) {
-          m_currentResult = m_currentResult->ai_next;
+        if (!isValidIOHandle(m_clientHandle)) {
+          m_currentEndpoint ++;
           return repeat();
         }
-        u_long flags = 1;
-        ioctlsocket(m_clientHandle, FIONBIO, &flags);
-#else
-        if (m_clientHandle < 0) {
-          m_currentResult = m_currentResult->ai_next;
-          return repeat();
-        }
-        fcntl(m_clientHandle, F_SETFL, O_NONBLOCK);
-#endif
+        setNonBlocking(m_clientHandle, true);
 
 #ifdef SO_NOSIGPIPE
         int yes = 1;
@@ -283,7 +338,8 @@ oatpp::async::CoroutineStarterForResult<const provider::ResourceHandle<data::str
     Action doConnect() {
       errno = 0;
 
-      auto res = connect(m_clientHandle, m_currentResult->ai_addr, m_currentResult->ai_addrlen);
+      const auto& endpoint = m_endpoints->at(m_currentEndpoint);
+      auto res = connect(m_clientHandle, getSocketAddress(endpoint), endpoint.addressLength);
 
 #if defined(WIN32) || defined(_WIN32)
 
@@ -320,14 +376,14 @@ oatpp::async::CoroutineStarterForResult<const provider::ResourceHandle<data::str
 
 #endif
 
-      m_currentResult = m_currentResult->ai_next;
-      return yieldTo(&ConnectCoroutine::iterateAddrInfoResults);
+      m_currentEndpoint ++;
+      return yieldTo(&ConnectCoroutine::iterateEndpoints);
 
     }
 
   };
 
-  return ConnectCoroutine::startForResult(m_invalidator, m_address);
+  return ConnectCoroutine::startForResult(m_invalidator, m_resolver, m_address);
 
 }
 
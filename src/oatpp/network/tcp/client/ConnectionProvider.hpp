@@ -25,6 +25,8 @@
 #ifndef oatpp_netword_tcp_client_ConnectionProvider_hpp
 #define oatpp_netword_tcp_client_ConnectionProvider_hpp
 
+#include "./Resolver.hpp"
+
 #include "oatpp/network/Address.hpp"
 
 #include "oatpp/network/ConnectionProvider.hpp"
@@ -34,9 +36,18 @@
 namespace oatpp { namespace network { namespace tcp { namespace client {
 
 /**
- * Simple provider of clinet TCP connections.
+ * Simple provider of clinet TCP connections. <br>
+ * Host names are resolved via &id:oatpp::network::tcp::client::Resolver;.
  */
 class ConnectionProvider : public ClientConnectionProvider {
+public:
+
+  /**
+   * Delay before starting connection attempt to the next endpoint while previous attempts are still in progress
+   * (happy eyeballs, RFC 8305). Used by &l:ConnectionProvider::get ();.
+   */
+  static constexpr v_int64 CONNECTION_ATTEMPT_DELAY_MICROSECONDS = 250 * 1000;
+
 private:
 
   class ConnectionInvalidator : public provider::Invalidator<data::stream::IOStream> {
@@ -48,23 +59,27 @@ private:
 
 private:
   std::shared_ptr<ConnectionInvalidator> m_invalidator;
+  std::shared_ptr<Resolver> m_resolver;
 protected:
   network::Address m_address;
 public:
   /**
    * Constructor.
    * @param address - &id:oatpp::network::Address;.
+   * @param resolver - &id:oatpp::network::tcp::client::Resolver;. If `nullptr` - default resolver is used.
    */
-  ConnectionProvider(const network::Address& address);
+  ConnectionProvider(const network::Address& address, const std::shared_ptr<Resolver>& resolver = nullptr);
 public:
 
   /**
    * Create shared client ConnectionProvider.
    * @param address - &id:oatpp::network::Address;.
+   * @param resolver - &id:oatpp::network::tcp::client::Resolver;. If `nullptr` - default resolver is used.
    * @return - `std::shared_ptr` to ConnectionProvider.
    */
-  static std::shared_ptr<ConnectionProvider> createShared(const network::Address& address){
-    return std::make_shared<ConnectionProvider>(address);
+  static std::shared_ptr<ConnectionProvider> createShared(const network::Address& address,
+                                                          const std::shared_ptr<Resolver>& resolver = nullptr){
+    return std::make_shared<ConnectionProvider>(address, resolver);
   }
 
   /**
@@ -75,13 +90,16 @@ public:
   }
 
   /**
-   * Get connection.
+   * Get connection. <br>
+   * Connection attempts to resolved endpoints are raced happy-eyeballs style -
+   * next attempt starts after &l:ConnectionProvider::CONNECTION_ATTEMPT_DELAY_MICROSECONDS; or as soon as previous attempt fails.
    * @return - `std::shared_ptr` to &id:oatpp::data::stream::IOStream;.
    */
   provider::ResourceHandle<data::stream::IOStream> get() override;
 
   /**
-   * Get connection in asynchronous manner.
+   * Get connection in asynchronous manner. <br>
+   * Address is resolved without blocking the processor. Endpoints are tried one by one in happy-eyeballs order.
    * @return - &id:oatpp::async::CoroutineStarterForResult;.
    */
   oatpp::async::CoroutineStarterForResult<const provider::ResourceHandle<data::stream::IOStream>&> getAsync() override;
@@ -93,6 +111,14 @@ public:
   const network::Address& getAddress() const {
     return m_address;
   }
+
+  /**
+   * Get resolver - &id:oatpp::network::tcp::client::Resolver;.
+   * @return
+   */
+  const std::shared_ptr<Resolver>& getResolver() const {
+    return m_resolver;
+  }
   
 };
   
@@ -0,0 +1,399 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "./Resolver.hpp"
+
+#include "oatpp/utils/Conversion.hpp"
+
+#include <string.h>
+
+#if defined(WIN32) || defined(_WIN32)
+  #include <winsock2.h>
+  #include <ws2tcpip.h>
+#else
+  #include <netdb.h>
+  #include <arpa/inet.h>
+  #include <sys/socket.h>
+#endif
+
+namespace oatpp { namespace network { namespace tcp { namespace client {
+
+Resolver::Lookup::Lookup(const Address& pAddress, const std::string& pKey)
+  : address(pAddress)
+  , key(pKey)
+  , ready(false)
+  , expiresAt(0)
+{
+  waitList.setListener(this);
+}
+
+void Resolver::Lookup::onNewItem(async::CoroutineWaitList& list) {
+  if(ready.load(std::memory_order_acquire)) {
+    list.notifyAll();
+  }
+}
+
+Resolver::Resolver(const Config& config)
+  : m_config(config)
+  , m_running(true)
+{}
+
+Resolver::~Resolver() {
+  stop();
+}
+
+std::shared_ptr<Resolver> Resolver::createShared(const Config& config) {
+  return std::make_shared<Resolver>(config);
+}
+
+std::shared_ptr<Resolver> Resolver::getDefault() {
+  static std::shared_ptr<Resolver> resolver = createShared();
+  return resolver;
+}
+
+std::string Resolver::makeKey(const Address& address) {
+  std::string key = address.host ? *address.host : "";
+  key.push_back('\n');
+  key.append(std::to_string(static_cast<v_int32>(address.port)));
+  key.push_back('\n');
+  key.append(std::to_string(static_cast<v_int32>(address.family)));
+  return key;
+}
+
+void Resolver::orderEndpoints(Endpoints& endpoints) {
+
+  if(endpoints.empty()) {
+    return;
+  }
+
+  /* RFC 8305 section 4 - keep the preferred family first, then alternate families */
+  Endpoints preferred;
+  Endpoints other;
+  auto preferredFamily = endpoints.front().family;
+  for(auto& endpoint : endpoints) {
+    if(endpoint.family == preferredFamily) {
+      preferred.push_back(endpoint);
+    } else {
+      other.push_back(endpoint);
+    }
+  }
+
+  endpoints.clear();
+  size_t i = 0;
+  while(i < preferred.size() || i < other.size()) {
+    if(i < preferred.size()) endpoints.push_back(preferred[i]);
+    if(i < other.size()) endpoints.push_back(other[i]);
+    i ++;
+  }
+
+}
+
+std::shared_ptr<Resolver::Lookup> Resolver::getLookup(const Address& address, bool& created) {
+
+  auto key = makeKey(address);
+  auto now = oatpp::Environment::getMicroTickCount();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto it = m_cache.find(key);
+  if(it != m_cache.end()) {
+    auto& lookup = it->second;
+    if(!lookup->ready.load(std::memory_order_acquire) || now < lookup->expiresAt) {
+      created = false;
+      return lookup;
+    }
+    m_cache.erase(it);
+  }
+
+  if(static_cast<v_int64>(m_cache.size()) >= m_config.maxCacheSize) {
+    evict(now);
+  }
+
+  auto lookup = std::make_shared<Lookup>(address, key);
+  m_cache.insert({key, lookup});
+  created = true;
+  return lookup;
+
+}
+
+void Resolver::evict(v_int64 now) {
+
+  for(auto it = m_cache.begin(); it != m_cache.end();) {
+    if(it->second->ready.load(std::memory_order_acquire) && now >= it->second->expiresAt) {
+      it = m_cache.erase(it);
+    } else {
+      it ++;
+    }
+  }
+
+  /* still full - drop completed lookups regardless of their ttl */
+  for(auto it = m_cache.begin(); it != m_cache.end() && static_cast<v_int64>(m_cache.size()) >= m_config.maxCacheSize;) {
+    if(it->second->ready.load(std::memory_order_acquire)) {
+      it = m_cache.erase(it);
+    } else {
+      it ++;
+    }
+  }
+
+}
+
+void Resolver::resolveLookup(const std::shared_ptr<Lookup>& lookup) {
+
+  const auto& address = lookup->address;
+  auto portStr = oatpp::utils::Conversion::int32ToStr(address.port);
+
+  addrinfo hints;
+
+  memset(&hints, 0, sizeof(addrinfo));
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = 0;
+  hints.ai_protocol = 0;
+
+  switch(address.family) {
+    case Address::IP_4: hints.ai_family = AF_INET; break;
+    case Address::IP_6: hints.ai_family = AF_INET6; break;
+    case Address::UNSPEC:
+    default:
+      hints.ai_family = AF_UNSPEC;
+  }
+
+  addrinfo* result = nullptr;
+  auto res = getaddrinfo(address.host ? address.host->c_str() : nullptr, portStr->c_str(), &hints, &result);
+
+  if (res != 0) {
+#if defined(WIN32) || defined(_WIN32)
+    complete(lookup, nullptr, "[oatpp::network::tcp::client::Resolver::resolve()]: Error. Call to getaddrinfo() failed with code " + std::to_string(res));
+#else
+    std::string errorString = "[oatpp::network::tcp::client::Resolver::resolve()]: Error. Call to getaddrinfo() failed: ";
+    complete(lookup, nullptr, errorString.append(gai_strerror(res)));
+#endif
+    return;
+  }
+
+  auto endpoints = std::make_shared<Endpoints>();
+
+  for(addrinfo* curr = result; curr != nullptr; curr = curr->ai_next) {
+
+    if(curr->ai_addr == nullptr || curr->ai_addrlen > sizeof(Endpoint::address)) {
+      continue;
+    }
+
+    Endpoint endpoint;
+    endpoint.family = curr->ai_family == AF_INET6 ? Address::IP_6 : Address::IP_4;
+    endpoint.socketFamily = curr->ai_family;
+    endpoint.socketType = curr->ai_socktype;
+    endpoint.protocol = curr->ai_protocol;
+    memcpy(endpoint.address, curr->ai_addr, curr->ai_addrlen);
+    endpoint.addressLength = curr->ai_addrlen;
+    endpoints->push_back(endpoint);
+
+  }
+
+  if(result != nullptr) {
+    freeaddrinfo(result);
+  }
+
+  if(endpoints->empty()) {
+    complete(lookup, nullptr, "[oatpp::network::tcp::client::Resolver::resolve()]: Error. Call to getaddrinfo() returned no results.");
+    return;
+  }
+
+  orderEndpoints(*endpoints);
+  complete(lookup, endpoints, "");
+
+}
+
+void Resolver::complete(const std::shared_ptr<Lookup>& lookup, const std::shared_ptr<const Endpoints>& endpoints, const std::string& error) {
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    lookup->endpoints = endpoints;
+    lookup->error = error;
+    lookup->expiresAt = oatpp::Environment::getMicroTickCount() + (endpoints ? m_config.ttl.count() : m_config.negativeTtl.count());
+    lookup->ready.store(true, std::memory_order_release);
+  }
+
+  m_readyCondition.notify_all();
+  lookup->waitList.notifyAll();
+
+}
+
+void Resolver::enqueue(const std::shared_ptr<Lookup>& lookup) {
+
+  bool queued = false;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_running) {
+      m_queue.push_back(lookup);
+      if(m_threads.empty()) {
+        v_int32 threads = m_config.threads > 0 ? m_config.threads : 1;
+        for(v_int32 i = 0; i < threads; i ++) {
+          m_threads.emplace_back(&Resolver::run, this);
+        }
+      }
+      queued = true;
+    }
+  }
+
+  if(queued) {
+    m_queueCondition.notify_one();
+  } else {
+    complete(lookup, nullptr, "[oatpp::network::tcp::client::Resolver::resolveAsync()]: Error. Resolver is stopped.");
+  }
+
+}
+
+void Resolver::run() {
+
+  while(true) {
+
+    std::shared_ptr<Lookup> lookup;
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      while(m_running && m_queue.empty()) {
+        m_queueCondition.wait(lock);
+      }
+      if(!m_running) {
+        return;
+      }
+      lookup = m_queue.front();
+      m_queue.pop_front();
+    }
+
+    resolveLookup(lookup);
+
+  }
+
+}
+
+std::shared_ptr<const Resolver::Endpoints> Resolver::resolve(const Address& address) {
+
+  bool created;
+  auto lookup = getLookup(address, created);
+
+  if(created) {
+    resolveLookup(lookup);
+  } else if(!lookup->ready.load(std::memory_order_acquire)) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_readyCondition.wait(lock, [&lookup]{
+      return lookup->ready.load(std::memory_order_acquire);
+    });
+  }
+
+  if(!lookup->endpoints) {
+    throw std::runtime_error(lookup->error);
+  }
+
+  return lookup->endpoints;
+
+}
+
+async::CoroutineStarterForResult<const std::shared_ptr<const Resolver::Endpoints>&> Resolver::resolveAsync(const Address& address) {
+
+  class ResolveCoroutine : public async::CoroutineWithResult<ResolveCoroutine, const std::shared_ptr<const Endpoints>&> {
+  private:
+    Resolver* m_resolver;
+    Address m_address;
+    std::shared_ptr<Lookup> m_lookup;
+  public:
+
+    ResolveCoroutine(Resolver* resolver, const Address& address)
+      : m_resolver(resolver)
+      , m_address(address)
+    {}
+
+    Action act() override {
+      bool created;
+      m_lookup = m_resolver->getLookup(m_address, created);
+      if(created) {
+        m_resolver->enqueue(m_lookup);
+      }
+      return yieldTo(&ResolveCoroutine::waitLookup);
+    }
+
+    Action waitLookup() {
+      if(!m_lookup->ready.load(std::memory_order_acquire)) {
+        return Action::createWaitListAction(&m_lookup->waitList);
+      }
+      if(!m_lookup->endpoints) {
+        return error<async::Error>(m_lookup->error);
+      }
+      return _return(m_lookup->endpoints);
+    }
+
+  };
+
+  return ResolveCoroutine::startForResult(this, address);
+
+}
+
+void Resolver::clearCache() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for(auto it = m_cache.begin(); it != m_cache.end();) {
+    if(it->second->ready.load(std::memory_order_acquire)) {
+      it = m_cache.erase(it);
+    } else {
+      it ++;
+    }
+  }
+}
+
+v_int64 Resolver::getCacheSize() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return static_cast<v_int64>(m_cache.size());
+}
+
+void Resolver::stop() {
+
+  std::list<std::shared_ptr<Lookup>> pending;
+  std::vector<std::thread> threads;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_running = false;
+    pending = std::move(m_queue);
+    m_queue.clear();
+    threads = std::move(m_threads);
+    m_threads.clear();
+  }
+
+  m_queueCondition.notify_all();
+
+  for(auto& lookup : pending) {
+    complete(lookup, nullptr, "[oatpp::network::tcp::client::Resolver::resolveAsync()]: Error. Resolver is stopped.");
+  }
+
+  for(auto& thread : threads) {
+    if(thread.get_id() == std::this_thread::get_id()) {
+      thread.detach();
+    } else {
+      thread.join();
+    }
+  }
+
+}
+
+}}}}
@@ -0,0 +1,240 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_network_tcp_client_Resolver_hpp
+#define oatpp_network_tcp_client_Resolver_hpp
+
+#include "oatpp/network/Address.hpp"
+
+#include "oatpp/async/Coroutine.hpp"
+#include "oatpp/async/CoroutineWaitList.hpp"
+#include "oatpp/IODefinitions.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace oatpp { namespace network { namespace tcp { namespace client {
+
+/**
+ * Caching resolver of host names. <br>
+ * Successful lookups are cached for &l:Resolver::Config::ttl;, failed lookups - for &l:Resolver::Config::negativeTtl;.
+ * Concurrent lookups of the same address share one `getaddrinfo()` call. <br>
+ * Synchronous lookups run in the calling thread.
+ * Asynchronous lookups run in a small pool of resolver threads and never block the async processor -
+ * waiting coroutines are woken via &id:oatpp::async::CoroutineWaitList;. <br>
+ * Resolved endpoints are ordered for happy-eyeballs style connection (RFC 8305) - address families are interleaved.
+ */
+class Resolver {
+public:
+
+  /**
+   * Resolver config.
+   */
+  struct Config {
+
+    /**
+     * Constructor.
+     */
+    Config()
+      : threads(2)
+      , ttl(std::chrono::seconds(30))
+      , negativeTtl(std::chrono::seconds(5))
+      , maxCacheSize(1024)
+    {}
+
+    /**
+     * Number of resolver threads serving asynchronous lookups. Threads are started on the first asynchronous lookup.
+     */
+    v_int32 threads;
+
+    /**
+     * Time to keep successful lookup in cache. <br>
+     * `getaddrinfo()` doesn't expose record TTL, so it is configured here.
+     */
+    std::chrono::duration<v_int64, std::micro> ttl;
+
+    /**
+     * Time to keep failed lookup in cache.
+     */
+    std::chrono::duration<v_int64, std::micro> negativeTtl;
+
+    /**
+     * Max number of cached lookups.
+     */
+    v_int64 maxCacheSize;
+
+  };
+
+  /**
+   * Resolved endpoint.
+   */
+  struct Endpoint {
+
+    /**
+     * Address family. IP_4 or IP_6.
+     */
+    Address::Family family;
+
+    /**
+     * Socket domain - `ai_family` of the `getaddrinfo()` result.
+     */
+    v_int32 socketFamily;
+
+    /**
+     * Socket type - `ai_socktype` of the `getaddrinfo()` result.
+     */
+    v_int32 socketType;
+
+    /**
+     * Socket protocol - `ai_protocol` of the `getaddrinfo()` result.
+     */
+    v_int32 protocol;
+
+    /**
+     * Raw `sockaddr` of the endpoint (including port).
+     */
+    alignas(8) v_uint8 address[128];
+
+    /**
+     * Size of the `sockaddr` in &l:Resolver::Endpoint::address;.
+     */
+    v_sock_size addressLength;
+
+  };
+
+  /**
+   * List of resolved endpoints.
+   */
+  typedef std::vector<Endpoint> Endpoints;
+
+private:
+
+  class Lookup : public async::CoroutineWaitList::Listener {
+  public:
+
+    Lookup(const Address& pAddress, const std::string& pKey);
+
+    void onNewItem(async::CoroutineWaitList& list) override;
+
+    Address address;
+    std::string key;
+
+    std::atomic<bool> ready;
+    std::shared_ptr<const Endpoints> endpoints;
+    std::string error;
+    v_int64 expiresAt;
+
+    async::CoroutineWaitList waitList;
+
+  };
+
+private:
+
+  static std::string makeKey(const Address& address);
+  static void orderEndpoints(Endpoints& endpoints);
+
+  std::shared_ptr<Lookup> getLookup(const Address& address, bool& created);
+  void evict(v_int64 now);
+  void resolveLookup(const std::shared_ptr<Lookup>& lookup);
+  void complete(const std::shared_ptr<Lookup>& lookup, const std::shared_ptr<const Endpoints>& endpoints, const std::string& error);
+  void enqueue(const std::shared_ptr<Lookup>& lookup);
+  void run();
+
+private:
+  Config m_config;
+  std::mutex m_mutex;
+  std::condition_variable m_readyCondition;
+  std::condition_variable m_queueCondition;
+  std::unordered_map<std::string, std::shared_ptr<Lookup>> m_cache;
+  std::list<std::shared_ptr<Lookup>> m_queue;
+  std::vector<std::thread> m_threads;
+  bool m_running;
+public:
+
+  /**
+   * Constructor.
+   * @param config - &l:Resolver::Config;.
+   */
+  Resolver(const Config& config = Config());
+
+  /**
+   * Non-virtual destructor. Stops resolver threads.
+   */
+  ~Resolver();
+
+  /**
+   * Create shared Resolver.
+   * @param config - &l:Resolver::Config;.
+   * @return - `std::shared_ptr` to Resolver.
+   */
+  static std::shared_ptr<Resolver> createShared(const Config& config = Config());
+
+  /**
+   * Get process-wide default resolver. <br>
+   * Used by &id:oatpp::network::tcp::client::ConnectionProvider; when no resolver is specified.
+   * @return - `std::shared_ptr` to Resolver.
+   */
+  static std::shared_ptr<Resolver> getDefault();
+
+  /**
+   * Resolve address. Lookup runs in the calling thread unless the same address is being resolved already.
+   * @param address - &id:oatpp::network::Address;.
+   * @return - &l:Resolver::Endpoints;.
+   * @throws - `std::runtime_error` if address can't be resolved.
+   */
+  std::shared_ptr<const Endpoints> resolve(const Address& address);
+
+  /**
+   * Resolve address in asynchronous manner.
+   * @param address - &id:oatpp::network::Address;.
+   * @return - &id:oatpp::async::CoroutineStarterForResult;.
+   */
+  async::CoroutineStarterForResult<const std::shared_ptr<const Endpoints>&> resolveAsync(const Address& address);
+
+  /**
+   * Remove all completed lookups from cache.
+   */
+  void clearCache();
+
+  /**
+   * Get number of cached lookups (including lookups in progress).
+   * @return
+   */
+  v_int64 getCacheSize();
+
+  /**
+   * Stop resolver threads. Pending asynchronous lookups fail.
+   */
+  void stop();
+
+};
+
+}}}}
+
+#endif // oatpp_network_tcp_client_Resolver_hpp
@@ -28,6 +28,7 @@
 #include "oatpp/base/Log.hpp"
 
 #include <fcntl.h>
+#include <cerrno>
 
 #if defined(WIN32) || defined(_WIN32)
   #include <io.h>
@@ -38,6 +39,7 @@
   #include <arpa/inet.h>
   #include <sys/socket.h>
   #include <netinet/tcp.h>
+  #include <poll.h>
   #include <unistd.h>
   #if defined(__FreeBSD__)
     #include <netinet/in.h>
@@ -83,6 +85,13 @@ ConnectionProvider::ExtendedConnection::ExtendedConnection(v_io_handle handle, d
   , m_context(data::stream::StreamType::STREAM_INFINITE, std::forward<data::stream::Context::Properties>(properties))
 {}
 
+ConnectionProvider::ExtendedConnection::ExtendedConnection(v_io_handle handle,
+                                                           data::stream::IOMode ioMode,
+                                                           data::stream::Context::Properties&& properties)
+  : Connection(handle, ioMode)
+  , m_context(data::stream::StreamType::STREAM_INFINITE, std::forward<data::stream::Context::Properties>(properties))
+{}
+
 oatpp::data::stream::Context& ConnectionProvider::ExtendedConnection::getOutputStreamContext() {
   return m_context;
 }
@@ -123,33 +132,102 @@ void ConnectionProvider::ConnectionInvalidator::invalidate(const std::shared_ptr
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // ConnectionProvider
 
-ConnectionProvider::ConnectionProvider(const network::Address& address, bool useExtendedConnections)
+ConnectionProvider::ConnectionProvider(const network::Address& address, bool useExtendedConnections, bool reusePort)
         : m_invalidator(std::make_shared<ConnectionInvalidator>())
         , m_address(address)
         , m_closed(false)
         , m_useExtendedConnections(useExtendedConnections)
+        , m_reusePort(reusePort)
+        , m_configureAcceptedHandles(false)
+        , m_acceptIOMode(data::stream::IOMode::BLOCKING)
+        , m_acceptBatchSize(DEFAULT_ACCEPT_BATCH_SIZE)
 {
   setProperty(PROPERTY_HOST, m_address.host);
   setProperty(PROPERTY_PORT, oatpp::utils::Conversion::int32ToStr(m_address.port));
   m_serverHandle = instantiateServer();
 }
 
+std::vector<std::shared_ptr<ConnectionProvider>> ConnectionProvider::createSharedGroup(const network::Address& address,
+                                                                                      v_int32 count,
+                                                                                      bool useExtendedConnections)
+{
+
+  if(count < 1) {
+    throw std::runtime_error("[oatpp::network::tcp::server::ConnectionProvider::createSharedGroup()]: Error. Invalid listeners count.");
+  }
+
+  std::vector<std::shared_ptr<ConnectionProvider>> result;
+  result.reserve(static_cast<size_t>(count));
+
+  result.push_back(std::make_shared<ConnectionProvider>(address, useExtendedConnections, true));
+
+  network::Address groupAddress = address;
+  if(groupAddress.port == 0) {
+    groupAddress.port = static_cast<v_uint16>(oatpp::utils::Conversion::strToInt32(result[0]->getProperty(PROPERTY_PORT).toString()->c_str()));
+  }
+
+  for(v_int32 i = 1; i < count; i ++) {
+    result.push_back(std::make_shared<ConnectionProvider>(groupAddress, useExtendedConnections, true));
+  }
+
+  return result;
+
+}
+
 void ConnectionProvider::setConnectionConfigurer(const std::shared_ptr<ConnectionConfigurer> &connectionConfigurer) {
   m_connectionConfigurer = connectionConfigurer;
+  m_configureAcceptedHandles = m_connectionConfigurer && !m_connectionConfigurer->configureListener(m_serverHandle);
+}
+
+void ConnectionProvider::setAcceptIOMode(data::stream::IOMode ioMode) {
+  m_acceptIOMode = ioMode;
+}
+
+void ConnectionProvider::setAcceptBatchSize(v_int32 batchSize) {
+  if(batchSize < 1) {
+    throw std::runtime_error("[oatpp::network::tcp::server::ConnectionProvider::setAcceptBatchSize()]: Error. Invalid batch size.");
+  }
+  m_acceptBatchSize = batchSize;
+}
+
+bool ConnectionProvider::setDeferAccept(const std::chrono::seconds& timeout) {
+#if defined(TCP_DEFER_ACCEPT)
+  int seconds = static_cast<int>(timeout.count());
+  if(setsockopt(m_serverHandle, IPPROTO_TCP, TCP_DEFER_ACCEPT, &seconds, sizeof(int)) != 0) {
+    OATPP_LOGw("[oatpp::network::tcp::server::ConnectionProvider::setDeferAccept()]",
+               "Warning. Failed to set {} for accepting socket: {}", "TCP_DEFER_ACCEPT", strerror(errno))
+    return false;
+  }
+  return true;
+#else
+  (void) timeout;
+  OATPP_LOGw("[oatpp::network::tcp::server::ConnectionProvider::setDeferAccept()]",
+             "Warning. {} is not supported on this platform.", "TCP_DEFER_ACCEPT")
+  return false;
+#endif
 }
 
 ConnectionProvider::~ConnectionProvider() {
   stop();
 }
 
-void ConnectionProvider::stop() {
-  if(!m_closed) {
-    m_closed = true;
+void ConnectionProvider::closeHandle(oatpp::v_io_handle handle) {
 #if defined(WIN32) || defined(_WIN32)
-	  ::closesocket(m_serverHandle);
+  ::closesocket(handle);
 #else
-	  ::close(m_serverHandle);
+  ::close(handle);
 #endif
+}
+
+void ConnectionProvider::stop() {
+  if(!m_closed) {
+    m_closed = true;
+    closeHandle(m_serverHandle);
+    std::lock_guard<std::mutex> lock(m_acceptLock);
+    for(auto& accepted : m_acceptedHandles) {
+      closeHandle(accepted.handle);
+    }
+    m_acceptedHandles.clear();
   }
 }
 
@@ -159,6 +237,10 @@ oatpp::v_io_handle ConnectionProvider::instantiateServer(){
 
   SOCKET serverHandle = INVALID_SOCKET;
 
+  if(m_reusePort) {
+    throw std::runtime_error("[oatpp::network::tcp::server::ConnectionProvider::instantiateServer()]: Error. SO_REUSEPORT is not supported on this platform.");
+  }
+
   struct addrinfo *result = nullptr;
   struct addrinfo hints;
 
@@ -285,6 +367,19 @@ oatpp::v_io_handle ConnectionProvider::instantiateServer(){
                    "Warning. Failed to set {} for accepting socket: {}", "SO_REUSEADDR", strerror(errno))
       }
 
+      if(m_reusePort) {
+#ifdef SO_REUSEPORT
+        if (setsockopt(serverHandle, SOL_SOCKET, SO_REUSEPORT, &yes, sizeof(int)) != 0) {
+          OATPP_LOGw("[oatpp::network::tcp::server::ConnectionProvider::instantiateServer()]",
+                     "Warning. Failed to set {} for accepting socket: {}", "SO_REUSEPORT", strerror(errno))
+        }
+#else
+        ::close(serverHandle);
+        freeaddrinfo(result);
+        throw std::runtime_error("[oatpp::network::tcp::server::ConnectionProvider::instantiateServer()]: Error. SO_REUSEPORT is not supported on this platform.");
+#endif
+      }
+
       if (bind(serverHandle, currResult->ai_addr, currResult->ai_addrlen) == 0 &&
           listen(serverHandle, 10000) == 0)
       {
@@ -324,6 +419,93 @@ oatpp::v_io_handle ConnectionProvider::instantiateServer(){
 
 #endif
 
+bool ConnectionProvider::waitForConnections() {
+
+#if defined(WIN32) || defined(_WIN32)
+
+  fd_set set;
+  timeval timeout;
+  FD_ZERO(&set);
+  FD_SET(m_serverHandle, &set);
+
+  timeout.tv_sec = 1;
+  timeout.tv_usec = 0;
+
+  return select(static_cast<int>(m_serverHandle + 1), &set, nullptr, nullptr, &timeout) > 0;
+
+#else
+
+  pollfd pfd;
+  pfd.fd = m_serverHandle;
+  pfd.events = POLLIN;
+  pfd.revents = 0;
+
+  return poll(&pfd, 1, 1000) > 0;
+
+#endif
+
+}
+
+oatpp::v_io_handle ConnectionProvider::acceptHandle(AcceptedHandle& accepted) {
+
+  static_assert(sizeof(accepted.address) >= sizeof(sockaddr_storage), "AcceptedHandle::address is too small");
+
+  sockaddr* address = nullptr;
+  v_sock_size addressSize = sizeof(sockaddr_storage);
+  v_sock_size* addressSizePtr = nullptr;
+
+  if(m_useExtendedConnections) {
+    address = reinterpret_cast<sockaddr*>(accepted.address);
+    addressSizePtr = &addressSize;
+  }
+
+#if defined(__linux__)
+  int flags = SOCK_CLOEXEC;
+  if(m_acceptIOMode == data::stream::IOMode::ASYNCHRONOUS) {
+    flags |= SOCK_NONBLOCK;
+  }
+  return accept4(m_serverHandle, address, addressSizePtr, flags);
+#else
+  return accept(m_serverHandle, address, addressSizePtr);
+#endif
+
+}
+
+void ConnectionProvider::acceptBatch() {
+
+  std::lock_guard<std::mutex> lock(m_acceptLock);
+
+  /* the accept-socket is non-blocking - drain the backlog until it's empty or the batch is full */
+  for(v_int32 i = 0; i < m_acceptBatchSize && !m_closed; i ++) {
+
+    m_acceptedHandles.emplace_back();
+    auto& accepted = m_acceptedHandles.back();
+    accepted.handle = acceptHandle(accepted);
+
+    if(!oatpp::isValidIOHandle(accepted.handle)) {
+      m_acceptedHandles.pop_back();
+#if !defined(WIN32) && !defined(_WIN32)
+      if(errno == EINTR || errno == ECONNABORTED) {
+        continue;
+      }
+#endif
+      break;
+    }
+
+  }
+
+}
+
+bool ConnectionProvider::popAcceptedHandle(AcceptedHandle& accepted) {
+  std::lock_guard<std::mutex> lock(m_acceptLock);
+  if(m_acceptedHandles.empty()) {
+    return false;
+  }
+  accepted = m_acceptedHandles.front();
+  m_acceptedHandles.pop_front();
+  return true;
+}
+
 void ConnectionProvider::prepareConnectionHandle(oatpp::v_io_handle handle) {
 
 #ifdef SO_NOSIGPIPE
@@ -334,56 +516,50 @@ void ConnectionProvider::prepareConnectionHandle(oatpp::v_io_handle handle) {
   }
 #endif
 
-  if(m_connectionConfigurer) {
+  if(m_configureAcceptedHandles) {
     m_connectionConfigurer->configure(handle);
   }
 
 }
 
-provider::ResourceHandle<data::stream::IOStream> ConnectionProvider::getDefaultConnection() {
+provider::ResourceHandle<data::stream::IOStream> ConnectionProvider::getDefaultConnection(const AcceptedHandle& accepted) {
 
-  oatpp::v_io_handle handle = accept(m_serverHandle, nullptr, nullptr);
-
-  if(!oatpp::isValidIOHandle(handle)) {
-    return nullptr;
-  }
+  oatpp::v_io_handle handle = accepted.handle;
 
   prepareConnectionHandle(handle);
 
   return provider::ResourceHandle<data::stream::IOStream>(
+#if defined(__linux__)
+    std::make_shared<Connection>(handle, m_acceptIOMode),
+#else
     std::make_shared<Connection>(handle),
-      m_invalidator
+#endif
+    m_invalidator
   );
 
 }
 
-provider::ResourceHandle<data::stream::IOStream> ConnectionProvider::getExtendedConnection() {
+provider::ResourceHandle<data::stream::IOStream> ConnectionProvider::getExtendedConnection(const AcceptedHandle& accepted) {
 
-  sockaddr_storage clientAddress;
-  v_sock_size clientAddressSize = sizeof(clientAddress);
+  oatpp::v_io_handle handle = accepted.handle;
+  auto clientAddress = reinterpret_cast<const sockaddr_storage*>(accepted.address);
 
   data::stream::Context::Properties properties;
 
-  oatpp::v_io_handle handle = accept(m_serverHandle, reinterpret_cast<sockaddr*>(&clientAddress), &clientAddressSize);
-
-  if(!oatpp::isValidIOHandle(handle)) {
-    return nullptr;
-  }
-
-  if (clientAddress.ss_family == AF_INET) {
+  if (clientAddress->ss_family == AF_INET) {
 
     char strIp[INET_ADDRSTRLEN];
-    sockaddr_in* sockAddress = reinterpret_cast<sockaddr_in*>(&clientAddress);
+    const sockaddr_in* sockAddress = reinterpret_cast<const sockaddr_in*>(clientAddress);
     inet_ntop(AF_INET, &sockAddress->sin_addr, strIp, INET_ADDRSTRLEN);
 
     properties.put_LockFree(ExtendedConnection::PROPERTY_PEER_ADDRESS, oatpp::String(reinterpret_cast<const char*>(strIp)));
     properties.put_LockFree(ExtendedConnection::PROPERTY_PEER_ADDRESS_FORMAT, "ipv4");
     properties.put_LockFree(ExtendedConnection::PROPERTY_PEER_PORT, oatpp::utils::Conversion::int32ToStr(sockAddress->sin_port));
 
-  } else if (clientAddress.ss_family == AF_INET6) {
+  } else if (clientAddress->ss_family == AF_INET6) {
 
     char strIp[INET6_ADDRSTRLEN];
-    sockaddr_in6* sockAddress = reinterpret_cast<sockaddr_in6*>(&clientAddress);
+    const sockaddr_in6* sockAddress = reinterpret_cast<const sockaddr_in6*>(clientAddress);
     inet_ntop(AF_INET6, &sockAddress->sin6_addr, strIp, INET6_ADDRSTRLEN);
 
     properties.put_LockFree(ExtendedConnection::PROPERTY_PEER_ADDRESS, oatpp::String(reinterpret_cast<const char*>(strIp)));
@@ -392,11 +568,7 @@ provider::ResourceHandle<data::stream::IOStream> ConnectionProvider::getExtended
 
   } else {
 
-#if defined(WIN32) || defined(_WIN32)
-    ::closesocket(handle);
-#else
-    ::close(handle);
-#endif
+    closeHandle(handle);
 
     OATPP_LOGe("[oatpp::network::tcp::server::ConnectionProvider::getExtendedConnection()]", "Error. Unknown address family.")
     return nullptr;
@@ -406,7 +578,11 @@ provider::ResourceHandle<data::stream::IOStream> ConnectionProvider::getExtended
   prepareConnectionHandle(handle);
 
   return provider::ResourceHandle<data::stream::IOStream>(
+#if defined(__linux__)
+    std::make_shared<ExtendedConnection>(handle, m_acceptIOMode, std::move(properties)),
+#else
     std::make_shared<ExtendedConnection>(handle, std::move(properties)),
+#endif
     m_invalidator
   );
 
@@ -414,38 +590,23 @@ provider::ResourceHandle<data::stream::IOStream> ConnectionProvider::getExtended
 
 provider::ResourceHandle<oatpp::data::stream::IOStream> ConnectionProvider::get() {
 
-  while(!m_closed) {
+  AcceptedHandle accepted;
 
-    fd_set set;
-    timeval timeout;
-    FD_ZERO(&set);
-    FD_SET(m_serverHandle, &set);
-
-    timeout.tv_sec = 1;
-    timeout.tv_usec = 0;
-
-    auto res = select(
-#if defined(WIN32) || defined(_WIN32)
-      static_cast<int>(m_serverHandle + 1),
-#else
-      m_serverHandle + 1,
-#endif
-      &set,
-      nullptr,
-      nullptr,
-      &timeout);
-
-    if (res >= 0) {
-      break;
+  if(!popAcceptedHandle(accepted)) {
+    if(m_closed || !waitForConnections()) {
+      return nullptr;
+    }
+    acceptBatch();
+    if(!popAcceptedHandle(accepted)) {
+      return nullptr;
     }
-
   }
 
   if(m_useExtendedConnections) {
-    return getExtendedConnection();
+    return getExtendedConnection(accepted);
   }
 
-  return getDefaultConnection();
+  return getDefaultConnection(accepted);
 
 }
 
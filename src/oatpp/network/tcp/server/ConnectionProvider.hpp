@@ -32,12 +32,34 @@
 
 #include "oatpp/Types.hpp"
 
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <vector>
+
 namespace oatpp { namespace network { namespace tcp { namespace server {
 
 /**
- * Simple provider of TCP connections.
+ * Simple provider of TCP connections. <br>
+ * On each wakeup of the accept-socket the provider drains up to &l:ConnectionProvider::setAcceptBatchSize (); pending connections
+ * from the backlog and then hands them out one per &l:ConnectionProvider::get (); call without further syscalls.
  */
 class ConnectionProvider : public ServerConnectionProvider {
+public:
+
+  /**
+   * Default max number of connections accepted per wakeup of the accept-socket.
+   */
+  static constexpr v_int32 DEFAULT_ACCEPT_BATCH_SIZE = 64;
+
+private:
+
+  struct AcceptedHandle {
+    v_io_handle handle;
+    /* sockaddr_storage of the peer. Filled for extended connections only */
+    alignas(8) v_uint8 address[128];
+  };
+
 private:
 
   class ConnectionInvalidator : public provider::Invalidator<data::stream::IOStream> {
@@ -70,6 +92,14 @@ public:
      */
     ExtendedConnection(v_io_handle handle, data::stream::Context::Properties&& properties);
 
+    /**
+     * Constructor.
+     * @param handle - &id:oatpp::v_io_handle;.
+     * @param ioMode - current I/O mode of the socket. &id:oatpp::data::stream::IOMode;.
+     * @param properties - &id:oatpp::data::stream::Context::Properties;.
+     */
+    ExtendedConnection(v_io_handle handle, data::stream::IOMode ioMode, data::stream::Context::Properties&& properties);
+
     /**
      * Get output stream context.
      * @return - &id:oatpp::data::stream::Context;.
@@ -90,13 +120,25 @@ private:
   std::atomic<bool> m_closed;
   oatpp::v_io_handle m_serverHandle;
   bool m_useExtendedConnections;
+  bool m_reusePort;
   std::shared_ptr<ConnectionConfigurer> m_connectionConfigurer;
+  bool m_configureAcceptedHandles;
+  data::stream::IOMode m_acceptIOMode;
+  v_int32 m_acceptBatchSize;
+private:
+  std::mutex m_acceptLock;
+  std::deque<AcceptedHandle> m_acceptedHandles;
 private:
   oatpp::v_io_handle instantiateServer();
 private:
+  static void closeHandle(oatpp::v_io_handle handle);
+  bool waitForConnections();
+  oatpp::v_io_handle acceptHandle(AcceptedHandle& accepted);
+  void acceptBatch();
+  bool popAcceptedHandle(AcceptedHandle& accepted);
   void prepareConnectionHandle(oatpp::v_io_handle handle);
-  provider::ResourceHandle<data::stream::IOStream> getDefaultConnection();
-  provider::ResourceHandle<data::stream::IOStream> getExtendedConnection();
+  provider::ResourceHandle<data::stream::IOStream> getDefaultConnection(const AcceptedHandle& accepted);
+  provider::ResourceHandle<data::stream::IOStream> getExtendedConnection(const AcceptedHandle& accepted);
 public:
 
   /**
@@ -104,8 +146,10 @@ public:
    * @param address - &id:oatpp::network::Address;.
    * @param useExtendedConnections - set `true` to use &l:ConnectionProvider::ExtendedConnection;.
    * `false` to use &id:oatpp::network::tcp::Connection;.
+   * @param reusePort - set `true` to bind the accept-socket with `SO_REUSEPORT` so that several
+   * providers can listen on the same address. Not supported on Windows.
    */
-  ConnectionProvider(const network::Address& address, bool useExtendedConnections = false);
+  ConnectionProvider(const network::Address& address, bool useExtendedConnections = false, bool reusePort = false);
 
 public:
 
@@ -121,11 +165,50 @@ public:
   }
 
   /**
-   * Set connection configurer.
+   * Create a group of ConnectionProviders listening on the same address. <br>
+   * Each provider has its own accept-socket bound with `SO_REUSEPORT`, so the kernel distributes
+   * incoming connections between them. Use with &id:oatpp::network::MultiListenerServer;. <br>
+   * If `address.port` is `0` all providers are bound to the port picked for the first one.
+   * @param address - &id:oatpp::network::Address;.
+   * @param count - number of providers (listeners) in the group.
+   * @param useExtendedConnections - set `true` to use &l:ConnectionProvider::ExtendedConnection;.
+   * `false` to use &id:oatpp::network::tcp::Connection;.
+   * @return - `std::vector` of `std::shared_ptr` to ConnectionProvider.
+   */
+  static std::vector<std::shared_ptr<ConnectionProvider>> createSharedGroup(const network::Address& address,
+                                                                            v_int32 count,
+                                                                            bool useExtendedConnections = false);
+
+  /**
+   * Set connection configurer. <br>
+   * &id:oatpp::network::tcp::ConnectionConfigurer::configureListener; is called for the accept-socket right away.
    * @param connectionConfigurer
    */
   void setConnectionConfigurer(const std::shared_ptr<ConnectionConfigurer>& connectionConfigurer);
 
+  /**
+   * Set I/O mode in which connections are accepted. Default - &id:oatpp::data::stream::IOMode::BLOCKING;. <br>
+   * Set &id:oatpp::data::stream::IOMode::ASYNCHRONOUS; when connections are handled by the async connection handler.
+   * On Linux connections are accepted with `accept4()` directly in this mode, so connection handlers
+   * don't have to switch it with extra `fcntl()` calls. On other platforms the mode is only detected.
+   * @param ioMode - &id:oatpp::data::stream::IOMode;.
+   */
+  void setAcceptIOMode(data::stream::IOMode ioMode);
+
+  /**
+   * Set max number of connections accepted per wakeup of the accept-socket.
+   * @param batchSize - batch size. Default - &l:ConnectionProvider::DEFAULT_ACCEPT_BATCH_SIZE;.
+   */
+  void setAcceptBatchSize(v_int32 batchSize);
+
+  /**
+   * Enable `TCP_DEFER_ACCEPT` on the accept-socket - connections surface only once the first request bytes
+   * have arrived (or the timeout expires). Supported on Linux only.
+   * @param timeout - max time to wait for the data. Zero - disable.
+   * @return - `true` if the option was set.
+   */
+  bool setDeferAccept(const std::chrono::seconds& timeout);
+
   /**
    * Virtual destructor.
    */
@@ -137,7 +220,8 @@ public:
   void stop() override;
 
   /**
-   * Get incoming connection.
+   * Get incoming connection. <br>
+   * Waits up to one second for incoming connections and returns `nullptr` if there are none.
    * @return &id:oatpp::data::stream::IOStream;.
    */
   provider::ResourceHandle<data::stream::IOStream> get() override;
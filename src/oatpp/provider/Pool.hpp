@@ -34,9 +34,41 @@
 
 namespace oatpp { namespace provider {
 
+template<class TResource, class AcquisitionProxyImpl>
+class AcquisitionProxy; // FWD
+
 template<class TResource, class AcquisitionProxyImpl>
 class PoolTemplate; // FWD
 
+template<class TResource, class AcquisitionProxyImpl>
+class ShardedPoolTemplate; // FWD
+
+/**
+ * Pool which &l:AcquisitionProxy; returns resources to.
+ * @tparam TResource - abstract resource interface type, Ex.: `IOStream`.
+ * @tparam AcquisitionProxyImpl - implementation of proxy.
+ */
+template<class TResource, class AcquisitionProxyImpl>
+class AbstractPool {
+  friend AcquisitionProxy<TResource, AcquisitionProxyImpl>;
+protected:
+
+  /**
+   * Return resource to the pool.
+   * @param resource - resource.
+   * @param canReuse - `false` if resource was invalidated and must not be reused.
+   */
+  virtual void release(provider::ResourceHandle<TResource>&& resource, bool canReuse) = 0;
+
+public:
+
+  /**
+   * Default virtual destructor.
+   */
+  virtual ~AbstractPool() = default;
+
+};
+
 /**
  * TestPool acquisition proxy template.
  * @tparam TResource - abstract resource interface type, Ex.: `IOStream`.
@@ -45,11 +77,12 @@ class PoolTemplate; // FWD
 template<class TResource, class AcquisitionProxyImpl>
 class AcquisitionProxy : public TResource {
   friend PoolTemplate<TResource, AcquisitionProxyImpl>;
+  friend ShardedPoolTemplate<TResource, AcquisitionProxyImpl>;
 public:
   /**
    * Convenience typedef for TestPool.
    */
-  typedef PoolTemplate<TResource, AcquisitionProxyImpl> PoolInstance;
+  typedef AbstractPool<TResource, AcquisitionProxyImpl> PoolInstance;
 private:
 
   void __pool__invalidate() {
@@ -88,8 +121,7 @@ public:
 };
 
 template<class TResource, class AcquisitionProxyImpl>
-class PoolTemplate : public oatpp::base::Countable, public async::CoroutineWaitList::Listener {
-  friend AcquisitionProxy<TResource, AcquisitionProxyImpl>;
+class PoolTemplate : public oatpp::base::Countable, public AbstractPool<TResource, AcquisitionProxyImpl>, public async::CoroutineWaitList::Listener {
 private:
 
   struct PoolRecord {
@@ -133,7 +165,7 @@ private:
 
   }
 
-  void release(provider::ResourceHandle<TResource>&& resource, bool canReuse) {
+  void release(provider::ResourceHandle<TResource>&& resource, bool canReuse) override {
 
     {
 
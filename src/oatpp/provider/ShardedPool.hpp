@@ -0,0 +1,695 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_provider_ShardedPool_hpp
+#define oatpp_provider_ShardedPool_hpp
+
+#include "Pool.hpp"
+
+#include "oatpp/concurrency/SpinLock.hpp"
+#include "oatpp/concurrency/Utils.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace oatpp { namespace provider {
+
+/**
+ * Pool statistics.
+ */
+struct PoolStatistics {
+
+  /**
+   * Number of successful acquisitions.
+   */
+  v_int64 acquisitions = 0;
+
+  /**
+   * Number of acquisitions served by reusing a pooled resource.
+   */
+  v_int64 hits = 0;
+
+  /**
+   * Number of resources created by the underlying provider.
+   */
+  v_int64 creations = 0;
+
+  /**
+   * Number of acquisitions which had to wait for a resource.
+   */
+  v_int64 waits = 0;
+
+  /**
+   * Total time spent waiting for resources.
+   */
+  v_int64 waitTimeMicroseconds = 0;
+
+  /**
+   * Longest time spent waiting for a resource.
+   */
+  v_int64 maxWaitTimeMicroseconds = 0;
+
+  /**
+   * Number of acquisitions failed by timeout.
+   */
+  v_int64 timeouts = 0;
+
+};
+
+/**
+ * Sharded resource pool. <br>
+ * Each shard has its own LIFO bench guarded by a spin-lock. Thread releases resources to its home shard
+ * and takes the most recently released (hot) resource first, stealing from other shards when its own shard is empty. <br>
+ * Resource accounting is lock-free. Threads and coroutines only take locks when they have to wait for a resource.
+ * @tparam TResource - abstract resource interface type, Ex.: `IOStream`.
+ * @tparam AcquisitionProxyImpl - implementation of &l:AcquisitionProxy;.
+ */
+template<class TResource, class AcquisitionProxyImpl>
+class ShardedPoolTemplate : public oatpp::base::Countable, public AbstractPool<TResource, AcquisitionProxyImpl>, public async::CoroutineWaitList::Listener {
+private:
+
+  struct PoolRecord {
+    provider::ResourceHandle<TResource> resource;
+    v_int64 timestamp = 0;
+  };
+
+  struct alignas(64) Shard {
+    oatpp::concurrency::SpinLock lock;
+    std::vector<PoolRecord> bench;
+    std::atomic<v_int64> size{0};
+    std::atomic<v_int64> acquisitions{0};
+    std::atomic<v_int64> hits{0};
+  };
+
+private:
+
+  class ResourceInvalidator : public provider::Invalidator<TResource> {
+  public:
+
+    void invalidate(const std::shared_ptr<TResource>& resource) override {
+      auto proxy = std::static_pointer_cast<AcquisitionProxyImpl>(resource);
+      if (proxy == nullptr) {
+        return;
+      }
+      proxy->__pool__invalidate();
+      const auto& handle = proxy->__pool__getUnderlyingResource();
+      handle.invalidator->invalidate(handle.object);
+    }
+
+  };
+
+private:
+
+  Shard& getHomeShard() {
+    /* std::hash of thread id is often an aligned pointer - mix it before taking the modulo */
+    v_uint64 hash = std::hash<std::thread::id>()(std::this_thread::get_id());
+    hash *= 0x9E3779B97F4A7C15ULL;
+    return m_shards[(hash >> 32) % static_cast<v_uint64>(m_shardsCount)];
+  }
+
+  bool popRecord(Shard& home, PoolRecord& record) {
+
+    if(m_available.load() <= 0) {
+      return false;
+    }
+
+    auto homeIndex = static_cast<v_int64>(&home - m_shards.get());
+    for(v_int64 i = 0; i < m_shardsCount; i ++) {
+      auto& shard = m_shards[static_cast<size_t>((homeIndex + i) % m_shardsCount)];
+      if(shard.size.load() == 0) {
+        continue;
+      }
+      std::lock_guard<oatpp::concurrency::SpinLock> guard(shard.lock);
+      if(!shard.bench.empty()) {
+        record = std::move(shard.bench.back());
+        shard.bench.pop_back();
+        -- shard.size;
+        -- m_available;
+        return true;
+      }
+    }
+
+    return false;
+
+  }
+
+  bool reserve() {
+    v_int64 counter = m_counter.load();
+    while(counter < m_maxResources) {
+      if(m_counter.compare_exchange_weak(counter, counter + 1)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool isReady() const {
+    return !m_running || m_available.load() > 0 || m_counter.load() < m_maxResources;
+  }
+
+  void notifyWaiters() {
+    if(m_syncWaiters.load() > 0) {
+      {
+        std::lock_guard<std::mutex> guard(m_waitLock);
+      }
+      m_condition.notify_one();
+    }
+    if(m_asyncWaiters.load() > 0) {
+      m_waitList.notifyFirst();
+    }
+  }
+
+  void onAcquired(Shard& shard, bool hit, v_int64 waitTime) {
+    ++ shard.acquisitions;
+    if(hit) {
+      ++ shard.hits;
+    }
+    if(waitTime >= 0) {
+      ++ m_waits;
+      m_waitTime += waitTime;
+      v_int64 maxWaitTime = m_maxWaitTime.load();
+      while(waitTime > maxWaitTime && !m_maxWaitTime.compare_exchange_weak(maxWaitTime, waitTime)) {}
+    }
+  }
+
+  void onNewItem(async::CoroutineWaitList& list) override {
+    if(!m_running) {
+      list.notifyAll();
+    } else if(isReady()) {
+      list.notifyFirst();
+    }
+  }
+
+  void release(provider::ResourceHandle<TResource>&& resource, bool canReuse) override {
+
+    if(!m_running) {
+      -- m_counter;
+      return;
+    }
+
+    if(canReuse) {
+      auto& shard = getHomeShard();
+      {
+        std::lock_guard<oatpp::concurrency::SpinLock> guard(shard.lock);
+        shard.bench.push_back({std::move(resource), oatpp::Environment::getMicroTickCount()});
+        ++ shard.size;
+      }
+      ++ m_available;
+    } else {
+      -- m_counter;
+    }
+
+    notifyWaiters();
+
+  }
+
+  void invalidateRecords(std::vector<PoolRecord>& records) {
+    for(auto& record : records) {
+      record.resource.invalidator->invalidate(record.resource.object);
+    }
+    m_available -= static_cast<v_int64>(records.size());
+    m_counter -= static_cast<v_int64>(records.size());
+    records.clear();
+  }
+
+  void evictExpired(v_int64 ticks) {
+
+    std::vector<PoolRecord> expired;
+
+    for(v_int64 i = 0; i < m_shardsCount; i ++) {
+
+      auto& shard = m_shards[static_cast<size_t>(i)];
+      if(shard.size.load() == 0) {
+        continue;
+      }
+
+      std::lock_guard<oatpp::concurrency::SpinLock> guard(shard.lock);
+      auto& bench = shard.bench;
+      size_t kept = 0;
+      for(size_t j = 0; j < bench.size(); j ++) {
+        if(ticks - bench[j].timestamp > m_maxResourceTTL) {
+          expired.push_back(std::move(bench[j]));
+        } else {
+          if(kept != j) {
+            bench[kept] = std::move(bench[j]);
+          }
+          kept ++;
+        }
+      }
+      shard.size -= static_cast<v_int64>(bench.size() - kept);
+      bench.resize(kept);
+
+    }
+
+    if(!expired.empty()) {
+      invalidateRecords(expired);
+      notifyWaiters();
+    }
+
+  }
+
+private:
+
+  static void cleanupTask(std::shared_ptr<ShardedPoolTemplate> pool) {
+
+    while(pool->m_running) { // timer-based cleanup loop
+      pool->evictExpired(oatpp::Environment::getMicroTickCount());
+      std::unique_lock<std::mutex> guard(pool->m_waitLock);
+      pool->m_cleanupCondition.wait_for(guard, std::chrono::milliseconds(100), [&pool]{ return !pool->m_running; });
+    }
+
+    /* invalidate all pooled resources */
+    pool->evictExpired(std::numeric_limits<v_int64>::max());
+
+    {
+      std::lock_guard<std::mutex> guard(pool->m_waitLock);
+      pool->m_finished = true;
+    }
+
+    pool->m_cleanupCondition.notify_all();
+
+  }
+
+private:
+  std::shared_ptr<ResourceInvalidator> m_invalidator;
+  std::shared_ptr<Provider<TResource>> m_provider;
+  v_int64 m_maxResources;
+  v_int64 m_maxResourceTTL;
+  std::chrono::duration<v_int64, std::micro> m_timeout;
+private:
+  v_int64 m_shardsCount;
+  std::unique_ptr<Shard[]> m_shards;
+  alignas(64) std::atomic<v_int64> m_counter{0};
+  alignas(64) std::atomic<v_int64> m_available{0};
+  std::atomic<bool> m_running{true};
+private:
+  std::atomic<v_int64> m_syncWaiters{0};
+  std::atomic<v_int64> m_asyncWaiters{0};
+  async::CoroutineWaitList m_waitList;
+  std::mutex m_waitLock;
+  std::condition_variable m_condition;
+  std::condition_variable m_cleanupCondition;
+  bool m_finished{false};
+private:
+  std::atomic<v_int64> m_creations{0};
+  std::atomic<v_int64> m_waits{0};
+  std::atomic<v_int64> m_waitTime{0};
+  std::atomic<v_int64> m_maxWaitTime{0};
+  std::atomic<v_int64> m_timeouts{0};
+protected:
+
+  ShardedPoolTemplate(const std::shared_ptr<Provider<TResource>>& provider,
+                      v_int64 maxResources,
+                      v_int64 maxResourceTTL,
+                      const std::chrono::duration<v_int64, std::micro>& timeout,
+                      v_int32 shards)
+    : m_invalidator(std::make_shared<ResourceInvalidator>())
+    , m_provider(provider)
+    , m_maxResources(maxResources)
+    , m_maxResourceTTL(maxResourceTTL)
+    , m_timeout(timeout)
+    , m_shardsCount(shards > 0 ? shards : oatpp::concurrency::Utils::getHardwareConcurrency())
+  {
+    if(m_shardsCount < 1) {
+      m_shardsCount = 1;
+    }
+    m_shards.reset(new Shard[static_cast<size_t>(m_shardsCount)]);
+    m_waitList.setListener(this);
+  }
+
+  static void startCleanupTask(const std::shared_ptr<ShardedPoolTemplate>& _this) {
+    std::thread poolCleanupTask(cleanupTask, _this);
+    poolCleanupTask.detach();
+  }
+
+  static provider::ResourceHandle<TResource> get(const std::shared_ptr<ShardedPoolTemplate>& _this) {
+
+    auto& shard = _this->getHomeShard();
+    v_int64 waitStart = -1;
+
+    while(_this->m_running) {
+
+      PoolRecord record;
+      if(_this->popRecord(shard, record)) {
+        _this->onAcquired(shard, true, waitStart < 0 ? -1 : oatpp::Environment::getMicroTickCount() - waitStart);
+        return provider::ResourceHandle<TResource>(
+          std::make_shared<AcquisitionProxyImpl>(record.resource, _this),
+          _this->m_invalidator
+        );
+      }
+
+      if(_this->reserve()) {
+        try {
+          auto resource = _this->m_provider->get();
+          ++ _this->m_creations;
+          _this->onAcquired(shard, false, waitStart < 0 ? -1 : oatpp::Environment::getMicroTickCount() - waitStart);
+          return provider::ResourceHandle<TResource>(
+            std::make_shared<AcquisitionProxyImpl>(resource, _this),
+            _this->m_invalidator
+          );
+        } catch (...) {
+          -- _this->m_counter;
+          _this->notifyWaiters();
+          return nullptr;
+        }
+      }
+
+      auto now = oatpp::Environment::getMicroTickCount();
+      if(waitStart < 0) {
+        waitStart = now;
+      }
+
+      std::unique_lock<std::mutex> guard(_this->m_waitLock);
+      ++ _this->m_syncWaiters;
+      bool ready = true;
+      if(_this->m_timeout == std::chrono::microseconds::zero()) {
+        while(!_this->isReady()) {
+          _this->m_condition.wait(guard);
+        }
+      } else {
+        auto remaining = waitStart + _this->m_timeout.count() - now;
+        ready = remaining > 0 && _this->m_condition.wait_for(guard, std::chrono::microseconds(remaining), [&_this]{ return _this->isReady(); });
+      }
+      -- _this->m_syncWaiters;
+
+      if(!ready) {
+        ++ _this->m_timeouts;
+        return nullptr;
+      }
+
+    }
+
+    return nullptr;
+
+  }
+
+  static async::CoroutineStarterForResult<const provider::ResourceHandle<TResource>&> getAsync(const std::shared_ptr<ShardedPoolTemplate>& _this) {
+
+    class GetCoroutine : public oatpp::async::CoroutineWithResult<GetCoroutine, const provider::ResourceHandle<TResource>&> {
+    private:
+      std::shared_ptr<ShardedPoolTemplate> m_pool;
+      std::chrono::system_clock::time_point m_startTime{std::chrono::system_clock::now()};
+      v_int64 m_waitStart{-1};
+      bool m_waiting{false};
+      bool m_reserved{false};
+    private:
+
+      void stopWaiting() {
+        if(m_waiting) {
+          m_waiting = false;
+          -- m_pool->m_asyncWaiters;
+        }
+      }
+
+      v_int64 getWaitTime() const {
+        return m_waitStart < 0 ? -1 : oatpp::Environment::getMicroTickCount() - m_waitStart;
+      }
+
+    public:
+
+      GetCoroutine(const std::shared_ptr<ShardedPoolTemplate>& pool)
+        : m_pool(pool)
+      {}
+
+      ~GetCoroutine() override {
+        stopWaiting();
+      }
+
+      bool timedout() const noexcept {
+        return m_pool->m_timeout != std::chrono::microseconds::zero() && m_pool->m_timeout < (std::chrono::system_clock::now() - m_startTime);
+      }
+
+      async::Action act() override {
+
+        stopWaiting();
+
+        if (timedout()) {
+          ++ m_pool->m_timeouts;
+          return this->_return(nullptr);
+        }
+
+        if(!m_pool->m_running) {
+          return this->_return(nullptr);
+        }
+
+        auto& shard = m_pool->getHomeShard();
+
+        PoolRecord record;
+        if(m_pool->popRecord(shard, record)) {
+          m_pool->onAcquired(shard, true, getWaitTime());
+          return this->_return(provider::ResourceHandle<TResource>(
+            std::make_shared<AcquisitionProxyImpl>(record.resource, m_pool),
+            m_pool->m_invalidator
+          ));
+        }
+
+        if(m_pool->reserve()) {
+          m_reserved = true;
+          return m_pool->m_provider->getAsync().callbackTo(&GetCoroutine::onGet);
+        }
+
+        if(m_waitStart < 0) {
+          m_waitStart = oatpp::Environment::getMicroTickCount();
+        }
+
+        m_waiting = true;
+        ++ m_pool->m_asyncWaiters;
+        if(m_pool->isReady()) {
+          return this->repeat();
+        }
+
+        return m_pool->m_timeout == std::chrono::microseconds::zero()
+          ? async::Action::createWaitListAction(&m_pool->m_waitList)
+          : async::Action::createWaitListAction(&m_pool->m_waitList, m_startTime + m_pool->m_timeout);
+
+      }
+
+      async::Action onGet(const provider::ResourceHandle<TResource>& resource) {
+        m_reserved = false;
+        ++ m_pool->m_creations;
+        m_pool->onAcquired(m_pool->getHomeShard(), false, getWaitTime());
+        return this->_return(provider::ResourceHandle<TResource>(
+          std::make_shared<AcquisitionProxyImpl>(resource, m_pool),
+          m_pool->m_invalidator
+        ));
+      }
+
+      async::Action handleError(oatpp::async::Error* error) override {
+        if(m_reserved) {
+          m_reserved = false;
+          -- m_pool->m_counter;
+          m_pool->notifyWaiters();
+        }
+        return error;
+      }
+
+    };
+
+    return GetCoroutine::startForResult(_this);
+
+  }
+
+public:
+
+  static std::shared_ptr<ShardedPoolTemplate> createShared(const std::shared_ptr<Provider<TResource>>& provider,
+                                                           v_int64 maxResources,
+                                                           const std::chrono::duration<v_int64, std::micro>& maxResourceTTL,
+                                                           const std::chrono::duration<v_int64, std::micro>& timeout,
+                                                           v_int32 shards = 0)
+  {
+    /* "new" is called directly to keep constructor private */
+    auto ptr = std::shared_ptr<ShardedPoolTemplate>(new ShardedPoolTemplate(provider, maxResources, maxResourceTTL.count(), timeout, shards));
+    startCleanupTask(ptr);
+    return ptr;
+  }
+
+  virtual ~ShardedPoolTemplate() override {
+    stop();
+  }
+
+  void stop() {
+
+    if(!m_running.exchange(false)) {
+      return;
+    }
+
+    /* invalidate all pooled resources */
+    std::vector<PoolRecord> records;
+    for(v_int64 i = 0; i < m_shardsCount; i ++) {
+      auto& shard = m_shards[static_cast<size_t>(i)];
+      std::lock_guard<oatpp::concurrency::SpinLock> guard(shard.lock);
+      shard.size -= static_cast<v_int64>(shard.bench.size());
+      std::move(shard.bench.begin(), shard.bench.end(), std::back_inserter(records));
+      shard.bench.clear();
+    }
+    invalidateRecords(records);
+
+    {
+      std::lock_guard<std::mutex> guard(m_waitLock);
+    }
+    m_condition.notify_all();
+    m_cleanupCondition.notify_all();
+    m_waitList.notifyAll();
+
+    {
+      std::unique_lock<std::mutex> guard(m_waitLock);
+      while (!m_finished) {
+        m_cleanupCondition.wait(guard);
+      }
+    }
+
+    m_provider->stop();
+
+  }
+
+  v_int64 getCounter() {
+    return m_counter.load();
+  }
+
+  v_int64 getShardsCount() const {
+    return m_shardsCount;
+  }
+
+  PoolStatistics getStatistics() {
+    PoolStatistics statistics;
+    for(v_int64 i = 0; i < m_shardsCount; i ++) {
+      statistics.acquisitions += m_shards[static_cast<size_t>(i)].acquisitions.load();
+      statistics.hits += m_shards[static_cast<size_t>(i)].hits.load();
+    }
+    statistics.creations = m_creations.load();
+    statistics.waits = m_waits.load();
+    statistics.waitTimeMicroseconds = m_waitTime.load();
+    statistics.maxWaitTimeMicroseconds = m_maxWaitTime.load();
+    statistics.timeouts = m_timeouts.load();
+    return statistics;
+  }
+
+};
+
+/**
+ * Sharded pool template class. Drop-in replacement of &id:oatpp::provider::Pool; for highly concurrent workloads. <br>
+ * See &l:ShardedPoolTemplate;.
+ * @tparam TProvider - base class for pool to inherit, ex.: ServerConnectionProvider.
+ * @tparam TResource - abstract resource interface type, Ex.: `IOStream`. Must be the same as a return-type of Provider.
+ * @tparam AcquisitionProxyImpl - implementation of &l:AcquisitionProxy;.
+ */
+template<class TProvider, class TResource, class AcquisitionProxyImpl>
+class ShardedPool :
+  public TProvider,
+  public std::enable_shared_from_this<ShardedPool<TProvider, TResource, AcquisitionProxyImpl>>,
+  public ShardedPoolTemplate<TResource, AcquisitionProxyImpl> {
+private:
+  typedef ShardedPoolTemplate<TResource, AcquisitionProxyImpl> TPool;
+protected:
+
+  /*
+   * Protected Constructor.
+   * @param provider
+   * @param maxResources
+   * @param maxResourceTTL
+   * @param timeout
+   * @param shards
+   */
+  ShardedPool(const std::shared_ptr<TProvider>& provider,
+              v_int64 maxResources,
+              v_int64 maxResourceTTL,
+              const std::chrono::duration<v_int64, std::micro>& timeout,
+              v_int32 shards)
+    : ShardedPoolTemplate<TResource, AcquisitionProxyImpl>(provider, maxResources, maxResourceTTL, timeout, shards)
+  {
+    TProvider::m_properties = provider->getProperties();
+  }
+
+public:
+
+  /**
+   * Create shared ShardedPool.
+   * @param provider - resource provider.
+   * @param maxResources - max resource count in the pool.
+   * @param maxResourceTTL - max time-to-live for unused resource in the pool.
+   * @param timeout - optional timeout on &l:ShardedPool::get (); and &l:ShardedPool::getAsync (); operations.
+   * @param shards - number of shards. `0` - number of hardware threads.
+   * @return - `std::shared_ptr` of `ShardedPool`.
+   */
+  static std::shared_ptr<ShardedPool> createShared(const std::shared_ptr<TProvider>& provider,
+                                                   v_int64 maxResources,
+                                                   const std::chrono::duration<v_int64, std::micro>& maxResourceTTL,
+                                                   const std::chrono::duration<v_int64, std::micro>& timeout = std::chrono::microseconds::zero(),
+                                                   v_int32 shards = 0)
+  {
+    /* "new" is called directly to keep constructor private */
+    auto ptr = std::shared_ptr<ShardedPool>(new ShardedPool(provider, maxResources, maxResourceTTL.count(), timeout, shards));
+    ptr->startCleanupTask(ptr);
+    return ptr;
+  }
+
+  /**
+   * Get resource.
+   * @return
+   */
+  provider::ResourceHandle<TResource> get() override {
+    return TPool::get(this->shared_from_this());
+  }
+
+  /**
+   * Get resource asynchronously.
+   * @return
+   */
+  async::CoroutineStarterForResult<const provider::ResourceHandle<TResource>&> getAsync() override {
+    return TPool::getAsync(this->shared_from_this());
+  }
+
+  /**
+   * Stop pool. <br>
+   * *Note: call to stop() may block.*
+   */
+  void stop() override {
+    TPool::stop();
+  }
+
+  /**
+   * Get pool resource count. Both acquired and available.
+   * @return
+   */
+  v_int64 getCounter() {
+    return TPool::getCounter();
+  }
+
+  /**
+   * Get pool statistics.
+   * @return - &l:PoolStatistics;.
+   */
+  PoolStatistics getStatistics() {
+    return TPool::getStatistics();
+  }
+
+};
+
+}}
+
+#endif // oatpp_provider_ShardedPool_hpp
@@ -24,88 +24,143 @@
 
 #include "Conversion.hpp"
 
+#include <charconv>
 #include <cstdlib>
+#include <cstdio>
+#include <cstring>
 
 namespace oatpp { namespace utils {
-  
-v_int32 Conversion::strToInt32(const char* str){
-  char* end;
-  return static_cast<v_int32>(std::strtol(str, &end, 10));
+
+namespace {
+
+/*
+ * std::from_chars doesn't skip leading whitespace and doesn't accept '+' sign - strto* functions do.
+ */
+const char* skipSpaceAndPlus(const char* begin, const char* end) {
+  while(begin < end && (*begin == ' ' || (*begin >= '\t' && *begin <= '\r'))) {
+    begin ++;
+  }
+  if(begin + 1 < end && begin[0] == '+' && begin[1] != '-') {
+    begin ++;
+  }
+  return begin;
 }
 
-v_int32 Conversion::strToInt32(const oatpp::String& str, bool& success){
+template<typename T>
+T parseNumber(const char* begin, const char* end, const char*& parsedEnd) {
+  T result = 0;
+  auto res = std::from_chars(skipSpaceAndPlus(begin, end), end, result);
+  if(res.ec == std::errc()) {
+    parsedEnd = res.ptr;
+    return result;
+  }
+  parsedEnd = begin;
+  return 0;
+}
+
+template<typename T>
+T parseNumber(const char* str) {
+  const char* parsedEnd;
+  return parseNumber<T>(str, str + std::strlen(str), parsedEnd);
+}
+
+template<typename T>
+T parseNumber(const oatpp::String& str, bool& success) {
   if(str == nullptr || str->empty()) {
     success = false;
     return 0;
   }
-  char* end;
-  v_int32 result = static_cast<v_int32>(std::strtol(str->data(), &end, 10));
-  success = ((reinterpret_cast<v_buff_size>(end) - reinterpret_cast<v_buff_size>(str->data())) == static_cast<v_buff_size>(str->size()));
+  const char* end = str->data() + str->size();
+  const char* parsedEnd;
+  T result = parseNumber<T>(str->data(), end, parsedEnd);
+  success = (parsedEnd == end);
   return result;
 }
 
+template<typename T>
+v_buff_size numberToCharSequence(T value, p_char8 data, v_buff_size n) {
+  auto begin = reinterpret_cast<char*>(data);
+  auto res = std::to_chars(begin, begin + n, value);
+  if(res.ec != std::errc()) {
+    return 0;
+  }
+  v_buff_size size = res.ptr - begin;
+  if(size < n) {
+    *res.ptr = 0;
+  }
+  return size;
+}
+
+}
+
+v_int32 Conversion::strToInt32(const char* str){
+  return parseNumber<v_int32>(str);
+}
+
+v_int32 Conversion::strToInt32(const oatpp::String& str, bool& success){
+  return parseNumber<v_int32>(str, success);
+}
+
 v_uint32 Conversion::strToUInt32(const char* str){
-  char* end;
-  return static_cast<v_uint32>(std::strtoul(str, &end, 10));
+  return parseNumber<v_uint32>(str);
 }
 
 v_uint32 Conversion::strToUInt32(const oatpp::String& str, bool& success){
-  if(str == nullptr || str->empty()) {
-    success = false;
-    return 0;
-  }
-  char* end;
-  v_uint32 result = static_cast<v_uint32>(std::strtoul(str->data(), &end, 10));
-  success = ((reinterpret_cast<v_buff_size>(end) - reinterpret_cast<v_buff_size>(str->data())) == static_cast<v_buff_size>(str->size()));
-  return result;
+  return parseNumber<v_uint32>(str, success);
 }
 
 v_int64 Conversion::strToInt64(const char* str){
-  char* end;
-  return std::strtoll(str, &end, 10);
+  return parseNumber<v_int64>(str);
 }
 
 v_int64 Conversion::strToInt64(const oatpp::String& str, bool& success){
-  if(str == nullptr || str->empty()) {
-    success = false;
-    return 0;
-  }
-  char* end;
-  v_int64 result = std::strtoll(str->data(), &end, 10);
-  success = ((reinterpret_cast<v_buff_size>(end) - reinterpret_cast<v_buff_size>(str->data())) == static_cast<v_buff_size>(str->size()));
-  return result;
+  return parseNumber<v_int64>(str, success);
 }
 
 v_uint64 Conversion::strToUInt64(const char* str){
-  char* end;
-  return std::strtoull(str, &end, 10);
+  return parseNumber<v_uint64>(str);
 }
 
 v_uint64 Conversion::strToUInt64(const oatpp::String& str, bool& success){
-  if(str == nullptr || str->empty()) {
-    success = false;
-    return 0;
+  return parseNumber<v_uint64>(str, success);
+}
+
+v_int64 Conversion::parseInt(const char* begin, const char* end, const char*& parsedEnd, int base) {
+  v_int64 result = 0;
+  auto res = std::from_chars(skipSpaceAndPlus(begin, end), end, result, base);
+  if(res.ec == std::errc()) {
+    parsedEnd = res.ptr;
+    return result;
   }
-  char* end;
-  v_uint64 result = std::strtoull(str->data(), &end, 10);
-  success = ((reinterpret_cast<v_buff_size>(end) - reinterpret_cast<v_buff_size>(str->data())) == static_cast<v_buff_size>(str->size()));
-  return result;
+  parsedEnd = begin;
+  return 0;
+}
+
+v_uint64 Conversion::parseUInt(const char* begin, const char* end, const char*& parsedEnd, int base) {
+  v_uint64 result = 0;
+  auto res = std::from_chars(skipSpaceAndPlus(begin, end), end, result, base);
+  if(res.ec == std::errc()) {
+    parsedEnd = res.ptr;
+    return result;
+  }
+  parsedEnd = begin;
+  return 0;
 }
 
 v_buff_size Conversion::int32ToCharSequence(v_int32 value, p_char8 data, v_buff_size n) {
-  return snprintf(reinterpret_cast<char*>(data), static_cast<size_t>(n), "%ld", static_cast<long>(value));
+  return numberToCharSequence(value, data, n);
 }
 
 v_buff_size Conversion::uint32ToCharSequence(v_uint32 value, p_char8 data, v_buff_size n) {
-  return snprintf(reinterpret_cast<char*>(data), static_cast<size_t>(n), "%lu", static_cast<unsigned long>(value));
+  return numberToCharSequence(value, data, n);
 }
 
 v_buff_size Conversion::int64ToCharSequence(v_int64 value, p_char8 data, v_buff_size n) {
-  return snprintf(reinterpret_cast<char*>(data), static_cast<size_t>(n), "%lld", static_cast<long long int>(value));
+  return numberToCharSequence(value, data, n);
 }
 
 v_buff_size Conversion::uint64ToCharSequence(v_uint64 value, p_char8 data, v_buff_size n) {
-  return snprintf(reinterpret_cast<char*>(data), static_cast<size_t>(n), "%llu", static_cast<long long unsigned int>(value));
+  return numberToCharSequence(value, data, n);
 }
 
 oatpp::String Conversion::int32ToStr(v_int32 value){
@@ -181,11 +236,18 @@ std::string Conversion::uint64ToStdStr(v_uint64 value){
 }
 
 v_float32 Conversion::strToFloat32(const char* str){
+#if defined(__cpp_lib_to_chars)
+  return parseNumber<v_float32>(str);
+#else
   char* end;
   return std::strtof(str, &end);
+#endif
 }
 
 v_float32 Conversion::strToFloat32(const oatpp::String& str, bool& success) {
+#if defined(__cpp_lib_to_chars)
+  return parseNumber<v_float32>(str, success);
+#else
   if(str == nullptr || str->empty()) {
     success = false;
     return 0;
@@ -194,14 +256,22 @@ v_float32 Conversion::strToFloat32(const oatpp::String& str, bool& success) {
   v_float32 result = std::strtof(str->data(), &end);
   success = ((reinterpret_cast<v_buff_size>(end) - reinterpret_cast<v_buff_size>(str->data())) == static_cast<v_buff_size>(str->size()));
   return result;
+#endif
 }
 
 v_float64 Conversion::strToFloat64(const char* str){
+#if defined(__cpp_lib_to_chars)
+  return parseNumber<v_float64>(str);
+#else
   char* end;
   return std::strtod(str, &end);
+#endif
 }
 
 v_float64 Conversion::strToFloat64(const oatpp::String& str, bool& success) {
+#if defined(__cpp_lib_to_chars)
+  return parseNumber<v_float64>(str, success);
+#else
   if(str == nullptr || str->empty()) {
     success = false;
     return 0;
@@ -210,13 +280,52 @@ v_float64 Conversion::strToFloat64(const oatpp::String& str, bool& success) {
   v_float64 result = std::strtod(str->data(), &end);
   success = ((reinterpret_cast<v_buff_size>(end) - reinterpret_cast<v_buff_size>(str->data())) == static_cast<v_buff_size>(str->size()));
   return result;
+#endif
+}
+
+v_float64 Conversion::parseFloat64(const char* begin, const char* end, const char*& parsedEnd) {
+#if defined(__cpp_lib_to_chars)
+  return parseNumber<v_float64>(begin, end, parsedEnd);
+#else
+  (void) end;
+  char* strEnd;
+  v_float64 result = std::strtod(begin, &strEnd);
+  parsedEnd = strEnd;
+  return result;
+#endif
+}
+
+v_float32 Conversion::parseFloat32(const char* begin, const char* end, const char*& parsedEnd) {
+#if defined(__cpp_lib_to_chars)
+  return parseNumber<v_float32>(begin, end, parsedEnd);
+#else
+  (void) end;
+  char* strEnd;
+  v_float32 result = std::strtof(begin, &strEnd);
+  parsedEnd = strEnd;
+  return result;
+#endif
 }
 
 v_buff_size Conversion::float32ToCharSequence(v_float32 value, p_char8 data, v_buff_size n, const char* format) {
+  if(format == nullptr) {
+#if defined(__cpp_lib_to_chars)
+    return numberToCharSequence(value, data, n);
+#else
+    format = "%.9g";
+#endif
+  }
   return snprintf(reinterpret_cast<char*>(data), static_cast<size_t>(n), format, static_cast<double>(value));
 }
 
 v_buff_size Conversion::float64ToCharSequence(v_float64 value, p_char8 data, v_buff_size n, const char* format) {
+  if(format == nullptr) {
+#if defined(__cpp_lib_to_chars)
+    return numberToCharSequence(value, data, n);
+#else
+    format = "%.17g";
+#endif
+  }
   return snprintf(reinterpret_cast<char*>(data), static_cast<size_t>(n), format, value);
 }
 
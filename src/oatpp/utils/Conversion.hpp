@@ -102,6 +102,28 @@ public:
    */
   static v_uint64 strToUInt64(const oatpp::String &str, bool &success);
 
+  /**
+   * Parse integer at the beginning of the `[begin, end)` range. <br>
+   * Doesn't require null-terminated string. Leading whitespace and `'+'` sign are skipped.
+   * @param begin - pointer to the first char.
+   * @param end - pointer past the last char.
+   * @param parsedEnd - out parameter. Pointer past the last parsed char. `begin` if nothing was parsed or value is out of range.
+   * @param base - base.
+   * @return - 64-bit integer value.
+   */
+  static v_int64 parseInt(const char* begin, const char* end, const char*& parsedEnd, int base = 10);
+
+  /**
+   * Parse unsigned integer at the beginning of the `[begin, end)` range. <br>
+   * Doesn't require null-terminated string. Leading whitespace and `'+'` sign are skipped.
+   * @param begin - pointer to the first char.
+   * @param end - pointer past the last char.
+   * @param parsedEnd - out parameter. Pointer past the last parsed char. `begin` if nothing was parsed or value is out of range.
+   * @param base - base.
+   * @return - 64-bit unsigned integer value.
+   */
+  static v_uint64 parseUInt(const char* begin, const char* end, const char*& parsedEnd, int base = 10);
+
   /**
    * Convert 32-bit integer to it's string representation.
    * @param value - 32-bit integer value.
@@ -255,11 +277,30 @@ public:
    */
   static v_float64 strToFloat64(const oatpp::String &str, bool &success);
 
+  /**
+   * Parse 32-bit float at the beginning of the `[begin, end)` range. Locale independent.
+   * @param begin - pointer to the first char.
+   * @param end - pointer past the last char.
+   * @param parsedEnd - out parameter. Pointer past the last parsed char. `begin` if nothing was parsed or value is out of range.
+   * @return - 32-bit float value.
+   */
+  static v_float32 parseFloat32(const char* begin, const char* end, const char*& parsedEnd);
+
+  /**
+   * Parse 64-bit float at the beginning of the `[begin, end)` range. Locale independent.
+   * @param begin - pointer to the first char.
+   * @param end - pointer past the last char.
+   * @param parsedEnd - out parameter. Pointer past the last parsed char. `begin` if nothing was parsed or value is out of range.
+   * @return - 64-bit float value.
+   */
+  static v_float64 parseFloat64(const char* begin, const char* end, const char*& parsedEnd);
+
   /**
    * Convert 32-bit float to it's string representation.
    * @param value - 32-bit float value.
    * @param data - buffer to write data to.
    * @param n - buffer size.
+   * @param format - `snprintf` format. `nullptr` - shortest representation which parses back to the same value.
    * @return - length of the resultant string.
    */
   static v_buff_size float32ToCharSequence(v_float32 value, p_char8 data, v_buff_size n, const char *format = OATPP_FLOAT_STRING_FORMAT);
@@ -269,6 +310,7 @@ public:
    * @param value - 64-bit float value.
    * @param data - buffer to write data to.
    * @param n - buffer size.
+   * @param format - `snprintf` format. `nullptr` - shortest representation which parses back to the same value.
    * @return - length of the resultant string.
    */
   static v_buff_size float64ToCharSequence(v_float64 value, p_char8 data, v_buff_size n, const char *format = OATPP_FLOAT_STRING_FORMAT);
@@ -276,6 +318,7 @@ public:
   /**
    * Convert 32-bit float to it's string representation.
    * @param value - 32-bit float value.
+   * @param format - `snprintf` format. `nullptr` - shortest representation which parses back to the same value.
    * @return - value as `oatpp::String`
    */
   static oatpp::String float32ToStr(v_float32 value, const char *format = OATPP_FLOAT_STRING_FORMAT);
@@ -283,6 +326,7 @@ public:
   /**
    * Convert 64-bit float to it's string representation.
    * @param value - 64-bit float value.
+   * @param format - `snprintf` format. `nullptr` - shortest representation which parses back to the same value.
    * @return - value as `oatpp::String`
    */
   static oatpp::String float64ToStr(v_float64 value, const char *format = OATPP_FLOAT_STRING_FORMAT);
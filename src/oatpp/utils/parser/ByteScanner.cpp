@@ -0,0 +1,295 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ByteScanner.hpp"
+
+#if !defined(OATPP_DISABLE_SIMD) && (defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__)))
+  #define OATPP_BYTE_SCANNER_SSE2
+  #include <emmintrin.h>
+  #if defined(__GNUC__) || defined(__clang__)
+    #define OATPP_BYTE_SCANNER_AVX2
+    #include <immintrin.h>
+  #endif
+  #if defined(_MSC_VER)
+    #include <intrin.h>
+  #endif
+#endif
+
+namespace oatpp { namespace utils { namespace parser {
+
+/////////////////////////////////////////////////////////////////////////////////
+// ByteScanner::Scalar
+
+v_buff_size ByteScanner::Scalar::findChar(const char* data, v_buff_size size, char c) {
+  for(v_buff_size i = 0; i < size; i ++) {
+    if(data[i] == c) {
+      return i;
+    }
+  }
+  return size;
+}
+
+v_buff_size ByteScanner::Scalar::findEitherChar(const char* data, v_buff_size size, char a, char b) {
+  for(v_buff_size i = 0; i < size; i ++) {
+    if(data[i] == a || data[i] == b) {
+      return i;
+    }
+  }
+  return size;
+}
+
+v_buff_size ByteScanner::Scalar::findRN(const char* data, v_buff_size size) {
+  for(v_buff_size i = 0; i + 1 < size; i ++) {
+    if(data[i] == '\r' && data[i + 1] == '\n') {
+      return i;
+    }
+  }
+  return size;
+}
+
+v_buff_size ByteScanner::Scalar::findRNRN(const char* data, v_buff_size size) {
+  for(v_buff_size i = 0; i + 3 < size; i ++) {
+    if(data[i] == '\r' && data[i + 1] == '\n' && data[i + 2] == '\r' && data[i + 3] == '\n') {
+      return i;
+    }
+  }
+  return size;
+}
+
+namespace {
+
+/////////////////////////////////////////////////////////////////////////////////
+// Implementations
+
+struct Implementation {
+  const char* name;
+  v_buff_size (*findChar)(const char* data, v_buff_size size, char c);
+  v_buff_size (*findEitherChar)(const char* data, v_buff_size size, char a, char b);
+  v_buff_size (*findRN)(const char* data, v_buff_size size);
+  v_buff_size (*findRNRN)(const char* data, v_buff_size size);
+};
+
+#if defined(OATPP_BYTE_SCANNER_SSE2)
+
+inline v_buff_size lowestBit(v_uint32 mask) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return static_cast<v_buff_size>(index);
+#else
+  return static_cast<v_buff_size>(__builtin_ctz(mask));
+#endif
+}
+
+inline v_uint32 maskEq16(const char* data, __m128i needle) {
+  __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+  return static_cast<v_uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+}
+
+v_buff_size findChar_SSE2(const char* data, v_buff_size size, char c) {
+  const __m128i vc = _mm_set1_epi8(c);
+  v_buff_size i = 0;
+  for(; i + 16 <= size; i += 16) {
+    v_uint32 mask = maskEq16(data + i, vc);
+    if(mask != 0) {
+      return i + lowestBit(mask);
+    }
+  }
+  return i + ByteScanner::Scalar::findChar(data + i, size - i, c);
+}
+
+v_buff_size findEitherChar_SSE2(const char* data, v_buff_size size, char a, char b) {
+  const __m128i va = _mm_set1_epi8(a);
+  const __m128i vb = _mm_set1_epi8(b);
+  v_buff_size i = 0;
+  for(; i + 16 <= size; i += 16) {
+    v_uint32 mask = maskEq16(data + i, va) | maskEq16(data + i, vb);
+    if(mask != 0) {
+      return i + lowestBit(mask);
+    }
+  }
+  return i + ByteScanner::Scalar::findEitherChar(data + i, size - i, a, b);
+}
+
+v_buff_size findRN_SSE2(const char* data, v_buff_size size) {
+  const __m128i vr = _mm_set1_epi8('\r');
+  const __m128i vn = _mm_set1_epi8('\n');
+  v_buff_size i = 0;
+  for(; i + 17 <= size; i += 16) {
+    v_uint32 mask = maskEq16(data + i, vr) & maskEq16(data + i + 1, vn);
+    if(mask != 0) {
+      return i + lowestBit(mask);
+    }
+  }
+  return i + ByteScanner::Scalar::findRN(data + i, size - i);
+}
+
+v_buff_size findRNRN_SSE2(const char* data, v_buff_size size) {
+  const __m128i vr = _mm_set1_epi8('\r');
+  const __m128i vn = _mm_set1_epi8('\n');
+  v_buff_size i = 0;
+  for(; i + 19 <= size; i += 16) {
+    v_uint32 mask = maskEq16(data + i, vr) & maskEq16(data + i + 1, vn);
+    if(mask != 0) {
+      mask &= maskEq16(data + i + 2, vr) & maskEq16(data + i + 3, vn);
+      if(mask != 0) {
+        return i + lowestBit(mask);
+      }
+    }
+  }
+  return i + ByteScanner::Scalar::findRNRN(data + i, size - i);
+}
+
+const Implementation IMPLEMENTATION_SSE2 = {"SSE2", &findChar_SSE2, &findEitherChar_SSE2, &findRN_SSE2, &findRNRN_SSE2};
+
+#endif
+
+#if defined(OATPP_BYTE_SCANNER_AVX2)
+
+__attribute__((target("avx2")))
+inline v_uint32 maskEq32(const char* data, __m256i needle) {
+  __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+  return static_cast<v_uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+}
+
+__attribute__((target("avx2")))
+v_buff_size findChar_AVX2(const char* data, v_buff_size size, char c) {
+  const __m256i vc = _mm256_set1_epi8(c);
+  v_buff_size i = 0;
+  for(; i + 32 <= size; i += 32) {
+    v_uint32 mask = maskEq32(data + i, vc);
+    if(mask != 0) {
+      return i + lowestBit(mask);
+    }
+  }
+  return i + findChar_SSE2(data + i, size - i, c);
+}
+
+__attribute__((target("avx2")))
+v_buff_size findEitherChar_AVX2(const char* data, v_buff_size size, char a, char b) {
+  const __m256i va = _mm256_set1_epi8(a);
+  const __m256i vb = _mm256_set1_epi8(b);
+  v_buff_size i = 0;
+  for(; i + 32 <= size; i += 32) {
+    v_uint32 mask = maskEq32(data + i, va) | maskEq32(data + i, vb);
+    if(mask != 0) {
+      return i + lowestBit(mask);
+    }
+  }
+  return i + findEitherChar_SSE2(data + i, size - i, a, b);
+}
+
+__attribute__((target("avx2")))
+v_buff_size findRN_AVX2(const char* data, v_buff_size size) {
+  const __m256i vr = _mm256_set1_epi8('\r');
+  const __m256i vn = _mm256_set1_epi8('\n');
+  v_buff_size i = 0;
+  for(; i + 33 <= size; i += 32) {
+    v_uint32 mask = maskEq32(data + i, vr) & maskEq32(data + i + 1, vn);
+    if(mask != 0) {
+      return i + lowestBit(mask);
+    }
+  }
+  return i + findRN_SSE2(data + i, size - i);
+}
+
+__attribute__((target("avx2")))
+v_buff_size findRNRN_AVX2(const char* data, v_buff_size size) {
+  const __m256i vr = _mm256_set1_epi8('\r');
+  const __m256i vn = _mm256_set1_epi8('\n');
+  v_buff_size i = 0;
+  for(; i + 35 <= size; i += 32) {
+    v_uint32 mask = maskEq32(data + i, vr) & maskEq32(data + i + 1, vn);
+    if(mask != 0) {
+      mask &= maskEq32(data + i + 2, vr) & maskEq32(data + i + 3, vn);
+      if(mask != 0) {
+        return i + lowestBit(mask);
+      }
+    }
+  }
+  return i + findRNRN_SSE2(data + i, size - i);
+}
+
+const Implementation IMPLEMENTATION_AVX2 = {"AVX2", &findChar_AVX2, &findEitherChar_AVX2, &findRN_AVX2, &findRNRN_AVX2};
+
+#endif
+
+#if !defined(OATPP_BYTE_SCANNER_SSE2)
+
+const Implementation IMPLEMENTATION_SCALAR = {
+  "scalar",
+  &ByteScanner::Scalar::findChar,
+  &ByteScanner::Scalar::findEitherChar,
+  &ByteScanner::Scalar::findRN,
+  &ByteScanner::Scalar::findRNRN
+};
+
+#endif
+
+const Implementation& chooseImplementation() {
+#if defined(OATPP_BYTE_SCANNER_AVX2)
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx2")) {
+    return IMPLEMENTATION_AVX2;
+  }
+#endif
+#if defined(OATPP_BYTE_SCANNER_SSE2)
+  return IMPLEMENTATION_SSE2;
+#else
+  return IMPLEMENTATION_SCALAR;
+#endif
+}
+
+const Implementation& getImplementation() {
+  static const Implementation& implementation = chooseImplementation();
+  return implementation;
+}
+
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+// ByteScanner
+
+v_buff_size ByteScanner::findChar(const char* data, v_buff_size size, char c) {
+  return getImplementation().findChar(data, size, c);
+}
+
+v_buff_size ByteScanner::findEitherChar(const char* data, v_buff_size size, char a, char b) {
+  return getImplementation().findEitherChar(data, size, a, b);
+}
+
+v_buff_size ByteScanner::findRN(const char* data, v_buff_size size) {
+  return getImplementation().findRN(data, size);
+}
+
+v_buff_size ByteScanner::findRNRN(const char* data, v_buff_size size) {
+  return getImplementation().findRNRN(data, size);
+}
+
+const char* ByteScanner::getImplementationName() {
+  return getImplementation().name;
+}
+
+}}}
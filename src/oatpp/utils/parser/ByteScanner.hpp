@@ -0,0 +1,132 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_utils_parser_ByteScanner_hpp
+#define oatpp_utils_parser_ByteScanner_hpp
+
+#include "oatpp/Types.hpp"
+
+namespace oatpp { namespace utils { namespace parser {
+
+/**
+ * Vectorized byte search used by the HTTP parsers. <br>
+ * Uses AVX2 (if supported by CPU at runtime) or SSE2 on x86 and plain scalar loops on other platforms.
+ * Build with `OATPP_DISABLE_SIMD` to always use scalar implementation. <br>
+ * All methods return position of the match relative to `data`, or `size` if nothing is found.
+ */
+class ByteScanner {
+public:
+
+  /**
+   * Reference (non-vectorized) implementation. Used as a fallback and for verification.
+   */
+  class Scalar {
+  public:
+
+    /**
+     * Find first occurrence of the char `c`.
+     * @param data - pointer to data.
+     * @param size - data size.
+     * @param c - char to find.
+     * @return - position of the char or `size` if not found.
+     */
+    static v_buff_size findChar(const char* data, v_buff_size size, char c);
+
+    /**
+     * Find first occurrence of either char `a` or char `b`.
+     * @param data - pointer to data.
+     * @param size - data size.
+     * @param a - char to find.
+     * @param b - char to find.
+     * @return - position of the char or `size` if not found.
+     */
+    static v_buff_size findEitherChar(const char* data, v_buff_size size, char a, char b);
+
+    /**
+     * Find first occurrence of `\r\n`.
+     * @param data - pointer to data.
+     * @param size - data size.
+     * @return - position of `\r` or `size` if not found.
+     */
+    static v_buff_size findRN(const char* data, v_buff_size size);
+
+    /**
+     * Find first occurrence of `\r\n\r\n`.
+     * @param data - pointer to data.
+     * @param size - data size.
+     * @return - position of the first `\r` or `size` if not found.
+     */
+    static v_buff_size findRNRN(const char* data, v_buff_size size);
+
+  };
+
+public:
+
+  /**
+   * Find first occurrence of the char `c`.
+   * @param data - pointer to data.
+   * @param size - data size.
+   * @param c - char to find.
+   * @return - position of the char or `size` if not found.
+   */
+  static v_buff_size findChar(const char* data, v_buff_size size, char c);
+
+  /**
+   * Find first occurrence of either char `a` or char `b`.
+   * @param data - pointer to data.
+   * @param size - data size.
+   * @param a - char to find.
+   * @param b - char to find.
+   * @return - position of the char or `size` if not found.
+   */
+  static v_buff_size findEitherChar(const char* data, v_buff_size size, char a, char b);
+
+  /**
+   * Find first occurrence of `\r\n`.
+   * @param data - pointer to data.
+   * @param size - data size.
+   * @return - position of `\r` or `size` if not found.
+   */
+  static v_buff_size findRN(const char* data, v_buff_size size);
+
+  /**
+   * Find first occurrence of `\r\n\r\n`.
+   * @param data - pointer to data.
+   * @param size - data size.
+   * @return - position of the first `\r` or `size` if not found.
+   */
+  static v_buff_size findRNRN(const char* data, v_buff_size size);
+
+  /**
+   * Name of the implementation selected for this CPU - `"AVX2"`, `"SSE2"` or `"scalar"`.
+   * @return
+   */
+  static const char* getImplementationName();
+
+};
+
+}}}
+
+#endif // oatpp_utils_parser_ByteScanner_hpp
@@ -23,6 +23,9 @@
  ***************************************************************************/
 
 #include "Caret.hpp"
+#include "ByteScanner.hpp"
+
+#include "oatpp/utils/Conversion.hpp"
 
 #include <cstdlib>
 #include <algorithm>
@@ -237,14 +240,14 @@ v_int64 Caret::StateSaveGuard::getSavedErrorCode() {
   }
   
   bool Caret::findChar(char c){
-    
-    while(m_pos < m_size){
-      if(m_data[m_pos] == c)
-        return true;
-      m_pos ++;
+
+    if(m_pos >= m_size) {
+      return false;
     }
-    
-    return false;
+
+    m_pos += ByteScanner::findChar(&m_data[m_pos], m_size - m_pos, c);
+    return m_pos < m_size;
+
   }
   
   bool Caret::skipCharsFromSet(const char* set){
@@ -287,17 +290,14 @@ v_int64 Caret::StateSaveGuard::getSavedErrorCode() {
   }
   
   bool Caret::findRN() {
-    
-    while(m_pos < m_size){
-      if(m_data[m_pos] == '\r'){
-        if(m_pos + 1 < m_size && m_data[m_pos + 1] == '\n'){
-          return true;
-        }
-      }
-      m_pos ++;
+
+    if(m_pos >= m_size) {
+      return false;
     }
-    
-    return false;
+
+    m_pos += ByteScanner::findRN(&m_data[m_pos], m_size - m_pos);
+    return m_pos < m_size;
+
   }
   
   bool Caret::skipRN() {
@@ -314,14 +314,11 @@ v_int64 Caret::StateSaveGuard::getSavedErrorCode() {
 
 
   bool Caret::findROrN() {
-    while(m_pos < m_size) {
-      char a = m_data[m_pos];
-      if(a == '\r' || a == '\n') {
-        return true;
-      }
-      m_pos ++;
+    if(m_pos >= m_size) {
+      return false;
     }
-    return false;
+    m_pos += ByteScanner::findEitherChar(&m_data[m_pos], m_size - m_pos, '\r', '\n');
+    return m_pos < m_size;
   }
 
   bool Caret::skipRNOrN() {
@@ -351,46 +348,46 @@ v_int64 Caret::StateSaveGuard::getSavedErrorCode() {
   }
 
   v_int64 Caret::parseInt(int base) {
-    char* end;
-    char* start = const_cast<char*>(&m_data[m_pos]);
-    v_int64 result = static_cast<v_int64>(std::strtoll(start, &end, base));
+    const char* start = &m_data[m_pos];
+    const char* end;
+    v_int64 result = Conversion::parseInt(start, &m_data[m_size], end, base);
     if(start == end){
       m_errorMessage = ERROR_INVALID_INTEGER;
     }
-    m_pos = (reinterpret_cast<v_buff_size>(end) - reinterpret_cast<v_buff_size>(m_data));
+    m_pos = end - m_data;
     return result;
   }
 
   v_uint64 Caret::parseUnsignedInt(int base) {
-    char* end;
-    char* start = const_cast<char*>(&m_data[m_pos]);
-    v_uint64 result = static_cast<v_uint64>(std::strtoull(start, &end, base));
+    const char* start = &m_data[m_pos];
+    const char* end;
+    v_uint64 result = Conversion::parseUInt(start, &m_data[m_size], end, base);
     if(start == end){
       m_errorMessage = ERROR_INVALID_INTEGER;
     }
-    m_pos = (reinterpret_cast<v_buff_size>(end) - reinterpret_cast<v_buff_size>(m_data));
+    m_pos = end - m_data;
     return result;
   }
   
   v_float32 Caret::parseFloat32(){
-    char* end;
-    char* start = const_cast<char*>(&m_data[m_pos]);
-    v_float32 result = std::strtof(start , &end);
+    const char* start = &m_data[m_pos];
+    const char* end;
+    v_float32 result = Conversion::parseFloat32(start, &m_data[m_size], end);
     if(start == end){
       m_errorMessage = ERROR_INVALID_FLOAT;
     }
-    m_pos = (reinterpret_cast<v_buff_size>(end) - reinterpret_cast<v_buff_size>(m_data));
+    m_pos = end - m_data;
     return result;
   }
   
   v_float64 Caret::parseFloat64(){
-    char* end;
-    char* start = const_cast<char*>(&m_data[m_pos]);
-    v_float64 result = std::strtod(start , &end);
+    const char* start = &m_data[m_pos];
+    const char* end;
+    v_float64 result = Conversion::parseFloat64(start, &m_data[m_size], end);
     if(start == end){
       m_errorMessage = ERROR_INVALID_FLOAT;
     }
-    m_pos = (reinterpret_cast<v_buff_size>(end) - reinterpret_cast<v_buff_size>(m_data));
+    m_pos = end - m_data;
     return result;
   }
   
@@ -345,42 +345,30 @@ public:
 
   /**
    * parse integer value starting from the current position.
-   * Using function std::strtol()
-   *
-   * Warning: position may go out of @Caret::getSize() bound.
-   *
-   * @param base - base is passed to std::strtol function
+   * Using &id:oatpp::utils::Conversion::parseInt; (`std::from_chars`). Doesn't read past the data end.
+   * @param base - base.
    * @return parsed value
    */
   v_int64 parseInt(int base = 10);
 
   /**
    * parse integer value starting from the current position.
-   * Using function std::strtoul()
-   *
-   * Warning: position may go out of @Caret::getSize() bound.
-   *
-   * @param base - base is passed to std::strtoul function
+   * Using &id:oatpp::utils::Conversion::parseUInt; (`std::from_chars`). Doesn't read past the data end.
+   * @param base - base.
    * @return parsed value
    */
   v_uint64 parseUnsignedInt(int base = 10);
 
   /**
    * parse float value starting from the current position.
-   * Using function std::strtof()
-   *
-   * Warning: position may go out of @Caret::getSize() bound.
-   *
+   * Using &id:oatpp::utils::Conversion::parseFloat32; (`std::from_chars`). Locale independent.
    * @return parsed value
    */
   v_float32 parseFloat32();
 
   /**
    * parse float value starting from the current position.
-   * Using function std::strtod()
-   *
-   * Warning: position may go out of @Caret::getSize() bound.
-   *
+   * Using &id:oatpp::utils::Conversion::parseFloat64; (`std::from_chars`). Locale independent.
    * @return parsed value
    */
   v_float64 parseFloat64();
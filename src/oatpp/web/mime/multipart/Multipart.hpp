@@ -32,9 +32,9 @@ namespace oatpp { namespace web { namespace mime { namespace multipart {
 
 /**
  * Typedef for headers map. Headers map key is case-insensitive.
- * For more info see &id:oatpp::data::share::LazyStringMap;.
+ * For more info see &id:oatpp::data::share::LazyStringFlatMultimap;.
  */
-typedef oatpp::data::share::LazyStringMultimap<oatpp::data::share::StringKeyLabelCI> Headers;
+typedef oatpp::data::share::LazyStringFlatMultimap<oatpp::data::share::StringKeyLabelCI> Headers;
 
 /**
  * Abstract Multipart.
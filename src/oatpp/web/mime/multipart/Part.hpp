@@ -25,7 +25,7 @@
 #ifndef oatpp_web_mime_multipart_Part_hpp
 #define oatpp_web_mime_multipart_Part_hpp
 
-#include "oatpp/data/share/LazyStringMap.hpp"
+#include "oatpp/data/share/LazyStringFlatMap.hpp"
 #include "oatpp/data/resource/Resource.hpp"
 
 namespace oatpp { namespace web { namespace mime { namespace multipart {
@@ -37,9 +37,9 @@ class Part {
 public:
   /**
    * Typedef for headers map. Headers map key is case-insensitive.
-   * For more info see &id:oatpp::data::share::LazyStringMap;.
+   * For more info see &id:oatpp::data::share::LazyStringFlatMultimap;.
    */
-  typedef oatpp::data::share::LazyStringMultimap<oatpp::data::share::StringKeyLabelCI> Headers;
+  typedef oatpp::data::share::LazyStringFlatMultimap<oatpp::data::share::StringKeyLabelCI> Headers;
 private:
   oatpp::String m_name;
   oatpp::String m_filename;
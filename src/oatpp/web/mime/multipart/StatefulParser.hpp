@@ -26,7 +26,7 @@
 #define oatpp_web_mime_multipart_StatefulParser_hpp
 
 #include "oatpp/data/stream/BufferStream.hpp"
-#include "oatpp/data/share/LazyStringMap.hpp"
+#include "oatpp/data/share/LazyStringFlatMap.hpp"
 #include "oatpp/Types.hpp"
 
 #include <unordered_map>
@@ -49,9 +49,9 @@ private:
 private:
   /**
    * Typedef for headers map. Headers map key is case-insensitive.
-   * For more info see &id:oatpp::data::share::LazyStringMap;.
+   * For more info see &id:oatpp::data::share::LazyStringFlatMultimap;.
    */
-  typedef oatpp::data::share::LazyStringMultimap<oatpp::data::share::StringKeyLabelCI> Headers;
+  typedef oatpp::data::share::LazyStringFlatMultimap<oatpp::data::share::StringKeyLabelCI> Headers;
 public:
 
   /**
@@ -61,9 +61,9 @@ public:
   public:
     /**
      * Typedef for headers map. Headers map key is case-insensitive.
-     * For more info see &id:oatpp::data::share::LazyStringMap;.
+     * For more info see &id:oatpp::data::share::LazyStringFlatMultimap;.
      */
-    typedef oatpp::data::share::LazyStringMultimap<oatpp::data::share::StringKeyLabelCI> Headers;
+    typedef oatpp::data::share::LazyStringFlatMultimap<oatpp::data::share::StringKeyLabelCI> Headers;
   public:
 
     /**
@@ -98,9 +98,9 @@ public:
   public:
     /**
      * Typedef for headers map. Headers map key is case-insensitive.
-     * For more info see &id:oatpp::data::share::LazyStringMap;.
+     * For more info see &id:oatpp::data::share::LazyStringFlatMultimap;.
      */
-    typedef oatpp::data::share::LazyStringMultimap<oatpp::data::share::StringKeyLabelCI> Headers;
+    typedef oatpp::data::share::LazyStringFlatMultimap<oatpp::data::share::StringKeyLabelCI> Headers;
   public:
 
     /**
@@ -26,6 +26,7 @@
 
 #include "oatpp/data/stream/BufferStream.hpp"
 #include "oatpp/utils/Conversion.hpp"
+#include "oatpp/utils/parser/ByteScanner.hpp"
 
 namespace oatpp { namespace web { namespace protocol { namespace http {
   
@@ -134,6 +135,7 @@ const char* const Header::CORS_MAX_AGE = "Access-Control-Max-Age";
 const char* const Header::ACCEPT_ENCODING = "Accept-Encoding";
 
 const char* const Header::EXPECT = "Expect";
+const char* const Header::ETAG = "ETag";
 
 const char* const Range::UNIT_BYTES = "bytes";
 const char* const ContentRange::UNIT_BYTES = "bytes";
@@ -144,7 +146,9 @@ oatpp::String Range::toString() const {
   stream.writeSimple("=", 1);
   stream.writeAsString(start);
   stream.writeSimple("-", 1);
-  stream.writeAsString(end);
+  if(end >= 0) {
+    stream.writeAsString(end);
+  }
   return stream.toString();
 }
 
@@ -173,7 +177,10 @@ Range Range::parse(oatpp::utils::parser::Caret& caret) {
   endLabel.end();
 
   auto start = oatpp::utils::Conversion::strToInt64(startLabel.getData());
-  auto end = oatpp::utils::Conversion::strToInt64(endLabel.getData());
+  v_int64 end = -1; // open-ended range - "bytes=100-"
+  if(endLabel.getSize() > 0) {
+    end = oatpp::utils::Conversion::strToInt64(endLabel.getData());
+  }
   return Range(unitsLabel.toString(), start, end);
   
 }
@@ -265,13 +272,13 @@ oatpp::String HeaderValueData::getTitleParamValue(const data::share::StringKeyLa
 oatpp::data::share::StringKeyLabelCI Parser::parseHeaderNameLabel(const std::shared_ptr<std::string>& headersText,
                                                                   oatpp::utils::parser::Caret& caret) {
   const char* data = caret.getData();
-  for(v_buff_size i = caret.getPosition(); i < caret.getDataSize(); i++) {
-    v_char8 a = static_cast<v_char8>(data[i]);
-    if(a == ':' || a == ' '){
-      oatpp::data::share::StringKeyLabelCI label(headersText, &data[caret.getPosition()], i - caret.getPosition());
+  v_buff_size pos = caret.getPosition();
+  if(pos < caret.getDataSize()) {
+    v_buff_size i = pos + utils::parser::ByteScanner::findEitherChar(&data[pos], caret.getDataSize() - pos, ':', ' ');
+    if(i < caret.getDataSize()) {
+      oatpp::data::share::StringKeyLabelCI label(headersText, &data[pos], i - pos);
       caret.setPosition(i);
       return label;
-      
     }
   }
   return oatpp::data::share::StringKeyLabelCI(nullptr, nullptr, 0);
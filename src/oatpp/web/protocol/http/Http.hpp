@@ -31,6 +31,7 @@
 
 #include "oatpp/utils/parser/Caret.hpp"
 #include "oatpp/data/share/LazyStringMap.hpp"
+#include "oatpp/data/share/LazyStringFlatMap.hpp"
 #include "oatpp/Types.hpp"
 
 #include <unordered_map>
@@ -40,9 +41,9 @@ namespace oatpp { namespace web { namespace protocol { namespace http {
 
 /**
  * Typedef for headers map. Headers map key is case-insensitive.
- * For more info see &id:oatpp::data::share::LazyStringMultimap;.
+ * For more info see &id:oatpp::data::share::LazyStringFlatMultimap;.
  */
-typedef oatpp::data::share::LazyStringMultimap<oatpp::data::share::StringKeyLabelCI> Headers;
+typedef oatpp::data::share::LazyStringFlatMultimap<oatpp::data::share::StringKeyLabelCI> Headers;
 
 /**
  * Typedef for query parameters map.
@@ -506,6 +507,7 @@ public:
   static const char* const CORS_MAX_AGE;        // Access-Control-Max-Age
   static const char* const ACCEPT_ENCODING;     // Accept-Encoding
   static const char* const EXPECT;              // Expect
+  static const char* const ETAG;                // ETag
 };
   
 class Range {
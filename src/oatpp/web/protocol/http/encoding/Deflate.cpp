@@ -0,0 +1,280 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "Deflate.hpp"
+
+#ifdef OATPP_ZLIB_SUPPORTED
+
+#include <zlib.h>
+#include <limits>
+
+namespace oatpp { namespace web { namespace protocol { namespace http { namespace encoding {
+
+namespace {
+
+int getWindowBits(DeflateFormat format) {
+  switch(format) {
+    case DeflateFormat::GZIP: return MAX_WBITS + 16;
+    case DeflateFormat::DEFLATE:
+    default:
+      return MAX_WBITS;
+  }
+}
+
+void setStreamInput(z_stream* zStream, data::buffer::InlineReadData& dataIn) {
+  if(dataIn.currBufferPtr != nullptr) {
+    v_buff_size size = dataIn.bytesLeft;
+    if(size > std::numeric_limits<uInt>::max()) {
+      size = std::numeric_limits<uInt>::max();
+    }
+    zStream->next_in = reinterpret_cast<Bytef*>(dataIn.currBufferPtr);
+    zStream->avail_in = static_cast<uInt>(size);
+  } else {
+    zStream->next_in = nullptr;
+    zStream->avail_in = 0;
+  }
+}
+
+void consumeStreamInput(z_stream* zStream, data::buffer::InlineReadData& dataIn) {
+  if(dataIn.currBufferPtr != nullptr) {
+    dataIn.inc(zStream->next_in - reinterpret_cast<p_char8>(dataIn.currBufferPtr));
+  }
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// EncoderDeflate
+
+EncoderDeflate::EncoderDeflate(DeflateFormat format, v_int32 compressionLevel)
+  : m_zStream(new z_stream())
+  , m_buffer(new v_char8[BUFFER_SIZE])
+  , m_initialized(false)
+  , m_finished(false)
+{
+  auto res = deflateInit2(m_zStream.get(), compressionLevel, Z_DEFLATED, getWindowBits(format), 8, Z_DEFAULT_STRATEGY);
+  m_initialized = (res == Z_OK);
+}
+
+EncoderDeflate::~EncoderDeflate() {
+  if(m_initialized) {
+    deflateEnd(m_zStream.get());
+  }
+}
+
+v_io_size EncoderDeflate::suggestInputStreamReadSize() {
+  return 32767;
+}
+
+v_int32 EncoderDeflate::iterate(data::buffer::InlineReadData& dataIn, data::buffer::InlineReadData& dataOut) {
+
+  if(dataOut.bytesLeft > 0) {
+    return Error::FLUSH_DATA_OUT;
+  }
+
+  if(m_finished) {
+    dataOut.set(nullptr, 0);
+    return Error::FINISHED;
+  }
+
+  if(!m_initialized) {
+    return ERROR_ZLIB;
+  }
+
+  bool isEnd = dataIn.currBufferPtr == nullptr;
+
+  /* Output buffer was filled completely last time - there might be more output pending in zlib */
+  bool hasPendingOutput = m_zStream->avail_out == 0 && m_zStream->total_out > 0;
+
+  if(!isEnd && dataIn.bytesLeft == 0 && !hasPendingOutput) {
+    return Error::PROVIDE_DATA_IN;
+  }
+
+  setStreamInput(m_zStream.get(), dataIn);
+  m_zStream->next_out = m_buffer.get();
+  m_zStream->avail_out = static_cast<uInt>(BUFFER_SIZE);
+
+  auto res = deflate(m_zStream.get(), isEnd ? Z_FINISH : Z_NO_FLUSH);
+  consumeStreamInput(m_zStream.get(), dataIn);
+
+  if(res == Z_STREAM_END) {
+    m_finished = true;
+  } else if(res != Z_OK && res != Z_BUF_ERROR) {
+    return ERROR_ZLIB;
+  }
+
+  auto produced = BUFFER_SIZE - static_cast<v_buff_size>(m_zStream->avail_out);
+  if(produced > 0) {
+    dataOut.set(m_buffer.get(), produced);
+    return Error::FLUSH_DATA_OUT;
+  }
+
+  if(m_finished) {
+    dataOut.set(nullptr, 0);
+    return Error::FINISHED;
+  }
+
+  if(isEnd) {
+    return ERROR_ZLIB;
+  }
+
+  return dataIn.bytesLeft > 0 ? Error::OK : Error::PROVIDE_DATA_IN;
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DecoderDeflate
+
+DecoderDeflate::DecoderDeflate(DeflateFormat format)
+  : m_zStream(new z_stream())
+  , m_buffer(new v_char8[BUFFER_SIZE])
+  , m_initialized(false)
+  , m_finished(false)
+{
+  auto res = inflateInit2(m_zStream.get(), getWindowBits(format));
+  m_initialized = (res == Z_OK);
+}
+
+DecoderDeflate::~DecoderDeflate() {
+  if(m_initialized) {
+    inflateEnd(m_zStream.get());
+  }
+}
+
+v_io_size DecoderDeflate::suggestInputStreamReadSize() {
+  return 32767;
+}
+
+v_int32 DecoderDeflate::iterate(data::buffer::InlineReadData& dataIn, data::buffer::InlineReadData& dataOut) {
+
+  if(dataOut.bytesLeft > 0) {
+    return Error::FLUSH_DATA_OUT;
+  }
+
+  if(m_finished) {
+    dataOut.set(nullptr, 0);
+    return Error::FINISHED;
+  }
+
+  if(!m_initialized) {
+    return ERROR_ZLIB;
+  }
+
+  bool isEnd = dataIn.currBufferPtr == nullptr;
+
+  /* Output buffer was filled completely last time - there might be more output pending in zlib */
+  bool hasPendingOutput = m_zStream->avail_out == 0 && m_zStream->total_out > 0;
+
+  if(!isEnd && dataIn.bytesLeft == 0 && !hasPendingOutput) {
+    return Error::PROVIDE_DATA_IN;
+  }
+
+  setStreamInput(m_zStream.get(), dataIn);
+  m_zStream->next_out = m_buffer.get();
+  m_zStream->avail_out = static_cast<uInt>(BUFFER_SIZE);
+
+  auto res = inflate(m_zStream.get(), Z_NO_FLUSH);
+  consumeStreamInput(m_zStream.get(), dataIn);
+
+  if(res == Z_STREAM_END) {
+    m_finished = true;
+  } else if(res != Z_OK && res != Z_BUF_ERROR) {
+    return ERROR_ZLIB;
+  }
+
+  auto produced = BUFFER_SIZE - static_cast<v_buff_size>(m_zStream->avail_out);
+  if(produced > 0) {
+    dataOut.set(m_buffer.get(), produced);
+    return Error::FLUSH_DATA_OUT;
+  }
+
+  if(m_finished) {
+    dataOut.set(nullptr, 0);
+    return Error::FINISHED;
+  }
+
+  if(isEnd) {
+    return ERROR_UNEXPECTED_END;
+  }
+
+  return dataIn.bytesLeft > 0 ? Error::OK : Error::PROVIDE_DATA_IN;
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DeflateEncoderProvider
+
+DeflateEncoderProvider::DeflateEncoderProvider(v_int32 compressionLevel)
+  : m_compressionLevel(compressionLevel)
+{}
+
+oatpp::String DeflateEncoderProvider::getEncodingName() {
+  return "deflate";
+}
+
+std::shared_ptr<data::buffer::Processor> DeflateEncoderProvider::getProcessor() {
+  return std::make_shared<EncoderDeflate>(DeflateFormat::DEFLATE, m_compressionLevel);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DeflateDecoderProvider
+
+oatpp::String DeflateDecoderProvider::getEncodingName() {
+  return "deflate";
+}
+
+std::shared_ptr<data::buffer::Processor> DeflateDecoderProvider::getProcessor() {
+  return std::make_shared<DecoderDeflate>(DeflateFormat::DEFLATE);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// GzipEncoderProvider
+
+GzipEncoderProvider::GzipEncoderProvider(v_int32 compressionLevel)
+  : m_compressionLevel(compressionLevel)
+{}
+
+oatpp::String GzipEncoderProvider::getEncodingName() {
+  return "gzip";
+}
+
+std::shared_ptr<data::buffer::Processor> GzipEncoderProvider::getProcessor() {
+  return std::make_shared<EncoderDeflate>(DeflateFormat::GZIP, m_compressionLevel);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// GzipDecoderProvider
+
+oatpp::String GzipDecoderProvider::getEncodingName() {
+  return "gzip";
+}
+
+std::shared_ptr<data::buffer::Processor> GzipDecoderProvider::getProcessor() {
+  return std::make_shared<DecoderDeflate>(DeflateFormat::GZIP);
+}
+
+}}}}}
+
+#endif // #ifdef OATPP_ZLIB_SUPPORTED
@@ -0,0 +1,260 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_web_protocol_http_encoding_Deflate_hpp
+#define oatpp_web_protocol_http_encoding_Deflate_hpp
+
+#include "EncoderProvider.hpp"
+
+#include <memory>
+
+/*
+ * OATPP_ZLIB_SUPPORTED is defined by the build when oatpp is linked against zlib.
+ * See `OATPP_DISABLE_ZLIB` cmake option.
+ */
+#ifdef OATPP_ZLIB_SUPPORTED
+
+struct z_stream_s; // FWD
+
+namespace oatpp { namespace web { namespace protocol { namespace http { namespace encoding {
+
+/**
+ * Container format of the deflate stream.
+ */
+enum class DeflateFormat : v_int32 {
+
+  /**
+   * zlib wrapped deflate stream. Used by the "deflate" content encoding.
+   */
+  DEFLATE = 0,
+
+  /**
+   * gzip wrapped deflate stream. Used by the "gzip" content encoding.
+   */
+  GZIP = 1
+
+};
+
+/**
+ * Deflate/gzip compressing buffer processor (zlib). &id:oatpp::data::buffer::Processor;.
+ */
+class EncoderDeflate : public data::buffer::Processor {
+public:
+  static constexpr v_int32 ERROR_ZLIB = 100;
+public:
+  /**
+   * Compression level used by zlib by default.
+   */
+  static constexpr v_int32 DEFAULT_COMPRESSION_LEVEL = -1;
+  /**
+   * Size of the output buffer.
+   */
+  static constexpr v_buff_size BUFFER_SIZE = 16 * 1024;
+private:
+  std::unique_ptr<z_stream_s> m_zStream;
+  std::unique_ptr<v_char8[]> m_buffer;
+  bool m_initialized;
+  bool m_finished;
+public:
+
+  /**
+   * Constructor.
+   * @param format - &l:DeflateFormat;.
+   * @param compressionLevel - zlib compression level `[0..9]` or `-1` for zlib default.
+   */
+  EncoderDeflate(DeflateFormat format, v_int32 compressionLevel = DEFAULT_COMPRESSION_LEVEL);
+
+  /**
+   * Destructor.
+   */
+  ~EncoderDeflate() override;
+
+  /**
+   * If the client is using the input stream to read data and add it to the processor,
+   * the client MAY ask the processor for a suggested read size.
+   * @return - suggested read size.
+   */
+  v_io_size suggestInputStreamReadSize() override;
+
+  /**
+   * Process data.
+   * @param dataIn - data provided by client to processor. Input data. &id:data::buffer::InlineReadData;.
+   * Set `dataIn` buffer pointer to `nullptr` to designate the end of input.
+   * @param dataOut - data provided to client by processor. Output data. &id:data::buffer::InlineReadData;.
+   * @return - &l:Processor::Error;.
+   */
+  v_int32 iterate(data::buffer::InlineReadData& dataIn, data::buffer::InlineReadData& dataOut) override;
+
+};
+
+/**
+ * Deflate/gzip decompressing buffer processor (zlib). &id:oatpp::data::buffer::Processor;.
+ */
+class DecoderDeflate : public data::buffer::Processor {
+public:
+  static constexpr v_int32 ERROR_ZLIB = 100;
+  static constexpr v_int32 ERROR_UNEXPECTED_END = 101;
+public:
+  /**
+   * Size of the output buffer.
+   */
+  static constexpr v_buff_size BUFFER_SIZE = 16 * 1024;
+private:
+  std::unique_ptr<z_stream_s> m_zStream;
+  std::unique_ptr<v_char8[]> m_buffer;
+  bool m_initialized;
+  bool m_finished;
+public:
+
+  /**
+   * Constructor.
+   * @param format - &l:DeflateFormat;.
+   */
+  DecoderDeflate(DeflateFormat format);
+
+  /**
+   * Destructor.
+   */
+  ~DecoderDeflate() override;
+
+  /**
+   * If the client is using the input stream to read data and add it to the processor,
+   * the client MAY ask the processor for a suggested read size.
+   * @return - suggested read size.
+   */
+  v_io_size suggestInputStreamReadSize() override;
+
+  /**
+   * Process data.
+   * @param dataIn - data provided by client to processor. Input data. &id:data::buffer::InlineReadData;.
+   * Set `dataIn` buffer pointer to `nullptr` to designate the end of input.
+   * @param dataOut - data provided to client by processor. Output data. &id:data::buffer::InlineReadData;.
+   * @return - &l:Processor::Error;.
+   */
+  v_int32 iterate(data::buffer::InlineReadData& dataIn, data::buffer::InlineReadData& dataOut) override;
+
+};
+
+/**
+ * EncoderProvider for "deflate" encoding.
+ */
+class DeflateEncoderProvider : public EncoderProvider {
+private:
+  v_int32 m_compressionLevel;
+public:
+
+  /**
+   * Constructor.
+   * @param compressionLevel - zlib compression level `[0..9]` or `-1` for zlib default.
+   */
+  DeflateEncoderProvider(v_int32 compressionLevel = EncoderDeflate::DEFAULT_COMPRESSION_LEVEL);
+
+  /**
+   * Get encoding name.
+   * @return
+   */
+  oatpp::String getEncodingName() override;
+
+  /**
+   * Get &id:oatpp::data::buffer::Processor; for deflate encoding.
+   * @return - &id:oatpp::data::buffer::Processor;
+   */
+  std::shared_ptr<data::buffer::Processor> getProcessor() override;
+
+};
+
+/**
+ * EncoderProvider for "deflate" decoding.
+ */
+class DeflateDecoderProvider : public EncoderProvider {
+public:
+
+  /**
+   * Get encoding name.
+   * @return
+   */
+  oatpp::String getEncodingName() override;
+
+  /**
+   * Get &id:oatpp::data::buffer::Processor; for deflate decoding.
+   * @return - &id:oatpp::data::buffer::Processor;
+   */
+  std::shared_ptr<data::buffer::Processor> getProcessor() override;
+
+};
+
+/**
+ * EncoderProvider for "gzip" encoding.
+ */
+class GzipEncoderProvider : public EncoderProvider {
+private:
+  v_int32 m_compressionLevel;
+public:
+
+  /**
+   * Constructor.
+   * @param compressionLevel - zlib compression level `[0..9]` or `-1` for zlib default.
+   */
+  GzipEncoderProvider(v_int32 compressionLevel = EncoderDeflate::DEFAULT_COMPRESSION_LEVEL);
+
+  /**
+   * Get encoding name.
+   * @return
+   */
+  oatpp::String getEncodingName() override;
+
+  /**
+   * Get &id:oatpp::data::buffer::Processor; for gzip encoding.
+   * @return - &id:oatpp::data::buffer::Processor;
+   */
+  std::shared_ptr<data::buffer::Processor> getProcessor() override;
+
+};
+
+/**
+ * EncoderProvider for "gzip" decoding.
+ */
+class GzipDecoderProvider : public EncoderProvider {
+public:
+
+  /**
+   * Get encoding name.
+   * @return
+   */
+  oatpp::String getEncodingName() override;
+
+  /**
+   * Get &id:oatpp::data::buffer::Processor; for gzip decoding.
+   * @return - &id:oatpp::data::buffer::Processor;
+   */
+  std::shared_ptr<data::buffer::Processor> getProcessor() override;
+
+};
+
+}}}}}
+
+#endif // #ifdef OATPP_ZLIB_SUPPORTED
+
+#endif // oatpp_web_protocol_http_encoding_Deflate_hpp
@@ -0,0 +1,194 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "EncodedBodyCache.hpp"
+
+#include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/utils/Conversion.hpp"
+
+#include <cstring>
+#include <string_view>
+
+namespace oatpp { namespace web { namespace protocol { namespace http { namespace encoding {
+
+EncodedBodyCache::EncodedBodyCache(v_buff_size maxSize, v_buff_size minBodySize)
+  : m_maxSize(maxSize)
+  , m_minBodySize(minBodySize)
+  , m_size(0)
+  , m_hits(0)
+  , m_misses(0)
+{}
+
+std::string EncodedBodyCache::makeKey(const oatpp::String& encoding, const oatpp::String& etag, const void* data, v_buff_size size) {
+
+  std::string key = *encoding;
+  key.push_back('\n');
+  key += utils::Conversion::int64ToStdStr(size);
+  key.push_back('\n');
+
+  if(etag) {
+    key += *etag;
+  } else {
+    auto hash = std::hash<std::string_view>{}(std::string_view(reinterpret_cast<const char*>(data), static_cast<size_t>(size)));
+    key += utils::Conversion::uint64ToStdStr(hash);
+  }
+
+  return key;
+
+}
+
+oatpp::String EncodedBodyCache::encode(EncoderProvider* provider, const void* data, v_buff_size size) {
+
+  auto processor = provider->getProcessor();
+  data::stream::BufferOutputStream stream(size / 2 + 64);
+
+  data::buffer::InlineReadData dataIn(const_cast<void*>(data), size);
+  data::buffer::InlineReadData dataOut;
+
+  while(true) {
+
+    auto res = processor->iterate(dataIn, dataOut);
+
+    switch(res) {
+
+      case data::buffer::Processor::Error::OK:
+        break;
+
+      case data::buffer::Processor::Error::FLUSH_DATA_OUT:
+        stream.writeSimple(dataOut.currBufferPtr, dataOut.bytesLeft);
+        dataOut.setEof();
+        break;
+
+      case data::buffer::Processor::Error::PROVIDE_DATA_IN:
+        if(dataIn.currBufferPtr == nullptr) {
+          return nullptr;
+        }
+        dataIn.set(nullptr, 0);
+        break;
+
+      case data::buffer::Processor::Error::FINISHED:
+        return stream.toString();
+
+      default:
+        return nullptr;
+
+    }
+
+  }
+
+}
+
+void EncodedBodyCache::removeEntry(std::list<Entry>::iterator it) {
+  m_size -= static_cast<v_buff_size>(it->source.size() + it->encoded->size());
+  m_index.erase(it->key);
+  m_entries.erase(it);
+}
+
+bool EncodedBodyCache::isCacheable(v_buff_size size) const {
+  return size >= m_minBodySize && size <= m_maxSize / 2;
+}
+
+oatpp::String EncodedBodyCache::get(EncoderProvider* provider, const oatpp::String& etag, const void* data, v_buff_size size) {
+
+  if(provider == nullptr || !isCacheable(size)) {
+    return nullptr;
+  }
+
+  auto encoding = provider->getEncodingName();
+  auto key = makeKey(encoding, etag, data, size);
+
+  {
+    std::lock_guard<std::mutex> lock(m_lock);
+    auto it = m_index.find(key);
+    if(it != m_index.end()) {
+      auto entry = it->second;
+      if(std::memcmp(entry->source.data(), data, static_cast<size_t>(size)) == 0) {
+        m_entries.splice(m_entries.begin(), m_entries, entry);
+        m_hits ++;
+        return entry->encoded;
+      }
+      /* Same key, different content - the body has changed */
+      removeEntry(entry);
+    }
+  }
+
+  m_misses ++;
+
+  /* Encode outside of the lock - concurrent misses of the same body are allowed to encode it twice */
+  auto encoded = encode(provider, data, size);
+  if(!encoded) {
+    return nullptr;
+  }
+
+  auto entrySize = size + static_cast<v_buff_size>(encoded->size());
+  if(entrySize > m_maxSize) {
+    return encoded;
+  }
+
+  std::lock_guard<std::mutex> lock(m_lock);
+
+  auto it = m_index.find(key);
+  if(it != m_index.end()) {
+    removeEntry(it->second);
+  }
+
+  while(!m_entries.empty() && m_size + entrySize > m_maxSize) {
+    removeEntry(std::prev(m_entries.end()));
+  }
+
+  m_entries.push_front({key, std::string(reinterpret_cast<const char*>(data), static_cast<size_t>(size)), encoded});
+  m_index[key] = m_entries.begin();
+  m_size += entrySize;
+
+  return encoded;
+
+}
+
+void EncodedBodyCache::clear() {
+  std::lock_guard<std::mutex> lock(m_lock);
+  m_index.clear();
+  m_entries.clear();
+  m_size = 0;
+}
+
+v_buff_size EncodedBodyCache::getSize() {
+  std::lock_guard<std::mutex> lock(m_lock);
+  return m_size;
+}
+
+v_buff_size EncodedBodyCache::getEntriesCount() {
+  std::lock_guard<std::mutex> lock(m_lock);
+  return static_cast<v_buff_size>(m_entries.size());
+}
+
+v_int64 EncodedBodyCache::getHitsCount() const {
+  return m_hits.load();
+}
+
+v_int64 EncodedBodyCache::getMissesCount() const {
+  return m_misses.load();
+}
+
+}}}}}
@@ -0,0 +1,141 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_web_protocol_http_encoding_EncodedBodyCache_hpp
+#define oatpp_web_protocol_http_encoding_EncodedBodyCache_hpp
+
+#include "EncoderProvider.hpp"
+
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+
+namespace oatpp { namespace web { namespace protocol { namespace http { namespace encoding {
+
+/**
+ * LRU cache of encoded (compressed) response bodies. <br>
+ * Entries are keyed by encoding name and either the `ETag` of the response or the hash of the body.
+ * Hits are verified against the stored source bytes, so different bodies never share an entry. <br>
+ * Used by &id:oatpp::web::server::HttpProcessor; when set in &id:oatpp::web::server::HttpProcessor::Config;.
+ */
+class EncodedBodyCache {
+public:
+  /**
+   * Default maximum size of all cached data (source and encoded) in bytes.
+   */
+  static constexpr v_buff_size DEFAULT_MAX_SIZE = 32 * 1024 * 1024;
+
+  /**
+   * Default minimum size of body to be cached.
+   */
+  static constexpr v_buff_size DEFAULT_MIN_BODY_SIZE = 1024;
+private:
+
+  struct Entry {
+    std::string key;
+    std::string source;
+    oatpp::String encoded;
+  };
+
+private:
+  v_buff_size m_maxSize;
+  v_buff_size m_minBodySize;
+  v_buff_size m_size;
+  std::list<Entry> m_entries;
+  std::unordered_map<std::string, std::list<Entry>::iterator> m_index;
+  std::mutex m_lock;
+  std::atomic<v_int64> m_hits;
+  std::atomic<v_int64> m_misses;
+private:
+  static std::string makeKey(const oatpp::String& encoding, const oatpp::String& etag, const void* data, v_buff_size size);
+  static oatpp::String encode(EncoderProvider* provider, const void* data, v_buff_size size);
+  void removeEntry(std::list<Entry>::iterator it);
+public:
+
+  /**
+   * Constructor.
+   * @param maxSize - maximum size of all cached data (source and encoded) in bytes. Least recently used entries are evicted first.
+   * @param minBodySize - bodies smaller than this size are not cached.
+   */
+  EncodedBodyCache(v_buff_size maxSize = DEFAULT_MAX_SIZE, v_buff_size minBodySize = DEFAULT_MIN_BODY_SIZE);
+
+  /**
+   * Non-copyable.
+   */
+  EncodedBodyCache(const EncodedBodyCache&) = delete;
+  EncodedBodyCache& operator=(const EncodedBodyCache&) = delete;
+
+  /**
+   * Check if body of the given size can be cached.
+   * @param size - size of the body.
+   * @return - `true` if body can be cached.
+   */
+  bool isCacheable(v_buff_size size) const;
+
+  /**
+   * Get encoded body. Encode and cache it if it's not in the cache.
+   * @param provider - &id:oatpp::web::protocol::http::encoding::EncoderProvider;.
+   * @param etag - `ETag` of the body. May be `nullptr`, then the body hash is used as the key.
+   * @param data - body data.
+   * @param size - body size.
+   * @return - encoded body, or `nullptr` if the body is not cacheable or the encoder has failed.
+   */
+  oatpp::String get(EncoderProvider* provider, const oatpp::String& etag, const void* data, v_buff_size size);
+
+  /**
+   * Remove all entries.
+   */
+  void clear();
+
+  /**
+   * Get size of all cached data (source and encoded) in bytes.
+   * @return
+   */
+  v_buff_size getSize();
+
+  /**
+   * Get number of cached entries.
+   * @return
+   */
+  v_buff_size getEntriesCount();
+
+  /**
+   * Get number of cache hits.
+   * @return
+   */
+  v_int64 getHitsCount() const;
+
+  /**
+   * Get number of cache misses.
+   * @return
+   */
+  v_int64 getMissesCount() const;
+
+};
+
+}}}}}
+
+#endif // oatpp_web_protocol_http_encoding_EncodedBodyCache_hpp
@@ -124,9 +124,10 @@ oatpp::String Request::getHeader(const oatpp::data::share::StringKeyLabelCI& hea
 
 std::vector<oatpp::String> Request::getHeaderValues(const oatpp::data::share::StringKeyLabelCI& headerName) const {
   std::vector<oatpp::String> result;
-  auto range = m_headers.getAll_Unsafe().equal_range(headerName);
-  for (auto it = range.first; it != range.second; ++it) {
-    result.emplace_back(it->second.toString());
+  for (const auto& pair : m_headers.getAll_Unsafe()) {
+    if(pair.first == headerName) {
+      result.emplace_back(pair.second.toString());
+    }
   }
   return result;
 }
@@ -23,10 +23,36 @@
  ***************************************************************************/
 
 #include "RequestHeadersReader.hpp"
+
+#include "oatpp/utils/parser/ByteScanner.hpp"
 #include "oatpp/base/Log.hpp"
 
 namespace oatpp { namespace web { namespace protocol { namespace http { namespace incoming {
 
+v_buff_size RequestHeadersReader::findSectionEnd(ReadHeadersIteration& iteration, p_char8 data, v_buff_size size) {
+
+  /* "\r\n\r\n" may start in the previous chunk */
+  for(v_buff_size i = 0; i < size && i < 3; i ++) {
+    iteration.accumulator <<= 8;
+    iteration.accumulator |= data[i];
+    if(iteration.accumulator == SECTION_END) {
+      return i + 1;
+    }
+  }
+
+  if(size > 3) {
+    auto pos = utils::parser::ByteScanner::findRNRN(reinterpret_cast<const char*>(data), size);
+    if(pos < size) {
+      return pos + 4;
+    }
+    iteration.accumulator = (static_cast<v_uint32>(data[size - 4]) << 24) | (static_cast<v_uint32>(data[size - 3]) << 16) |
+                            (static_cast<v_uint32>(data[size - 2]) << 8) | static_cast<v_uint32>(data[size - 1]);
+  }
+
+  return 0;
+
+}
+
 v_io_size RequestHeadersReader::readHeadersSectionIterative(ReadHeadersIteration& iteration,
                                                                   data::stream::InputStreamBufferedProxy* stream,
                                                                   async::Action& action)
@@ -47,14 +73,11 @@ v_io_size RequestHeadersReader::readHeadersSectionIterative(ReadHeadersIteration
 
     m_bufferStream->setCurrentPosition(m_bufferStream->getCurrentPosition() + res);
 
-    for(v_buff_size i = 0; i < res; i ++) {
-      iteration.accumulator <<= 8;
-      iteration.accumulator |= bufferData[i];
-      if(iteration.accumulator == SECTION_END) {
-        stream->commitReadOffset(i + 1);
-        iteration.done = true;
-        return res;
-      }
+    auto sectionEnd = findSectionEnd(iteration, bufferData, res);
+    if(sectionEnd > 0) {
+      stream->commitReadOffset(sectionEnd);
+      iteration.done = true;
+      return res;
     }
 
     stream->commitReadOffset(res);
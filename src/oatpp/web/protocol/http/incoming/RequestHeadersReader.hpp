@@ -69,6 +69,7 @@ private:
   };
 
 private:
+  static v_buff_size findSectionEnd(ReadHeadersIteration& iteration, p_char8 data, v_buff_size size);
   v_io_size readHeadersSectionIterative(ReadHeadersIteration& iteration,
                                               data::stream::InputStreamBufferedProxy* stream,
                                               async::Action& action);
@@ -77,6 +77,7 @@ private:
 
 private:
 
+  static v_buff_size findSectionEnd(ReadHeadersIteration& iteration, p_char8 data, v_buff_size size);
   v_io_size readHeadersSectionIterative(ReadHeadersIteration& iteration,
                                               const std::shared_ptr<oatpp::data::stream::IOStream>& connection,
                                               data::stream::ConsistentOutputStream* bufferStream,
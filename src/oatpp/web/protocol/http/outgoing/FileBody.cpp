@@ -0,0 +1,199 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "FileBody.hpp"
+
+#include "oatpp/utils/Conversion.hpp"
+#include "oatpp/base/Log.hpp"
+
+namespace oatpp { namespace web { namespace protocol { namespace http { namespace outgoing {
+
+FileBody::FileBody(const oatpp::String& filename, const oatpp::String& contentType)
+  : m_filename(filename)
+  , m_contentType(contentType)
+  , m_file(nullptr)
+  , m_fileSize(0)
+  , m_start(0)
+  , m_size(0)
+  , m_position(0)
+  , m_isRange(false)
+{
+  open();
+  m_size = m_fileSize;
+}
+
+FileBody::FileBody(const oatpp::String& filename, const http::Range& range, const oatpp::String& contentType)
+  : m_filename(filename)
+  , m_contentType(contentType)
+  , m_file(nullptr)
+  , m_fileSize(0)
+  , m_start(0)
+  , m_size(0)
+  , m_position(0)
+  , m_isRange(true)
+{
+
+  open();
+
+  v_int64 end = range.end;
+  if(end < 0 || end >= m_fileSize) {
+    end = m_fileSize - 1;
+  }
+
+  if(!range.isValid() || range.units != Range::UNIT_BYTES || range.start < 0 || range.start > end) {
+    std::fclose(m_file);
+    m_file = nullptr;
+    Headers headers;
+    headers.put(Header::CONTENT_RANGE, "bytes */" + utils::Conversion::int64ToStr(m_fileSize));
+    throw HttpError(Status::CODE_416, "Range Not Satisfiable", headers);
+  }
+
+  m_start = range.start;
+  m_size = end - range.start + 1;
+
+}
+
+FileBody::~FileBody() {
+  if(m_file) {
+    std::fclose(m_file);
+  }
+}
+
+void FileBody::open() {
+
+  if(!m_filename) {
+    throw std::runtime_error("[oatpp::web::protocol::http::outgoing::FileBody::open()]: Error. Filename is null.");
+  }
+
+  m_file = std::fopen(m_filename->c_str(), "rb");
+
+  if(m_file == nullptr) {
+    OATPP_LOGe("[oatpp::web::protocol::http::outgoing::FileBody::open()]", "Error. Can't open file '{}'.", m_filename)
+    throw std::runtime_error("[oatpp::web::protocol::http::outgoing::FileBody::open()]: Error. Can't open file.");
+  }
+
+  std::fseek(m_file, 0, SEEK_END);
+  m_fileSize = std::ftell(m_file);
+  std::fseek(m_file, 0, SEEK_SET);
+
+  if(m_fileSize < 0) {
+    std::fclose(m_file);
+    m_file = nullptr;
+    OATPP_LOGe("[oatpp::web::protocol::http::outgoing::FileBody::open()]", "Error. Can't get size of file '{}'.", m_filename)
+    throw std::runtime_error("[oatpp::web::protocol::http::outgoing::FileBody::open()]: Error. Can't get file size.");
+  }
+
+}
+
+std::shared_ptr<FileBody> FileBody::createShared(const oatpp::String& filename, const oatpp::String& contentType) {
+  return std::make_shared<FileBody>(filename, contentType);
+}
+
+std::shared_ptr<FileBody> FileBody::createShared(const oatpp::String& filename,
+                                                 const http::Range& range,
+                                                 const oatpp::String& contentType)
+{
+  return std::make_shared<FileBody>(filename, range, contentType);
+}
+
+v_io_size FileBody::read(void *buffer, v_buff_size count, async::Action& action) {
+
+  (void) action;
+
+  v_int64 bytesLeft = getBytesLeft();
+  if(bytesLeft <= 0) {
+    return 0;
+  }
+
+  if(count > bytesLeft) {
+    count = bytesLeft;
+  }
+
+  if(std::fseek(m_file, m_start + m_position, SEEK_SET) != 0) {
+    return IOError::BROKEN_PIPE;
+  }
+
+  auto res = static_cast<v_io_size>(std::fread(buffer, 1, static_cast<size_t>(count), m_file));
+  if(res == 0) {
+    return IOError::BROKEN_PIPE; // File was truncated while sending
+  }
+
+  m_position += res;
+  return res;
+
+}
+
+void FileBody::declareHeaders(Headers& headers) {
+  if(m_contentType) {
+    headers.putIfNotExists(Header::CONTENT_TYPE, m_contentType);
+  }
+  if(m_isRange) {
+    headers.putIfNotExists(Header::CONTENT_RANGE, getContentRange().toString());
+  }
+}
+
+p_char8 FileBody::getKnownData() {
+  return nullptr;
+}
+
+v_int64 FileBody::getKnownSize() {
+  return m_size;
+}
+
+http::ContentRange FileBody::getContentRange() const {
+  return http::ContentRange(ContentRange::UNIT_BYTES, m_start, m_start + m_size - 1, m_fileSize, true);
+}
+
+v_int64 FileBody::getBytesLeft() const {
+  return m_size - m_position;
+}
+
+v_io_size FileBody::sendTo(network::tcp::Connection* connection, async::Action& action) {
+
+  v_int64 bytesLeft = getBytesLeft();
+  if(bytesLeft <= 0) {
+    return 0;
+  }
+
+#if defined(WIN32) || defined(_WIN32)
+
+  (void) connection;
+  (void) action;
+  return IOError::BROKEN_PIPE; // sendfile is not supported. See network::tcp::Connection::isSendFileSupported().
+
+#else
+
+  auto res = connection->sendFile(fileno(m_file), m_start + m_position, bytesLeft, action);
+  if(res > 0) {
+    m_position += res;
+  }
+
+  return res;
+
+#endif
+
+}
+
+}}}}}
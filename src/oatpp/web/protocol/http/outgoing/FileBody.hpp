@@ -0,0 +1,153 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_web_protocol_http_outgoing_FileBody_hpp
+#define oatpp_web_protocol_http_outgoing_FileBody_hpp
+
+#include "./Body.hpp"
+
+#include "oatpp/network/tcp/Connection.hpp"
+
+#include <cstdio>
+
+namespace oatpp { namespace web { namespace protocol { namespace http { namespace outgoing {
+
+/**
+ * Body for serving files. <br>
+ * When the response is written to &id:oatpp::network::tcp::Connection; the file is sent with `sendfile()` -
+ * without copying file data to the user space. For other streams the file is transferred as a regular
+ * &id:oatpp::web::protocol::http::outgoing::Body; with &l:FileBody::read ();.
+ */
+class FileBody : public oatpp::base::Countable, public Body {
+private:
+  oatpp::String m_filename;
+  oatpp::String m_contentType;
+  std::FILE* m_file;
+  v_int64 m_fileSize;
+  v_int64 m_start;
+  v_int64 m_size;
+  v_int64 m_position;
+  bool m_isRange;
+private:
+  void open();
+public:
+
+  /**
+   * Constructor. Body for the whole file.
+   * @param filename - file name.
+   * @param contentType - content type. If not `nullptr` then `Content-Type` header is declared.
+   * @throws - `std::runtime_error` if file can't be opened.
+   */
+  FileBody(const oatpp::String& filename, const oatpp::String& contentType = nullptr);
+
+  /**
+   * Constructor. Body for the byte-range of the file. <br>
+   * `Content-Range` header is declared. Response status should be &id:oatpp::web::protocol::http::Status::CODE_206;.
+   * @param filename - file name.
+   * @param range - &id:oatpp::web::protocol::http::Range;. If `range.end` is negative then range ends at the end of the file.
+   * @param contentType - content type. If not `nullptr` then `Content-Type` header is declared.
+   * @throws - `std::runtime_error` if file can't be opened. &id:oatpp::web::protocol::http::HttpError;
+   * with status &id:oatpp::web::protocol::http::Status::CODE_416; if range is not satisfiable.
+   */
+  FileBody(const oatpp::String& filename, const http::Range& range, const oatpp::String& contentType = nullptr);
+
+  /**
+   * Virtual destructor. Closes file.
+   */
+  ~FileBody() override;
+
+  /**
+   * Create shared FileBody.
+   * @param filename - file name.
+   * @param contentType - content type. If not `nullptr` then `Content-Type` header is declared.
+   * @return - `std::shared_ptr` to FileBody.
+   */
+  static std::shared_ptr<FileBody> createShared(const oatpp::String& filename, const oatpp::String& contentType = nullptr);
+
+  /**
+   * Create shared FileBody for the byte-range of the file.
+   * @param filename - file name.
+   * @param range - &id:oatpp::web::protocol::http::Range;.
+   * @param contentType - content type. If not `nullptr` then `Content-Type` header is declared.
+   * @return - `std::shared_ptr` to FileBody.
+   */
+  static std::shared_ptr<FileBody> createShared(const oatpp::String& filename,
+                                                const http::Range& range,
+                                                const oatpp::String& contentType = nullptr);
+
+  /**
+   * Read next chunk of the file (fallback path).
+   * @param buffer - pointer to buffer.
+   * @param count - size of the buffer in bytes.
+   * @param action - async specific action. If action is NOT &id:oatpp::async::Action::TYPE_NONE;, then
+   * caller MUST return this action on coroutine iteration.
+   * @return - actual number of bytes written to buffer. 0 - to indicate end-of-file.
+   */
+  v_io_size read(void *buffer, v_buff_size count, async::Action& action) override;
+
+  /**
+   * Declare `Content-Type` (if specified) and `Content-Range` (for the byte-range body) headers.
+   * @param headers - &id:oatpp::web::protocol::http::Headers;.
+   */
+  void declareHeaders(Headers& headers) override;
+
+  /**
+   * Pointer to the body known data.
+   * @return - `nullptr`.
+   */
+  p_char8 getKnownData() override;
+
+  /**
+   * Return known size of the body.
+   * @return - size of the file (or size of the range).
+   */
+  v_int64 getKnownSize() override;
+
+  /**
+   * Get content range of the body.
+   * @return - &id:oatpp::web::protocol::http::ContentRange;.
+   */
+  http::ContentRange getContentRange() const;
+
+  /**
+   * Number of bytes which are not sent (read) yet.
+   * @return - bytes left.
+   */
+  v_int64 getBytesLeft() const;
+
+  /**
+   * Send next chunk of the file to the connection with &id:oatpp::network::tcp::Connection::sendFile;.
+   * @param connection - &id:oatpp::network::tcp::Connection;.
+   * @param action - async specific action. If action is NOT &id:oatpp::async::Action::TYPE_NONE;, then
+   * caller MUST return this action on coroutine iteration.
+   * @return - actual number of bytes sent. &id:oatpp::v_io_size;.
+   */
+  v_io_size sendTo(network::tcp::Connection* connection, async::Action& action);
+
+};
+
+}}}}}
+
+#endif // oatpp_web_protocol_http_outgoing_FileBody_hpp
@@ -0,0 +1,80 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "HeadersBlock.hpp"
+
+#include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/base/Log.hpp"
+
+namespace oatpp { namespace web { namespace protocol { namespace http { namespace outgoing {
+
+HeadersBlock::HeadersBlock(const Headers& headers)
+  : m_headers(headers)
+{
+
+  const auto& map = m_headers.getAll();
+
+  for(const auto& pair : map) {
+    if(pair.first == Header::CONTENT_LENGTH || pair.first == Header::TRANSFER_ENCODING ||
+       pair.first == Header::CONTENT_ENCODING || pair.first == Header::CONNECTION)
+    {
+      OATPP_LOGe("[oatpp::web::protocol::http::outgoing::HeadersBlock::HeadersBlock()]", "Error. Header '{}' can't be a part of the block.", pair.first.toString())
+      throw std::runtime_error("[oatpp::web::protocol::http::outgoing::HeadersBlock::HeadersBlock()]: Error. "
+                               "Content-Length, Transfer-Encoding, Content-Encoding, and Connection headers can't be a part of the block.");
+    }
+  }
+
+  data::stream::BufferOutputStream stream(256);
+  http::Utils::writeHeaders(m_headers, &stream);
+  m_data = stream.toString();
+
+}
+
+std::shared_ptr<HeadersBlock> HeadersBlock::createShared(const Headers& headers) {
+  return std::make_shared<HeadersBlock>(headers);
+}
+
+bool HeadersBlock::contains(const oatpp::data::share::StringKeyLabelCI& name) const {
+  const auto& map = m_headers.getAll_Unsafe();
+  return map.find(name) != map.end();
+}
+
+oatpp::String HeadersBlock::get(const oatpp::data::share::StringKeyLabelCI& name) const {
+  return m_headers.get(name);
+}
+
+const Headers& HeadersBlock::getHeaders() const {
+  return m_headers;
+}
+
+const void* HeadersBlock::getData() const {
+  return m_data->data();
+}
+
+v_buff_size HeadersBlock::getSize() const {
+  return static_cast<v_buff_size>(m_data->size());
+}
+
+}}}}}
@@ -0,0 +1,98 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_web_protocol_http_outgoing_HeadersBlock_hpp
+#define oatpp_web_protocol_http_outgoing_HeadersBlock_hpp
+
+#include "oatpp/web/protocol/http/Http.hpp"
+
+namespace oatpp { namespace web { namespace protocol { namespace http { namespace outgoing {
+
+/**
+ * Immutable block of response headers serialized once. <br>
+ * Use it for headers which are the same for every response of an endpoint or of an interceptor -
+ * such as `Server`, `Content-Type`, or CORS headers. The block is written to the output as-is,
+ * only dynamic headers (like `Content-Length`) are formatted per response. <br>
+ * Headers put to the response override the block headers with the same name. <br>
+ * See &id:oatpp::web::protocol::http::outgoing::Response::setHeadersBlock;.
+ */
+class HeadersBlock : public oatpp::base::Countable {
+private:
+  Headers m_headers;
+  oatpp::String m_data;
+public:
+
+  /**
+   * Constructor.
+   * @param headers - &id:oatpp::web::protocol::http::Headers;.
+   * @throws - `std::runtime_error` if headers contain `Content-Length`, `Transfer-Encoding`, `Content-Encoding`,
+   * or `Connection` header. Those headers are set per response.
+   */
+  HeadersBlock(const Headers& headers);
+
+  /**
+   * Create shared HeadersBlock.
+   * @param headers - &id:oatpp::web::protocol::http::Headers;.
+   * @return - `std::shared_ptr` to HeadersBlock.
+   */
+  static std::shared_ptr<HeadersBlock> createShared(const Headers& headers);
+
+  /**
+   * Check if block contains header.
+   * @param name - header name.
+   * @return - `true` if block contains header.
+   */
+  bool contains(const oatpp::data::share::StringKeyLabelCI& name) const;
+
+  /**
+   * Get header value.
+   * @param name - header name.
+   * @return - &id:oatpp::String;. `nullptr` if block has no such header.
+   */
+  oatpp::String get(const oatpp::data::share::StringKeyLabelCI& name) const;
+
+  /**
+   * Get headers of the block.
+   * @return - &id:oatpp::web::protocol::http::Headers;.
+   */
+  const Headers& getHeaders() const;
+
+  /**
+   * Get serialized block - `Name: Value\r\n` for each header.
+   * @return - pointer to serialized data.
+   */
+  const void* getData() const;
+
+  /**
+   * Get size of serialized block.
+   * @return - size in bytes.
+   */
+  v_buff_size getSize() const;
+
+};
+
+}}}}}
+
+#endif // oatpp_web_protocol_http_outgoing_HeadersBlock_hpp
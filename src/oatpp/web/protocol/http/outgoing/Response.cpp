@@ -23,8 +23,10 @@
  ***************************************************************************/
 
 #include "./Response.hpp"
+#include "./FileBody.hpp"
 
 #include "oatpp/web/protocol/http/encoding/Chunked.hpp"
+#include "oatpp/network/tcp/Connection.hpp"
 #include "oatpp/utils/Conversion.hpp"
 
 namespace oatpp { namespace web { namespace protocol { namespace http { namespace outgoing {
@@ -48,15 +50,30 @@ protocol::http::Headers& Response::getHeaders() {
   return m_headers;
 }
 
+void Response::setHeadersBlock(const std::shared_ptr<const HeadersBlock>& headersBlock) {
+  m_headersBlock = headersBlock;
+}
+
+std::shared_ptr<const HeadersBlock> Response::getHeadersBlock() const {
+  return m_headersBlock;
+}
+
 std::shared_ptr<Body> Response::getBody() const {
   return m_body;
 }
 
+void Response::setBody(const std::shared_ptr<Body>& body) {
+  m_body = body;
+}
+
 void Response::putHeader(const oatpp::String& key, const oatpp::String& value) {
   m_headers.put(key, value);
 }
 
 bool Response::putHeaderIfNotExists(const oatpp::String& key, const oatpp::String& value) {
+  if(m_headersBlock && m_headersBlock->contains(key)) {
+    return false;
+  }
   return m_headers.putIfNotExists(key, value);
 }
 
@@ -74,11 +91,18 @@ void Response::putHeader_Unsafe(const oatpp::data::share::StringKeyLabelCI& key,
 }
 
 bool Response::putHeaderIfNotExists_Unsafe(const oatpp::data::share::StringKeyLabelCI& key, const oatpp::data::share::StringKeyLabel& value) {
+  if(m_headersBlock && m_headersBlock->contains(key)) {
+    return false;
+  }
   return m_headers.putIfNotExists(key, value);
 }
 
 oatpp::String Response::getHeader(const oatpp::data::share::StringKeyLabelCI& headerName) const {
-  return m_headers.get(headerName);
+  auto value = m_headers.get(headerName);
+  if(!value && m_headersBlock) {
+    return m_headersBlock->get(headerName);
+  }
+  return value;
 }
 
 void Response::putBundleData(const oatpp::String& key, const oatpp::Void& polymorph) {
@@ -105,6 +129,48 @@ std::shared_ptr<const Response::ConnectionHandler::ParameterMap> Response::getCo
   return m_connectionUpgradeParameters;
 }
 
+void Response::writeHead(data::stream::BufferOutputStream* buffer) const {
+
+  buffer->setCurrentPosition(0);
+
+  buffer->writeSimple("HTTP/1.1 ", 9);
+  buffer->writeAsString(m_status.code);
+  buffer->writeSimple(" ", 1);
+  buffer->writeSimple(m_status.description);
+  buffer->writeSimple("\r\n", 2);
+
+  if(m_headersBlock) {
+
+    /* Dynamic headers take precedence over the same-named headers of the block */
+    const auto& headers = m_headers.getAll_Unsafe();
+    bool overridden = false;
+    for(const auto& pair : headers) {
+      overridden = overridden || m_headersBlock->contains(pair.first);
+    }
+
+    http::Utils::writeHeaders(m_headers, buffer);
+
+    if(!overridden) {
+      buffer->writeSimple(m_headersBlock->getData(), m_headersBlock->getSize());
+    } else {
+      for(const auto& pair : m_headersBlock->getHeaders().getAll_Unsafe()) {
+        if(headers.find(pair.first) == headers.end()) {
+          buffer->writeSimple(pair.first.getData(), pair.first.getSize());
+          buffer->writeSimple(": ", 2);
+          buffer->writeSimple(pair.second.getData(), pair.second.getSize());
+          buffer->writeSimple("\r\n", 2);
+        }
+      }
+    }
+
+  } else {
+    http::Utils::writeHeaders(m_headers, buffer);
+  }
+
+  buffer->writeSimple("\r\n", 2);
+
+}
+
 void Response::send(data::stream::OutputStream* stream,
                     data::stream::BufferOutputStream* headersWriteBuffer,
                     http::encoding::EncoderProvider* contentEncoderProvider)
@@ -135,17 +201,7 @@ void Response::send(data::stream::OutputStream* stream,
     m_headers.put_LockFree(Header::CONTENT_LENGTH, "0");
   }
 
-  headersWriteBuffer->setCurrentPosition(0);
-
-  headersWriteBuffer->writeSimple("HTTP/1.1 ", 9);
-  headersWriteBuffer->writeAsString(m_status.code);
-  headersWriteBuffer->writeSimple(" ", 1);
-  headersWriteBuffer->writeSimple(m_status.description);
-  headersWriteBuffer->writeSimple("\r\n", 2);
-
-  http::Utils::writeHeaders(m_headers, headersWriteBuffer);
-
-  headersWriteBuffer->writeSimple("\r\n", 2);
+  writeHead(headersWriteBuffer);
 
   if(m_body) {
 
@@ -155,16 +211,33 @@ void Response::send(data::stream::OutputStream* stream,
 
         if(m_body->getKnownData() == nullptr) {
           headersWriteBuffer->flushToStream(stream);
-          /* Reuse headers buffer */
-          /* Transfer without chunked encoder */
-          data::stream::transfer(m_body, stream, 0, headersWriteBuffer->getData(), headersWriteBuffer->getCapacity());
+          auto fileBody = std::dynamic_pointer_cast<FileBody>(m_body);
+          auto connection = dynamic_cast<network::tcp::Connection*>(stream);
+          if(fileBody && connection && network::tcp::Connection::isSendFileSupported()) {
+            /* Zero-copy file transfer */
+            while(fileBody->getBytesLeft() > 0) {
+              async::Action action;
+              auto res = fileBody->sendTo(connection, action);
+              if(res <= 0 && res != IOError::RETRY_READ && res != IOError::RETRY_WRITE) {
+                break;
+              }
+            }
+          } else {
+            /* Reuse headers buffer */
+            /* Transfer without chunked encoder */
+            data::stream::transfer(m_body, stream, 0, headersWriteBuffer->getData(), headersWriteBuffer->getCapacity());
+          }
         } else { 
           if (bodySize + headersWriteBuffer->getCurrentPosition() < headersWriteBuffer->getCapacity()) {
             headersWriteBuffer->writeSimple(m_body->getKnownData(), bodySize);
             headersWriteBuffer->flushToStream(stream);
           } else {
-            headersWriteBuffer->flushToStream(stream);
-            stream->writeExactSizeDataSimple(m_body->getKnownData(), bodySize);
+            /* Headers and body with one vectored write - no copy of the body */
+            data::buffer::InlineWriteData buffers[2] = {
+              {headersWriteBuffer->getData(), headersWriteBuffer->getCurrentPosition()},
+              {m_body->getKnownData(), bodySize}
+            };
+            stream->writevExactSizeDataSimple(buffers, 2);
           }
         }
       } else {
@@ -213,6 +286,9 @@ oatpp::async::CoroutineStarter Response::sendAsync(const std::shared_ptr<Respons
     std::shared_ptr<data::stream::OutputStream> m_stream;
     std::shared_ptr<oatpp::data::stream::BufferOutputStream> m_headersWriteBuffer;
     std::shared_ptr<http::encoding::EncoderProvider> m_contentEncoderProvider;
+    data::buffer::InlineWriteData m_buffers[2];
+    std::shared_ptr<FileBody> m_fileBody;
+    network::tcp::Connection* m_connection;
   public:
 
     SendAsyncCoroutine(const std::shared_ptr<Response>& _this,
@@ -223,6 +299,7 @@ oatpp::async::CoroutineStarter Response::sendAsync(const std::shared_ptr<Respons
       , m_stream(stream)
       , m_headersWriteBuffer(headersWriteBuffer)
       , m_contentEncoderProvider(contentEncoderProvider)
+      , m_connection(nullptr)
     {}
 
     Action act() override {
@@ -252,17 +329,7 @@ oatpp::async::CoroutineStarter Response::sendAsync(const std::shared_ptr<Respons
         m_this->m_headers.put_LockFree(Header::CONTENT_LENGTH, "0");
       }
 
-      m_headersWriteBuffer->setCurrentPosition(0);
-
-      m_headersWriteBuffer->writeSimple("HTTP/1.1 ", 9);
-      m_headersWriteBuffer->writeAsString(m_this->m_status.code);
-      m_headersWriteBuffer->writeSimple(" ", 1);
-      m_headersWriteBuffer->writeSimple(m_this->m_status.description);
-      m_headersWriteBuffer->writeSimple("\r\n", 2);
-
-      http::Utils::writeHeaders(m_this->m_headers, m_headersWriteBuffer.get());
-
-      m_headersWriteBuffer->writeSimple("\r\n", 2);
+      m_this->writeHead(m_headersWriteBuffer.get());
 
       if(m_this->m_body) {
 
@@ -270,17 +337,35 @@ oatpp::async::CoroutineStarter Response::sendAsync(const std::shared_ptr<Respons
 
           if (bodySize >= 0) {
 
-            if (bodySize + m_headersWriteBuffer->getCurrentPosition() < m_headersWriteBuffer->getCapacity()) {
+            if(m_this->m_body->getKnownData() == nullptr) {
 
-              m_headersWriteBuffer->writeSimple(m_this->m_body->getKnownData(), bodySize);
+              m_fileBody = std::dynamic_pointer_cast<FileBody>(m_this->m_body);
+              m_connection = dynamic_cast<network::tcp::Connection*>(m_stream.get());
+
+              if(m_fileBody && m_connection && network::tcp::Connection::isSendFileSupported()) {
+                /* Zero-copy file transfer */
+                return oatpp::data::stream::BufferOutputStream::flushToStreamAsync(m_headersWriteBuffer, m_stream)
+                  .next(yieldTo(&SendAsyncCoroutine::sendFile));
+              }
+
+              /* Transfer without chunked encoder */
               return oatpp::data::stream::BufferOutputStream::flushToStreamAsync(m_headersWriteBuffer, m_stream)
+                .next(data::stream::transferAsync(m_this->m_body, m_stream, 0, data::buffer::IOBuffer::createShared()))
                 .next(finish());
 
-            } else {
+            } else if (bodySize + m_headersWriteBuffer->getCurrentPosition() < m_headersWriteBuffer->getCapacity()) {
 
+              m_headersWriteBuffer->writeSimple(m_this->m_body->getKnownData(), bodySize);
               return oatpp::data::stream::BufferOutputStream::flushToStreamAsync(m_headersWriteBuffer, m_stream)
-                .next(m_stream->writeExactSizeDataAsync(m_this->m_body->getKnownData(), bodySize))
                 .next(finish());
+
+            } else {
+
+              /* Headers and body with one vectored write - no copy of the body */
+              m_buffers[0].set(m_headersWriteBuffer->getData(), m_headersWriteBuffer->getCurrentPosition());
+              m_buffers[1].set(m_this->m_body->getKnownData(), bodySize);
+              return yieldTo(&SendAsyncCoroutine::writeBuffers);
+
             }
 
           } else {
@@ -316,6 +401,31 @@ oatpp::async::CoroutineStarter Response::sendAsync(const std::shared_ptr<Respons
 
     }
 
+    Action writeBuffers() {
+      return m_stream->writevExactSizeDataAsyncInline(m_buffers, 2, finish());
+    }
+
+    Action sendFile() {
+
+      if(m_fileBody->getBytesLeft() <= 0) {
+        return finish();
+      }
+
+      async::Action action;
+      auto res = m_fileBody->sendTo(m_connection, action);
+
+      if(!action.isNone()) {
+        return action;
+      }
+
+      if(res > 0 || res == IOError::RETRY_READ || res == IOError::RETRY_WRITE) {
+        return repeat();
+      }
+
+      return new AsyncIOError(IOError::BROKEN_PIPE);
+
+    }
+
   };
 
   return SendAsyncCoroutine::start(_this, stream, headersWriteBuffer, contentEncoder);
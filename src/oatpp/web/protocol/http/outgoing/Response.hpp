@@ -26,6 +26,7 @@
 #define oatpp_web_protocol_http_outgoing_Response_hpp
 
 #include "oatpp/web/protocol/http/outgoing/Body.hpp"
+#include "oatpp/web/protocol/http/outgoing/HeadersBlock.hpp"
 #include "oatpp/web/protocol/http/encoding/EncoderProvider.hpp"
 #include "oatpp/web/protocol/http/Http.hpp"
 
@@ -56,10 +57,13 @@ public:
 private:
   Status m_status;
   Headers m_headers;
+  std::shared_ptr<const HeadersBlock> m_headersBlock;
   std::shared_ptr<Body> m_body;
   std::shared_ptr<ConnectionHandler> m_connectionUpgradeHandler;
   std::shared_ptr<const ConnectionHandler::ParameterMap> m_connectionUpgradeParameters;
   data::Bundle m_bundle;
+private:
+  void writeHead(data::stream::BufferOutputStream* buffer) const;
 public:
   /**
    * Constructor.
@@ -89,12 +93,34 @@ public:
    */
   Headers& getHeaders();
 
+  /**
+   * Set precompiled block of headers. <br>
+   * Headers put to this response take precedence over headers of the block with the same name -
+   * those block headers are not written. Only one block can be set per response.
+   * @param headersBlock - `std::shared_ptr` to &id:oatpp::web::protocol::http::outgoing::HeadersBlock;.
+   */
+  void setHeadersBlock(const std::shared_ptr<const HeadersBlock>& headersBlock);
+
+  /**
+   * Get precompiled block of headers.
+   * @return - `std::shared_ptr` to &id:oatpp::web::protocol::http::outgoing::HeadersBlock;.
+   */
+  std::shared_ptr<const HeadersBlock> getHeadersBlock() const;
+
   /**
    * Get body
    * @return - &id:oatpp::web::protocol::http::outgoing::Body;
    */
   std::shared_ptr<Body> getBody() const;
 
+  /**
+   * Replace body. <br>
+   * Headers declared by the previous body (see &id:oatpp::web::protocol::http::outgoing::Body::declareHeaders;)
+   * are not removed.
+   * @param body - &id:oatpp::web::protocol::http::outgoing::Body;.
+   */
+  void setBody(const std::shared_ptr<Body>& body);
+
   /**
    * Add http header.
    * @param key - &id:oatpp::String;.
@@ -103,7 +129,7 @@ public:
   void putHeader(const oatpp::String& key, const oatpp::String& value);
 
   /**
-   * Add http header if not already exists.
+   * Add http header if not already exists - neither in the response headers nor in the headers block.
    * @param key - &id:oatpp::String;.
    * @param value - &id:oatpp::String;.
    * @return - `true` if header was added.
@@ -134,7 +160,7 @@ public:
   void putHeader_Unsafe(const oatpp::data::share::StringKeyLabelCI& key, const oatpp::data::share::StringKeyLabel& value);
 
   /**
-   * Add http header if not already exists.
+   * Add http header if not already exists - neither in the response headers nor in the headers block.
    * @param key - &id:oatpp::data::share::StringKeyLabelCI;.
    * @param value - &id:oatpp::data::share::StringKeyLabel;.
    * @return - `true` if header was added.
@@ -142,7 +168,7 @@ public:
   bool putHeaderIfNotExists_Unsafe(const oatpp::data::share::StringKeyLabelCI& key, const oatpp::data::share::StringKeyLabel& value);
 
   /**
-   * Get header value
+   * Get header value. Headers block is checked if the response has no such header.
    * @param headerName - &id:oatpp::data::share::StringKeyLabelCI;.
    * @return - &id:oatpp::String;.
    */
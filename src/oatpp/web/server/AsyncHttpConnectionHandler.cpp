@@ -24,6 +24,9 @@
 
 #include "./AsyncHttpConnectionHandler.hpp"
 
+#include "oatpp/network/MultiListenerServer.hpp"
+#include "oatpp/utils/Conversion.hpp"
+
 namespace oatpp { namespace web { namespace server {
 
 void AsyncHttpConnectionHandler::onTaskStart(const provider::ResourceHandle<data::stream::IOStream>& connection) {
@@ -106,13 +109,21 @@ void AsyncHttpConnectionHandler::handleConnection(const provider::ResourceHandle
                                                   const std::shared_ptr<const ParameterMap>& params)
 {
 
-  (void)params;
-
   if (m_continue.load()) {
 
     connection.object->setOutputStreamIOMode(oatpp::data::stream::IOMode::ASYNCHRONOUS);
     connection.object->setInputStreamIOMode(oatpp::data::stream::IOMode::ASYNCHRONOUS);
 
+    if(params) {
+      auto it = params->find(network::MultiListenerServer::PARAM_LISTENER_INDEX);
+      if(it != params->end()) {
+        /* keep connections accepted by the same listener on the same processor */
+        v_uint32 index = oatpp::utils::Conversion::strToUInt32(it->second->c_str());
+        m_executor->executeOn<HttpProcessor::Coroutine>(index, m_components, connection, this);
+        return;
+      }
+    }
+
     m_executor->execute<HttpProcessor::Coroutine>(m_components, connection, this);
 
   }
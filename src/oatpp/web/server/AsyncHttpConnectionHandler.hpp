@@ -35,7 +35,9 @@
 namespace oatpp { namespace web { namespace server {
 
 /**
- * Asynchronous &id:oatpp::network::ConnectionHandler; for handling http communication.
+ * Asynchronous &id:oatpp::network::ConnectionHandler; for handling http communication. <br>
+ * Connections accepted by &id:oatpp::network::MultiListenerServer; are executed on the
+ * Executor processor with the same index as the listener that accepted them.
  */
 class AsyncHttpConnectionHandler : public base::Countable, public network::ConnectionHandler, public HttpProcessor::TaskProcessingListener {
 protected:
@@ -0,0 +1,317 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ConnectionEventLoop.hpp"
+
+#include "oatpp/async/worker/IOEventWorker.hpp"
+#include "oatpp/base/Log.hpp"
+
+#if defined(OATPP_IO_EVENT_INTERFACE_EPOLL)
+  #include <unistd.h>
+  #include <sys/epoll.h>
+  #include <sys/eventfd.h>
+  #include <cstring>
+#endif
+
+namespace oatpp { namespace web { namespace server {
+
+ConnectionEventLoop::ConnectionEventLoop(v_int32 workersCount)
+  : m_running(true)
+  , m_eventQueueHandle(INVALID_IO_HANDLE)
+  , m_wakeupTrigger(INVALID_IO_HANDLE)
+{
+
+  if(workersCount < 1) {
+    throw std::runtime_error("[oatpp::web::server::ConnectionEventLoop::ConnectionEventLoop()]: Error. Invalid workers count.");
+  }
+
+  initEventQueue();
+
+#if defined(OATPP_IO_EVENT_INTERFACE_EPOLL)
+  m_poller = std::thread(&ConnectionEventLoop::pollEvents, this);
+#endif
+
+  m_workers.reserve(static_cast<size_t>(workersCount));
+  for(v_int32 i = 0; i < workersCount; i ++) {
+    m_workers.emplace_back(&ConnectionEventLoop::work, this);
+  }
+
+}
+
+ConnectionEventLoop::~ConnectionEventLoop() {
+  stop();
+  closeEventQueue();
+}
+
+#if defined(OATPP_IO_EVENT_INTERFACE_EPOLL)
+
+void ConnectionEventLoop::initEventQueue() {
+
+  m_eventQueueHandle = ::epoll_create1(0);
+  if(m_eventQueueHandle == -1) {
+    OATPP_LOGe("[oatpp::web::server::ConnectionEventLoop::initEventQueue()]", "Error. Call to ::epoll_create1() failed. errno={}", errno)
+    throw std::runtime_error("[oatpp::web::server::ConnectionEventLoop::initEventQueue()]: Error. Call to ::epoll_create1() failed.");
+  }
+
+  m_wakeupTrigger = ::eventfd(0, EFD_NONBLOCK);
+  if(m_wakeupTrigger == -1) {
+    ::close(m_eventQueueHandle);
+    OATPP_LOGe("[oatpp::web::server::ConnectionEventLoop::initEventQueue()]", "Error. Call to ::eventfd() failed. errno={}", errno)
+    throw std::runtime_error("[oatpp::web::server::ConnectionEventLoop::initEventQueue()]: Error. Call to ::eventfd() failed.");
+  }
+
+  epoll_event event;
+  std::memset(&event, 0, sizeof(epoll_event));
+  event.data.ptr = nullptr;
+  event.events = EPOLLIN;
+
+  if(::epoll_ctl(m_eventQueueHandle, EPOLL_CTL_ADD, m_wakeupTrigger, &event) != 0) {
+    ::close(m_wakeupTrigger);
+    ::close(m_eventQueueHandle);
+    OATPP_LOGe("[oatpp::web::server::ConnectionEventLoop::initEventQueue()]", "Error. Call to ::epoll_ctl() failed. errno={}", errno)
+    throw std::runtime_error("[oatpp::web::server::ConnectionEventLoop::initEventQueue()]: Error. Call to ::epoll_ctl() failed.");
+  }
+
+}
+
+void ConnectionEventLoop::closeEventQueue() {
+  if(m_wakeupTrigger != INVALID_IO_HANDLE) {
+    ::close(m_wakeupTrigger);
+    m_wakeupTrigger = INVALID_IO_HANDLE;
+  }
+  if(m_eventQueueHandle != INVALID_IO_HANDLE) {
+    ::close(m_eventQueueHandle);
+    m_eventQueueHandle = INVALID_IO_HANDLE;
+  }
+}
+
+void ConnectionEventLoop::triggerWakeup() {
+  eventfd_write(m_wakeupTrigger, 1);
+}
+
+void ConnectionEventLoop::pollEvents() {
+
+  epoll_event events[MAX_EVENTS];
+
+  while(m_running) {
+
+    auto count = ::epoll_wait(m_eventQueueHandle, events, MAX_EVENTS, -1);
+
+    if(count < 0) {
+      if(errno == EINTR) {
+        continue;
+      }
+      OATPP_LOGe("[oatpp::web::server::ConnectionEventLoop::pollEvents()]", "Error. Call to ::epoll_wait() failed. errno={}", errno)
+      break;
+    }
+
+    for(v_int32 i = 0; i < count; i ++) {
+
+      auto task = static_cast<HttpProcessor::Task*>(events[i].data.ptr);
+
+      if(task == nullptr) {
+        eventfd_t value;
+        eventfd_read(m_wakeupTrigger, &value);
+        continue;
+      }
+
+      bool wasParked;
+      {
+        std::lock_guard<oatpp::concurrency::SpinLock> lock(m_parkedLock);
+        wasParked = m_parked.erase(task) > 0;
+      }
+
+      if(wasParked) {
+        dispatch(task);
+      }
+
+    }
+
+  }
+
+}
+
+void ConnectionEventLoop::park(HttpProcessor::Task* task, v_io_handle ioHandle) {
+
+  {
+    std::lock_guard<oatpp::concurrency::SpinLock> lock(m_parkedLock);
+    m_parked.insert(task);
+  }
+
+  epoll_event event;
+  std::memset(&event, 0, sizeof(epoll_event));
+  event.data.ptr = task;
+  event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+
+  /* The handle stays registered (disarmed) after EPOLLONESHOT fired, so re-arm it on the next park */
+  auto res = ::epoll_ctl(m_eventQueueHandle, EPOLL_CTL_ADD, ioHandle, &event);
+  if(res != 0 && errno == EEXIST) {
+    res = ::epoll_ctl(m_eventQueueHandle, EPOLL_CTL_MOD, ioHandle, &event);
+  }
+
+  if(res != 0) {
+    OATPP_LOGw("[oatpp::web::server::ConnectionEventLoop::park()]", "Warning. Call to ::epoll_ctl() failed. errno={}. Serving connection in a dedicated thread.", errno)
+    bool wasParked;
+    {
+      std::lock_guard<oatpp::concurrency::SpinLock> lock(m_parkedLock);
+      wasParked = m_parked.erase(task) > 0;
+    }
+    if(wasParked) {
+      runDedicated(task);
+    }
+  }
+
+}
+
+#else
+
+void ConnectionEventLoop::initEventQueue() {
+  // DO NOTHING
+}
+
+void ConnectionEventLoop::closeEventQueue() {
+  // DO NOTHING
+}
+
+void ConnectionEventLoop::triggerWakeup() {
+  // DO NOTHING
+}
+
+void ConnectionEventLoop::pollEvents() {
+  // DO NOTHING
+}
+
+void ConnectionEventLoop::park(HttpProcessor::Task* task, v_io_handle ioHandle) {
+  (void) ioHandle;
+  runDedicated(task);
+}
+
+#endif
+
+void ConnectionEventLoop::runDedicated(HttpProcessor::Task* task) {
+  std::thread thread([task]{
+    task->run();
+    delete task;
+  });
+  thread.detach();
+}
+
+void ConnectionEventLoop::dispatch(HttpProcessor::Task* task) {
+  {
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    m_queue.push_back(task);
+  }
+  m_queueCondition.notify_one();
+}
+
+void ConnectionEventLoop::work() {
+
+  while(true) {
+
+    HttpProcessor::Task* task;
+
+    {
+      std::unique_lock<std::mutex> lock(m_queueMutex);
+      while(m_queue.empty() && m_running) {
+        m_queueCondition.wait(lock);
+      }
+      if(m_queue.empty()) {
+        return;
+      }
+      task = m_queue.front();
+      m_queue.pop_front();
+    }
+
+    v_io_handle ioHandle = INVALID_IO_HANDLE;
+
+    switch(task->runUntilIdle(ioHandle)) {
+
+      case HttpProcessor::Task::IdleState::WAITING:
+        park(task, ioHandle);
+        break;
+
+      case HttpProcessor::Task::IdleState::NOT_PARKABLE:
+        runDedicated(task);
+        break;
+
+      case HttpProcessor::Task::IdleState::FINISHED:
+      default:
+        delete task;
+        break;
+
+    }
+
+  }
+
+}
+
+void ConnectionEventLoop::submit(HttpProcessor::Task* task) {
+  dispatch(task);
+}
+
+void ConnectionEventLoop::stop() {
+
+  {
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    if(!m_running) {
+      return;
+    }
+    m_running = false;
+  }
+
+  m_queueCondition.notify_all();
+  triggerWakeup();
+
+  for(auto& worker : m_workers) {
+    worker.join();
+  }
+  m_workers.clear();
+
+  if(m_poller.joinable()) {
+    m_poller.join();
+  }
+
+  for(auto task : m_queue) {
+    delete task;
+  }
+  m_queue.clear();
+
+  std::unordered_set<HttpProcessor::Task*> parked;
+  {
+    std::lock_guard<oatpp::concurrency::SpinLock> lock(m_parkedLock);
+    std::swap(parked, m_parked);
+  }
+  for(auto task : parked) {
+    delete task;
+  }
+
+}
+
+v_int64 ConnectionEventLoop::getParkedCount() {
+  std::lock_guard<oatpp::concurrency::SpinLock> lock(m_parkedLock);
+  return static_cast<v_int64>(m_parked.size());
+}
+
+}}}
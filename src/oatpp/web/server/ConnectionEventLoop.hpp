@@ -0,0 +1,107 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_web_server_ConnectionEventLoop_hpp
+#define oatpp_web_server_ConnectionEventLoop_hpp
+
+#include "oatpp/web/server/HttpProcessor.hpp"
+#include "oatpp/concurrency/SpinLock.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace oatpp { namespace web { namespace server {
+
+/**
+ * Event loop for blocking HTTP processing. <br>
+ * Connections are served by the bounded pool of worker threads using blocking API.
+ * When a keep-alive connection becomes idle it is parked in the event queue (`epoll`) and doesn't occupy a thread
+ * until the next request bytes arrive. <br>
+ * Connections which don't expose I/O handle, and all connections on platforms without `epoll`,
+ * are served by a dedicated thread each.
+ */
+class ConnectionEventLoop {
+private:
+  static constexpr const v_int32 MAX_EVENTS = 1024;
+private:
+  std::atomic<bool> m_running;
+  std::mutex m_queueMutex;
+  std::condition_variable m_queueCondition;
+  std::deque<HttpProcessor::Task*> m_queue;
+  std::vector<std::thread> m_workers;
+private:
+  oatpp::concurrency::SpinLock m_parkedLock;
+  std::unordered_set<HttpProcessor::Task*> m_parked;
+  v_io_handle m_eventQueueHandle;
+  v_io_handle m_wakeupTrigger;
+  std::thread m_poller;
+private:
+  void initEventQueue();
+  void closeEventQueue();
+  void triggerWakeup();
+  void pollEvents();
+  void dispatch(HttpProcessor::Task* task);
+  void park(HttpProcessor::Task* task, v_io_handle ioHandle);
+  void runDedicated(HttpProcessor::Task* task);
+  void work();
+public:
+
+  /**
+   * Constructor.
+   * @param workersCount - number of worker threads.
+   */
+  ConnectionEventLoop(v_int32 workersCount);
+
+  /**
+   * Non-virtual destructor. Stops the loop if not stopped. Tasks left parked are destroyed.
+   */
+  ~ConnectionEventLoop();
+
+  /**
+   * Submit connection processing task. Event loop takes ownership of the task.
+   * @param task - &id:oatpp::web::server::HttpProcessor::Task;.
+   */
+  void submit(HttpProcessor::Task* task);
+
+  /**
+   * Stop worker threads and event queue polling. Blocks until all threads are joined.
+   */
+  void stop();
+
+  /**
+   * Get number of connections currently parked in the event queue.
+   * @return
+   */
+  v_int64 getParkedCount();
+
+};
+
+}}}
+
+#endif // oatpp_web_server_ConnectionEventLoop_hpp
@@ -71,10 +71,26 @@ HttpConnectionHandler::HttpConnectionHandler(const std::shared_ptr<HttpProcessor
   , m_continue(true)
 {}
 
+HttpConnectionHandler::HttpConnectionHandler(const std::shared_ptr<HttpProcessor::Components>& components, v_int32 eventLoopWorkersCount)
+  : m_components(components)
+  , m_continue(true)
+  , m_eventLoop(new ConnectionEventLoop(eventLoopWorkersCount))
+{}
+
+HttpConnectionHandler::~HttpConnectionHandler() {
+  if(m_eventLoop) {
+    m_eventLoop->stop();
+  }
+}
+
 std::shared_ptr<HttpConnectionHandler> HttpConnectionHandler::createShared(const std::shared_ptr<HttpRouter>& router){
   return std::make_shared<HttpConnectionHandler>(router);
 }
 
+std::shared_ptr<HttpConnectionHandler> HttpConnectionHandler::createShared(const std::shared_ptr<HttpRouter>& router, v_int32 eventLoopWorkersCount){
+  return std::make_shared<HttpConnectionHandler>(std::make_shared<HttpProcessor::Components>(router), eventLoopWorkersCount);
+}
+
 void HttpConnectionHandler::setErrorHandler(const std::shared_ptr<handler::ErrorHandler>& errorHandler){
   m_components->errorHandler = errorHandler;
   if(!m_components->errorHandler) {
@@ -101,6 +117,11 @@ void HttpConnectionHandler::handleConnection(const provider::ResourceHandle<data
     connection.object->setOutputStreamIOMode(oatpp::data::stream::IOMode::BLOCKING);
     connection.object->setInputStreamIOMode(oatpp::data::stream::IOMode::BLOCKING);
 
+    if(m_eventLoop) {
+      m_eventLoop->submit(new HttpProcessor::Task(m_components, connection, this));
+      return;
+    }
+
     /* Create working thread */
     std::thread thread(&HttpProcessor::Task::run, std::move(HttpProcessor::Task(m_components, connection, this)));
 
@@ -130,6 +151,10 @@ void HttpConnectionHandler::stop() {
   while(getConnectionsCount() > 0) {
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
   }
+
+  if(m_eventLoop) {
+    m_eventLoop->stop();
+  }
 }
 
 }}}
@@ -25,6 +25,7 @@
 #ifndef oatpp_web_server_HttpConnectionHandler_hpp
 #define oatpp_web_server_HttpConnectionHandler_hpp
 
+#include "oatpp/web/server/ConnectionEventLoop.hpp"
 #include "oatpp/web/server/HttpProcessor.hpp"
 #include "oatpp/network/ConnectionHandler.hpp"
 #include "oatpp/concurrency/SpinLock.hpp"
@@ -35,7 +36,9 @@ namespace oatpp { namespace web { namespace server {
 
 /**
  * Simple ConnectionHandler (&id:oatpp::network::ConnectionHandler;) for handling HTTP communication. <br>
- * Will create one thread per each connection to handle communication.
+ * By default will create one thread per each connection to handle communication. <br>
+ * In event-loop mode connections are served by a bounded pool of threads, and idle keep-alive connections
+ * wait for the next request in the event queue. See &id:oatpp::web::server::ConnectionEventLoop;.
  */
 class HttpConnectionHandler : public base::Countable, public network::ConnectionHandler, public HttpProcessor::TaskProcessingListener {
 protected:
@@ -50,6 +53,7 @@ private:
   std::atomic_bool m_continue;
   std::unordered_map<v_uint64, provider::ResourceHandle<data::stream::IOStream>> m_connections;
   oatpp::concurrency::SpinLock m_connectionsLock;
+  std::unique_ptr<ConnectionEventLoop> m_eventLoop;
 public:
 
   /**
@@ -58,6 +62,18 @@ public:
    */
   HttpConnectionHandler(const std::shared_ptr<HttpProcessor::Components>& components);
 
+  /**
+   * Constructor. Event-loop mode.
+   * @param components - &id:oatpp::web::server::HttpProcessor::Components;.
+   * @param eventLoopWorkersCount - number of threads serving requests. Idle keep-alive connections don't occupy threads.
+   */
+  HttpConnectionHandler(const std::shared_ptr<HttpProcessor::Components>& components, v_int32 eventLoopWorkersCount);
+
+  /**
+   * Virtual destructor.
+   */
+  ~HttpConnectionHandler() override;
+
   /**
    * Constructor.
    * @param router - &id:oatpp::web::server::HttpRouter; to route incoming requests.
@@ -85,6 +101,14 @@ public:
    */
   static std::shared_ptr<HttpConnectionHandler> createShared(const std::shared_ptr<HttpRouter>& router);
 
+  /**
+   * Create shared HttpConnectionHandler working in event-loop mode.
+   * @param router - &id:oatpp::web::server::HttpRouter; to route incoming requests.
+   * @param eventLoopWorkersCount - number of threads serving requests.
+   * @return - `std::shared_ptr` to HttpConnectionHandler.
+   */
+  static std::shared_ptr<HttpConnectionHandler> createShared(const std::shared_ptr<HttpRouter>& router, v_int32 eventLoopWorkersCount);
+
   /**
    * Set root error handler for all requests coming through this Connection Handler.
    * All unhandled errors will be handled by this error handler.
@@ -26,7 +26,10 @@
 
 #include "oatpp/web/server/HttpServerError.hpp"
 #include "oatpp/web/protocol/http/incoming/SimpleBodyDecoder.hpp"
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
 #include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/utils/parser/ByteScanner.hpp"
+#include "oatpp/base/Log.hpp"
 
 namespace oatpp { namespace web { namespace server {
 
@@ -47,7 +50,14 @@ HttpProcessor::Components::Components(const std::shared_ptr<HttpRouter>& pRouter
   , requestInterceptors(pRequestInterceptors)
   , responseInterceptors(pResponseInterceptors)
   , config(pConfig)
-{}
+  , headersInBufferPool(nullptr)
+  , headersOutBufferPool(nullptr)
+{
+  if(config->poolHeadersBuffers) {
+    headersInBufferPool = &data::buffer::BufferPool::getShared(config->headersInBufferInitial);
+    headersOutBufferPool = &data::buffer::BufferPool::getShared(config->headersOutBufferInitial);
+  }
+}
 
 HttpProcessor::Components::Components(const std::shared_ptr<HttpRouter>& pRouter)
   : Components(pRouter,
@@ -76,16 +86,91 @@ HttpProcessor::ProcessingResources::ProcessingResources(const std::shared_ptr<Co
                                                         const provider::ResourceHandle<oatpp::data::stream::IOStream>& pConnection)
   : components(pComponents)
   , connection(pConnection)
-  , headersInBuffer(components->config->headersInBufferInitial)
-  , headersOutBuffer(components->config->headersOutBufferInitial)
+  , headersInBuffer(components->config->headersInBufferInitial, components->headersInBufferPool)
+  , headersOutBuffer(components->config->headersOutBufferInitial, components->headersOutBufferPool)
   , headersReader(&headersInBuffer, components->config->headersReaderChunkSize, components->config->headersReaderMaxSize)
   , inStream(data::stream::InputStreamBufferedProxy::createShared(connection.object, std::make_shared<std::string>(data::buffer::IOBuffer::BUFFER_SIZE, 0)))
 {}
 
+bool HttpProcessor::hasPipelinedRequest(oatpp::data::stream::InputStreamBufferedProxy* inStream) {
+
+  if(inStream->availableToRead() <= 0) {
+    return false;
+  }
+
+  /* Data is buffered - peek doesn't touch the connection */
+  char buffer[4096];
+  async::Action action;
+  auto size = inStream->peek(buffer, sizeof(buffer), action);
+  if(size <= 0) {
+    return false;
+  }
+
+  return utils::parser::ByteScanner::findRNRN(buffer, size) < size;
+
+}
+
+bool HttpProcessor::isPipelineBufferable(const std::shared_ptr<protocol::http::outgoing::Response>& response,
+                                         protocol::http::encoding::EncoderProvider* contentEncoderProvider,
+                                         ConnectionState connectionState,
+                                         v_buff_size flushThreshold)
+{
+
+  if(flushThreshold <= 0 || connectionState != ConnectionState::ALIVE || contentEncoderProvider != nullptr) {
+    return false;
+  }
+
+  auto body = response->getBody();
+  if(!body) {
+    return true;
+  }
+
+  return body->getKnownData() != nullptr && body->getKnownSize() < flushThreshold;
+
+}
+
+void HttpProcessor::flushPipelineBuffer(ProcessingResources& resources) {
+  if(resources.pipelineBuffer && resources.pipelineBuffer->getCurrentPosition() > 0) {
+    resources.pipelineBuffer->flushToStream(resources.connection.object.get());
+    resources.pipelineBuffer->setCurrentPosition(0);
+  }
+}
+
+std::shared_ptr<protocol::http::encoding::EncoderProvider>
+HttpProcessor::applyEncodedBodyCache(const std::shared_ptr<protocol::http::outgoing::Response>& response,
+                                     const std::shared_ptr<protocol::http::encoding::EncoderProvider>& contentEncoderProvider,
+                                     protocol::http::encoding::EncodedBodyCache* cache)
+{
+
+  if(cache == nullptr || !contentEncoderProvider) {
+    return contentEncoderProvider;
+  }
+
+  auto body = response->getBody();
+  if(!body || body->getKnownData() == nullptr || !cache->isCacheable(body->getKnownSize())) {
+    return contentEncoderProvider;
+  }
+
+  auto encoded = cache->get(contentEncoderProvider.get(), response->getHeader(protocol::http::Header::ETAG),
+                            body->getKnownData(), body->getKnownSize());
+  if(!encoded) {
+    return contentEncoderProvider;
+  }
+
+  /* Body is already encoded - send it as is, with Content-Length */
+  body->declareHeaders(response->getHeaders());
+  response->putOrReplaceHeader(protocol::http::Header::CONTENT_ENCODING, contentEncoderProvider->getEncodingName());
+  response->setBody(protocol::http::outgoing::BufferBody::createShared(encoded));
+
+  return nullptr;
+
+}
+
 std::shared_ptr<protocol::http::outgoing::Response>
 HttpProcessor::processNextRequest(ProcessingResources& resources,
                                   const std::shared_ptr<protocol::http::incoming::Request>& request,
-                                  ConnectionState& connectionState)
+                                  ConnectionState& connectionState,
+                                  metrics::HttpMetrics::Measurement* measurement)
 {
 
   std::shared_ptr<protocol::http::outgoing::Response> response;
@@ -96,13 +181,21 @@ HttpProcessor::processNextRequest(ProcessingResources& resources,
       for (auto &interceptor: resources.components->requestInterceptors) {
         response = interceptor->intercept(request);
         if (response) {
+          if(measurement) measurement->mark(metrics::HttpMetrics::PHASE_REQUEST_INTERCEPTORS);
           return response;
         }
       }
 
+      if(measurement) measurement->mark(metrics::HttpMetrics::PHASE_REQUEST_INTERCEPTORS);
+
       auto route = resources.components->router->getRoute(request->getStartingLine().method,
                                                           request->getStartingLine().path);
 
+      if(measurement) {
+        measurement->mark(metrics::HttpMetrics::PHASE_ROUTING);
+        measurement->pattern = route.getPattern();
+      }
+
       if (!route) {
         data::stream::BufferOutputStream ss;
         ss << "No mapping for HTTP-method: '" << request->getStartingLine().method.toString()
@@ -112,7 +205,11 @@ HttpProcessor::processNextRequest(ProcessingResources& resources,
       }
 
       request->setPathVariables(route.getMatchMap());
-      return route.getEndpoint()->handle(request);
+      response = route.getEndpoint()->handle(request);
+
+      if(measurement) measurement->mark(metrics::HttpMetrics::PHASE_ENDPOINT);
+
+      return response;
 
     } catch (...) {
       std::throw_with_nested(HttpServerError(request, "Error processing request"));
@@ -128,13 +225,32 @@ HttpProcessor::processNextRequest(ProcessingResources& resources,
 
 HttpProcessor::ConnectionState HttpProcessor::processNextRequest(ProcessingResources& resources) {
 
+  auto metrics = resources.components->config->metrics.get();
+  metrics::HttpMetrics::Measurement measurementData;
+  metrics::HttpMetrics::Measurement* measurement = nullptr;
+
+  if(metrics) {
+    /* keep-alive idle time is not a part of the request - start measuring once request data is available */
+    async::Action action;
+    v_char8 byte;
+    v_io_size res;
+    do {
+      res = resources.inStream->peek(&byte, 1, action);
+    } while((res == IOError::RETRY_READ || res == IOError::RETRY_WRITE) && action.isNone());
+    measurement = &measurementData;
+    measurement->start();
+  }
+
   oatpp::web::protocol::http::HttpError::Info error;
   auto headersReadResult = resources.headersReader.readHeaders(resources.inStream.get(), error);
 
   if(error.ioStatus <= 0) {
+    flushPipelineBuffer(resources);
     return ConnectionState::DEAD;
   }
 
+  if(measurement) measurement->mark(metrics::HttpMetrics::PHASE_HEADERS_READ);
+
   ConnectionState connectionState = ConnectionState::ALIVE;
   std::shared_ptr<protocol::http::incoming::Request> request;
   std::shared_ptr<protocol::http::outgoing::Response> response;
@@ -152,7 +268,7 @@ HttpProcessor::ConnectionState HttpProcessor::processNextRequest(ProcessingResou
                                                               resources.inStream,
                                                               resources.components->bodyDecoder);
 
-    response = processNextRequest(resources, request, connectionState);
+    response = processNextRequest(resources, request, connectionState, measurement);
 
     try {
       try {
@@ -172,6 +288,8 @@ HttpProcessor::ConnectionState HttpProcessor::processNextRequest(ProcessingResou
       connectionState = ConnectionState::CLOSING;
     }
 
+    if(measurement) measurement->mark(metrics::HttpMetrics::PHASE_RESPONSE_INTERCEPTORS);
+
     response->putHeaderIfNotExists(protocol::http::Header::SERVER, protocol::http::Header::Value::SERVER);
     protocol::http::utils::CommunicationUtils::considerConnectionState(request, response, connectionState);
 
@@ -195,9 +313,47 @@ HttpProcessor::ConnectionState HttpProcessor::processNextRequest(ProcessingResou
   }
 
   auto contentEncoderProvider =
-    protocol::http::utils::CommunicationUtils::selectEncoder(request, resources.components->contentEncodingProviders);
+    applyEncodedBodyCache(response,
+                          protocol::http::utils::CommunicationUtils::selectEncoder(request, resources.components->contentEncodingProviders),
+                          resources.components->config->encodedBodyCache.get());
 
-  response->send(resources.connection.object.get(), &resources.headersOutBuffer, contentEncoderProvider.get());
+  auto flushThreshold = resources.components->config->pipelineFlushThreshold;
+  bool hasPending = resources.pipelineBuffer && resources.pipelineBuffer->getCurrentPosition() > 0;
+  bool isBuffered = false;
+
+  if(isPipelineBufferable(response, contentEncoderProvider.get(), connectionState, flushThreshold)) {
+
+    bool hasNext = hasPipelinedRequest(resources.inStream.get());
+
+    if(hasNext || hasPending) {
+
+      if(!resources.pipelineBuffer) {
+        resources.pipelineBuffer = std::make_shared<data::stream::BufferOutputStream>(resources.components->config->headersOutBufferInitial,
+                                                                                      resources.components->headersOutBufferPool);
+      }
+
+      response->send(resources.pipelineBuffer.get(), &resources.headersOutBuffer, nullptr);
+      isBuffered = true;
+
+      if(!hasNext || resources.pipelineBuffer->getCurrentPosition() >= flushThreshold) {
+        flushPipelineBuffer(resources);
+      }
+
+    }
+
+  }
+
+  if(!isBuffered) {
+    flushPipelineBuffer(resources);
+    response->send(resources.connection.object.get(), &resources.headersOutBuffer, contentEncoderProvider.get());
+  }
+
+  if(measurement) {
+    measurement->finish();
+    metrics->record(request ? request->getStartingLine().method : data::share::StringKeyLabel(),
+                    response->getStatus().code,
+                    *measurement);
+  }
 
   /* Delegate connection handling to another handler only after the response is sent to the client */
   if(connectionState == ConnectionState::DELEGATED) {
@@ -266,10 +422,71 @@ void HttpProcessor::Task::run(){
 
     } while (connectionState == ConnectionState::ALIVE);
 
+  } catch (std::exception& e) {
+    OATPP_LOGe("[oatpp::web::server::HttpProcessor::Task::run()]", "Unhandled error. '{}'. Dropping connection", e.what())
+    m_connection.invalidator->invalidate(m_connection.object);
+  } catch (...) {
+    OATPP_LOGe("[oatpp::web::server::HttpProcessor::Task::run()]", "Unhandled unknown error. Dropping connection")
+    m_connection.invalidator->invalidate(m_connection.object);
+  }
+
+}
+
+HttpProcessor::Task::IdleState HttpProcessor::Task::runUntilIdle(v_io_handle& ioHandle) {
+
+  m_connection.object->initContexts();
+
+  m_connection.object->setOutputStreamIOMode(oatpp::data::stream::IOMode::BLOCKING);
+  m_connection.object->setInputStreamIOMode(oatpp::data::stream::IOMode::BLOCKING);
+
+  ProcessingResources resources(m_components, m_connection);
+
+  try {
+
+    while(true) {
+
+      auto connectionState = HttpProcessor::processNextRequest(resources);
+      if(connectionState != ConnectionState::ALIVE) {
+        return IdleState::FINISHED;
+      }
+
+      if(resources.inStream->availableToRead() > 0) {
+        continue; // pipelined request is already buffered
+      }
+
+      /* Check if next request is already there without blocking */
+      m_connection.object->setInputStreamIOMode(oatpp::data::stream::IOMode::ASYNCHRONOUS);
+      async::Action action;
+      v_char8 byte;
+      auto res = resources.inStream->peek(&byte, 1, action);
+      m_connection.object->setInputStreamIOMode(oatpp::data::stream::IOMode::BLOCKING);
+
+      if(res > 0) {
+        continue;
+      }
+
+      if(res == IOError::RETRY_READ) {
+        if(action.getType() == async::Action::TYPE_IO_WAIT) {
+          ioHandle = action.getIOHandle();
+          return IdleState::WAITING;
+        }
+        return IdleState::NOT_PARKABLE;
+      }
+
+      return IdleState::FINISHED;
+
+    }
+
+  } catch (std::exception& e) {
+    OATPP_LOGe("[oatpp::web::server::HttpProcessor::Task::runUntilIdle()]", "Unhandled error. '{}'. Dropping connection", e.what())
+    m_connection.invalidator->invalidate(m_connection.object);
   } catch (...) {
-    // DO NOTHING
+    OATPP_LOGe("[oatpp::web::server::HttpProcessor::Task::runUntilIdle()]", "Unhandled unknown error. Dropping connection")
+    m_connection.invalidator->invalidate(m_connection.object);
   }
 
+  return IdleState::FINISHED;
+
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -280,13 +497,14 @@ HttpProcessor::Coroutine::Coroutine(const std::shared_ptr<Components>& component
                                     TaskProcessingListener* taskListener)
   : m_components(components)
   , m_connection(connection)
-  , m_headersInBuffer(components->config->headersInBufferInitial)
+  , m_headersInBuffer(components->config->headersInBufferInitial, components->headersInBufferPool)
   , m_headersReader(&m_headersInBuffer, components->config->headersReaderChunkSize, components->config->headersReaderMaxSize)
-  , m_headersOutBuffer(std::make_shared<oatpp::data::stream::BufferOutputStream>(components->config->headersOutBufferInitial))
+  , m_headersOutBuffer(std::make_shared<oatpp::data::stream::BufferOutputStream>(components->config->headersOutBufferInitial, components->headersOutBufferPool))
   , m_inStream(data::stream::InputStreamBufferedProxy::createShared(m_connection.object, std::make_shared<std::string>(data::buffer::IOBuffer::BUFFER_SIZE, 0)))
   , m_connectionState(ConnectionState::ALIVE)
   , m_taskListener(taskListener)
   , m_shouldInterceptResponse(false)
+  , m_metrics(components->config->metrics.get())
 {
   m_taskListener->onTaskStart(m_connection);
 }
@@ -301,11 +519,36 @@ HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::act() {
 
 HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::parseHeaders() {
   m_shouldInterceptResponse = true;
+  if(m_metrics) {
+    return yieldTo(&HttpProcessor::Coroutine::waitRequestData);
+  }
   return m_headersReader.readHeadersAsync(m_inStream).callbackTo(&HttpProcessor::Coroutine::onHeadersParsed);
 }
 
+HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::waitRequestData() {
+
+  /* keep-alive idle time is not a part of the request - start measuring once request data is available */
+  async::Action action;
+  v_char8 byte;
+  auto res = m_inStream->peek(&byte, 1, action);
+
+  if(!action.isNone()) {
+    return action;
+  }
+
+  if(res == IOError::RETRY_READ || res == IOError::RETRY_WRITE) {
+    return repeat();
+  }
+
+  m_measurement.start();
+  return m_headersReader.readHeadersAsync(m_inStream).callbackTo(&HttpProcessor::Coroutine::onHeadersParsed);
+
+}
+
 oatpp::async::Action HttpProcessor::Coroutine::onHeadersParsed(const RequestHeadersReader::Result& headersReadResult) {
 
+  if(m_metrics) m_measurement.mark(metrics::HttpMetrics::PHASE_HEADERS_READ);
+
   m_currentRequest = protocol::http::incoming::Request::createShared(m_connection.object,
                                                                      headersReadResult.startingLine,
                                                                      headersReadResult.headers,
@@ -315,12 +558,20 @@ oatpp::async::Action HttpProcessor::Coroutine::onHeadersParsed(const RequestHead
   for(auto& interceptor : m_components->requestInterceptors) {
     m_currentResponse = interceptor->intercept(m_currentRequest);
     if(m_currentResponse) {
+      if(m_metrics) m_measurement.mark(metrics::HttpMetrics::PHASE_REQUEST_INTERCEPTORS);
       return yieldTo(&HttpProcessor::Coroutine::onResponseFormed);
     }
   }
 
+  if(m_metrics) m_measurement.mark(metrics::HttpMetrics::PHASE_REQUEST_INTERCEPTORS);
+
   m_currentRoute = m_components->router->getRoute(headersReadResult.startingLine.method.toString(), headersReadResult.startingLine.path.toString());
 
+  if(m_metrics) {
+    m_measurement.mark(metrics::HttpMetrics::PHASE_ROUTING);
+    m_measurement.pattern = m_currentRoute.getPattern();
+  }
+
   if(!m_currentRoute) {
 
     data::stream::BufferOutputStream ss;
@@ -345,6 +596,7 @@ HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::onRequestFormed() {
 
 HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::onResponse(const std::shared_ptr<protocol::http::outgoing::Response>& response) {
   m_currentResponse = response;
+  if(m_metrics) m_measurement.mark(metrics::HttpMetrics::PHASE_ENDPOINT);
   return yieldTo(&HttpProcessor::Coroutine::onResponseFormed);
 }
   
@@ -363,6 +615,8 @@ HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::onResponseFormed() {
     }
   }
 
+  if(m_metrics) m_measurement.mark(metrics::HttpMetrics::PHASE_RESPONSE_INTERCEPTORS);
+
   m_currentResponse->putHeaderIfNotExists(protocol::http::Header::SERVER, protocol::http::Header::Value::SERVER);
   oatpp::web::protocol::http::utils::CommunicationUtils::considerConnectionState(m_currentRequest, m_currentResponse, m_connectionState);
 
@@ -383,16 +637,74 @@ HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::onResponseFormed() {
 
   }
 
-  auto contentEncoderProvider =
-    protocol::http::utils::CommunicationUtils::selectEncoder(m_currentRequest, m_components->contentEncodingProviders);
+  m_currentEncoderProvider =
+    applyEncodedBodyCache(m_currentResponse,
+                          protocol::http::utils::CommunicationUtils::selectEncoder(m_currentRequest, m_components->contentEncodingProviders),
+                          m_components->config->encodedBodyCache.get());
+
+  return sendResponse();
+
+}
+
+HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::sendResponse() {
+
+  auto flushThreshold = m_components->config->pipelineFlushThreshold;
+  bool hasPending = m_pipelineBuffer && m_pipelineBuffer->getCurrentPosition() > 0;
+
+  if(isPipelineBufferable(m_currentResponse, m_currentEncoderProvider.get(), m_connectionState, flushThreshold)) {
+
+    bool hasNext = hasPipelinedRequest(m_inStream.get());
+
+    if(hasNext || hasPending) {
+
+      if(!m_pipelineBuffer) {
+        m_pipelineBuffer = std::make_shared<data::stream::BufferOutputStream>(m_components->config->headersOutBufferInitial,
+                                                                              m_components->headersOutBufferPool);
+      }
 
-  return protocol::http::outgoing::Response::sendAsync(m_currentResponse, m_connection.object, m_headersOutBuffer, contentEncoderProvider)
+      /* In-memory body - writing to the buffer never blocks */
+      m_currentResponse->send(m_pipelineBuffer.get(), m_headersOutBuffer.get(), nullptr);
+
+      if(!hasNext || m_pipelineBuffer->getCurrentPosition() >= flushThreshold) {
+        return data::stream::BufferOutputStream::flushToStreamAsync(m_pipelineBuffer, m_connection.object)
+               .next(yieldTo(&HttpProcessor::Coroutine::onPipelineBufferFlushed));
+      }
+
+      return yieldTo(&HttpProcessor::Coroutine::onRequestDone);
+
+    }
+
+  }
+
+  if(hasPending) {
+    return data::stream::BufferOutputStream::flushToStreamAsync(m_pipelineBuffer, m_connection.object)
+           .next(yieldTo(&HttpProcessor::Coroutine::onPipelineBufferFlushedBeforeResponse));
+  }
+
+  return protocol::http::outgoing::Response::sendAsync(m_currentResponse, m_connection.object, m_headersOutBuffer, m_currentEncoderProvider)
          .next(yieldTo(&HttpProcessor::Coroutine::onRequestDone));
 
 }
+
+HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::onPipelineBufferFlushed() {
+  m_pipelineBuffer->setCurrentPosition(0);
+  return yieldTo(&HttpProcessor::Coroutine::onRequestDone);
+}
+
+HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::onPipelineBufferFlushedBeforeResponse() {
+  m_pipelineBuffer->setCurrentPosition(0);
+  return sendResponse();
+}
   
 HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::onRequestDone() {
 
+  if(m_metrics) {
+    m_measurement.finish();
+    m_metrics->record(m_currentRequest ? m_currentRequest->getStartingLine().method : data::share::StringKeyLabel(),
+                      m_currentResponse->getStatus().code,
+                      m_measurement);
+  }
+
   switch (m_connectionState) {
     case ConnectionState::ALIVE:
       return yieldTo(&HttpProcessor::Coroutine::parseHeaders);
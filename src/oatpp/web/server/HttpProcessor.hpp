@@ -30,8 +30,10 @@
 #include "./interceptor/RequestInterceptor.hpp"
 #include "./interceptor/ResponseInterceptor.hpp"
 #include "./handler/ErrorHandler.hpp"
+#include "./metrics/HttpMetrics.hpp"
 
 #include "oatpp/web/protocol/http/encoding/ProviderCollection.hpp"
+#include "oatpp/web/protocol/http/encoding/EncodedBodyCache.hpp"
 
 #include "oatpp/web/protocol/http/incoming/RequestHeadersReader.hpp"
 #include "oatpp/web/protocol/http/incoming/Request.hpp"
@@ -83,6 +85,32 @@ public:
      */
     v_buff_size headersReaderMaxSize = 4096;
 
+    /**
+     * Obtain headers buffers from shared &id:oatpp::data::buffer::BufferPool; instead of allocating them per connection.
+     */
+    bool poolHeadersBuffers = true;
+
+    /**
+     * Responses to pipelined requests are accumulated and written to the connection with one write. <br>
+     * Accumulated responses are flushed once no complete request is buffered in the input, or when their size reaches this threshold.
+     * Only responses with in-memory bodies are accumulated. Set to `0` to write each response separately.
+     */
+    v_buff_size pipelineFlushThreshold = 64 * 1024;
+
+    /**
+     * Cache of encoded response bodies. Not set by default. <br>
+     * If set, in-memory bodies of responses to be content-encoded are encoded once and then served from the cache
+     * with a known `Content-Length` instead of being encoded and chunked on each request.
+     */
+    std::shared_ptr<protocol::http::encoding::EncodedBodyCache> encodedBodyCache;
+
+    /**
+     * Per-request latency metrics. Not set by default. <br>
+     * If set, latency of each request processing phase is recorded to &id:oatpp::web::server::metrics::HttpMetrics;.
+     * When not set, no time measurement is done.
+     */
+    std::shared_ptr<metrics::HttpMetrics> metrics;
+
   };
 
 public:
@@ -157,6 +185,16 @@ public:
      */
     std::shared_ptr<Config> config;
 
+    /**
+     * Pool for headers-in buffers. `nullptr` if &l:HttpProcessor::Config::poolHeadersBuffers; is `false`.
+     */
+    data::buffer::BufferPool* headersInBufferPool;
+
+    /**
+     * Pool for headers-out buffers. `nullptr` if &l:HttpProcessor::Config::poolHeadersBuffers; is `false`.
+     */
+    data::buffer::BufferPool* headersOutBufferPool;
+
   };
 
 private:
@@ -172,14 +210,28 @@ private:
     oatpp::data::stream::BufferOutputStream headersOutBuffer;
     RequestHeadersReader headersReader;
     std::shared_ptr<oatpp::data::stream::InputStreamBufferedProxy> inStream;
+    std::shared_ptr<oatpp::data::stream::BufferOutputStream> pipelineBuffer;
 
   };
 
+  static bool hasPipelinedRequest(oatpp::data::stream::InputStreamBufferedProxy* inStream);
+  static bool isPipelineBufferable(const std::shared_ptr<protocol::http::outgoing::Response>& response,
+                                   protocol::http::encoding::EncoderProvider* contentEncoderProvider,
+                                   ConnectionState connectionState,
+                                   v_buff_size flushThreshold);
+  static void flushPipelineBuffer(ProcessingResources& resources);
+
+  static std::shared_ptr<protocol::http::encoding::EncoderProvider>
+  applyEncodedBodyCache(const std::shared_ptr<protocol::http::outgoing::Response>& response,
+                        const std::shared_ptr<protocol::http::encoding::EncoderProvider>& contentEncoderProvider,
+                        protocol::http::encoding::EncodedBodyCache* cache);
+
   static
   std::shared_ptr<protocol::http::outgoing::Response>
   processNextRequest(ProcessingResources& resources,
                      const std::shared_ptr<protocol::http::incoming::Request>& request,
-                     ConnectionState& connectionState);
+                     ConnectionState& connectionState,
+                     metrics::HttpMetrics::Measurement* measurement);
   static ConnectionState processNextRequest(ProcessingResources& resources);
 
 public:
@@ -201,6 +253,30 @@ public:
    * `std::thread thread(&HttpProcessor::Task::run, HttpProcessor::Task(components, connection));`
    */
   class Task : public base::Countable {
+  public:
+
+    /**
+     * Result of &l:HttpProcessor::Task::runUntilIdle ();.
+     */
+    enum class IdleState : v_int32 {
+
+      /**
+       * Connection is closed or delegated. Task has nothing more to do.
+       */
+      FINISHED = 0,
+
+      /**
+       * Connection is idle. Wait until its I/O handle is readable and call `runUntilIdle()` again.
+       */
+      WAITING = 1,
+
+      /**
+       * Connection doesn't expose I/O handle to wait on. Call `run()` to serve it in blocking manner.
+       */
+      NOT_PARKABLE = 2
+
+    };
+
   private:
     std::shared_ptr<Components> m_components;
     provider::ResourceHandle<oatpp::data::stream::IOStream> m_connection;
@@ -243,6 +319,14 @@ public:
      */
     void run();
 
+    /**
+     * Serve requests until the connection has no more data to process and the next read would block. <br>
+     * Processing buffers are released before return, so waiting connection costs nothing but the task object itself.
+     * @param ioHandle - out parameter. I/O handle to wait on for &l:HttpProcessor::Task::IdleState::WAITING;.
+     * @return - &l:HttpProcessor::Task::IdleState;.
+     */
+    IdleState runUntilIdle(v_io_handle& ioHandle);
+
   };
   
 public:
@@ -258,14 +342,18 @@ public:
     RequestHeadersReader m_headersReader;
     std::shared_ptr<oatpp::data::stream::BufferOutputStream> m_headersOutBuffer;
     std::shared_ptr<oatpp::data::stream::InputStreamBufferedProxy> m_inStream;
+    std::shared_ptr<oatpp::data::stream::BufferOutputStream> m_pipelineBuffer;
     ConnectionState m_connectionState;
   private:
     oatpp::web::server::HttpRouter::BranchRouter::Route m_currentRoute;
     std::shared_ptr<protocol::http::incoming::Request> m_currentRequest;
     std::shared_ptr<protocol::http::outgoing::Response> m_currentResponse;
+    std::shared_ptr<protocol::http::encoding::EncoderProvider> m_currentEncoderProvider;
     TaskProcessingListener* m_taskListener;
   private:
     bool m_shouldInterceptResponse;
+    metrics::HttpMetrics* m_metrics;
+    metrics::HttpMetrics::Measurement m_measurement;
   public:
 
     /**
@@ -282,12 +370,16 @@ public:
     Action act() override;
 
     Action parseHeaders();
+    Action waitRequestData();
     
     Action onHeadersParsed(const RequestHeadersReader::Result& headersReadResult);
     
     Action onRequestFormed();
     Action onResponse(const std::shared_ptr<protocol::http::outgoing::Response>& response);
     Action onResponseFormed();
+    Action sendResponse();
+    Action onPipelineBufferFlushed();
+    Action onPipelineBufferFlushedBeforeResponse();
     Action onRequestDone();
     
     Action handleError(Error* error) override;
@@ -30,13 +30,17 @@
 #include "oatpp/web/server/api/ApiController.hpp"
 #include "oatpp/web/server/api/Endpoint.hpp"
 #include "oatpp/web/url/mapping/Router.hpp"
+#include "oatpp/web/url/mapping/TreeRouter.hpp"
 
 namespace oatpp { namespace web { namespace server {
 
 /**
  * HttpRouter is responsible for routing http requests by method and path-pattern.
+ * @tparam RouterEndpoint - endpoint of the route.
+ * @tparam BranchRouterType - router used for each http method. Either &id:oatpp::web::url::mapping::Router; (linear scan)
+ * or &id:oatpp::web::url::mapping::TreeRouter; (prefix-tree).
  */
-template<typename RouterEndpoint>
+template<typename RouterEndpoint, typename BranchRouterType = web::url::mapping::Router<RouterEndpoint>>
 class HttpRouterTemplate : public oatpp::base::Countable {
 private:
   /**
@@ -46,9 +50,9 @@ private:
 public:
 
   /**
-   * &id:oatpp::web::url::mapping::Router;
+   * &id:oatpp::web::url::mapping::Router; or &id:oatpp::web::url::mapping::TreeRouter;.
    */
-  typedef web::url::mapping::Router<RouterEndpoint> BranchRouter;
+  typedef BranchRouterType BranchRouter;
 
   /**
    * Http method to &l:HttpRouter::BranchRouter; map.
@@ -101,7 +105,7 @@ public:
   typename BranchRouter::Route getRoute(const StringKeyLabel& method, const StringKeyLabel& path){
     auto it = m_branchMap.find(method);
     if(it != m_branchMap.end()) {
-      return m_branchMap[method]->getRoute(path);
+      return it->second->getRoute(path);
     }
     return typename BranchRouter::Route();
   }
@@ -118,9 +122,12 @@ public:
 };
 
 /**
- * Default HttpRouter.
+ * Default HttpRouter. Uses &id:oatpp::web::url::mapping::TreeRouter; to resolve paths.
  */
-class HttpRouter : public HttpRouterTemplate<std::shared_ptr<HttpRequestHandler>> {
+class HttpRouter : public HttpRouterTemplate<
+  std::shared_ptr<HttpRequestHandler>,
+  web::url::mapping::TreeRouter<std::shared_ptr<HttpRequestHandler>>
+> {
 private:
   std::list<std::shared_ptr<server::api::ApiController>> m_controllers;
 public:
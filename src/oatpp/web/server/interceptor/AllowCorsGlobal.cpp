@@ -46,11 +46,25 @@ AllowCorsGlobal::AllowCorsGlobal(const oatpp::String &origin,
   , m_methods(methods)
   , m_headers(headers)
   , m_maxAge(maxAge)
-{}
+{
+  protocol::http::Headers corsHeaders;
+  corsHeaders.put(protocol::http::Header::CORS_ORIGIN, m_origin);
+  corsHeaders.put(protocol::http::Header::CORS_METHODS, m_methods);
+  corsHeaders.put(protocol::http::Header::CORS_HEADERS, m_headers);
+  corsHeaders.put(protocol::http::Header::CORS_MAX_AGE, m_maxAge);
+  m_headersBlock = protocol::http::outgoing::HeadersBlock::createShared(corsHeaders);
+}
 
 std::shared_ptr<protocol::http::outgoing::Response> AllowCorsGlobal::intercept(const std::shared_ptr<IncomingRequest>& request,
                                                                                const std::shared_ptr<OutgoingResponse>& response)
 {
+
+  /* Precompiled CORS headers - CORS headers set on the response itself still take precedence */
+  if(!response->getHeadersBlock()) {
+    response->setHeadersBlock(m_headersBlock);
+    return response;
+  }
+
   response->putHeaderIfNotExists(protocol::http::Header::CORS_ORIGIN, m_origin);
   response->putHeaderIfNotExists(protocol::http::Header::CORS_METHODS, m_methods);
   response->putHeaderIfNotExists(protocol::http::Header::CORS_HEADERS, m_headers);
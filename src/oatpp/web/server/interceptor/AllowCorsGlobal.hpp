@@ -41,6 +41,7 @@ private:
   oatpp::String m_methods;
   oatpp::String m_headers;
   oatpp::String m_maxAge;
+  std::shared_ptr<protocol::http::outgoing::HeadersBlock> m_headersBlock;
 public:
 
   AllowCorsGlobal(const oatpp::String &origin = "*",
@@ -0,0 +1,180 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "Histogram.hpp"
+
+#include <limits>
+
+namespace oatpp { namespace web { namespace server { namespace metrics {
+
+namespace {
+
+v_int32 getHighestBit(v_uint64 value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return 63 - __builtin_clzll(value);
+#else
+  v_int32 result = 0;
+  while(value >>= 1) {
+    result ++;
+  }
+  return result;
+#endif
+}
+
+}
+
+v_uint64 Histogram::Snapshot::getValueAtPercentile(v_float64 percentile) const {
+
+  if(totalCount == 0 || counts.empty()) {
+    return 0;
+  }
+
+  if(percentile < 0) {
+    percentile = 0;
+  } else if(percentile > 100) {
+    percentile = 100;
+  }
+
+  auto target = static_cast<v_uint64>(percentile / 100.0 * static_cast<v_float64>(totalCount) + 0.5);
+  if(target < 1) {
+    target = 1;
+  }
+
+  v_uint64 accumulated = 0;
+  for(size_t i = 0; i < counts.size(); i ++) {
+    accumulated += counts[i];
+    if(accumulated >= target) {
+      auto value = getBucketHighestValue(static_cast<v_int32>(i));
+      if(value > max) value = max;
+      if(value < min) value = min;
+      return value;
+    }
+  }
+
+  return max;
+
+}
+
+v_float64 Histogram::Snapshot::getMean() const {
+  if(totalCount == 0) {
+    return 0;
+  }
+  return static_cast<v_float64>(sum) / static_cast<v_float64>(totalCount);
+}
+
+v_int32 Histogram::getBucketIndex(v_uint64 value) {
+
+  if(value > MAX_VALUE) {
+    value = MAX_VALUE;
+  }
+
+  if(value < static_cast<v_uint64>(SUB_BUCKETS_COUNT)) {
+    return static_cast<v_int32>(value);
+  }
+
+  v_int32 shift = getHighestBit(value) - SUB_BUCKET_BITS;
+  return (shift + 1) * SUB_BUCKETS_COUNT + static_cast<v_int32>(value >> shift) - SUB_BUCKETS_COUNT;
+
+}
+
+v_uint64 Histogram::getBucketLowestValue(v_int32 index) {
+  if(index < SUB_BUCKETS_COUNT) {
+    return static_cast<v_uint64>(index);
+  }
+  v_int32 shift = index / SUB_BUCKETS_COUNT - 1;
+  auto mantissa = static_cast<v_uint64>(index % SUB_BUCKETS_COUNT + SUB_BUCKETS_COUNT);
+  return mantissa << shift;
+}
+
+v_uint64 Histogram::getBucketHighestValue(v_int32 index) {
+  if(index < SUB_BUCKETS_COUNT) {
+    return static_cast<v_uint64>(index);
+  }
+  v_int32 shift = index / SUB_BUCKETS_COUNT - 1;
+  auto mantissa = static_cast<v_uint64>(index % SUB_BUCKETS_COUNT + SUB_BUCKETS_COUNT);
+  return ((mantissa + 1) << shift) - 1;
+}
+
+Histogram::Histogram() {
+  reset();
+}
+
+void Histogram::record(v_uint64 value) {
+
+  auto currMin = m_min.load(std::memory_order_relaxed);
+  while(value < currMin && !m_min.compare_exchange_weak(currMin, value, std::memory_order_relaxed)) {}
+
+  auto currMax = m_max.load(std::memory_order_relaxed);
+  while(value > currMax && !m_max.compare_exchange_weak(currMax, value, std::memory_order_relaxed)) {}
+
+  m_sum.fetch_add(value, std::memory_order_relaxed);
+  m_counts[getBucketIndex(value)].fetch_add(1, std::memory_order_release);
+  m_totalCount.fetch_add(1, std::memory_order_release);
+
+}
+
+v_uint64 Histogram::getTotalCount() const {
+  return m_totalCount.load(std::memory_order_acquire);
+}
+
+Histogram::Snapshot Histogram::getSnapshot() const {
+
+  Snapshot result;
+
+  result.totalCount = m_totalCount.load(std::memory_order_acquire);
+  result.counts.resize(BUCKETS_COUNT);
+
+  v_uint64 countsSum = 0;
+  for(v_int32 i = 0; i < BUCKETS_COUNT; i ++) {
+    result.counts[static_cast<size_t>(i)] = m_counts[i].load(std::memory_order_acquire);
+    countsSum += result.counts[static_cast<size_t>(i)];
+  }
+
+  /* values recorded after totalCount was read are still visible in counts */
+  if(countsSum > result.totalCount) {
+    result.totalCount = countsSum;
+  }
+
+  result.sum = m_sum.load(std::memory_order_relaxed);
+
+  if(result.totalCount > 0) {
+    result.min = m_min.load(std::memory_order_relaxed);
+    result.max = m_max.load(std::memory_order_relaxed);
+  }
+
+  return result;
+
+}
+
+void Histogram::reset() {
+  for(auto& count : m_counts) {
+    count.store(0, std::memory_order_relaxed);
+  }
+  m_totalCount.store(0, std::memory_order_relaxed);
+  m_sum.store(0, std::memory_order_relaxed);
+  m_min.store(std::numeric_limits<v_uint64>::max(), std::memory_order_relaxed);
+  m_max.store(0, std::memory_order_relaxed);
+}
+
+}}}}
@@ -0,0 +1,190 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_web_server_metrics_Histogram_hpp
+#define oatpp_web_server_metrics_Histogram_hpp
+
+#include "oatpp/Environment.hpp"
+
+#include <atomic>
+#include <vector>
+
+namespace oatpp { namespace web { namespace server { namespace metrics {
+
+/**
+ * Lock-free log-linear (HDR-style) histogram of non-negative integer values. <br>
+ * Every power-of-two range is split into &l:Histogram::SUB_BUCKETS_COUNT; linear sub-buckets
+ * so the relative error of the reported value is bounded by `1 / SUB_BUCKETS_COUNT`. <br>
+ * &l:Histogram::record (); is wait-free and can be called concurrently from any number of threads.
+ */
+class Histogram {
+public:
+
+  /**
+   * Number of bits of value precision.
+   */
+  static constexpr v_int32 SUB_BUCKET_BITS = 3;
+
+  /**
+   * Number of linear sub-buckets per power-of-two range.
+   */
+  static constexpr v_int32 SUB_BUCKETS_COUNT = 1 << SUB_BUCKET_BITS;
+
+  /**
+   * Values greater or equal to `2^MAX_VALUE_BITS` are recorded as `2^MAX_VALUE_BITS - 1`.
+   */
+  static constexpr v_int32 MAX_VALUE_BITS = 40;
+
+  /**
+   * Total number of buckets.
+   */
+  static constexpr v_int32 BUCKETS_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS_COUNT;
+
+  /**
+   * Max value which can be recorded without clamping.
+   */
+  static constexpr v_uint64 MAX_VALUE = (v_uint64(1) << MAX_VALUE_BITS) - 1;
+
+public:
+
+  /**
+   * Point-in-time copy of histogram data.
+   */
+  class Snapshot {
+  public:
+
+    /**
+     * Count of values recorded in each bucket.
+     */
+    std::vector<v_uint64> counts;
+
+    /**
+     * Total count of recorded values.
+     */
+    v_uint64 totalCount = 0;
+
+    /**
+     * Sum of recorded values.
+     */
+    v_uint64 sum = 0;
+
+    /**
+     * Min recorded value. `0` if no values recorded.
+     */
+    v_uint64 min = 0;
+
+    /**
+     * Max recorded value. `0` if no values recorded.
+     */
+    v_uint64 max = 0;
+
+  public:
+
+    /**
+     * Get value at percentile.
+     * @param percentile - percentile in range [0, 100].
+     * @return - highest value equivalent to the value at percentile (within histogram precision). `0` if histogram is empty.
+     */
+    v_uint64 getValueAtPercentile(v_float64 percentile) const;
+
+    /**
+     * Get mean of recorded values.
+     * @return
+     */
+    v_float64 getMean() const;
+
+  };
+
+private:
+  std::atomic<v_uint64> m_counts[BUCKETS_COUNT];
+  std::atomic<v_uint64> m_totalCount;
+  std::atomic<v_uint64> m_sum;
+  std::atomic<v_uint64> m_min;
+  std::atomic<v_uint64> m_max;
+public:
+
+  /**
+   * Get bucket index of the value.
+   * @param value
+   * @return
+   */
+  static v_int32 getBucketIndex(v_uint64 value);
+
+  /**
+   * Get the lowest value which falls into the bucket.
+   * @param index - bucket index.
+   * @return
+   */
+  static v_uint64 getBucketLowestValue(v_int32 index);
+
+  /**
+   * Get the highest value which falls into the bucket.
+   * @param index - bucket index.
+   * @return
+   */
+  static v_uint64 getBucketHighestValue(v_int32 index);
+
+public:
+
+  /**
+   * Constructor.
+   */
+  Histogram();
+
+  /**
+   * Non-copyable.
+   */
+  Histogram(const Histogram&) = delete;
+  Histogram& operator=(const Histogram&) = delete;
+
+  /**
+   * Record value.
+   * @param value
+   */
+  void record(v_uint64 value);
+
+  /**
+   * Get total count of recorded values.
+   * @return
+   */
+  v_uint64 getTotalCount() const;
+
+  /**
+   * Take snapshot of the histogram. <br>
+   * Snapshot taken while other threads record values may be slightly inconsistent
+   * (ex.: `totalCount` not equal to the sum of `counts`), but never loses values.
+   * @return - &l:Histogram::Snapshot;.
+   */
+  Snapshot getSnapshot() const;
+
+  /**
+   * Reset all counters.
+   */
+  void reset();
+
+};
+
+}}}}
+
+#endif // oatpp_web_server_metrics_Histogram_hpp
@@ -0,0 +1,194 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "HttpMetrics.hpp"
+
+#include <chrono>
+
+namespace oatpp { namespace web { namespace server { namespace metrics {
+
+void HttpMetrics::Measurement::start() {
+  for(auto& phase : phases) {
+    phase = -1;
+  }
+  pattern = nullptr;
+  m_startTick = getTickNanos();
+  m_lastTick = m_startTick;
+}
+
+void HttpMetrics::Measurement::mark(Phase phase) {
+  auto tick = getTickNanos();
+  phases[phase] = tick - m_lastTick;
+  m_lastTick = tick;
+}
+
+void HttpMetrics::Measurement::finish() {
+  mark(PHASE_RESPONSE_WRITE);
+  phases[PHASE_TOTAL] = m_lastTick - m_startTick;
+}
+
+v_int64 HttpMetrics::getTickNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const char* HttpMetrics::getPhaseName(v_int32 phase) {
+  switch(phase) {
+    case PHASE_HEADERS_READ: return "headers_read";
+    case PHASE_REQUEST_INTERCEPTORS: return "request_interceptors";
+    case PHASE_ROUTING: return "routing";
+    case PHASE_ENDPOINT: return "endpoint";
+    case PHASE_RESPONSE_INTERCEPTORS: return "response_interceptors";
+    case PHASE_RESPONSE_WRITE: return "response_write";
+    case PHASE_TOTAL: return "total";
+    default: return "unknown";
+  }
+}
+
+std::atomic<v_uint64> HttpMetrics::ID_COUNTER(0);
+
+HttpMetrics::HttpMetrics()
+  : m_id(++ ID_COUNTER)
+  , m_startTime(getTickNanos())
+{}
+
+std::shared_ptr<HttpMetrics> HttpMetrics::createShared() {
+  return std::make_shared<HttpMetrics>();
+}
+
+HttpMetrics::RouteEntry* HttpMetrics::createRouteEntry(url::mapping::Pattern* pattern) {
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto entry = static_cast<RouteEntry*>(pattern->getAttachment(m_id));
+  if(entry == nullptr) {
+    m_entries.emplace_back(new RouteEntry());
+    entry = m_entries.back().get();
+    pattern->attach(m_id, entry);
+  }
+
+  return entry;
+
+}
+
+HttpMetrics::RouteMetrics* HttpMetrics::createRouteMetrics(RouteEntry* entry,
+                                                           v_int32 statusClass,
+                                                           const data::share::StringKeyLabel& method,
+                                                           url::mapping::Pattern* pattern)
+{
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto& slot = entry->statusClasses[statusClass];
+  auto result = slot.load(std::memory_order_acquire);
+  if(result != nullptr) {
+    return result;
+  }
+
+  std::unique_ptr<RouteMetrics> metrics(new RouteMetrics());
+  metrics->statusClass = statusClass;
+  if(pattern) {
+    metrics->method = method.toString();
+    metrics->route = pattern->toString();
+    if(metrics->route->empty()) {
+      metrics->route = "/";
+    }
+  } else {
+    metrics->method = "*";
+    metrics->route = "";
+  }
+
+  result = metrics.get();
+  m_routes.push_back(std::move(metrics));
+  slot.store(result, std::memory_order_release);
+
+  return result;
+
+}
+
+void HttpMetrics::record(const data::share::StringKeyLabel& method, v_int32 statusCode, const Measurement& measurement) {
+
+  v_int32 statusClass = statusCode / 100;
+  if(statusClass < 1 || statusClass > 5) {
+    statusClass = 0;
+  }
+
+  /* resolved once per pattern and status class - then only histogram atomics are touched */
+
+  RouteEntry* entry = &m_notRoutedEntry;
+  if(measurement.pattern) {
+    entry = static_cast<RouteEntry*>(measurement.pattern->getAttachment(m_id));
+    if(entry == nullptr) {
+      entry = createRouteEntry(measurement.pattern);
+    }
+  }
+
+  auto metrics = entry->statusClasses[statusClass].load(std::memory_order_acquire);
+  if(metrics == nullptr) {
+    metrics = createRouteMetrics(entry, statusClass, method, measurement.pattern);
+  }
+
+  for(v_int32 i = 0; i < PHASES_COUNT; i ++) {
+    if(measurement.phases[i] >= 0) {
+      metrics->phases[i].record(static_cast<v_uint64>(measurement.phases[i]));
+    }
+  }
+
+}
+
+HttpMetrics::Snapshot HttpMetrics::getSnapshot() const {
+
+  Snapshot result;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  result.uptimeMicros = (getTickNanos() - m_startTime) / 1000;
+  result.routes.reserve(m_routes.size());
+
+  for(auto& metrics : m_routes) {
+    result.routes.emplace_back();
+    auto& route = result.routes.back();
+    route.method = metrics->method;
+    route.route = metrics->route;
+    route.statusClass = metrics->statusClass;
+    for(v_int32 i = 0; i < PHASES_COUNT; i ++) {
+      route.phases[i] = metrics->phases[i].getSnapshot();
+    }
+  }
+
+  return result;
+
+}
+
+void HttpMetrics::reset() {
+  /* entries are never removed - other threads may be recording to them right now */
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for(auto& metrics : m_routes) {
+    for(auto& histogram : metrics->phases) {
+      histogram.reset();
+    }
+  }
+  m_startTime = getTickNanos();
+}
+
+}}}}
@@ -0,0 +1,273 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_web_server_metrics_HttpMetrics_hpp
+#define oatpp_web_server_metrics_HttpMetrics_hpp
+
+#include "./Histogram.hpp"
+
+#include "oatpp/web/url/mapping/Pattern.hpp"
+#include "oatpp/data/share/MemoryLabel.hpp"
+#include "oatpp/Types.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace oatpp { namespace web { namespace server { namespace metrics {
+
+/**
+ * Per-request latency metrics of &id:oatpp::web::server::HttpProcessor;. <br>
+ * Latencies of request processing phases are recorded into &l:Histogram;s grouped by route template and response status class. <br>
+ * Set it to &id:oatpp::web::server::HttpProcessor::Config::metrics; to enable collection.
+ * Use &id:oatpp::web::server::metrics::PrometheusExporter; to expose collected metrics.
+ */
+class HttpMetrics {
+public:
+
+  /**
+   * Request processing phases.
+   */
+  enum Phase : v_int32 {
+
+    /**
+     * Reading and parsing of request headers. Starts when the first byte of the request is available,
+     * so time a keep-alive connection stays idle between requests is not included.
+     */
+    PHASE_HEADERS_READ = 0,
+
+    /**
+     * Request interceptors.
+     */
+    PHASE_REQUEST_INTERCEPTORS = 1,
+
+    /**
+     * Router lookup.
+     */
+    PHASE_ROUTING = 2,
+
+    /**
+     * Endpoint handler.
+     */
+    PHASE_ENDPOINT = 3,
+
+    /**
+     * Response interceptors. If processing failed - also includes time spent in the error handler.
+     */
+    PHASE_RESPONSE_INTERCEPTORS = 4,
+
+    /**
+     * Writing response to the connection (or to the pipeline buffer).
+     */
+    PHASE_RESPONSE_WRITE = 5,
+
+    /**
+     * From the moment the first byte of the request was available till the moment response was written.
+     */
+    PHASE_TOTAL = 6,
+
+    /**
+     * Number of phases.
+     */
+    PHASES_COUNT = 7
+
+  };
+
+  /**
+   * Measurement of one request. Durations are in nanoseconds.
+   */
+  class Measurement {
+  private:
+    v_int64 m_startTick;
+    v_int64 m_lastTick;
+  public:
+
+    /**
+     * Duration of each phase. `-1` - phase was not executed.
+     */
+    v_int64 phases[PHASES_COUNT];
+
+    /**
+     * Route pattern which matched the request. `nullptr` - request was not routed.
+     */
+    url::mapping::Pattern* pattern;
+
+  public:
+
+    /**
+     * Reset measurement and start measuring from the current moment.
+     * Call it when the first byte of the request is available.
+     */
+    void start();
+
+    /**
+     * Set duration of phase to the time elapsed since the previous mark.
+     * @param phase - &l:HttpMetrics::Phase;.
+     */
+    void mark(Phase phase);
+
+    /**
+     * Mark &l:HttpMetrics::PHASE_RESPONSE_WRITE; and calculate &l:HttpMetrics::PHASE_TOTAL;.
+     */
+    void finish();
+
+  };
+
+  /**
+   * Metrics of one route and status class.
+   */
+  struct RouteSnapshot {
+
+    /**
+     * Http method. `"*"` for requests which were not routed.
+     */
+    oatpp::String method;
+
+    /**
+     * Route path template. Ex.: `"/users/{userId}"`. Empty for requests which were not routed.
+     */
+    oatpp::String route;
+
+    /**
+     * Response status class - first digit of the status code. `0` - unknown.
+     */
+    v_int32 statusClass;
+
+    /**
+     * Histogram of each phase. Values are in nanoseconds.
+     */
+    Histogram::Snapshot phases[PHASES_COUNT];
+
+  };
+
+  /**
+   * Snapshot of all metrics.
+   */
+  struct Snapshot {
+
+    /**
+     * Time elapsed since metrics were created or reset, in microseconds.
+     */
+    v_int64 uptimeMicros;
+
+    /**
+     * Metrics of each route and status class.
+     */
+    std::vector<RouteSnapshot> routes;
+
+  };
+
+private:
+
+  static constexpr v_int32 STATUS_CLASSES_COUNT = 6;
+
+  struct RouteMetrics {
+    oatpp::String method;
+    oatpp::String route;
+    v_int32 statusClass;
+    Histogram phases[PHASES_COUNT];
+  };
+
+  /*
+   * Metrics of one route pattern by status class.
+   * Attached to the &id:oatpp::web::url::mapping::Pattern; so that recording doesn't look the route up.
+   */
+  struct RouteEntry {
+
+    std::atomic<RouteMetrics*> statusClasses[STATUS_CLASSES_COUNT];
+
+    RouteEntry() {
+      for(auto& metrics : statusClasses) {
+        metrics.store(nullptr, std::memory_order_relaxed);
+      }
+    }
+
+  };
+
+private:
+  static std::atomic<v_uint64> ID_COUNTER;
+private:
+  RouteEntry* createRouteEntry(url::mapping::Pattern* pattern);
+  RouteMetrics* createRouteMetrics(RouteEntry* entry, v_int32 statusClass, const data::share::StringKeyLabel& method, url::mapping::Pattern* pattern);
+private:
+  const v_uint64 m_id;
+  RouteEntry m_notRoutedEntry;
+  /* guards creation of entries, snapshots and reset - not taken when recording to existing entries */
+  mutable std::mutex m_mutex;
+  std::vector<std::unique_ptr<RouteEntry>> m_entries;
+  std::vector<std::unique_ptr<RouteMetrics>> m_routes;
+  v_int64 m_startTime;
+public:
+
+  /**
+   * Get monotonic clock tick in nanoseconds.
+   * @return
+   */
+  static v_int64 getTickNanos();
+
+  /**
+   * Get name of the phase.
+   * @param phase - &l:HttpMetrics::Phase;.
+   * @return - phase name. Ex.: `"endpoint"`.
+   */
+  static const char* getPhaseName(v_int32 phase);
+
+public:
+
+  /**
+   * Constructor.
+   */
+  HttpMetrics();
+
+  /**
+   * Create shared HttpMetrics.
+   * @return
+   */
+  static std::shared_ptr<HttpMetrics> createShared();
+
+  /**
+   * Record request measurement.
+   * @param method - request method.
+   * @param statusCode - response status code.
+   * @param measurement - &l:HttpMetrics::Measurement;.
+   */
+  void record(const data::share::StringKeyLabel& method, v_int32 statusCode, const Measurement& measurement);
+
+  /**
+   * Get snapshot of all metrics.
+   * @return - &l:HttpMetrics::Snapshot;.
+   */
+  Snapshot getSnapshot() const;
+
+  /**
+   * Reset all recorded values.
+   */
+  void reset();
+
+};
+
+}}}}
+
+#endif // oatpp_web_server_metrics_HttpMetrics_hpp
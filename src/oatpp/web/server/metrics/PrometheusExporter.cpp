@@ -0,0 +1,147 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "PrometheusExporter.hpp"
+
+#include "oatpp/data/stream/BufferStream.hpp"
+
+namespace oatpp { namespace web { namespace server { namespace metrics {
+
+namespace {
+
+const char* const STATUS_CLASSES[] = {"unknown", "1xx", "2xx", "3xx", "4xx", "5xx"};
+const v_float64 QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+void writeLabelValue(data::stream::ConsistentOutputStream* stream, const oatpp::String& value) {
+  if(!value) {
+    return;
+  }
+  for(char c : *value) {
+    switch(c) {
+      case '\\': stream->writeSimple("\\\\", 2); break;
+      case '"': stream->writeSimple("\\\"", 2); break;
+      case '\n': stream->writeSimple("\\n", 2); break;
+      default: stream->writeCharSimple(static_cast<v_char8>(c));
+    }
+  }
+}
+
+void writeLabels(data::stream::ConsistentOutputStream* stream, const HttpMetrics::RouteSnapshot& route) {
+  *stream << "method=\"";
+  writeLabelValue(stream, route.method);
+  *stream << "\",route=\"";
+  writeLabelValue(stream, route.route);
+  *stream << "\",status=\"" << STATUS_CLASSES[route.statusClass] << "\"";
+}
+
+v_float64 toSeconds(v_uint64 nanos) {
+  return static_cast<v_float64>(nanos) / 1e9;
+}
+
+}
+
+const char* const PrometheusExporter::CONTENT_TYPE = "text/plain; version=0.0.4; charset=utf-8";
+
+PrometheusExporter::PrometheusExporter(const std::shared_ptr<HttpMetrics>& metrics)
+  : m_metrics(metrics)
+{}
+
+void PrometheusExporter::writeSnapshot(const HttpMetrics::Snapshot& snapshot, data::stream::ConsistentOutputStream* stream) {
+
+  *stream << "# HELP oatpp_http_requests_total Total number of processed HTTP requests.\n";
+  *stream << "# TYPE oatpp_http_requests_total counter\n";
+
+  for(auto& route : snapshot.routes) {
+    *stream << "oatpp_http_requests_total{";
+    writeLabels(stream, route);
+    *stream << "} " << route.phases[HttpMetrics::PHASE_TOTAL].totalCount << "\n";
+  }
+
+  *stream << "# HELP oatpp_http_request_phase_seconds Time spent in HTTP request processing phase.\n";
+  *stream << "# TYPE oatpp_http_request_phase_seconds summary\n";
+
+  for(auto& route : snapshot.routes) {
+    for(v_int32 phase = 0; phase < HttpMetrics::PHASES_COUNT; phase ++) {
+
+      auto& histogram = route.phases[phase];
+      if(histogram.totalCount == 0) {
+        continue;
+      }
+
+      for(auto quantile : QUANTILES) {
+        *stream << "oatpp_http_request_phase_seconds{";
+        writeLabels(stream, route);
+        *stream << ",phase=\"" << HttpMetrics::getPhaseName(phase) << "\",quantile=\"" << quantile << "\"} "
+                << toSeconds(histogram.getValueAtPercentile(quantile * 100)) << "\n";
+      }
+
+      *stream << "oatpp_http_request_phase_seconds_sum{";
+      writeLabels(stream, route);
+      *stream << ",phase=\"" << HttpMetrics::getPhaseName(phase) << "\"} " << toSeconds(histogram.sum) << "\n";
+
+      *stream << "oatpp_http_request_phase_seconds_count{";
+      writeLabels(stream, route);
+      *stream << ",phase=\"" << HttpMetrics::getPhaseName(phase) << "\"} " << histogram.totalCount << "\n";
+
+    }
+  }
+
+}
+
+oatpp::String PrometheusExporter::toText() const {
+  data::stream::BufferOutputStream stream(4096);
+  writeSnapshot(m_metrics->getSnapshot(), &stream);
+  return stream.toString();
+}
+
+std::shared_ptr<PrometheusExporter::OutgoingResponse> PrometheusExporter::handle(const std::shared_ptr<IncomingRequest>& request) {
+  (void) request;
+  auto response = ResponseFactory::createResponse(Status::CODE_200, toText());
+  response->putHeader(Header::CONTENT_TYPE, CONTENT_TYPE);
+  return response;
+}
+
+oatpp::async::CoroutineStarterForResult<const std::shared_ptr<PrometheusExporter::OutgoingResponse>&>
+PrometheusExporter::handleAsync(const std::shared_ptr<IncomingRequest>& request) {
+
+  class ExportCoroutine : public oatpp::async::CoroutineWithResult<ExportCoroutine, const std::shared_ptr<OutgoingResponse>&> {
+  private:
+    std::shared_ptr<OutgoingResponse> m_response;
+  public:
+
+    ExportCoroutine(const std::shared_ptr<OutgoingResponse>& response)
+      : m_response(response)
+    {}
+
+    Action act() override {
+      return _return(m_response);
+    }
+
+  };
+
+  return ExportCoroutine::startForResult(handle(request));
+
+}
+
+}}}}
@@ -0,0 +1,91 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_web_server_metrics_PrometheusExporter_hpp
+#define oatpp_web_server_metrics_PrometheusExporter_hpp
+
+#include "./HttpMetrics.hpp"
+
+#include "oatpp/web/server/HttpRequestHandler.hpp"
+#include "oatpp/data/stream/Stream.hpp"
+
+namespace oatpp { namespace web { namespace server { namespace metrics {
+
+/**
+ * Endpoint exposing &l:HttpMetrics; in the Prometheus text exposition format. <br>
+ * Example:
+ * ```cpp
+ * auto metrics = oatpp::web::server::metrics::HttpMetrics::createShared();
+ * config->metrics = metrics;
+ * router->route("GET", "/metrics", std::make_shared<oatpp::web::server::metrics::PrometheusExporter>(metrics));
+ * ```
+ * Exported metrics:
+ * <ul>
+ *   <li>`oatpp_http_requests_total{method, route, status}` - counter of processed requests.</li>
+ *   <li>`oatpp_http_request_phase_seconds{method, route, status, phase}` - summary of phase latencies.</li>
+ * </ul>
+ */
+class PrometheusExporter : public HttpRequestHandler {
+public:
+
+  /**
+   * Content-Type of the Prometheus text format.
+   */
+  static const char* const CONTENT_TYPE;
+
+private:
+  std::shared_ptr<HttpMetrics> m_metrics;
+public:
+
+  /**
+   * Write snapshot in the Prometheus text format.
+   * @param snapshot - &id:oatpp::web::server::metrics::HttpMetrics::Snapshot;.
+   * @param stream - stream to write to.
+   */
+  static void writeSnapshot(const HttpMetrics::Snapshot& snapshot, data::stream::ConsistentOutputStream* stream);
+
+public:
+
+  /**
+   * Constructor.
+   * @param metrics - &l:HttpMetrics; to export.
+   */
+  PrometheusExporter(const std::shared_ptr<HttpMetrics>& metrics);
+
+  /**
+   * Get metrics as Prometheus text.
+   * @return
+   */
+  oatpp::String toText() const;
+
+  std::shared_ptr<OutgoingResponse> handle(const std::shared_ptr<IncomingRequest>& request) override;
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&>
+  handleAsync(const std::shared_ptr<IncomingRequest>& request) override;
+
+};
+
+}}}}
+
+#endif // oatpp_web_server_metrics_PrometheusExporter_hpp
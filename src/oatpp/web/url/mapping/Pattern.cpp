@@ -32,6 +32,42 @@ const char* Pattern::Part::FUNCTION_CONST = "const";
 const char* Pattern::Part::FUNCTION_VAR = "var";
 const char* Pattern::Part::FUNCTION_ANY_END = "tail";
 
+Pattern::~Pattern() {
+  auto curr = m_attachments.load();
+  while(curr != nullptr) {
+    auto next = curr->next;
+    delete curr;
+    curr = next;
+  }
+}
+
+void* Pattern::getAttachment(v_uint64 ownerId) const {
+  auto curr = m_attachments.load(std::memory_order_acquire);
+  while(curr != nullptr) {
+    if(curr->ownerId == ownerId) {
+      return curr->data;
+    }
+    curr = curr->next;
+  }
+  return nullptr;
+}
+
+void* Pattern::attach(v_uint64 ownerId, void* data) const {
+  auto attachment = new Attachment{ownerId, data, m_attachments.load(std::memory_order_acquire)};
+  while(true) {
+    /* the owner might have attached its data concurrently */
+    for(auto curr = attachment->next; curr != nullptr; curr = curr->next) {
+      if(curr->ownerId == ownerId) {
+        delete attachment;
+        return curr->data;
+      }
+    }
+    if(m_attachments.compare_exchange_weak(attachment->next, attachment, std::memory_order_acq_rel, std::memory_order_acquire)) {
+      return data;
+    }
+  }
+}
+
 std::shared_ptr<Pattern> Pattern::parse(p_char8 data, v_buff_size size){
   
   if(size <= 0){
@@ -163,14 +199,14 @@ bool Pattern::match(const StringKeyLabel& url, MatchMap& matchMap) {
       v_char8 a = findSysChar(caret);
       if(a == '?') {
         if(curr == end || (*curr)->function == Part::FUNCTION_ANY_END) {
-          matchMap.m_variables[part->text] = StringKeyLabel(url.getMemoryHandle(), label.getData(), label.getSize());
+          matchMap.setVariable(part->text, StringKeyLabel(url.getMemoryHandle(), label.getData(), label.getSize()));
           matchMap.m_tail = StringKeyLabel(url.getMemoryHandle(), caret.getCurrData(), caret.getDataSize() - caret.getPosition());
           return true;
         }
         caret.findChar('/');
       }
       
-      matchMap.m_variables[part->text] = StringKeyLabel(url.getMemoryHandle(), label.getData(), label.getSize());
+      matchMap.setVariable(part->text, StringKeyLabel(url.getMemoryHandle(), label.getData(), label.getSize()));
       
     }
     
@@ -29,12 +29,18 @@
 
 #include "oatpp/utils/parser/Caret.hpp"
 
+#include <atomic>
 #include <list>
-#include <unordered_map>
+#include <vector>
 
 namespace oatpp { namespace web { namespace url { namespace mapping {
+
+template<typename Endpoint>
+class TreeRouter; // FWD
   
 class Pattern : public base::Countable{
+  template<typename Endpoint>
+  friend class TreeRouter;
 private:
   typedef oatpp::data::share::StringKeyLabel StringKeyLabel;
 public:
@@ -42,10 +48,24 @@ public:
   class MatchMap {
     friend Pattern;
   public:
-    typedef std::unordered_map<StringKeyLabel, StringKeyLabel> Variables;
+    /**
+     * Flat list of `name -> value` pairs. Routes have just a few variables,
+     * so linear search is cheaper than allocating hash-map nodes for every request.
+     */
+    typedef std::vector<std::pair<StringKeyLabel, StringKeyLabel>> Variables;
   private:
     Variables m_variables;
     StringKeyLabel m_tail;
+  private:
+    void setVariable(const StringKeyLabel& key, const StringKeyLabel& value) {
+      for(auto& pair : m_variables) {
+        if(pair.first == key) {
+          pair.second = value;
+          return;
+        }
+      }
+      m_variables.emplace_back(key, value);
+    }
   public:
     
     MatchMap() {}
@@ -54,11 +74,17 @@ public:
       : m_variables(vars)
       , m_tail(urlTail)
     {}
+
+    MatchMap(Variables&& vars, const StringKeyLabel& urlTail)
+      : m_variables(std::move(vars))
+      , m_tail(urlTail)
+    {}
     
     oatpp::String getVariable(const StringKeyLabel& key) const {
-      auto it = m_variables.find(key);
-      if(it != m_variables.end()) {
-        return it->second.toString();
+      for(auto& pair : m_variables) {
+        if(pair.first == key) {
+          return pair.second.toString();
+        }
       }
       return nullptr;
     }
@@ -96,11 +122,23 @@ private:
     
   };
   
+private:
+
+  struct Attachment {
+    v_uint64 ownerId;
+    void* data;
+    Attachment* next;
+  };
+
 private:
   std::shared_ptr<std::list<std::shared_ptr<Part>>> m_parts{std::make_shared<std::list<std::shared_ptr<Part>>>()};
+  mutable std::atomic<Attachment*> m_attachments{nullptr};
 private:
   v_char8 findSysChar(oatpp::utils::parser::Caret& caret);
 public:
+
+  Pattern() = default;
+  ~Pattern() override;
   
   static std::shared_ptr<Pattern> createShared(){
     return std::make_shared<Pattern>();
@@ -113,6 +151,23 @@ public:
   bool match(const StringKeyLabel& url, MatchMap& matchMap);
   
   oatpp::String toString();
+
+  /**
+   * Get data attached to the pattern by the owner. Lock-free. <br>
+   * Lets components (ex.: &id:oatpp::web::server::metrics::HttpMetrics;) cache per-route data
+   * next to the pattern instead of looking it up by the pattern on every request.
+   * @param ownerId - unique id of the owner. Ids must never be reused.
+   * @return - attached data or `nullptr`.
+   */
+  void* getAttachment(v_uint64 ownerId) const;
+
+  /**
+   * Attach data to the pattern. Attachments are never removed. The pattern doesn't own the data.
+   * @param ownerId - unique id of the owner. Ids must never be reused.
+   * @param data - data to attach.
+   * @return - data attached by the owner - `data`, or data attached by a concurrent call which won the race.
+   */
+  void* attach(v_uint64 ownerId, void* data) const;
   
 };
   
@@ -61,6 +61,7 @@ public:
     bool m_valid;
     Endpoint m_endpoint;
     Pattern::MatchMap m_matchMap;
+    Pattern* m_pattern;
   public:
 
     /**
@@ -68,17 +69,20 @@ public:
      */
     Route()
       : m_valid(false)
+      , m_pattern(nullptr)
     {}
 
     /**
      * Constructor.
      * @param pEndpoint - route endpoint.
      * @param pMatchMap - Match map of resolved path containing resolved path variables.
+     * @param pattern - pattern which matched the path. Owned by the router.
      */
-    Route(const Endpoint& endpoint, Pattern::MatchMap&& matchMap)
+    Route(const Endpoint& endpoint, Pattern::MatchMap&& matchMap, Pattern* pattern = nullptr)
       : m_valid(true)
       , m_endpoint(endpoint)
-      , m_matchMap(matchMap)
+      , m_matchMap(std::move(matchMap))
+      , m_pattern(pattern)
     {}
 
     /**
@@ -95,6 +99,15 @@ public:
       return m_matchMap;
     }
 
+    /**
+     * Pattern which matched the path. <br>
+     * The pattern is owned by the router and stays valid as long as the router is alive.
+     * @return - &id:oatpp::web::url::mapping::Pattern; or `nullptr` if route is not valid.
+     */
+    Pattern* getPattern() const {
+      return m_pattern;
+    }
+
     /**
      * Check if route is valid.
      * @return
@@ -137,7 +150,7 @@ public:
     for(auto& pair : m_endpointsByPattern) {
       Pattern::MatchMap matchMap;
       if(pair.first->match(path, matchMap)) {
-        return Route(pair.second, std::move(matchMap));
+        return Route(pair.second, std::move(matchMap), pair.first.get());
       }
     }
 
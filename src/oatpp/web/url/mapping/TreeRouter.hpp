@@ -0,0 +1,356 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_web_url_mapping_TreeRouter_hpp
+#define oatpp_web_url_mapping_TreeRouter_hpp
+
+#include "./Router.hpp"
+
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace oatpp { namespace web { namespace url { namespace mapping {
+
+/**
+ * Prefix-tree implementation of &id:oatpp::web::url::mapping::Router;. <br>
+ * Constant path segments are edges of the tree. `{var}` and `*` parts are stored as wildcard children of a node.
+ * Lookup cost depends on the number of path segments rather than on the number of routes. <br>
+ * Matching semantics are identical to &id:oatpp::web::url::mapping::Router; - when several patterns match the path,
+ * the one which was added first wins.
+ * @tparam Endpoint - endpoint of the route.
+ */
+template<typename Endpoint>
+class TreeRouter : public base::Countable {
+private:
+
+  /**
+   * Convenience typedef &id:oatpp::data::share::StringKeyLabel;.
+   */
+  typedef oatpp::data::share::StringKeyLabel StringKeyLabel;
+
+  static constexpr v_int64 NO_INDEX = std::numeric_limits<v_int64>::max();
+
+  /**
+   * Number of path variables which can be captured without heap allocation.
+   */
+  static constexpr v_int32 STACK_CAPTURES = 16;
+
+public:
+
+  /**
+   * Resolved "Route" for "path-pattern". Same as &id:oatpp::web::url::mapping::Router::Route;.
+   */
+  typedef typename Router<Endpoint>::Route Route;
+
+private:
+
+  struct Terminal {
+
+    Terminal(v_int64 pIndex, const Endpoint& pEndpoint, std::vector<StringKeyLabel>&& pVariables, Pattern* pPattern)
+      : index(pIndex)
+      , endpoint(pEndpoint)
+      , variables(std::move(pVariables))
+      , pattern(pPattern)
+    {}
+
+    v_int64 index;
+    Endpoint endpoint;
+    std::vector<StringKeyLabel> variables;
+    Pattern* pattern;
+
+  };
+
+  struct Node {
+    std::unordered_map<StringKeyLabel, std::unique_ptr<Node>> constChildren;
+    std::unique_ptr<Node> varChild;
+    std::unique_ptr<Terminal> terminal;
+    std::unique_ptr<Terminal> tailTerminal;
+    v_int64 minIndex = NO_INDEX;
+  };
+
+  struct Capture {
+    const char* data;
+    v_buff_size size;
+  };
+
+  struct SearchState {
+
+    const char* url;
+    v_buff_size size;
+
+    Capture* captures;
+
+    const Terminal* best;
+    Capture* bestCaptures;
+    v_buff_size bestTailPosition;
+
+    v_int64 getBestIndex() const {
+      return best != nullptr ? best->index : NO_INDEX;
+    }
+
+  };
+
+private:
+
+  static void offer(const Terminal* terminal, v_int32 depth, v_buff_size tailPosition, SearchState& state) {
+    if(terminal != nullptr && terminal->index < state.getBestIndex()) {
+      state.best = terminal;
+      for(v_int32 i = 0; i < depth; i ++) {
+        state.bestCaptures[i] = state.captures[i];
+      }
+      state.bestTailPosition = tailPosition;
+    }
+  }
+
+  /*
+   * Pattern is matched up to the `?` character and has no more parts (or has the `*` part only).
+   */
+  static void offerQuery(const Node* node, v_int32 depth, v_buff_size queryPosition, SearchState& state) {
+    offer(node->terminal.get(), depth, queryPosition, state);
+    offer(node->tailTerminal.get(), depth, queryPosition, state);
+  }
+
+  static void search(const Node* node, v_buff_size position, v_int32 depth, bool branchesOnly, SearchState& state) {
+
+    if(node->minIndex >= state.getBestIndex()) {
+      return;
+    }
+
+    const char* url = state.url;
+    const v_buff_size size = state.size;
+
+    v_buff_size pos = position;
+    while(pos < size && url[pos] == '/') {
+      pos ++;
+    }
+
+    if(!branchesOnly) {
+      if(pos == size) {
+        offer(node->terminal.get(), depth, -1, state);
+      }
+      offer(node->tailTerminal.get(), depth, pos < size ? pos : -1, state);
+    }
+
+    if(pos == size) {
+      return;
+    }
+
+    v_buff_size segmentEnd = pos;
+    v_buff_size sysCharPos = -1;
+    while(segmentEnd < size && url[segmentEnd] != '/') {
+      if(sysCharPos == -1 && url[segmentEnd] == '?') {
+        sysCharPos = segmentEnd;
+      }
+      segmentEnd ++;
+    }
+
+    if(!node->constChildren.empty()) {
+
+      auto it = node->constChildren.find(StringKeyLabel(nullptr, &url[pos], segmentEnd - pos));
+      if(it != node->constChildren.end()) {
+        search(it->second.get(), segmentEnd, depth, false, state);
+      }
+
+      if(sysCharPos != -1) {
+        for(v_buff_size q = sysCharPos; q < segmentEnd; q ++) {
+          if(url[q] == '?') {
+            it = node->constChildren.find(StringKeyLabel(nullptr, &url[pos], q - pos));
+            if(it != node->constChildren.end()) {
+              offerQuery(it->second.get(), depth, q, state);
+            }
+          }
+        }
+      }
+
+    }
+
+    if(node->varChild) {
+
+      const Node* child = node->varChild.get();
+
+      if(sysCharPos != -1) {
+        state.captures[depth] = {&url[pos], sysCharPos - pos};
+        offerQuery(child, depth + 1, sysCharPos, state);
+        state.captures[depth] = {&url[pos], segmentEnd - pos};
+        search(child, segmentEnd, depth + 1, true, state);
+      } else {
+        state.captures[depth] = {&url[pos], segmentEnd - pos};
+        search(child, segmentEnd, depth + 1, false, state);
+      }
+
+    }
+
+  }
+
+private:
+  Node m_root;
+  std::list<std::shared_ptr<Pattern>> m_patterns;
+  v_int64 m_routesCount;
+  v_int32 m_maxVariables;
+public:
+
+  /**
+   * Default constructor.
+   */
+  TreeRouter()
+    : m_routesCount(0)
+    , m_maxVariables(0)
+  {}
+
+  static std::shared_ptr<TreeRouter> createShared(){
+    return std::make_shared<TreeRouter>();
+  }
+
+  /**
+   * Add `path-pattern` to `endpoint` mapping.
+   * @param pathPattern - path pattern for endpoint.
+   * @param endpoint - route endpoint.
+   */
+  void route(const oatpp::String& pathPattern, const Endpoint& endpoint) {
+
+    auto pattern = Pattern::parse(pathPattern);
+    if(!pattern) {
+      pattern = Pattern::createShared();
+    }
+    m_patterns.push_back(pattern);
+
+    v_int64 index = m_routesCount ++;
+
+    Node* node = &m_root;
+    node->minIndex = std::min(node->minIndex, index);
+
+    std::vector<StringKeyLabel> variables;
+    bool isTail = false;
+
+    for(auto& part : *pattern->m_parts) {
+
+      if(part->function == Pattern::Part::FUNCTION_CONST) {
+        auto& child = node->constChildren[StringKeyLabel(part->text)];
+        if(!child) {
+          child.reset(new Node());
+        }
+        node = child.get();
+      } else if(part->function == Pattern::Part::FUNCTION_VAR) {
+        if(!node->varChild) {
+          node->varChild.reset(new Node());
+        }
+        node = node->varChild.get();
+        variables.push_back(part->text ? StringKeyLabel(part->text) : StringKeyLabel(""));
+      } else if(part->function == Pattern::Part::FUNCTION_ANY_END) {
+        isTail = true;
+        break;
+      }
+
+      node->minIndex = std::min(node->minIndex, index);
+
+    }
+
+    if(static_cast<v_int32>(variables.size()) > m_maxVariables) {
+      m_maxVariables = static_cast<v_int32>(variables.size());
+    }
+
+    auto& terminal = isTail ? node->tailTerminal : node->terminal;
+    if(!terminal) { // if pattern is already routed - the earlier route wins
+      terminal.reset(new Terminal(index, endpoint, std::move(variables), pattern.get()));
+    }
+
+  }
+
+  /**
+   * Resolve path to corresponding endpoint.
+   * @param path
+   * @return - &id:TreeRouter::Route;.
+   */
+  Route getRoute(const StringKeyLabel& path){
+
+    Capture stackCaptures[STACK_CAPTURES * 2];
+    std::unique_ptr<Capture[]> heapCaptures;
+
+    SearchState state;
+    state.url = reinterpret_cast<const char*>(path.getData());
+    state.size = path.getSize();
+    state.best = nullptr;
+    state.bestTailPosition = -1;
+
+    if(m_maxVariables <= STACK_CAPTURES) {
+      state.captures = stackCaptures;
+      state.bestCaptures = stackCaptures + STACK_CAPTURES;
+    } else {
+      heapCaptures.reset(new Capture[static_cast<size_t>(m_maxVariables) * 2]);
+      state.captures = heapCaptures.get();
+      state.bestCaptures = heapCaptures.get() + m_maxVariables;
+    }
+
+    search(&m_root, 0, 0, false, state);
+
+    if(state.best == nullptr) {
+      return Route();
+    }
+
+    auto memoryHandle = path.getMemoryHandle();
+
+    Pattern::MatchMap::Variables variables;
+    variables.reserve(state.best->variables.size());
+    for(size_t i = 0; i < state.best->variables.size(); i ++) {
+      const auto& name = state.best->variables[i];
+      StringKeyLabel value(memoryHandle, state.bestCaptures[i].data, state.bestCaptures[i].size);
+      bool replaced = false;
+      for(auto& pair : variables) {
+        if(pair.first == name) {
+          pair.second = value;
+          replaced = true;
+          break;
+        }
+      }
+      if(!replaced) {
+        variables.emplace_back(name, value);
+      }
+    }
+
+    StringKeyLabel tail;
+    if(state.bestTailPosition >= 0) {
+      tail = StringKeyLabel(memoryHandle, state.url + state.bestTailPosition, state.size - state.bestTailPosition);
+    }
+
+    return Route(state.best->endpoint, Pattern::MatchMap(std::move(variables), tail), state.best->pattern);
+
+  }
+
+  void logRouterMappings(const oatpp::data::share::StringKeyLabel &branch) {
+
+    for(auto& pattern : m_patterns) {
+      auto mapping = pattern->toString();
+      OATPP_LOGd("Router", "url '{} {}' -> mapped", reinterpret_cast<const char*>(branch.getData()), mapping)
+    }
+
+  }
+
+};
+
+}}}}
+
+#endif /* oatpp_web_url_mapping_TreeRouter_hpp */
@@ -5,11 +5,21 @@
 #include "oatpp/web/FullAsyncClientTest.hpp"
 #include "oatpp/web/PipelineTest.hpp"
 #include "oatpp/web/PipelineAsyncTest.hpp"
+#include "oatpp/web/protocol/http/HeadersParserPerfTest.hpp"
+#include "oatpp/web/protocol/http/HeadersParserTest.hpp"
 #include "oatpp/web/protocol/http/encoding/ChunkedTest.hpp"
+#include "oatpp/web/protocol/http/encoding/DeflateTest.hpp"
+#include "oatpp/web/protocol/http/encoding/EncodedBodyCacheTest.hpp"
+#include "oatpp/web/protocol/http/outgoing/FileBodyTest.hpp"
+#include "oatpp/web/protocol/http/outgoing/HeadersBlockTest.hpp"
 #include "oatpp/web/server/api/ApiControllerTest.hpp"
 #include "oatpp/web/server/handler/AuthorizationHandlerTest.hpp"
+#include "oatpp/web/server/HttpProcessorTest.hpp"
+#include "oatpp/web/server/metrics/HistogramTest.hpp"
+#include "oatpp/web/server/metrics/HttpMetricsTest.hpp"
 #include "oatpp/web/server/HttpRouterTest.hpp"
 #include "oatpp/web/server/ServerStopTest.hpp"
+#include "oatpp/web/url/mapping/TreeRouterTest.hpp"
 #include "oatpp/web/mime/multipart/StatefulParserTest.hpp"
 #include "oatpp/web/mime/ContentMappersTest.hpp"
 
@@ -17,12 +27,17 @@
 #include "oatpp/network/virtual_/InterfaceTest.hpp"
 #include "oatpp/network/UrlTest.hpp"
 #include "oatpp/network/ConnectionPoolTest.hpp"
+#include "oatpp/network/MultiListenerServerTest.hpp"
 #include "oatpp/network/monitor/ConnectionMonitorTest.hpp"
+#include "oatpp/network/tcp/client/ResolverTest.hpp"
+#include "oatpp/network/tcp/server/ConnectionProviderTest.hpp"
 
 #include "oatpp/json/DeserializerTest.hpp"
 #include "oatpp/json/DTOMapperPerfTest.hpp"
 #include "oatpp/json/DTOMapperTest.hpp"
 #include "oatpp/json/EnumTest.hpp"
+#include "oatpp/json/ObjectDeserializerTest.hpp"
+#include "oatpp/json/ObjectSerializerTest.hpp"
 #include "oatpp/json/BooleanTest.hpp"
 #include "oatpp/json/UnorderedSetTest.hpp"
 
@@ -31,11 +46,18 @@
 #include "oatpp/encoding/UnicodeTest.hpp"
 #include "oatpp/encoding/UrlTest.hpp"
 
+#include "oatpp/utils/ConversionTest.hpp"
+#include "oatpp/utils/parser/ByteScannerTest.hpp"
 #include "oatpp/utils/parser/CaretTest.hpp"
 #include "oatpp/provider/PoolTest.hpp"
 #include "oatpp/provider/PoolTemplateTest.hpp"
+#include "oatpp/provider/ShardedPoolTest.hpp"
 #include "oatpp/async/ConditionVariableTest.hpp"
+#include "oatpp/async/CoroutineMemoryPoolTest.hpp"
+#include "oatpp/async/IOUringWorkerTest.hpp"
 #include "oatpp/async/LockTest.hpp"
+#include "oatpp/async/TimingWheelTest.hpp"
+#include "oatpp/async/WorkStealingTest.hpp"
 
 #include "oatpp/data/type/UnorderedMapTest.hpp"
 #include "oatpp/data/type/PairListTest.hpp"
@@ -61,11 +83,14 @@
 #include "oatpp/data/mapping/TreeToObjectMapperTest.hpp"
 #include "oatpp/data/mapping/ObjectRemapperTest.hpp"
 
+#include "oatpp/data/share/LazyStringFlatMapTest.hpp"
 #include "oatpp/data/share/LazyStringMapTest.hpp"
 #include "oatpp/data/share/StringTemplateTest.hpp"
 #include "oatpp/data/share/MemoryLabelTest.hpp"
+#include "oatpp/data/buffer/BufferPoolTest.hpp"
 #include "oatpp/data/buffer/ProcessorTest.hpp"
 
+#include "oatpp/base/AsyncLoggerTest.hpp"
 #include "oatpp/base/CommandLineArgumentsTest.hpp"
 #include "oatpp/base/LogTest.hpp"
 
@@ -109,11 +134,14 @@ void runTests() {
   OATPP_RUN_TEST(oatpp::test::LoggerTest);
   OATPP_RUN_TEST(oatpp::base::CommandLineArgumentsTest);
   OATPP_RUN_TEST(oatpp::base::LogTest);
+  OATPP_RUN_TEST(oatpp::base::AsyncLoggerTest);
 
   OATPP_RUN_TEST(oatpp::data::share::MemoryLabelTest);
   OATPP_RUN_TEST(oatpp::data::share::LazyStringMapTest);
+  OATPP_RUN_TEST(oatpp::data::share::LazyStringFlatMapTest);
   OATPP_RUN_TEST(oatpp::data::share::StringTemplateTest);
 
+  OATPP_RUN_TEST(oatpp::data::buffer::BufferPoolTest);
   OATPP_RUN_TEST(oatpp::data::buffer::ProcessorTest);
   OATPP_RUN_TEST(oatpp::data::stream::BufferStreamTest);
 
@@ -144,12 +172,19 @@ void runTests() {
   OATPP_RUN_TEST(oatpp::data::resource::InMemoryDataTest);
 
   OATPP_RUN_TEST(oatpp::async::ConditionVariableTest);
+  OATPP_RUN_TEST(oatpp::async::CoroutineMemoryPoolTest);
   OATPP_RUN_TEST(oatpp::async::LockTest);
+  OATPP_RUN_TEST(oatpp::async::IOUringWorkerTest);
+  OATPP_RUN_TEST(oatpp::async::TimingWheelTest);
+  OATPP_RUN_TEST(oatpp::async::WorkStealingTest);
 
+  OATPP_RUN_TEST(oatpp::utils::ConversionTest);
   OATPP_RUN_TEST(oatpp::utils::parser::CaretTest);
+  OATPP_RUN_TEST(oatpp::utils::parser::ByteScannerTest);
 
   OATPP_RUN_TEST(oatpp::provider::PoolTest);
   OATPP_RUN_TEST(oatpp::provider::PoolTemplateTest);
+  OATPP_RUN_TEST(oatpp::provider::ShardedPoolTest);
 
   OATPP_RUN_TEST(oatpp::json::EnumTest);
   OATPP_RUN_TEST(oatpp::json::BooleanTest);
@@ -161,6 +196,10 @@ void runTests() {
   OATPP_RUN_TEST(oatpp::json::DTOMapperPerfTest);
 
   OATPP_RUN_TEST(oatpp::json::DTOMapperTest);
+
+  OATPP_RUN_TEST(oatpp::json::ObjectSerializerTest);
+  OATPP_RUN_TEST(oatpp::json::ObjectDeserializerTest);
+
   OATPP_RUN_TEST(oatpp::test::encoding::Base64Test);
   OATPP_RUN_TEST(oatpp::encoding::HexTest);
   OATPP_RUN_TEST(oatpp::test::encoding::UnicodeTest);
@@ -168,15 +207,28 @@ void runTests() {
 
   OATPP_RUN_TEST(oatpp::test::network::UrlTest);
   OATPP_RUN_TEST(oatpp::test::network::ConnectionPoolTest);
+  OATPP_RUN_TEST(oatpp::test::network::MultiListenerServerTest);
   OATPP_RUN_TEST(oatpp::test::network::monitor::ConnectionMonitorTest);
+  OATPP_RUN_TEST(oatpp::test::network::tcp::client::ResolverTest);
+  OATPP_RUN_TEST(oatpp::test::network::tcp::server::ConnectionProviderTest);
   OATPP_RUN_TEST(oatpp::test::network::virtual_::PipeTest);
   OATPP_RUN_TEST(oatpp::test::network::virtual_::InterfaceTest);
 
   OATPP_RUN_TEST(oatpp::test::web::protocol::http::encoding::ChunkedTest);
+  OATPP_RUN_TEST(oatpp::test::web::protocol::http::encoding::DeflateTest);
+  OATPP_RUN_TEST(oatpp::test::web::protocol::http::encoding::EncodedBodyCacheTest);
+  OATPP_RUN_TEST(oatpp::test::web::protocol::http::HeadersParserTest);
+  OATPP_RUN_TEST(oatpp::test::web::protocol::http::HeadersParserPerfTest);
+  OATPP_RUN_TEST(oatpp::test::web::protocol::http::outgoing::FileBodyTest);
+  OATPP_RUN_TEST(oatpp::test::web::protocol::http::outgoing::HeadersBlockTest);
 
   OATPP_RUN_TEST(oatpp::test::web::mime::multipart::StatefulParserTest);
   OATPP_RUN_TEST(oatpp::web::mime::ContentMappersTest);
 
+  OATPP_RUN_TEST(oatpp::web::url::mapping::TreeRouterTest);
+  OATPP_RUN_TEST(oatpp::test::web::server::HttpProcessorTest);
+  OATPP_RUN_TEST(oatpp::test::web::server::metrics::HistogramTest);
+  OATPP_RUN_TEST(oatpp::test::web::server::metrics::HttpMetricsTest);
   OATPP_RUN_TEST(oatpp::test::web::server::HttpRouterTest);
   OATPP_RUN_TEST(oatpp::test::web::server::api::ApiControllerTest);
   OATPP_RUN_TEST(oatpp::test::web::server::handler::AuthorizationHandlerTest);
@@ -199,6 +251,9 @@ void runTests() {
     oatpp::test::web::PipelineTest test_port(8000, 3000);
     test_port.run();
 
+    oatpp::test::web::PipelineTest test_port_event_loop(8000, 3000, 4);
+    test_port_event_loop.run();
+
   }
 
   {
@@ -219,6 +274,12 @@ void runTests() {
     oatpp::test::web::FullTest test_port(8000, 5);
     test_port.run();
 
+    oatpp::test::web::FullTest test_virtual_event_loop(0, 100, 4);
+    test_virtual_event_loop.run();
+
+    oatpp::test::web::FullTest test_port_event_loop(8000, 5, 4);
+    test_port_event_loop.run();
+
   }
 
   {
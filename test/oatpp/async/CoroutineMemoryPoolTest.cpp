@@ -0,0 +1,216 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "CoroutineMemoryPoolTest.hpp"
+
+#include "oatpp/async/CoroutineMemoryPool.hpp"
+#include "oatpp/async/Executor.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace oatpp { namespace async {
+
+namespace {
+
+class ChildCoroutine : public oatpp::async::Coroutine<ChildCoroutine> {
+private:
+  std::atomic<v_int64>* m_counter;
+public:
+
+  ChildCoroutine(std::atomic<v_int64>* counter)
+    : m_counter(counter)
+  {}
+
+  Action act() override {
+    (*m_counter) ++;
+    return finish();
+  }
+
+};
+
+class ParentCoroutine : public oatpp::async::Coroutine<ParentCoroutine> {
+private:
+  std::atomic<v_int64>* m_counter;
+  v_int32 m_childrenLeft;
+public:
+
+  ParentCoroutine(std::atomic<v_int64>* counter, v_int32 childrenCount)
+    : m_counter(counter)
+    , m_childrenLeft(childrenCount)
+  {}
+
+  Action act() override {
+    if(m_childrenLeft > 0) {
+      m_childrenLeft --;
+      return ChildCoroutine::start(m_counter).next(repeat());
+    }
+    (*m_counter) ++;
+    return finish();
+  }
+
+};
+
+v_int64 runCoroutines(const char* tag, v_int32 parentsCount, v_int32 childrenCount) {
+
+  const v_int64 expectedCount = static_cast<v_int64>(parentsCount) * (childrenCount + 1);
+  std::atomic<v_int64> counter(0);
+  v_int64 ticks;
+
+  oatpp::async::Executor executor(1, 1, 1);
+
+  {
+    oatpp::test::PerformanceChecker checker(tag);
+    for(v_int32 i = 0; i < parentsCount; i ++) {
+      executor.execute<ParentCoroutine>(&counter, childrenCount);
+    }
+    while(counter.load() < expectedCount) {
+      std::this_thread::yield();
+    }
+    ticks = checker.getElapsedTicks();
+  }
+
+  executor.waitTasksFinished();
+  executor.stop();
+  executor.join();
+
+  OATPP_ASSERT(counter.load() == expectedCount)
+
+  return ticks > 0 ? expectedCount * 1000000 / ticks : 0;
+
+}
+
+void testPool() {
+
+  auto pool = CoroutineMemoryPool::create();
+
+  {
+    OATPP_LOGd("TEST", "No current pool...")
+    auto ptr = CoroutineMemoryPool::allocate(100);
+    CoroutineMemoryPool::deallocate(ptr);
+    auto stats = pool->getStatistics();
+    OATPP_ASSERT(stats.hits == 0)
+    OATPP_ASSERT(stats.misses == 0)
+    OATPP_LOGd("TEST", "OK")
+  }
+
+  {
+    OATPP_LOGd("TEST", "Local reuse...")
+    CoroutineMemoryPool::ScopedCurrent current(pool);
+
+    auto ptr1 = CoroutineMemoryPool::allocate(100);
+    auto ptr2 = CoroutineMemoryPool::allocate(200);
+    std::memset(ptr1, 1, 100);
+    std::memset(ptr2, 2, 200);
+    OATPP_ASSERT(pool->getStatistics().outstanding == 2)
+
+    CoroutineMemoryPool::deallocate(ptr1);
+    auto ptr3 = CoroutineMemoryPool::allocate(100);
+    OATPP_ASSERT(ptr3 == ptr1)
+
+    auto stats = pool->getStatistics();
+    OATPP_ASSERT(stats.hits == 1)
+    OATPP_ASSERT(stats.misses == 2)
+    OATPP_ASSERT(stats.outstanding == 2)
+
+    auto big = CoroutineMemoryPool::allocate(CoroutineMemoryPool::SIZE_CLASS_STEP * CoroutineMemoryPool::SIZE_CLASSES_COUNT + 1);
+    OATPP_ASSERT(pool->getStatistics().outstanding == 2)
+    CoroutineMemoryPool::deallocate(big);
+
+    CoroutineMemoryPool::deallocate(ptr2);
+    CoroutineMemoryPool::deallocate(ptr3);
+    OATPP_ASSERT(pool->getStatistics().outstanding == 0)
+    OATPP_LOGd("TEST", "OK")
+  }
+
+  {
+    OATPP_LOGd("TEST", "Remote free...")
+    void* ptr;
+    {
+      CoroutineMemoryPool::ScopedCurrent current(pool);
+      ptr = CoroutineMemoryPool::allocate(300);
+    }
+
+    std::thread thread([ptr]{
+      CoroutineMemoryPool::deallocate(ptr);
+    });
+    thread.join();
+    OATPP_ASSERT(pool->getStatistics().outstanding == 0)
+
+    {
+      CoroutineMemoryPool::ScopedCurrent current(pool);
+      auto hits = pool->getStatistics().hits;
+      auto ptr1 = CoroutineMemoryPool::allocate(300);
+      OATPP_ASSERT(ptr1 == ptr)
+      OATPP_ASSERT(pool->getStatistics().hits == hits + 1)
+      CoroutineMemoryPool::deallocate(ptr1);
+    }
+    OATPP_LOGd("TEST", "OK")
+  }
+
+  {
+    OATPP_LOGd("TEST", "Orphan pool with outstanding blocks...")
+    std::vector<void*> blocks;
+    {
+      CoroutineMemoryPool::ScopedCurrent current(pool);
+      for(v_int32 i = 0; i < 10; i ++) {
+        blocks.push_back(CoroutineMemoryPool::allocate(static_cast<size_t>(i * 40)));
+      }
+    }
+    pool->orphan(); // pool is deleted when the last block is freed
+    for(auto block : blocks) {
+      CoroutineMemoryPool::deallocate(block);
+    }
+    OATPP_LOGd("TEST", "OK")
+  }
+
+}
+
+}
+
+void CoroutineMemoryPoolTest::onRun() {
+
+  testPool();
+
+  constexpr v_int32 parentsCount = 1000;
+  constexpr v_int32 childrenCount = 1000;
+
+  for(v_int32 i = 0; i < 2; i ++) {
+
+    CoroutineMemoryPool::setEnabled(false);
+    auto unpooled = runCoroutines("Coroutines - global operator new", parentsCount, childrenCount);
+
+    CoroutineMemoryPool::setEnabled(true);
+    auto pooled = runCoroutines("Coroutines - memory pool", parentsCount, childrenCount);
+
+    OATPP_LOGd(TAG, "coroutines/sec: global operator new={}, memory pool={}", unpooled, pooled)
+
+  }
+
+}
+
+}}
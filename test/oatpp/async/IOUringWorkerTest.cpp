@@ -0,0 +1,270 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "IOUringWorkerTest.hpp"
+
+#include "oatpp/async/Executor.hpp"
+#include "oatpp/async/worker/IOUringWorker.hpp"
+
+#ifdef OATPP_IO_URING_SUPPORTED
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace oatpp { namespace async {
+
+#ifdef OATPP_IO_URING_SUPPORTED
+
+namespace {
+
+static constexpr v_buff_size DATA_SIZE = 256 * 1024;
+static constexpr v_int32 PAIRS_COUNT = 10;
+
+class WriterCoroutine : public oatpp::async::Coroutine<WriterCoroutine> {
+private:
+  v_io_handle m_handle;
+  v_buff_size m_progress;
+  v_char8 m_chunk[1024];
+public:
+
+  WriterCoroutine(v_io_handle handle)
+    : m_handle(handle)
+    , m_progress(0)
+  {
+    for(v_int32 i = 0; i < 1024; i ++) {
+      m_chunk[i] = static_cast<v_char8>(i);
+    }
+  }
+
+  Action act() override {
+    while(m_progress < DATA_SIZE) {
+      auto toWrite = std::min<v_buff_size>(DATA_SIZE - m_progress, 1024);
+      auto res = ::write(m_handle, m_chunk, static_cast<size_t>(toWrite));
+      if(res < 0) {
+        if(errno == EAGAIN) {
+          return ioWait(m_handle, Action::IOEventType::IO_EVENT_WRITE);
+        }
+        return error<Error>("[WriterCoroutine::act()]: Error. Write failed.");
+      }
+      m_progress += res;
+    }
+    return finish();
+  }
+
+};
+
+class ReaderCoroutine : public oatpp::async::Coroutine<ReaderCoroutine> {
+private:
+  v_io_handle m_handle;
+  std::atomic<v_buff_size>* m_totalCounter;
+  v_buff_size m_progress;
+  v_char8 m_buffer[4096];
+public:
+
+  ReaderCoroutine(v_io_handle handle, std::atomic<v_buff_size>* totalCounter)
+    : m_handle(handle)
+    , m_totalCounter(totalCounter)
+    , m_progress(0)
+  {}
+
+  Action act() override {
+    while(m_progress < DATA_SIZE) {
+      auto res = ::read(m_handle, m_buffer, sizeof(m_buffer));
+      if(res < 0) {
+        if(errno == EAGAIN) {
+          return ioWait(m_handle, Action::IOEventType::IO_EVENT_READ);
+        }
+        return error<Error>("[ReaderCoroutine::act()]: Error. Read failed.");
+      }
+      if(res == 0) {
+        return error<Error>("[ReaderCoroutine::act()]: Error. Unexpected EOF.");
+      }
+      m_progress += res;
+      (*m_totalCounter) += res;
+    }
+    return finish();
+  }
+
+};
+
+class WaitWritableCoroutine : public oatpp::async::Coroutine<WaitWritableCoroutine> {
+private:
+  v_io_handle m_handle;
+  std::atomic<v_int32>* m_counter;
+  bool m_waited;
+public:
+
+  WaitWritableCoroutine(v_io_handle handle, std::atomic<v_int32>* counter)
+    : m_handle(handle)
+    , m_counter(counter)
+    , m_waited(false)
+  {}
+
+  Action act() override {
+    if(!m_waited) {
+      m_waited = true;
+      return ioWait(m_handle, Action::IOEventType::IO_EVENT_WRITE);
+    }
+    ++ (*m_counter);
+    return finish();
+  }
+
+};
+
+class BadHandleCoroutine : public oatpp::async::Coroutine<BadHandleCoroutine> {
+private:
+  v_io_handle m_handle;
+  std::atomic<v_int32>* m_errorsCounter;
+  std::atomic<v_int32>* m_resumedCounter;
+  bool m_waited;
+public:
+
+  BadHandleCoroutine(v_io_handle handle, std::atomic<v_int32>* errorsCounter, std::atomic<v_int32>* resumedCounter)
+    : m_handle(handle)
+    , m_errorsCounter(errorsCounter)
+    , m_resumedCounter(resumedCounter)
+    , m_waited(false)
+  {}
+
+  Action act() override {
+    if(!m_waited) {
+      m_waited = true;
+      return ioWait(m_handle, Action::IOEventType::IO_EVENT_READ);
+    }
+    // must not be resumed as if the poll succeeded
+    ++ (*m_resumedCounter);
+    return finish();
+  }
+
+  Action handleError(Error* error) override {
+    ++ (*m_errorsCounter);
+    return error;
+  }
+
+};
+
+}
+
+void IOUringWorkerTest::onRun() {
+
+  if(!worker::IOUringWorker::isSupported()) {
+    OATPP_LOGw(TAG, "io_uring is not permitted by the running kernel. Skipping.")
+    return;
+  }
+
+  std::atomic<v_buff_size> totalCounter(0);
+  std::vector<int> handles;
+
+  {
+
+    oatpp::async::Executor executor(2, 1, 1, oatpp::async::Executor::IO_WORKER_TYPE_URING);
+
+    for(v_int32 i = 0; i < PAIRS_COUNT; i ++) {
+      int pair[2];
+      OATPP_ASSERT(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, pair) == 0)
+      handles.push_back(pair[0]);
+      handles.push_back(pair[1]);
+      executor.execute<ReaderCoroutine>(pair[0], &totalCounter);
+      executor.execute<WriterCoroutine>(pair[1]);
+    }
+
+    executor.waitTasksFinished();
+    executor.stop();
+    executor.join();
+
+  }
+
+  for(auto handle : handles) {
+    ::close(handle);
+  }
+
+  OATPP_LOGd(TAG, "total bytes transferred={}", totalCounter.load())
+  OATPP_ASSERT(totalCounter == DATA_SIZE * PAIRS_COUNT)
+
+  {
+
+    OATPP_LOGd(TAG, "More waiters than submission queue entries...")
+
+    static constexpr v_int32 WAITERS_COUNT = 2 * static_cast<v_int32>(worker::IOUringWorker::DEFAULT_QUEUE_DEPTH) + 100;
+
+    int pair[2];
+    OATPP_ASSERT(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, pair) == 0)
+
+    std::atomic<v_int32> readyCounter(0);
+
+    oatpp::async::Executor executor(1, 1, 1, oatpp::async::Executor::IO_WORKER_TYPE_URING);
+    for(v_int32 i = 0; i < WAITERS_COUNT; i ++) {
+      executor.execute<WaitWritableCoroutine>(pair[1], &readyCounter);
+    }
+
+    executor.waitTasksFinished();
+    executor.stop();
+    executor.join();
+
+    ::close(pair[0]);
+    ::close(pair[1]);
+
+    OATPP_LOGd(TAG, "ready={}", readyCounter.load())
+    OATPP_ASSERT(readyCounter == WAITERS_COUNT)
+
+  }
+
+  {
+
+    OATPP_LOGd(TAG, "Poll on invalid handle...")
+
+    std::atomic<v_int32> errorsCounter(0);
+    std::atomic<v_int32> resumedCounter(0);
+
+    oatpp::async::Executor executor(1, 1, 1, oatpp::async::Executor::IO_WORKER_TYPE_URING);
+
+    /* closed after the executor is created - so that the handle is not reused by the ring */
+    int pair[2];
+    OATPP_ASSERT(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, pair) == 0)
+    ::close(pair[0]);
+    ::close(pair[1]);
+
+    executor.execute<BadHandleCoroutine>(pair[0], &errorsCounter, &resumedCounter);
+
+    executor.waitTasksFinished();
+    executor.stop();
+    executor.join();
+
+    OATPP_ASSERT(errorsCounter == 1)
+    OATPP_ASSERT(resumedCounter == 0)
+
+  }
+
+}
+
+#else
+
+void IOUringWorkerTest::onRun() {
+  OATPP_LOGw(TAG, "io_uring is not available on this platform. Skipping.")
+}
+
+#endif
+
+}}
@@ -0,0 +1,237 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "TimingWheelTest.hpp"
+
+#include "oatpp/async/Executor.hpp"
+#include "oatpp/async/utils/TimingWheel.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace oatpp { namespace async {
+
+namespace {
+
+constexpr v_int64 RESOLUTION = 1000;
+constexpr v_int64 START_TIME = 1700000000000000;
+
+struct Timer {
+  v_int64 timePoint = 0;
+  v_int64 firedAt = -1;
+  v_int32 fireCount = 0;
+  bool removed = false;
+};
+
+void checkNextTimePoint(const utils::TimingWheel<Timer>& wheel, const std::vector<Timer>& timers) {
+  v_int64 earliest = std::numeric_limits<v_int64>::max();
+  for(auto& timer : timers) {
+    if(timer.fireCount == 0 && !timer.removed) {
+      earliest = std::min(earliest, (timer.timePoint / RESOLUTION + 1) * RESOLUTION);
+    }
+  }
+  OATPP_ASSERT(wheel.getNextTimePointMicroseconds() <= earliest)
+}
+
+void testRandomSteps() {
+
+  std::mt19937_64 random(42);
+  std::uniform_int_distribution<v_int64> nearDistribution(0, 200 * RESOLUTION);
+  std::uniform_int_distribution<v_int64> farDistribution(0, v_int64(40000000) * RESOLUTION); // beyond the top level
+
+  std::vector<Timer> timers(20000);
+  utils::TimingWheel<Timer> wheel(RESOLUTION, START_TIME);
+
+  for(size_t i = 0; i < timers.size(); i ++) {
+    timers[i].timePoint = START_TIME + (i % 4 == 0 ? farDistribution(random) : nearDistribution(random));
+    wheel.add(&timers[i], timers[i].timePoint);
+  }
+
+  for(size_t i = 0; i < timers.size(); i += 7) {
+    timers[i].removed = true;
+    OATPP_ASSERT(wheel.remove(&timers[i]))
+  }
+  OATPP_ASSERT(!wheel.remove(&timers[0]))
+
+  std::uniform_int_distribution<v_int64> stepDistribution(0, 3 * RESOLUTION);
+  std::uniform_int_distribution<v_int64> jumpDistribution(0, 200000 * RESOLUTION);
+
+  v_int64 now = START_TIME;
+  v_int64 prev = now;
+  v_int32 steps = 0;
+
+  while(!wheel.empty()) {
+
+    now += (steps % 10 == 0) ? jumpDistribution(random) : stepDistribution(random);
+    steps ++;
+
+    wheel.advance(now, [now, prev](Timer* timer) {
+      OATPP_ASSERT(timer->timePoint < now)                                  // never early
+      OATPP_ASSERT(prev / RESOLUTION <= timer->timePoint / RESOLUTION)      // was not due at previous advance
+      timer->firedAt = now;
+      timer->fireCount ++;
+    });
+
+    checkNextTimePoint(wheel, timers);
+    prev = now;
+
+  }
+
+  for(auto& timer : timers) {
+    if(timer.removed) {
+      OATPP_ASSERT(timer.fireCount == 0)
+    } else {
+      OATPP_ASSERT(timer.fireCount == 1)
+    }
+  }
+
+  OATPP_LOGd("TEST", "random steps: steps={}", steps)
+
+}
+
+void testEventDriven() {
+
+  std::mt19937_64 random(7);
+  std::uniform_int_distribution<v_int64> distribution(0, v_int64(1000000) * RESOLUTION);
+
+  std::vector<Timer> timers(10000);
+  utils::TimingWheel<Timer> wheel(RESOLUTION, START_TIME);
+
+  for(auto& timer : timers) {
+    timer.timePoint = START_TIME + distribution(random);
+    wheel.add(&timer, timer.timePoint);
+  }
+
+  v_int32 wakeups = 0;
+
+  while(!wheel.empty()) {
+
+    v_int64 now = wheel.getNextTimePointMicroseconds();
+    OATPP_ASSERT(now != std::numeric_limits<v_int64>::max())
+    wakeups ++;
+
+    wheel.advance(now, [now](Timer* timer) {
+      OATPP_ASSERT(now / RESOLUTION == timer->timePoint / RESOLUTION + 1) // exactly one tick
+      timer->fireCount ++;
+    });
+
+  }
+
+  for(auto& timer : timers) {
+    OATPP_ASSERT(timer.fireCount == 1)
+  }
+
+  /* every wakeup either expires timers or cascades a non-empty slot - idle ticks are skipped */
+  OATPP_LOGd("TEST", "event driven: timers={}, wakeups={}", timers.size(), wakeups)
+  OATPP_ASSERT(wakeups <= static_cast<v_int32>(timers.size()) * utils::TimingWheel<Timer>::LEVELS)
+
+}
+
+void testRescheduleOnExpire() {
+
+  Timer timer;
+  utils::TimingWheel<Timer> wheel(RESOLUTION, START_TIME);
+
+  timer.timePoint = START_TIME;
+  wheel.add(&timer, timer.timePoint);
+  OATPP_ASSERT(wheel.contains(&timer))
+
+  v_int64 now = START_TIME;
+  while(timer.fireCount < 5) {
+    now += RESOLUTION;
+    wheel.advance(now, [&wheel, now](Timer* t) {
+      OATPP_ASSERT(!wheel.contains(t))
+      t->fireCount ++;
+      t->timePoint = now + 10 * RESOLUTION;
+      wheel.add(t, t->timePoint);
+    });
+  }
+
+  OATPP_ASSERT(wheel.size() == 1)
+
+  /* past time points expire on the next tick */
+  wheel.add(&timer, 0);
+  v_int32 fired = 0;
+  wheel.advance(now + RESOLUTION, [&fired](Timer*) { fired ++; });
+  OATPP_ASSERT(fired == 1)
+  OATPP_ASSERT(wheel.empty())
+
+}
+
+class SleepyCoroutine : public oatpp::async::Coroutine<SleepyCoroutine> {
+private:
+  std::atomic<v_int64>* m_counter;
+  std::chrono::milliseconds m_delay;
+  v_int64 m_wakeupTime;
+public:
+
+  SleepyCoroutine(std::atomic<v_int64>* counter, std::chrono::milliseconds delay)
+    : m_counter(counter)
+    , m_delay(delay)
+    , m_wakeupTime(0)
+  {}
+
+  Action act() override {
+    m_wakeupTime = oatpp::Environment::getMicroTickCount() + std::chrono::duration_cast<std::chrono::microseconds>(m_delay).count();
+    return waitFor(m_delay).next(yieldTo(&SleepyCoroutine::onWakeup));
+  }
+
+  Action onWakeup() {
+    OATPP_ASSERT(oatpp::Environment::getMicroTickCount() >= m_wakeupTime)
+    (*m_counter) ++;
+    return finish();
+  }
+
+};
+
+void testExecutor() {
+
+  constexpr v_int32 coroutinesCount = 1000;
+
+  std::atomic<v_int64> counter(0);
+  oatpp::async::Executor executor(1, 1, 1);
+
+  for(v_int32 i = 0; i < coroutinesCount; i ++) {
+    executor.execute<SleepyCoroutine>(&counter, std::chrono::milliseconds(10 + i % 50));
+  }
+
+  executor.waitTasksFinished();
+  executor.stop();
+  executor.join();
+
+  OATPP_ASSERT(counter.load() == coroutinesCount)
+
+}
+
+}
+
+void TimingWheelTest::onRun() {
+  testRandomSteps();
+  testEventDriven();
+  testRescheduleOnExpire();
+  testExecutor();
+}
+
+}}
@@ -0,0 +1,213 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "WorkStealingTest.hpp"
+
+#include "oatpp/async/Executor.hpp"
+#include "oatpp/async/utils/WorkStealingDeque.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace oatpp { namespace async {
+
+namespace {
+
+struct Item {
+  std::atomic<v_int32> taken{0};
+};
+
+void testDeque() {
+
+  constexpr v_int32 itemsCount = 100000;
+  constexpr v_int32 thievesCount = 3;
+
+  std::vector<Item> items(itemsCount);
+  utils::WorkStealingDeque<Item> deque(64);
+  std::atomic<bool> done(false);
+  std::atomic<v_int32> stolen(0);
+
+  std::vector<std::thread> thieves;
+  for(v_int32 i = 0; i < thievesCount; i ++) {
+    thieves.emplace_back([&deque, &done, &stolen]{
+      while(!done.load() || !deque.empty()) {
+        auto item = deque.steal();
+        if(item != nullptr) {
+          item->taken ++;
+          stolen ++;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  v_int32 popped = 0;
+  for(v_int32 i = 0; i < itemsCount; i ++) {
+    while(!deque.push(&items[static_cast<size_t>(i)])) {
+      auto item = deque.pop();
+      if(item != nullptr) {
+        item->taken ++;
+        popped ++;
+      }
+    }
+    if(i % 3 == 0) {
+      auto item = deque.pop();
+      if(item != nullptr) {
+        item->taken ++;
+        popped ++;
+      }
+    }
+  }
+
+  Item* item;
+  while((item = deque.pop()) != nullptr) {
+    item->taken ++;
+    popped ++;
+  }
+
+  done = true;
+  for(auto& t : thieves) {
+    t.join();
+  }
+
+  OATPP_LOGd("TEST", "popped={}, stolen={}", popped, stolen.load())
+  OATPP_ASSERT(popped + stolen.load() == itemsCount)
+  for(auto& i : items) {
+    OATPP_ASSERT(i.taken.load() == 1)
+  }
+
+}
+
+class HeavyCoroutine : public oatpp::async::Coroutine<HeavyCoroutine> {
+private:
+  std::atomic<v_int64>* m_counter;
+  v_int32 m_iterationsLeft;
+  volatile v_int64 m_sink;
+public:
+
+  HeavyCoroutine(std::atomic<v_int64>* counter, v_int32 iterations)
+    : m_counter(counter)
+    , m_iterationsLeft(iterations)
+    , m_sink(0)
+  {}
+
+  Action act() override {
+    if(m_iterationsLeft > 0) {
+      m_iterationsLeft --;
+      for(v_int32 i = 0; i < 10000; i ++) {
+        m_sink = m_sink + i;
+      }
+      return repeat();
+    }
+    (*m_counter) ++;
+    return finish();
+  }
+
+};
+
+class LightCoroutine : public oatpp::async::Coroutine<LightCoroutine> {
+private:
+  std::atomic<v_int64>* m_counter;
+public:
+
+  LightCoroutine(std::atomic<v_int64>* counter)
+    : m_counter(counter)
+  {}
+
+  Action act() override {
+    (*m_counter) ++;
+    return finish();
+  }
+
+};
+
+v_int64 runImbalanced(bool workStealing, v_int64& stolenCount) {
+
+  constexpr v_int32 tasksCount = 64;
+
+  std::atomic<v_int64> counter(0);
+
+  oatpp::async::Executor executor(2, 1, 1, oatpp::async::Executor::VALUE_SUGGESTED, workStealing);
+
+  v_int64 ticks;
+  {
+    oatpp::test::PerformanceChecker checker(workStealing ? "Work stealing - ON" : "Work stealing - OFF");
+
+    /* Executor balances tasks round-robin. So all heavy tasks land on the same processor. */
+    for(v_int32 i = 0; i < tasksCount; i ++) {
+      executor.execute<HeavyCoroutine>(&counter, 100);
+      executor.execute<LightCoroutine>(&counter);
+    }
+
+    executor.waitTasksFinished();
+    ticks = checker.getElapsedTicks();
+  }
+
+  OATPP_ASSERT(counter.load() == tasksCount * 2)
+  OATPP_ASSERT(executor.getTasksCount() == 0)
+
+  auto stats = executor.getWorkStealingStatistics();
+  OATPP_ASSERT(stats.size() == 2)
+
+  v_int64 stolen = 0;
+  v_int64 givenAway = 0;
+  for(auto& s : stats) {
+    stolen += s.stolen;
+    givenAway += s.givenAway;
+  }
+  OATPP_ASSERT(stolen == givenAway)
+  stolenCount = stolen;
+
+  executor.stop();
+  executor.join();
+
+  return ticks;
+
+}
+
+}
+
+void WorkStealingTest::onRun() {
+
+  testDeque();
+
+  {
+    v_int64 stolen;
+    runImbalanced(false, stolen);
+    OATPP_ASSERT(stolen == 0)
+  }
+
+  {
+    v_int64 stolen;
+    runImbalanced(true, stolen);
+    OATPP_LOGd(TAG, "stolen={}", stolen)
+    OATPP_ASSERT(stolen > 0)
+  }
+
+}
+
+}}
@@ -0,0 +1,204 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "AsyncLoggerTest.hpp"
+
+#include "oatpp/base/AsyncLogger.hpp"
+#include "oatpp/base/Log.hpp"
+
+#include <cstdio>
+#include <thread>
+
+namespace oatpp::base {
+
+namespace {
+
+class TempFile {
+private:
+  FILE* m_file;
+public:
+
+  TempFile()
+    : m_file(std::tmpfile())
+  {
+    OATPP_ASSERT(m_file != nullptr)
+  }
+
+  ~TempFile() {
+    std::fclose(m_file);
+  }
+
+  int getHandle() {
+    return fileno(m_file);
+  }
+
+  std::vector<std::string> readLines() {
+    std::fseek(m_file, 0, SEEK_SET);
+    std::vector<std::string> result;
+    std::string line;
+    int c;
+    while((c = std::fgetc(m_file)) != EOF) {
+      if(c == '\n') {
+        result.push_back(line);
+        line.clear();
+      } else {
+        line.push_back(static_cast<char>(c));
+      }
+    }
+    OATPP_ASSERT(line.empty())
+    return result;
+  }
+
+};
+
+void testKeyValue() {
+
+  constexpr v_int32 THREADS_COUNT = 4;
+  constexpr v_int32 MESSAGES_COUNT = 1000;
+
+  TempFile file;
+
+  AsyncLogger::Config config;
+  config.format = AsyncLogger::Format::KEY_VALUE;
+  config.ringCapacity = 2048;
+  config.outputHandle = file.getHandle();
+
+  AsyncLogger logger(config);
+
+  std::vector<std::thread> threads;
+  for(v_int32 t = 0; t < THREADS_COUNT; t ++) {
+    threads.emplace_back([&logger, t]{
+      for(v_int32 i = 0; i < MESSAGES_COUNT; i ++) {
+        logger.log(Logger::PRIORITY_D, "thread-" + std::to_string(t), "message " + std::to_string(i));
+      }
+    });
+  }
+
+  for(auto& thread : threads) {
+    thread.join();
+  }
+
+  logger.log(Logger::PRIORITY_E, "tag", "say \"hi\"\nback\\slash");
+  logger.flush();
+
+  auto lines = file.readLines();
+  OATPP_ASSERT(logger.getDroppedCount() == 0)
+  OATPP_ASSERT(lines.size() == THREADS_COUNT * MESSAGES_COUNT + 1)
+
+  v_int32 counters[THREADS_COUNT] = {0};
+  for(v_uint64 i = 0; i < lines.size() - 1; i ++) {
+    const auto& line = lines[i];
+    OATPP_ASSERT(line.rfind("time=\"", 0) == 0)
+    OATPP_ASSERT(line.find(" ticks=") != std::string::npos)
+    OATPP_ASSERT(line.find(" level=D tag=\"thread-") != std::string::npos)
+    auto pos = line.find("tag=\"thread-") + 12;
+    auto t = line[pos] - '0';
+    OATPP_ASSERT(t >= 0 && t < THREADS_COUNT)
+    /* messages of the same thread are written in order */
+    OATPP_ASSERT(line.find("msg=\"message " + std::to_string(counters[t]) + "\"") != std::string::npos)
+    counters[t] ++;
+  }
+
+  const auto& last = lines.back();
+  OATPP_ASSERT(last.find(" level=E tag=\"tag\" msg=\"say \\\"hi\\\"\\nback\\\\slash\"") != std::string::npos)
+
+}
+
+void testText() {
+
+  TempFile file;
+
+  AsyncLogger::Config config;
+  config.timeFormat = nullptr;
+  config.printTicks = false;
+  config.outputHandle = file.getHandle();
+
+  AsyncLogger logger(config);
+  logger.disablePriority(Logger::PRIORITY_V);
+  OATPP_ASSERT(!logger.isLogPriorityEnabled(Logger::PRIORITY_V))
+
+  logger.log(Logger::PRIORITY_I, "tag", "hello");
+  logger.log(Logger::PRIORITY_W, "tag", "");
+
+  /* log from a thread which exits before the messages are written */
+  std::thread([&logger]{
+    logger.log(Logger::PRIORITY_E, "thread", "bye");
+  }).join();
+
+  logger.flush();
+
+  auto lines = file.readLines();
+  OATPP_ASSERT(lines.size() == 3)
+  OATPP_ASSERT(lines[0] == "\033[32m I \033[0m| tag:hello")
+  OATPP_ASSERT(lines[1] == "\033[45m W \033[0m| tag")
+  OATPP_ASSERT(lines[2] == "\033[41m E \033[0m| thread:bye")
+
+}
+
+void testOverflow() {
+
+  constexpr v_int32 MESSAGES_COUNT = 10000;
+
+  TempFile file;
+
+  AsyncLogger::Config config;
+  config.format = AsyncLogger::Format::KEY_VALUE;
+  config.ringCapacity = 4;
+  config.outputHandle = file.getHandle();
+  config.flushInterval = std::chrono::seconds(1);
+
+  {
+    AsyncLogger logger(config);
+    for(v_int32 i = 0; i < MESSAGES_COUNT; i++) {
+      logger.log(Logger::PRIORITY_D, "tag", "message");
+    }
+    logger.flush();
+
+    auto lines = file.readLines();
+    OATPP_LOGd("TEST", "written={}, dropped={}", lines.size(), logger.getDroppedCount())
+    OATPP_ASSERT(logger.getDroppedCount() > 0)
+    OATPP_ASSERT(static_cast<v_int64>(lines.size()) + logger.getDroppedCount() == MESSAGES_COUNT)
+  }
+
+  bool thrown = false;
+  try {
+    config.ringCapacity = 3;
+    AsyncLogger logger(config);
+  } catch (const std::runtime_error&) {
+    thrown = true;
+  }
+  OATPP_ASSERT(thrown)
+
+}
+
+}
+
+void AsyncLoggerTest::onRun() {
+  testKeyValue();
+  testText();
+  testOverflow();
+}
+
+}
@@ -0,0 +1,204 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "BufferPoolTest.hpp"
+
+#include "oatpp/data/buffer/BufferPool.hpp"
+#include "oatpp/data/buffer/IOBuffer.hpp"
+#include "oatpp/data/stream/BufferStream.hpp"
+
+#include <cstring>
+#include <thread>
+
+namespace oatpp { namespace data { namespace buffer {
+
+void BufferPoolTest::onRun() {
+
+  {
+    OATPP_LOGd(TAG, "obtain/release...")
+
+    BufferPool pool(1024, 2, 1);
+    OATPP_ASSERT(pool.getShardsCount() == 1)
+    OATPP_ASSERT(pool.getBlockSize() == 1024)
+
+    auto b1 = pool.obtain();
+    auto b2 = pool.obtain();
+    auto b3 = pool.obtain();
+    std::memset(b1, 1, 1024);
+    std::memset(b2, 2, 1024);
+    std::memset(b3, 3, 1024);
+
+    auto stats = pool.getStatistics();
+    OATPP_ASSERT(stats.hits == 0)
+    OATPP_ASSERT(stats.misses == 3)
+    OATPP_ASSERT(stats.inUse == 3)
+    OATPP_ASSERT(stats.highWaterMark == 3)
+
+    pool.release(b1);
+    pool.release(b2);
+    pool.release(b3);
+
+    stats = pool.getStatistics();
+    OATPP_ASSERT(stats.returns == 2)
+    OATPP_ASSERT(stats.drops == 1)
+    OATPP_ASSERT(stats.pooled == 2)
+    OATPP_ASSERT(stats.inUse == 0)
+
+    auto b4 = pool.obtain();
+    OATPP_ASSERT(b4 == b2)
+    pool.release(b4);
+
+    stats = pool.getStatistics();
+    OATPP_ASSERT(stats.hits == 1)
+    OATPP_ASSERT(stats.misses == 3)
+    OATPP_ASSERT(stats.highWaterMark == 3)
+
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "shards...")
+
+    BufferPool pool(64, 16, 3);
+    OATPP_ASSERT(pool.getShardsCount() == 4)
+
+    /* block released by other thread goes to other shard and still can be reused */
+    p_char8 block = nullptr;
+    std::thread t([&pool, &block]{
+      block = pool.obtain();
+    });
+    t.join();
+
+    pool.release(block);
+    auto block2 = pool.obtain();
+    OATPP_ASSERT(block2 == block)
+    pool.release(block2);
+
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "concurrent...")
+
+    BufferPool pool(256, 64);
+
+    std::vector<std::thread> threads;
+    for(v_int32 i = 0; i < 8; i ++) {
+      threads.emplace_back([&pool, i]{
+        std::vector<p_char8> blocks;
+        for(v_int32 n = 0; n < 10000; n ++) {
+          auto b = pool.obtain();
+          b[0] = static_cast<v_char8>(i);
+          blocks.push_back(b);
+          if(blocks.size() == 8) {
+            for(auto block : blocks) {
+              OATPP_ASSERT(block[0] == static_cast<v_char8>(i))
+              pool.release(block);
+            }
+            blocks.clear();
+          }
+        }
+        for(auto block : blocks) {
+          pool.release(block);
+        }
+      });
+    }
+
+    for(auto& t : threads) {
+      t.join();
+    }
+
+    auto stats = pool.getStatistics();
+    OATPP_LOGd(TAG, "hits={}, misses={}, highWaterMark={}", stats.hits, stats.misses, stats.highWaterMark)
+    OATPP_ASSERT(stats.inUse == 0)
+    OATPP_ASSERT(stats.hits + stats.misses == 80000)
+    OATPP_ASSERT(stats.returns + stats.drops == 80000)
+    OATPP_ASSERT(stats.highWaterMark <= 64)
+    OATPP_ASSERT(stats.hits > stats.misses)
+
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "shared pools...")
+
+    OATPP_ASSERT(&BufferPool::getShared(IOBuffer::BUFFER_SIZE) == &IOBuffer::getPool())
+    OATPP_ASSERT(&BufferPool::getShared(12345) == &BufferPool::getShared(12345))
+
+    auto before = IOBuffer::getPool().getStatistics();
+    {
+      IOBuffer buffer1;
+      IOBuffer buffer2;
+      OATPP_ASSERT(buffer1.getData() != buffer2.getData())
+      auto stats = IOBuffer::getPool().getStatistics();
+      OATPP_ASSERT(stats.hits + stats.misses == before.hits + before.misses + 2)
+    }
+    auto after = IOBuffer::getPool().getStatistics();
+    OATPP_ASSERT(after.returns + after.drops == before.returns + before.drops + 2)
+
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "BufferOutputStream...")
+
+    BufferPool pool(16, 4, 1);
+
+    {
+      data::stream::BufferOutputStream stream(8, &pool);
+      OATPP_ASSERT(stream.getCapacity() == 16)
+      stream << "0123456789";
+      OATPP_ASSERT(pool.getStatistics().inUse == 1)
+      stream << "0123456789";
+      OATPP_ASSERT(stream.getCapacity() == 32)
+      OATPP_ASSERT(pool.getStatistics().inUse == 0)
+      OATPP_ASSERT(stream.toStdString() == "01234567890123456789")
+      stream.reset(16);
+      OATPP_ASSERT(pool.getStatistics().inUse == 1)
+      stream << "abc";
+      OATPP_ASSERT(stream.toStdString() == "abc")
+      stream.reset(64);
+      OATPP_ASSERT(pool.getStatistics().inUse == 0)
+      OATPP_ASSERT(stream.getCapacity() == 64)
+    }
+
+    {
+      data::stream::BufferOutputStream stream(8, nullptr);
+      OATPP_ASSERT(stream.getCapacity() == 8)
+      stream << "0123456789";
+      OATPP_ASSERT(stream.toStdString() == "0123456789")
+    }
+
+    auto stats = pool.getStatistics();
+    OATPP_ASSERT(stats.inUse == 0)
+    OATPP_ASSERT(stats.hits == 1)
+    OATPP_ASSERT(stats.misses == 1)
+
+    OATPP_LOGd(TAG, "OK")
+  }
+
+}
+
+}}}
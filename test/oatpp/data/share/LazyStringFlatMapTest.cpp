@@ -0,0 +1,159 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "LazyStringFlatMapTest.hpp"
+
+#include "oatpp/data/share/LazyStringFlatMap.hpp"
+#include "oatpp/Types.hpp"
+
+namespace oatpp { namespace data { namespace share {
+
+void LazyStringFlatMapTest::onRun() {
+
+  const char* text = "Hello World!";
+
+  {
+
+    LazyStringFlatMultimap<StringKeyLabelCI> map;
+
+    map.put("key1", StringKeyLabel(nullptr, text, 5));
+    map.put("key2", StringKeyLabel(nullptr, text + 6, 6));
+
+    auto s01 = map.getAsMemoryLabel_Unsafe<StringKeyLabel>("key1");
+    auto s02 = map.getAsMemoryLabel_Unsafe<StringKeyLabel>("key2");
+
+    OATPP_ASSERT(s01 == "Hello")
+    OATPP_ASSERT(s02 == "World!")
+
+    OATPP_ASSERT(s01.getMemoryHandle() == nullptr)
+    OATPP_ASSERT(s02.getMemoryHandle() == nullptr)
+
+    oatpp::String s1 = map.get("KEY1");
+    oatpp::String s2 = map.get("Key2");
+
+    OATPP_ASSERT(s1 == "Hello")
+    OATPP_ASSERT(s2 == "World!")
+
+    OATPP_ASSERT(map.get("key1").get() == s1.get())
+    OATPP_ASSERT(map.get("key2").get() == s2.get())
+    OATPP_ASSERT(map.get("key3") == nullptr)
+    OATPP_ASSERT(map.find("key3") == map.end())
+
+    OATPP_ASSERT(map.getSize() == 2)
+
+  }
+
+  {
+
+    LazyStringFlatMultimap<StringKeyLabelCI> map;
+
+    map.put("Set-Cookie", StringKeyLabel(nullptr, text, 5));
+    map.put("Host", StringKeyLabel(nullptr, text + 6, 6));
+    map.put("set-cookie", StringKeyLabel(nullptr, text + 6, 6));
+
+    OATPP_ASSERT(map.count("SET-COOKIE") == 2)
+    OATPP_ASSERT(map.get("Set-Cookie") == "Hello")
+
+    auto it = map.begin();
+    OATPP_ASSERT(it->first == "Set-Cookie" && it->second == "Hello")
+    it ++;
+    OATPP_ASSERT(it->first == "Host" && it->second == "World!")
+    it ++;
+    OATPP_ASSERT(it->first == "set-cookie" && it->second == "World!")
+    it ++;
+    OATPP_ASSERT(it == map.end())
+
+    OATPP_ASSERT(map.putIfNotExists("host", StringKeyLabel(nullptr, text, 5)) == false)
+    OATPP_ASSERT(map.putOrReplace("set-cookie", StringKeyLabel(nullptr, text, 5)) == true)
+    OATPP_ASSERT(map.count("Set-Cookie") == 1)
+    OATPP_ASSERT(map.getSize() == 2)
+    OATPP_ASSERT(map.begin()->first == "Host")
+
+    OATPP_ASSERT(map.erase("HOST") == true)
+    OATPP_ASSERT(map.erase("Host") == false)
+    OATPP_ASSERT(map.getSize() == 1)
+
+    map.clear();
+    OATPP_ASSERT(map.empty())
+
+  }
+
+  {
+
+    LazyStringFlatMultimap<StringKeyLabelCI> map;
+
+    for(v_int32 i = 0; i < 64; i ++) {
+      map.put(oatpp::String("key-" + std::to_string(i)), StringKeyLabel(nullptr, text, i % 12));
+    }
+
+    OATPP_ASSERT(map.getSize() == 64)
+
+    v_int32 index = 0;
+    for(const auto& entry : map.getAll()) {
+      OATPP_ASSERT(entry.first == ("KEY-" + std::to_string(index)).c_str())
+      OATPP_ASSERT(entry.second.getSize() == index % 12)
+      OATPP_ASSERT(entry.second.getMemoryHandle())
+      index ++;
+    }
+    OATPP_ASSERT(index == 64)
+
+    OATPP_ASSERT(map.get("key-11") == "Hello World")
+
+  }
+
+  {
+
+    LazyStringFlatMultimap<StringKeyLabelCI> map1;
+
+    map1.put("key1", StringKeyLabel(nullptr, text, 5));
+    map1.put("key2", StringKeyLabel(nullptr, text + 6, 6));
+
+    LazyStringFlatMultimap<StringKeyLabelCI> map2(map1);
+
+    OATPP_ASSERT(map1.getSize() == 2)
+    OATPP_ASSERT(map2.getSize() == 2)
+    OATPP_ASSERT(map2.get("key1") == "Hello")
+
+    LazyStringFlatMultimap<StringKeyLabelCI> map3;
+    map3 = std::move(map1);
+
+    OATPP_ASSERT(map1.getSize() == 0)
+    OATPP_ASSERT(map3.getSize() == 2)
+    OATPP_ASSERT(map3.get("key2") == "World!")
+
+    for(v_int32 i = 0; i < 32; i ++) {
+      map3.put(oatpp::String("key-" + std::to_string(i)), StringKeyLabel(nullptr, text, 5));
+    }
+
+    LazyStringFlatMultimap<StringKeyLabelCI> map4(std::move(map3));
+
+    OATPP_ASSERT(map3.getSize() == 0)
+    OATPP_ASSERT(map4.getSize() == 34)
+    OATPP_ASSERT(map4.get("key-31") == "Hello")
+
+  }
+
+}
+
+}}}
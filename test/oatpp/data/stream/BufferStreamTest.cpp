@@ -142,6 +142,34 @@ void BufferStreamTest::onRun() {
 
   }
 
+  { // vectored write - default implementation
+
+    BufferOutputStream stream;
+
+    std::string bodyData(10000, 'a');
+    for(size_t i = 0; i < bodyData.size(); i ++) {
+      bodyData[i] = static_cast<char>('a' + i % 26);
+    }
+    oatpp::String body(bodyData);
+
+    data::buffer::InlineWriteData buffers[4] = {
+      {"head", 4},
+      {nullptr, 0},
+      {body->data(), static_cast<v_buff_size>(body->size())},
+      {"tail", 4}
+    };
+
+    auto res = stream.writevExactSizeDataSimple(buffers, 4);
+
+    OATPP_ASSERT(res == 10008)
+    OATPP_ASSERT(stream.toString() == "head" + body + "tail")
+
+    for(auto& buffer : buffers) {
+      OATPP_ASSERT(buffer.bytesLeft == 0)
+    }
+
+  }
+
 }
 
 }}}
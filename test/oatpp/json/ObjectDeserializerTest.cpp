@@ -0,0 +1,334 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ObjectDeserializerTest.hpp"
+
+#include "oatpp/json/ObjectMapper.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include "oatpp/macro/codegen.hpp"
+
+#include <cctype>
+
+namespace oatpp { namespace json {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+ENUM(Color, v_int32,
+  VALUE(RED, 1, "red", "Red color"),
+  VALUE(GREEN, 2, "green")
+);
+
+class TypeA : public oatpp::DTO {
+
+  DTO_INIT(TypeA, DTO)
+
+  DTO_FIELD(String, fieldA);
+
+};
+
+class Child : public oatpp::DTO {
+
+  DTO_INIT(Child, DTO)
+
+  DTO_FIELD(String, name, "child-name");
+  DTO_FIELD(Int32, value);
+
+  DTO_FIELD_INFO(required) {
+    info->required = true;
+  }
+  DTO_FIELD(String, required) = "default";
+
+};
+
+class Root : public oatpp::DTO {
+
+  DTO_INIT(Root, DTO)
+
+  DTO_FIELD(String, text, "text-qualifier");
+  DTO_FIELD(Int8, i8);
+  DTO_FIELD(UInt8, u8);
+  DTO_FIELD(Int16, i16);
+  DTO_FIELD(UInt16, u16);
+  DTO_FIELD(Int32, i32);
+  DTO_FIELD(UInt32, u32);
+  DTO_FIELD(Int64, i64);
+  DTO_FIELD(UInt64, u64);
+  DTO_FIELD(Float32, f32);
+  DTO_FIELD(Float64, f64);
+  DTO_FIELD(Boolean, flag);
+
+  DTO_FIELD(Enum<Color>, color);
+  DTO_FIELD(Enum<Color>::AsNumber, colorNumber);
+  DTO_FIELD(Enum<Color>::NotNull, colorNotNull) = Color::RED;
+
+  DTO_FIELD(Any, any);
+  DTO_FIELD(Tree, tree);
+
+  DTO_FIELD(String, type);
+  DTO_FIELD(Any, polymorph);
+
+  DTO_FIELD_TYPE_SELECTOR(polymorph) {
+    if(type == "A") return Object<TypeA>::Class::getType();
+    if(type == "int") return Int32::Class::getType();
+    return Tree::Class::getType();
+  }
+
+  DTO_FIELD(Object<Child>, child);
+  DTO_FIELD(List<Object<Child>>, children);
+  DTO_FIELD(Vector<String>, strings);
+  DTO_FIELD(UnorderedSet<Int32>, set);
+  DTO_FIELD(List<List<Float64>>, nested);
+  DTO_FIELD(Fields<Any>, fields);
+  DTO_FIELD(UnorderedFields<Enum<Color>>, unorderedFields);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+const char* const VALID_INPUTS[] = {
+  "{}",
+  "null",
+  " { \"text-qualifier\" : \"hello \\\"world\\\" \\u0444\" , \"i8\": -8, \"u8\": 8, \"i16\": -16, \"u16\": 16,"
+  " \"i32\": -32, \"u32\": 32, \"i64\": -64, \"u64\": 64, \"f32\": 0.5, \"f64\": -1.25e3, \"flag\": true } ",
+  "{\"i32\": 1.9, \"f64\": 10, \"flag\": 0, \"u8\": null, \"text-qualifier\": null}",
+  "{\"color\": \"green\", \"colorNumber\": 1, \"colorNotNull\": \"red\"}",
+  "{\"color\": null}",
+  "{\"any\": {\"a\": [1, 2.5, \"x\", null, true, {}]}, \"tree\": [1, {\"b\": null}]}",
+  "{\"any\": null, \"tree\": null}",
+  "{\"type\": \"A\", \"polymorph\": {\"fieldA\": \"value-A\"}}",
+  "{\"polymorph\": 10, \"type\": \"int\"}",
+  "{\"child\": {\"child-name\": \"c\", \"value\": 1, \"required\": \"r\"}, \"children\": [null, {\"required\": \"x\"}, {}]}",
+  "{\"strings\": [\"a\", null, \"\\n\"], \"set\": [1, 2, 2, 3], \"nested\": [[1, 2.5], null, []]}",
+  "{\"fields\": {\"k1\": 1, \"k2\": null, \"k\\u00e91\": [\"x\"]}, \"unorderedFields\": {\"a\": \"red\", \"b\": null}}",
+  "{\"unknown\": {\"a\": [1, 2, {\"b\": \"c\"}]}, \"i32\": 5, \"unknown2\": null}",
+  "{\"i\\u0033\\u0032\": 32, \"\\u0074ype\": \"A\"}",
+  "{\"i32\": 1, \"i32\": 2}",
+  "{ \"strings\" : [ ] , \"fields\" : { } }",
+  "[]"
+};
+
+const char* const INVALID_INPUTS[] = {
+  "{\"i32\": \"12\", \"f64\": \"1.5\", \"flag\": \"true\", \"text-qualifier\": 10}", // valid with lexical casting only
+  "{\"i32\": [1]}",
+  "{\"child\": \"string\"}",
+  "{\"color\": \"blue\"}",
+  "{\"colorNotNull\": null}",
+  "{\"child\": {\"required\": null}}",
+  "{\"strings\": [\"a\", 1]}",
+  "{\"fields\": {\"a\": x}}",
+  "{\"i32\": tru}",
+  "{\"i32\" 1}",
+  "{\"strings\": [\"a\"}",
+  "{\"i32\": 1"
+};
+
+oatpp::String readAndWrite(const std::shared_ptr<ObjectMapper>& mapper, const oatpp::String& json, bool& success) {
+  try {
+    auto object = mapper->readFromString<oatpp::Object<Root>>(json);
+    success = true;
+    ObjectMapper writer;
+    return writer.writeToString(object);
+  } catch (std::runtime_error&) {
+    success = false;
+  }
+  return nullptr;
+}
+
+void checkSame(const ObjectMapper::DeserializerConfig& config, const oatpp::String& json, bool expectSuccess) {
+
+  ObjectMapper::DeserializerConfig treeConfig = config;
+  treeConfig.streaming = false;
+
+  ObjectMapper::DeserializerConfig directConfig = config;
+  directConfig.streaming = true;
+
+  auto treeMapper = std::make_shared<ObjectMapper>(ObjectMapper::SerializerConfig(), treeConfig);
+  auto directMapper = std::make_shared<ObjectMapper>(ObjectMapper::SerializerConfig(), directConfig);
+
+  bool treeSuccess, directSuccess;
+  auto expected = readAndWrite(treeMapper, json, treeSuccess);
+  auto actual = readAndWrite(directMapper, json, directSuccess);
+
+  if(treeSuccess != directSuccess || expected != actual || (treeSuccess != expectSuccess && config.mapper.allowUnknownFields && !config.mapper.allowLexicalCasting && !config.mapper.useUnqualifiedEnumNames)) {
+    OATPP_LOGe("ObjectDeserializerTest", "input='{}'", json)
+    OATPP_LOGe("ObjectDeserializerTest", "tree   ({}): {}", treeSuccess, expected)
+    OATPP_LOGe("ObjectDeserializerTest", "direct ({}): {}", directSuccess, actual)
+  }
+
+  OATPP_ASSERT(treeSuccess == directSuccess)
+  OATPP_ASSERT(expected == actual)
+
+  if(config.mapper.allowUnknownFields && !config.mapper.allowLexicalCasting && !config.mapper.useUnqualifiedEnumNames) {
+    OATPP_ASSERT(treeSuccess == expectSuccess)
+  }
+
+}
+
+void checkAllConfigs(const oatpp::String& json, bool expectSuccess) {
+  for(v_int32 i = 0; i < 8; i ++) {
+    ObjectMapper::DeserializerConfig config;
+    config.mapper.allowUnknownFields = (i & 1) == 0;
+    config.mapper.allowLexicalCasting = (i & 2) != 0;
+    config.mapper.useUnqualifiedEnumNames = (i & 4) != 0;
+    checkSame(config, json, expectSuccess);
+  }
+}
+oatpp::Void mapUpperString(const data::mapping::TreeToObjectMapper* mapper, data::mapping::TreeToObjectMapper::State& state, const Type* type) {
+  (void) mapper;
+  (void) type;
+  if(state.tree->isString()) {
+    std::string value = *state.tree->getString();
+    for(auto& c : value) {
+      c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    return oatpp::String(value);
+  }
+  return oatpp::Void(String::Class::getType());
+}
+
+}
+
+void ObjectDeserializerTest::onRun() {
+
+  {
+    OATPP_LOGd(TAG, "findProperty...")
+    auto properties = Object<Root>::Class::getType()->polymorphicDispatcher;
+    auto props = static_cast<const data::type::__class::AbstractObject::PolymorphicDispatcher*>(properties)->getProperties();
+    for(auto& p : props->getList()) {
+      OATPP_ASSERT(props->findProperty(p->name.data(), static_cast<v_buff_size>(p->name.size())) == p)
+      OATPP_ASSERT(props->findProperty(p->unqualifiedName.data(), static_cast<v_buff_size>(p->unqualifiedName.size()), true) == p)
+    }
+    OATPP_ASSERT(props->findProperty("text", 4) == nullptr)
+    OATPP_ASSERT(props->findProperty("text", 4, true) != nullptr)
+    OATPP_ASSERT(props->findProperty("", 0) == nullptr)
+    OATPP_ASSERT(props->findProperty("i33", 3) == nullptr)
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "valid inputs...")
+    for(auto input : VALID_INPUTS) {
+      checkAllConfigs(input, true);
+    }
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "invalid inputs...")
+    for(auto input : INVALID_INPUTS) {
+      checkAllConfigs(input, false);
+    }
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "unqualified field names...")
+    ObjectMapper::DeserializerConfig config;
+    config.mapper.useUnqualifiedFieldNames = true;
+    checkSame(config, "{\"text\": \"a\", \"text-qualifier\": \"b\", \"child\": {\"name\": \"n\"}}", true);
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "overridden built-in mapper methods...")
+
+    ObjectMapper::DeserializerConfig treeConfig;
+    treeConfig.streaming = false;
+    ObjectMapper treeMapper(ObjectMapper::SerializerConfig(), treeConfig);
+
+    ObjectMapper::DeserializerConfig directConfig;
+    directConfig.streaming = true;
+    ObjectMapper directMapper(ObjectMapper::SerializerConfig(), directConfig);
+
+    for(auto mapper : {&treeMapper, &directMapper}) {
+      mapper->treeToObjectMapper().setMapperMethod(data::type::__class::String::CLASS_ID, &mapUpperString);
+    }
+
+    const char* json = "{\"text-qualifier\": \"text\", \"child\": {\"child-name\": \"child\"}, \"strings\": [\"a\", null]}";
+    auto expected = treeMapper.readFromString<oatpp::Object<Root>>(json);
+    auto actual = directMapper.readFromString<oatpp::Object<Root>>(json);
+
+    OATPP_ASSERT(expected->text == "TEXT")
+    OATPP_ASSERT(expected->child->name == "CHILD")
+
+    ObjectMapper writer;
+    OATPP_ASSERT(writer.writeToString(expected) == writer.writeToString(actual))
+
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "performance...")
+
+    ObjectMapper writer;
+    auto list = oatpp::List<oatpp::Object<Root>>::createShared();
+    for(v_int32 i = 0; i < 1000; i ++) {
+      auto root = Root::createShared();
+      root->text = "text";
+      root->i32 = i;
+      root->f64 = 0.5;
+      root->color = Color::GREEN;
+      root->child = Child::createShared();
+      root->child->name = "child";
+      root->child->required = "required";
+      root->strings = {"a", "b", "c"};
+      list->push_back(root);
+    }
+    auto json = writer.writeToString(list);
+
+    ObjectMapper::DeserializerConfig directConfig;
+    directConfig.streaming = true;
+    ObjectMapper treeMapper;
+    ObjectMapper directMapper(ObjectMapper::SerializerConfig(), directConfig);
+
+    v_int32 numIterations = 20;
+
+    {
+      oatpp::test::PerformanceChecker checker("Tree deserializer");
+      for(v_int32 i = 0; i < numIterations; i ++) {
+        treeMapper.readFromString<oatpp::List<oatpp::Object<Root>>>(json);
+      }
+    }
+
+    {
+      oatpp::test::PerformanceChecker checker("Direct deserializer");
+      for(v_int32 i = 0; i < numIterations; i ++) {
+        directMapper.readFromString<oatpp::List<oatpp::Object<Root>>>(json);
+      }
+    }
+
+    auto result = directMapper.readFromString<oatpp::List<oatpp::Object<Root>>>(json);
+    OATPP_ASSERT(writer.writeToString(result) == json)
+
+    OATPP_LOGd(TAG, "OK")
+  }
+
+}
+
+}}
@@ -0,0 +1,354 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ObjectSerializerTest.hpp"
+
+#include "oatpp/json/ObjectMapper.hpp"
+#include "oatpp/json/SerializingReadCallback.hpp"
+
+#include "oatpp/utils/Conversion.hpp"
+#include "oatpp/macro/codegen.hpp"
+
+#include <cctype>
+
+namespace oatpp { namespace json {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+ENUM(Color, v_int32,
+  VALUE(RED, 1, "red"),
+  VALUE(GREEN, 2, "green")
+);
+
+class Child : public oatpp::DTO {
+
+  DTO_INIT(Child, DTO)
+
+  DTO_FIELD(String, name, "child-name");
+  DTO_FIELD(Int32, value);
+
+  DTO_FIELD_INFO(required) {
+    info->required = true;
+  }
+  DTO_FIELD(String, required) = "required";
+
+};
+
+class Root : public oatpp::DTO {
+
+  DTO_INIT(Root, DTO)
+
+  DTO_FIELD(String, text, "text-qualifier") = "Hello \"json\" \n\t\xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82 /";
+  DTO_FIELD(Int8, i8) = -8;
+  DTO_FIELD(UInt8, u8) = 8;
+  DTO_FIELD(Int16, i16) = -16;
+  DTO_FIELD(UInt16, u16) = 16;
+  DTO_FIELD(Int32, i32) = -32;
+  DTO_FIELD(UInt32, u32) = 32;
+  DTO_FIELD(Int64, i64) = -64;
+  DTO_FIELD(UInt64, u64) = 64;
+  DTO_FIELD(Float32, f32) = 0.5f;
+  DTO_FIELD(Float64, f64) = 1.25;
+  DTO_FIELD(Boolean, flag) = true;
+  DTO_FIELD(String, nullString);
+
+  DTO_FIELD(Enum<Color>, color) = Color::GREEN;
+  DTO_FIELD(Enum<Color>::AsNumber, colorNumber) = Color::RED;
+  DTO_FIELD(Enum<Color>, nullColor);
+
+  DTO_FIELD(Any, any);
+  DTO_FIELD(Any, nullAny);
+  DTO_FIELD(Tree, tree);
+  DTO_FIELD(Tree, nullTree);
+
+  DTO_FIELD(Object<Child>, child);
+  DTO_FIELD(Object<Child>, nullChild);
+
+  DTO_FIELD(List<Object<Child>>, children);
+  DTO_FIELD(Vector<String>, strings);
+  DTO_FIELD(UnorderedSet<Int32>, set);
+  DTO_FIELD(List<List<Int32>>, nested);
+  DTO_FIELD(List<Tree>, trees);
+  DTO_FIELD(Fields<Any>, fields);
+  DTO_FIELD(UnorderedFields<Enum<Color>>, unorderedFields);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::Object<Root> createRoot() {
+
+  auto root = Root::createShared();
+
+  root->any = oatpp::Vector<oatpp::String>({"a", nullptr, "b"});
+  root->nullAny = oatpp::Any(oatpp::String(nullptr));
+
+  root->tree = oatpp::Tree({});
+  (*root->tree)["int"] = 1;
+  (*root->tree)["null"].setNull();
+  (*root->tree)["string"] = "str";
+
+  root->nullTree = oatpp::Tree({});
+
+  root->child = Child::createShared();
+  root->child->name = "child";
+
+  root->children = {Child::createShared(), nullptr, Child::createShared()};
+  root->children[0]->value = 1;
+
+  root->strings = {"one", nullptr, "three"};
+  root->set = {1};
+  root->nested = {{1, nullptr, 3}, nullptr, {}};
+
+  root->trees = {oatpp::Tree({}), nullptr, oatpp::Tree({})};
+  *root->trees[0] = 10;
+
+  root->fields = {
+    {"a", oatpp::Int32(1)},
+    {"b", nullptr},
+    {"c", oatpp::Any(oatpp::String(nullptr))},
+    {"d", oatpp::Any(oatpp::Enum<Color>(Color::RED))},
+    {"e", oatpp::Any(oatpp::String("e"))}
+  };
+
+  root->unorderedFields = {{"x", Color::GREEN}};
+
+  return root;
+
+}
+
+void checkStreamed(const std::shared_ptr<ObjectMapper>& mapper, const oatpp::Void& object, const oatpp::String& expected) {
+
+  /* small chunks and small read buffer */
+  for(v_buff_size chunkSize : {1, 7, 64, 16 * 1024}) {
+
+    SerializingReadCallback callback(mapper, object, chunkSize);
+    data::stream::BufferOutputStream stream;
+
+    v_char8 buffer[5];
+    async::Action action;
+    v_io_size res;
+    while((res = callback.read(buffer, 5, action)) > 0) {
+      stream.writeSimple(buffer, res);
+    }
+
+    OATPP_ASSERT(res == 0)
+    OATPP_ASSERT(stream.toString() == expected)
+
+  }
+
+}
+
+void checkSame(const ObjectMapper::SerializerConfig& config, const oatpp::Void& object) {
+
+  ObjectMapper::SerializerConfig treeConfig = config;
+  treeConfig.streaming = false;
+
+  ObjectMapper::SerializerConfig streamingConfig = config;
+  streamingConfig.streaming = true;
+
+  ObjectMapper treeMapper(treeConfig);
+  auto streamingMapper = std::make_shared<ObjectMapper>(streamingConfig);
+
+  auto expected = treeMapper.writeToString(object);
+  auto actual = streamingMapper->writeToString(object);
+
+  OATPP_ASSERT(expected == actual)
+
+  checkStreamed(streamingMapper, object, expected);
+
+}
+
+void checkAllConfigs(const oatpp::Void& object) {
+  for(v_int32 i = 0; i < 64; i ++) {
+    ObjectMapper::SerializerConfig config;
+    config.mapper.includeNullFields = (i & 1) != 0;
+    config.mapper.alwaysIncludeNullCollectionElements = (i & 2) != 0;
+    config.mapper.useUnqualifiedFieldNames = (i & 4) != 0;
+    config.mapper.useUnqualifiedEnumNames = (i & 8) != 0;
+    config.json.includeNullElements = (i & 16) != 0;
+    config.json.useBeautifier = (i & 32) != 0;
+    checkSame(config, object);
+  }
+}
+
+void mapUpperString(const data::mapping::ObjectToTreeMapper* mapper, data::mapping::ObjectToTreeMapper::State& state, const oatpp::Void& polymorph) {
+  (void) mapper;
+  if(polymorph) {
+    std::string value = *static_cast<std::string*>(polymorph.get());
+    for(auto& c : value) {
+      c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    state.tree->setString(oatpp::String(value));
+  } else {
+    state.tree->setNull();
+  }
+}
+
+void mapEnumPrefixed(const data::mapping::ObjectToTreeMapper* mapper, data::mapping::ObjectToTreeMapper::State& state, const oatpp::Void& polymorph) {
+  (void) mapper;
+  auto dispatcher = static_cast<const data::type::__class::AbstractEnum::PolymorphicDispatcher*>(
+    polymorph.getValueType()->polymorphicDispatcher
+  );
+  data::type::EnumInterpreterError e = data::type::EnumInterpreterError::OK;
+  auto interpretation = dispatcher->toInterpretation(polymorph, true, e).cast<oatpp::String>();
+  if(e != data::type::EnumInterpreterError::OK) {
+    state.errorStack.push("[mapEnumPrefixed()]: Error. Can't map Enum.");
+    return;
+  }
+  state.tree->setString("enum:" + interpretation);
+}
+
+void mapInt32AsString(const data::mapping::ObjectToTreeMapper* mapper, data::mapping::ObjectToTreeMapper::State& state, const oatpp::Void& polymorph) {
+  (void) mapper;
+  if(polymorph) {
+    state.tree->setString(oatpp::utils::Conversion::int32ToStr(*static_cast<v_int32*>(polymorph.get())));
+  } else {
+    state.tree->setNull();
+  }
+}
+
+}
+
+void ObjectSerializerTest::onRun() {
+
+  {
+    OATPP_LOGd(TAG, "object...")
+    checkAllConfigs(createRoot());
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "top-level list...")
+    oatpp::List<oatpp::Object<Root>> list({});
+    for(v_int32 i = 0; i < 20; i ++) {
+      list->push_back(i % 10 == 5 ? nullptr : createRoot());
+    }
+    checkAllConfigs(list);
+    checkAllConfigs(oatpp::List<oatpp::Object<Root>>({}));
+    checkAllConfigs(oatpp::List<oatpp::Object<Root>>(nullptr));
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "primitives...")
+    checkAllConfigs(oatpp::String("text"));
+    checkAllConfigs(oatpp::Int32(10));
+    checkAllConfigs(oatpp::Enum<Color>(Color::RED));
+    checkAllConfigs(oatpp::Any(oatpp::Float64(2.5)));
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "overridden built-in mapper methods...")
+
+    ObjectMapper::SerializerConfig treeConfig;
+    treeConfig.streaming = false;
+    ObjectMapper treeMapper(treeConfig);
+
+    ObjectMapper::SerializerConfig streamingConfig;
+    streamingConfig.streaming = true;
+    ObjectMapper streamingMapper(streamingConfig);
+
+    for(auto mapper : {&treeMapper, &streamingMapper}) {
+      mapper->objectToTreeMapper().setMapperMethod(data::type::__class::String::CLASS_ID, &mapUpperString);
+      mapper->objectToTreeMapper().setMapperMethod(data::type::__class::Int32::CLASS_ID, &mapInt32AsString);
+    }
+
+    auto root = createRoot();
+    auto expected = treeMapper.writeToString(root);
+    auto actual = streamingMapper.writeToString(root);
+
+    OATPP_ASSERT(expected->find("\"CHILD\"") != std::string::npos)
+    OATPP_ASSERT(expected->find("\"i32\":\"-32\"") != std::string::npos)
+    OATPP_ASSERT(expected == actual)
+
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "overridden mapper methods in streamed list...")
+
+    ObjectMapper::SerializerConfig treeConfig;
+    treeConfig.streaming = false;
+    ObjectMapper treeMapper(treeConfig);
+
+    ObjectMapper::SerializerConfig streamingConfig;
+    streamingConfig.streaming = true;
+    auto streamingMapper = std::make_shared<ObjectMapper>(streamingConfig);
+
+    for(auto mapper : {&treeMapper, streamingMapper.get()}) {
+      mapper->objectToTreeMapper().setMapperMethod(data::type::__class::String::CLASS_ID, &mapUpperString);
+      mapper->objectToTreeMapper().setMapperMethod(data::type::__class::AbstractEnum::CLASS_ID, &mapEnumPrefixed);
+    }
+
+    oatpp::List<oatpp::Enum<Color>> colors({Color::RED, Color::GREEN});
+    oatpp::Vector<oatpp::String> strings({"a", nullptr, "b"});
+
+    OATPP_ASSERT(treeMapper.writeToString(colors) == "[\"enum:RED\",\"enum:GREEN\"]")
+    OATPP_ASSERT(treeMapper.writeToString(oatpp::Any(strings)) == "[\"A\",null,\"B\"]")
+
+    for(const oatpp::Void& object : {oatpp::Void(colors), oatpp::Void(strings), oatpp::Void(oatpp::Any(colors))}) {
+      auto expected = treeMapper.writeToString(object);
+      OATPP_ASSERT(streamingMapper->writeToString(object) == expected)
+      checkStreamed(streamingMapper, object, expected);
+    }
+
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "required field error...")
+
+    auto child = Child::createShared();
+    child->required = nullptr;
+
+    ObjectMapper::SerializerConfig config;
+    config.streaming = true;
+    auto mapper = std::make_shared<ObjectMapper>(config);
+
+    bool thrown = false;
+    try {
+      mapper->writeToString(child);
+    } catch (std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown)
+
+    SerializingReadCallback callback(mapper, oatpp::List<oatpp::Object<Child>>({Child::createShared(), child}), 1);
+    v_char8 buffer[16];
+    async::Action action;
+    v_io_size res;
+    while((res = callback.read(buffer, 16, action)) > 0) {}
+    OATPP_ASSERT(res == oatpp::IOError::BROKEN_PIPE)
+
+    OATPP_LOGd(TAG, "OK")
+  }
+
+}
+
+}}
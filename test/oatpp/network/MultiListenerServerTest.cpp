@@ -0,0 +1,226 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "MultiListenerServerTest.hpp"
+
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+#include "oatpp/web/server/HttpRouter.hpp"
+#include "oatpp/web/protocol/http/outgoing/ResponseFactory.hpp"
+
+#include "oatpp/network/MultiListenerServer.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+#include "oatpp/network/tcp/server/ConnectionProvider.hpp"
+
+#include "oatpp/utils/Conversion.hpp"
+
+#include <thread>
+
+namespace oatpp { namespace test { namespace network {
+
+namespace {
+
+constexpr v_int32 LISTENERS_COUNT = 4;
+constexpr v_int32 CONNECTIONS_COUNT = 100;
+
+class CountingConnectionHandler : public oatpp::network::ConnectionHandler {
+public:
+
+  std::atomic<v_int32> counters[LISTENERS_COUNT];
+  std::atomic<v_int32> invalidParams;
+
+  CountingConnectionHandler()
+    : invalidParams(0)
+  {
+    for(auto& c : counters) {
+      c = 0;
+    }
+  }
+
+  void handleConnection(const provider::ResourceHandle<IOStream>& connection,
+                        const std::shared_ptr<const ParameterMap>& params) override
+  {
+    if(!params) {
+      invalidParams ++;
+      return;
+    }
+    auto it = params->find(oatpp::network::MultiListenerServer::PARAM_LISTENER_INDEX);
+    if(it == params->end()) {
+      invalidParams ++;
+      return;
+    }
+    v_uint32 index = oatpp::utils::Conversion::strToUInt32(it->second->c_str());
+    if(index >= LISTENERS_COUNT) {
+      invalidParams ++;
+      return;
+    }
+    counters[index] ++;
+  }
+
+  v_int32 getTotal() {
+    v_int32 result = 0;
+    for(auto& c : counters) {
+      result += c.load();
+    }
+    return result;
+  }
+
+  void stop() override {
+    // DO NOTHING
+  }
+
+};
+
+class HelloHandler : public oatpp::web::server::HttpRequestHandler {
+public:
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&>
+  handleAsync(const std::shared_ptr<IncomingRequest>& request) override {
+
+    class HelloCoroutine : public oatpp::async::CoroutineWithResult<HelloCoroutine, const std::shared_ptr<OutgoingResponse>&> {
+    public:
+
+      Action act() override {
+        return _return(oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(Status::CODE_200, "Hello"));
+      }
+
+    };
+
+    return HelloCoroutine::startForResult();
+
+  }
+
+};
+
+v_uint16 getPort(const std::shared_ptr<oatpp::network::tcp::server::ConnectionProvider>& provider) {
+  auto port = provider->getProperty(oatpp::network::ConnectionProvider::PROPERTY_PORT).toString();
+  return static_cast<v_uint16>(oatpp::utils::Conversion::strToInt32(port->c_str()));
+}
+
+void testAcceptLoops() {
+
+  auto providers = oatpp::network::tcp::server::ConnectionProvider::createSharedGroup(
+    {"localhost", 0, oatpp::network::Address::IP_4}, LISTENERS_COUNT);
+
+  OATPP_ASSERT(providers.size() == LISTENERS_COUNT)
+
+  v_uint16 port = getPort(providers[0]);
+  for(auto& p : providers) {
+    OATPP_ASSERT(getPort(p) == port)
+  }
+
+  auto handler = std::make_shared<CountingConnectionHandler>();
+  auto server = oatpp::network::MultiListenerServer::createShared(providers, handler, true);
+
+  OATPP_ASSERT(server->getListenersCount() == LISTENERS_COUNT)
+
+  std::thread serverThread([server]{
+    server->run();
+  });
+
+  auto clientProvider = oatpp::network::tcp::client::ConnectionProvider::createShared(
+    {"localhost", port, oatpp::network::Address::IP_4});
+
+  for(v_int32 i = 0; i < CONNECTIONS_COUNT; i ++) {
+    auto connection = clientProvider->get();
+    OATPP_ASSERT(connection)
+    connection.invalidator->invalidate(connection.object);
+  }
+
+  for(v_int32 i = 0; i < 500 && handler->getTotal() < CONNECTIONS_COUNT; i ++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  server->stop();
+  serverThread.join();
+
+  OATPP_ASSERT(server->getStatus() == oatpp::network::MultiListenerServer::STATUS_DONE)
+  OATPP_ASSERT(handler->invalidParams == 0)
+  OATPP_ASSERT(handler->getTotal() == CONNECTIONS_COUNT)
+
+  v_int32 activeListeners = 0;
+  for(v_int32 i = 0; i < LISTENERS_COUNT; i ++) {
+    OATPP_LOGd("TEST", "listener[{}] accepted {} connections", i, handler->counters[i].load())
+    if(handler->counters[i] > 0) {
+      activeListeners ++;
+    }
+  }
+
+  /* kernel should distribute connections between SO_REUSEPORT sockets */
+  OATPP_ASSERT(activeListeners > 1)
+
+}
+
+void testAsyncHttp() {
+
+  auto providers = oatpp::network::tcp::server::ConnectionProvider::createSharedGroup(
+    {"localhost", 0, oatpp::network::Address::IP_4}, LISTENERS_COUNT);
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->route("GET", "/hello", std::make_shared<HelloHandler>());
+
+  auto executor = std::make_shared<oatpp::async::Executor>(LISTENERS_COUNT, 1, 1);
+  auto connectionHandler = oatpp::web::server::AsyncHttpConnectionHandler::createShared(router, executor);
+
+  auto server = oatpp::network::MultiListenerServer::createShared(providers, connectionHandler);
+
+  std::thread serverThread([server]{
+    server->run();
+  });
+
+  auto clientProvider = oatpp::network::tcp::client::ConnectionProvider::createShared(
+    {"localhost", getPort(providers[0]), oatpp::network::Address::IP_4});
+  oatpp::web::client::HttpRequestExecutor requestExecutor(clientProvider);
+
+  for(v_int32 i = 0; i < 20; i ++) {
+    auto response = requestExecutor.execute("GET", "/hello", oatpp::web::protocol::http::Headers({}), nullptr, nullptr);
+    OATPP_ASSERT(response->getStatusCode() == 200)
+    OATPP_ASSERT(response->readBodyToString() == "Hello")
+  }
+
+  server->stop();
+  serverThread.join();
+
+  connectionHandler->stop();
+  executor->waitTasksFinished();
+  executor->stop();
+  executor->join();
+
+}
+
+}
+
+void MultiListenerServerTest::onRun() {
+
+#if !defined(WIN32) && !defined(_WIN32)
+  testAcceptLoops();
+  testAsyncHttp();
+#else
+  OATPP_LOGi(TAG, "SO_REUSEPORT is not supported on this platform. Skipping...")
+#endif
+
+}
+
+}}}
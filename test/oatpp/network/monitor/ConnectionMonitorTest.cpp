@@ -32,6 +32,7 @@
 
 #include "oatpp/network/monitor/ConnectionMonitor.hpp"
 #include "oatpp/network/monitor/ConnectionMaxAgeChecker.hpp"
+#include "oatpp/network/monitor/ConnectionInactivityChecker.hpp"
 
 #include "oatpp/network/Server.hpp"
 #include "oatpp/network/tcp/client/ConnectionProvider.hpp"
@@ -138,6 +139,152 @@ std::shared_ptr<oatpp::network::Server> runAsyncServer(const std::shared_ptr<oat
 
 }
 
+class StubConnection : public oatpp::data::stream::IOStream, public oatpp::base::Countable {
+private:
+  static oatpp::data::stream::DefaultInitializedContext DEFAULT_CONTEXT;
+public:
+
+  std::atomic<bool> invalidated{false};
+
+  v_io_size write(const void *buff, v_buff_size count, async::Action& action) override {
+    (void) buff;
+    (void) action;
+    return count;
+  }
+
+  v_io_size read(void *buff, v_buff_size count, async::Action& action) override {
+    (void) buff;
+    (void) action;
+    return count;
+  }
+
+  void setOutputStreamIOMode(oatpp::data::stream::IOMode ioMode) override {
+    (void) ioMode;
+  }
+
+  oatpp::data::stream::IOMode getOutputStreamIOMode() override {
+    return oatpp::data::stream::IOMode::BLOCKING;
+  }
+
+  oatpp::data::stream::Context& getOutputStreamContext() override {
+    return DEFAULT_CONTEXT;
+  }
+
+  void setInputStreamIOMode(oatpp::data::stream::IOMode ioMode) override {
+    (void) ioMode;
+  }
+
+  oatpp::data::stream::IOMode getInputStreamIOMode() override {
+    return oatpp::data::stream::IOMode::BLOCKING;
+  }
+
+  oatpp::data::stream::Context& getInputStreamContext() override {
+    return DEFAULT_CONTEXT;
+  }
+
+};
+
+oatpp::data::stream::DefaultInitializedContext StubConnection::DEFAULT_CONTEXT(oatpp::data::stream::StreamType::STREAM_INFINITE);
+
+class StubConnectionProvider : public oatpp::network::ServerConnectionProvider {
+private:
+
+  class Invalidator : public oatpp::provider::Invalidator<oatpp::data::stream::IOStream> {
+  public:
+    void invalidate(const std::shared_ptr<oatpp::data::stream::IOStream>& connection) override {
+      std::static_pointer_cast<StubConnection>(connection)->invalidated = true;
+    }
+  };
+
+private:
+  std::shared_ptr<Invalidator> m_invalidator = std::make_shared<Invalidator>();
+public:
+
+  std::vector<std::shared_ptr<StubConnection>> connections;
+
+  oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream> get() override {
+    auto connection = std::make_shared<StubConnection>();
+    connections.push_back(connection);
+    return oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>(connection, m_invalidator);
+  }
+
+  oatpp::async::CoroutineStarterForResult<const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>&> getAsync() override {
+    throw std::runtime_error("[StubConnectionProvider::getAsync()]: Not implemented.");
+  }
+
+  void stop() override {}
+
+};
+
+class BytesCollector : public oatpp::network::monitor::StatCollector {
+public:
+
+  std::atomic<v_io_size> bytes{0};
+
+  oatpp::String metricName() override {
+    return "bytes";
+  }
+
+  void* createMetricData() override {
+    return nullptr;
+  }
+
+  void deleteMetricData(void* metricData) override {
+    (void) metricData;
+  }
+
+  void onRead(void* metricData, v_io_size readResult, v_int64 timestamp) override {
+    (void) metricData;
+    (void) timestamp;
+    bytes += readResult;
+  }
+
+  void onWrite(void* metricData, v_io_size writeResult, v_int64 timestamp) override {
+    (void) metricData;
+    (void) timestamp;
+    bytes += writeResult;
+  }
+
+};
+
+void runInactivityTest() {
+
+  auto provider = std::make_shared<StubConnectionProvider>();
+  auto monitor = std::make_shared<oatpp::network::monitor::ConnectionMonitor>(provider, std::chrono::milliseconds(20));
+
+  monitor->addMetricsChecker(
+    std::make_shared<oatpp::network::monitor::ConnectionInactivityChecker>(
+      std::chrono::milliseconds(300),
+      std::chrono::milliseconds(300)
+    )
+  );
+
+  auto collector = std::make_shared<BytesCollector>();
+  monitor->addStatCollector(collector);
+
+  auto active = monitor->get();
+  auto idle = monitor->get();
+
+  v_char8 buffer[8];
+  oatpp::async::Action action;
+
+  for(v_int32 i = 0; i < 30; i ++) {
+    OATPP_ASSERT(active.object->write(buffer, 4, action) == 4)
+    OATPP_ASSERT(active.object->read(buffer, 4, action) == 4)
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+
+  OATPP_ASSERT(collector->bytes == 30 * 8)
+  OATPP_ASSERT(provider->connections[0]->invalidated == false)
+  OATPP_ASSERT(provider->connections[1]->invalidated == true)
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  OATPP_ASSERT(provider->connections[0]->invalidated == true)
+
+  monitor->stop();
+
+}
+
 void runClient() {
 
   auto connectionProvider = oatpp::network::tcp::client::ConnectionProvider::createShared(
@@ -249,8 +396,16 @@ void ConnectionMonitorTest::onRun() {
     std::this_thread::sleep_for(std::chrono::seconds(5));
   }
 
+  {
+    OATPP_LOGd(TAG, "run inactivity test")
+    runInactivityTest();
+  }
+
   monitor->stop();
 
+  /* wait monitor task exit */
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
 }
 
 }}}}
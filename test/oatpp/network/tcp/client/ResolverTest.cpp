@@ -0,0 +1,178 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "ResolverTest.hpp"
+
+#include "oatpp/network/tcp/client/Resolver.hpp"
+#include "oatpp/async/Executor.hpp"
+
+namespace oatpp { namespace test { namespace network { namespace tcp { namespace client {
+
+namespace {
+
+typedef oatpp::network::tcp::client::Resolver Resolver;
+typedef oatpp::network::Address Address;
+
+class ResolveCoroutine : public oatpp::async::Coroutine<ResolveCoroutine> {
+private:
+  std::shared_ptr<Resolver> m_resolver;
+  Address m_address;
+  std::shared_ptr<const Resolver::Endpoints>* m_result;
+  std::atomic<v_int32>* m_errors;
+public:
+
+  ResolveCoroutine(const std::shared_ptr<Resolver>& resolver,
+                   const Address& address,
+                   std::shared_ptr<const Resolver::Endpoints>* result,
+                   std::atomic<v_int32>* errors)
+    : m_resolver(resolver)
+    , m_address(address)
+    , m_result(result)
+    , m_errors(errors)
+  {}
+
+  Action act() override {
+    return m_resolver->resolveAsync(m_address).callbackTo(&ResolveCoroutine::onResolved);
+  }
+
+  Action onResolved(const std::shared_ptr<const Resolver::Endpoints>& endpoints) {
+    *m_result = endpoints;
+    return finish();
+  }
+
+  Action handleError(oatpp::async::Error* error) override {
+    (*m_errors) ++;
+    return error;
+  }
+
+};
+
+}
+
+void ResolverTest::onRun() {
+
+  {
+    OATPP_LOGd(TAG, "sync resolve and cache...")
+
+    auto resolver = Resolver::createShared();
+
+    auto endpoints = resolver->resolve({"localhost", 8000});
+    OATPP_ASSERT(endpoints && !endpoints->empty())
+    for(auto& endpoint : *endpoints) {
+      OATPP_ASSERT(endpoint.family == Address::IP_4 || endpoint.family == Address::IP_6)
+      OATPP_ASSERT(endpoint.addressLength > 0)
+    }
+
+    OATPP_ASSERT(resolver->resolve({"localhost", 8000}) == endpoints)
+    OATPP_ASSERT(resolver->resolve({"localhost", 8001}) != endpoints)
+    OATPP_ASSERT(resolver->getCacheSize() == 2)
+
+    resolver->clearCache();
+    OATPP_ASSERT(resolver->getCacheSize() == 0)
+    OATPP_ASSERT(resolver->resolve({"localhost", 8000}) != endpoints)
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "ttl...")
+
+    Resolver::Config config;
+    config.ttl = std::chrono::microseconds(0);
+    auto resolver = Resolver::createShared(config);
+
+    auto endpoints = resolver->resolve({"localhost", 8000});
+    OATPP_ASSERT(resolver->resolve({"localhost", 8000}) != endpoints)
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "negative cache...")
+
+    Resolver::Config config;
+    config.maxCacheSize = 2;
+    auto resolver = Resolver::createShared(config);
+
+    /* IPv6 literal with IPv4 family fails without DNS query */
+    for(v_int32 i = 0; i < 2; i ++) {
+      bool failed = false;
+      try {
+        resolver->resolve({"::1", 8000, Address::IP_4});
+      } catch (const std::runtime_error& e) {
+        OATPP_LOGd(TAG, "error='{}'", e.what())
+        failed = true;
+      }
+      OATPP_ASSERT(failed)
+    }
+    OATPP_ASSERT(resolver->getCacheSize() == 1)
+
+    resolver->resolve({"localhost", 8000});
+    resolver->resolve({"localhost", 8001});
+    OATPP_ASSERT(resolver->getCacheSize() <= 2)
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "async resolve...")
+
+    constexpr v_int32 coroutinesCount = 100;
+
+    auto resolver = Resolver::createShared();
+    std::vector<std::shared_ptr<const Resolver::Endpoints>> results(coroutinesCount);
+    std::shared_ptr<const Resolver::Endpoints> failedResult;
+    std::atomic<v_int32> errors(0);
+
+    oatpp::async::Executor executor(1, 1, 1);
+
+    for(v_int32 i = 0; i < coroutinesCount; i ++) {
+      executor.execute<ResolveCoroutine>(resolver, Address("localhost", 8000), &results[static_cast<size_t>(i)], &errors);
+    }
+    executor.execute<ResolveCoroutine>(resolver, Address("::1", 8000, Address::IP_4), &failedResult, &errors);
+
+    executor.waitTasksFinished();
+
+    OATPP_ASSERT(errors == 1)
+    OATPP_ASSERT(!failedResult)
+    OATPP_ASSERT(results[0] && !results[0]->empty())
+    for(auto& result : results) {
+      OATPP_ASSERT(result == results[0]) // one shared lookup
+    }
+    OATPP_ASSERT(resolver->resolve({"localhost", 8000}) == results[0])
+
+    resolver->stop();
+
+    std::shared_ptr<const Resolver::Endpoints> stoppedResult;
+    executor.execute<ResolveCoroutine>(resolver, Address("localhost", 8002), &stoppedResult, &errors);
+    executor.waitTasksFinished();
+
+    OATPP_ASSERT(errors == 2)
+    OATPP_ASSERT(!stoppedResult)
+
+    executor.stop();
+    executor.join();
+    OATPP_LOGd(TAG, "OK")
+  }
+
+}
+
+}}}}}
@@ -0,0 +1,241 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "ConnectionProviderTest.hpp"
+
+#include "oatpp/network/tcp/server/ConnectionProvider.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+#include "oatpp/utils/Conversion.hpp"
+
+#include <cstring>
+
+#if !defined(WIN32) && !defined(_WIN32)
+  #include <sys/socket.h>
+  #include <netinet/in.h>
+  #include <netinet/tcp.h>
+#endif
+
+namespace oatpp { namespace test { namespace network { namespace tcp { namespace server {
+
+namespace {
+
+typedef oatpp::network::tcp::server::ConnectionProvider ServerProvider;
+typedef oatpp::network::tcp::client::ConnectionProvider ClientProvider;
+typedef oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream> ConnectionHandle;
+
+class CountingConfigurer : public oatpp::network::tcp::ConnectionConfigurer {
+private:
+  bool m_configureListener;
+public:
+
+  std::atomic<v_int32> configuredCount{0};
+
+  CountingConfigurer(bool configureListener)
+    : m_configureListener(configureListener)
+  {}
+
+  void configure(oatpp::v_io_handle handle) override {
+    (void) handle;
+    configuredCount ++;
+  }
+
+  bool configureListener(oatpp::v_io_handle handle) override {
+#if !defined(WIN32) && !defined(_WIN32)
+    if(m_configureListener) {
+      int yes = 1;
+      OATPP_ASSERT(setsockopt(handle, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(int)) == 0)
+    }
+#else
+    (void) handle;
+#endif
+    return m_configureListener;
+  }
+
+};
+
+std::shared_ptr<ServerProvider> createServer(bool useExtendedConnections) {
+  return ServerProvider::createShared({"localhost", 0, oatpp::network::Address::IP_4}, useExtendedConnections);
+}
+
+std::shared_ptr<ClientProvider> createClient(const std::shared_ptr<ServerProvider>& server) {
+  auto port = oatpp::utils::Conversion::strToInt32(server->getProperty(ServerProvider::PROPERTY_PORT).toString()->c_str());
+  return ClientProvider::createShared({"localhost", static_cast<v_uint16>(port), oatpp::network::Address::IP_4});
+}
+
+void testBatch() {
+
+  auto server = createServer(true);
+  server->setAcceptBatchSize(4);
+  auto client = createClient(server);
+
+  std::vector<ConnectionHandle> clientConnections;
+  for(v_int32 i = 0; i < 10; i ++) {
+    clientConnections.push_back(client->get());
+    OATPP_ASSERT(clientConnections.back())
+  }
+
+  for(v_int32 i = 0; i < 10; i ++) {
+    auto connection = server->get();
+    OATPP_ASSERT(connection)
+    auto& context = connection.object->getInputStreamContext();
+    OATPP_ASSERT(context.getProperties().get(ServerProvider::ExtendedConnection::PROPERTY_PEER_ADDRESS) == "127.0.0.1")
+    OATPP_ASSERT(connection.object->getInputStreamIOMode() == oatpp::data::stream::IOMode::BLOCKING)
+  }
+
+  /* backlog is drained - get() times out */
+  OATPP_ASSERT(!server->get())
+
+  /* connections accepted but not taken yet are closed on stop */
+  clientConnections.push_back(client->get());
+  clientConnections.push_back(client->get());
+  OATPP_ASSERT(server->get())
+  server->stop();
+  OATPP_ASSERT(!server->get())
+
+  client->stop();
+
+}
+
+void testAcceptIOMode() {
+
+  auto server = createServer(false);
+  server->setAcceptIOMode(oatpp::data::stream::IOMode::ASYNCHRONOUS);
+  auto client = createClient(server);
+
+  auto clientConnection = client->get();
+  OATPP_ASSERT(clientConnection)
+
+  auto connection = server->get();
+  OATPP_ASSERT(connection)
+
+#if !defined(WIN32) && !defined(_WIN32)
+  OATPP_ASSERT(connection.object->getInputStreamIOMode() == oatpp::data::stream::IOMode::ASYNCHRONOUS)
+#endif
+
+  connection.object->setInputStreamIOMode(oatpp::data::stream::IOMode::BLOCKING);
+  OATPP_ASSERT(connection.object->getInputStreamIOMode() == oatpp::data::stream::IOMode::BLOCKING)
+
+  const char* message = "hello";
+  OATPP_ASSERT(clientConnection.object->writeExactSizeDataSimple(message, 5) == 5)
+
+  char buffer[5];
+  OATPP_ASSERT(connection.object->readExactSizeDataSimple(buffer, 5) == 5)
+  OATPP_ASSERT(std::memcmp(buffer, message, 5) == 0)
+
+  server->stop();
+  client->stop();
+
+}
+
+void testConfigurer() {
+
+  {
+    auto server = createServer(false);
+    auto configurer = std::make_shared<CountingConfigurer>(false);
+    server->setConnectionConfigurer(configurer);
+    auto client = createClient(server);
+
+    auto clientConnection = client->get();
+    OATPP_ASSERT(server->get())
+    OATPP_ASSERT(configurer->configuredCount == 1)
+
+    server->stop();
+    client->stop();
+  }
+
+  {
+    auto server = createServer(false);
+    auto configurer = std::make_shared<CountingConfigurer>(true);
+    server->setConnectionConfigurer(configurer);
+    auto client = createClient(server);
+
+    auto clientConnection = client->get();
+    auto connection = server->get();
+    OATPP_ASSERT(connection)
+    OATPP_ASSERT(configurer->configuredCount == 0)
+
+#if defined(__linux__)
+    /* option set on the accept-socket is inherited by the accepted one */
+    auto handle = std::static_pointer_cast<oatpp::network::tcp::Connection>(connection.object)->getHandle();
+    int value = 0;
+    socklen_t valueSize = sizeof(int);
+    OATPP_ASSERT(getsockopt(handle, IPPROTO_TCP, TCP_NODELAY, &value, &valueSize) == 0)
+    OATPP_ASSERT(value != 0)
+#endif
+
+    server->stop();
+    client->stop();
+  }
+
+}
+
+void testDeferAccept() {
+
+#if defined(__linux__)
+
+  auto server = createServer(false);
+  OATPP_ASSERT(server->setDeferAccept(std::chrono::seconds(5)))
+  auto client = createClient(server);
+
+  auto clientConnection = client->get();
+  OATPP_ASSERT(clientConnection)
+
+  /* no data yet - connection doesn't surface */
+  OATPP_ASSERT(!server->get())
+
+  OATPP_ASSERT(clientConnection.object->writeExactSizeDataSimple("A", 1) == 1)
+
+  auto connection = server->get();
+  OATPP_ASSERT(connection)
+
+  char buffer;
+  OATPP_ASSERT(connection.object->readExactSizeDataSimple(&buffer, 1) == 1)
+  OATPP_ASSERT(buffer == 'A')
+
+  server->stop();
+  client->stop();
+
+#endif
+
+}
+
+}
+
+void ConnectionProviderTest::onRun() {
+
+  OATPP_LOGd(TAG, "batch accept")
+  testBatch();
+
+  OATPP_LOGd(TAG, "accept I/O mode")
+  testAcceptIOMode();
+
+  OATPP_LOGd(TAG, "connection configurer")
+  testConfigurer();
+
+  OATPP_LOGd(TAG, "defer accept")
+  testDeferAccept();
+
+}
+
+}}}}}
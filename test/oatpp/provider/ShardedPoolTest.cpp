@@ -0,0 +1,316 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "ShardedPoolTest.hpp"
+
+#include "oatpp/provider/ShardedPool.hpp"
+#include "oatpp/async/Executor.hpp"
+
+#include <thread>
+
+namespace oatpp { namespace provider {
+
+namespace {
+
+class Resource {
+public:
+
+  virtual ~Resource() = default;
+
+  virtual v_int64 myId() = 0;
+
+};
+
+class MyResource : public Resource {
+private:
+  v_int64 m_id;
+public:
+
+  MyResource(v_int64 number)
+    : m_id(number)
+  {}
+
+  v_int64 myId() override {
+    return m_id;
+  }
+
+};
+
+class TestProvider : public oatpp::provider::Provider<Resource> {
+private:
+
+  class ResourceInvalidator : public oatpp::provider::Invalidator<Resource> {
+  public:
+
+    std::atomic<v_int64> invalidations{0};
+
+    void invalidate(const std::shared_ptr<Resource>& resource) override {
+      (void) resource;
+      invalidations ++;
+    }
+
+  };
+
+private:
+  std::shared_ptr<ResourceInvalidator> m_invalidator = std::make_shared<ResourceInvalidator>();
+  std::atomic<v_int64> m_id{0};
+public:
+
+  oatpp::provider::ResourceHandle<Resource> get() override {
+    return oatpp::provider::ResourceHandle<Resource>(
+      std::make_shared<MyResource>(++m_id),
+      m_invalidator
+    );
+  }
+
+  async::CoroutineStarterForResult<const oatpp::provider::ResourceHandle<Resource> &> getAsync() override {
+
+    class GetCoroutine : public oatpp::async::CoroutineWithResult<GetCoroutine, const oatpp::provider::ResourceHandle<Resource>&> {
+    private:
+      TestProvider* m_provider;
+    public:
+
+      GetCoroutine(TestProvider* provider)
+        : m_provider(provider)
+      {}
+
+      Action act() override {
+        return _return(oatpp::provider::ResourceHandle<Resource>(
+          std::make_shared<MyResource>(++ m_provider->m_id),
+          m_provider->m_invalidator
+        ));
+      }
+
+    };
+
+    return GetCoroutine::startForResult(this);
+  }
+
+  void stop() override {
+    OATPP_LOGd("TestProvider", "stop()")
+  }
+
+  v_int64 getIdCounter() {
+    return m_id;
+  }
+
+  v_int64 getInvalidationsCount() {
+    return m_invalidator->invalidations;
+  }
+
+};
+
+struct AcquisitionProxy : public oatpp::provider::AcquisitionProxy<Resource, AcquisitionProxy> {
+
+  AcquisitionProxy(const oatpp::provider::ResourceHandle<Resource>& resource,
+                   const std::shared_ptr<PoolInstance>& pool)
+    : oatpp::provider::AcquisitionProxy<Resource, AcquisitionProxy>(resource, pool)
+  {}
+
+  v_int64 myId() override {
+    return _handle.object->myId();
+  }
+
+};
+
+typedef oatpp::provider::ShardedPool<oatpp::provider::Provider<Resource>, Resource, AcquisitionProxy> TestPool;
+
+class ClientCoroutine : public oatpp::async::Coroutine<ClientCoroutine> {
+private:
+  std::shared_ptr<TestPool> m_pool;
+  std::atomic<v_int32>* m_failures;
+  oatpp::provider::ResourceHandle<Resource> m_resource;
+  v_int32 m_iterationsLeft;
+public:
+
+  ClientCoroutine(const std::shared_ptr<TestPool>& pool, std::atomic<v_int32>* failures, v_int32 iterations)
+    : m_pool(pool)
+    , m_failures(failures)
+    , m_iterationsLeft(iterations)
+  {}
+
+  Action act() override {
+    if(m_iterationsLeft -- == 0) {
+      return finish();
+    }
+    return m_pool->getAsync().callbackTo(&ClientCoroutine::onGet);
+  }
+
+  Action onGet(const oatpp::provider::ResourceHandle<Resource>& resource) {
+    if(!resource) {
+      (*m_failures) ++;
+      return finish();
+    }
+    m_resource = resource;
+    return yieldTo(&ClientCoroutine::onUse);
+  }
+
+  Action onUse() {
+    m_resource = nullptr;
+    return yieldTo(&ClientCoroutine::act);
+  }
+
+};
+
+void testLifo() {
+
+  auto provider = std::make_shared<TestProvider>();
+  auto pool = TestPool::createShared(provider, 10, std::chrono::seconds(10), std::chrono::microseconds::zero(), 1);
+
+  {
+    auto r1 = pool->get();
+    auto r2 = pool->get();
+    auto r3 = pool->get();
+    OATPP_ASSERT(r1.object->myId() == 1 && r2.object->myId() == 2 && r3.object->myId() == 3)
+    OATPP_ASSERT(pool->getCounter() == 3)
+  } // released in order r3, r2, r1
+
+  {
+    auto r = pool->get();
+    OATPP_ASSERT(r.object->myId() == 1) // the most recently released
+
+    r.invalidator->invalidate(r.object);
+  }
+
+  OATPP_ASSERT(pool->getCounter() == 2)
+
+  auto statistics = pool->getStatistics();
+  OATPP_ASSERT(statistics.acquisitions == 4)
+  OATPP_ASSERT(statistics.hits == 1)
+  OATPP_ASSERT(statistics.creations == 3)
+  OATPP_ASSERT(statistics.waits == 0)
+  OATPP_ASSERT(provider->getInvalidationsCount() == 1)
+
+  pool->stop();
+  OATPP_ASSERT(pool->getCounter() == 0)
+  OATPP_ASSERT(provider->getInvalidationsCount() == 3) // pooled resources are invalidated on stop
+
+}
+
+void testConcurrent() {
+
+  constexpr v_int64 maxResources = 8;
+  constexpr v_int32 threadsCount = 16;
+  constexpr v_int32 iterations = 1000;
+  constexpr v_int32 coroutinesCount = 50;
+  constexpr v_int32 coroutineIterations = 20;
+
+  auto provider = std::make_shared<TestProvider>();
+  auto pool = TestPool::createShared(provider, maxResources, std::chrono::seconds(10), std::chrono::microseconds::zero(), 4);
+
+  oatpp::async::Executor executor(2, 1, 1);
+  std::atomic<v_int32> failures(0);
+
+  for(v_int32 i = 0; i < coroutinesCount; i ++) {
+    executor.execute<ClientCoroutine>(pool, &failures, coroutineIterations);
+  }
+
+  std::vector<std::thread> threads;
+  for(v_int32 i = 0; i < threadsCount; i ++) {
+    threads.emplace_back([pool, &failures]{
+      for(v_int32 j = 0; j < iterations; j ++) {
+        auto resource = pool->get();
+        if(!resource) {
+          failures ++;
+          continue;
+        }
+        OATPP_ASSERT(pool->getCounter() <= maxResources)
+        std::this_thread::yield();
+      }
+    });
+  }
+
+  for(auto& thread : threads) {
+    thread.join();
+  }
+
+  executor.waitTasksFinished();
+  executor.stop();
+  executor.join();
+
+  auto statistics = pool->getStatistics();
+  OATPP_LOGd("TEST", "acquisitions={}, hits={}, creations={}, waits={}, waitTime={}us, maxWait={}us",
+             statistics.acquisitions, statistics.hits, statistics.creations,
+             statistics.waits, statistics.waitTimeMicroseconds, statistics.maxWaitTimeMicroseconds)
+
+  OATPP_ASSERT(failures == 0)
+  OATPP_ASSERT(provider->getIdCounter() <= maxResources)
+  OATPP_ASSERT(statistics.creations == provider->getIdCounter())
+  OATPP_ASSERT(statistics.acquisitions == threadsCount * iterations + coroutinesCount * coroutineIterations)
+  OATPP_ASSERT(statistics.hits == statistics.acquisitions - statistics.creations)
+  OATPP_ASSERT(pool->getCounter() == provider->getIdCounter())
+
+  pool->stop();
+  OATPP_ASSERT(provider->getInvalidationsCount() == provider->getIdCounter())
+
+}
+
+void testTimeoutAndTtl() {
+
+  auto provider = std::make_shared<TestProvider>();
+  auto pool = TestPool::createShared(provider, 1, std::chrono::milliseconds(200), std::chrono::milliseconds(100), 2);
+
+  {
+    auto resource = pool->get();
+    OATPP_ASSERT(resource)
+
+    auto start = oatpp::Environment::getMicroTickCount();
+    OATPP_ASSERT(!pool->get())
+    OATPP_ASSERT(oatpp::Environment::getMicroTickCount() - start >= 100 * 1000)
+
+    oatpp::async::Executor executor(1, 1, 1);
+    std::atomic<v_int32> failures(0);
+    executor.execute<ClientCoroutine>(pool, &failures, 1);
+    executor.waitTasksFinished();
+    executor.stop();
+    executor.join();
+    OATPP_ASSERT(failures == 1)
+  }
+
+  auto statistics = pool->getStatistics();
+  OATPP_ASSERT(statistics.timeouts == 2)
+  OATPP_ASSERT(statistics.waits == 0)
+
+  OATPP_ASSERT(pool->getCounter() == 1)
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  OATPP_ASSERT(pool->getCounter() == 0) // evicted by ttl
+
+  pool->stop();
+
+}
+
+}
+
+void ShardedPoolTest::onRun() {
+
+  testLifo();
+  testConcurrent();
+  testTimeoutAndTtl();
+
+  /* wait pool cleanup task exit */
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+}
+
+}}
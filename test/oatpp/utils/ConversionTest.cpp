@@ -0,0 +1,131 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ConversionTest.hpp"
+
+#include "oatpp/utils/Conversion.hpp"
+#include "oatpp/utils/parser/Caret.hpp"
+
+#include <cstring>
+#include <limits>
+#include <random>
+
+namespace oatpp { namespace utils {
+
+void ConversionTest::onRun() {
+
+  { // integers
+    OATPP_ASSERT(Conversion::int32ToStr(0) == "0")
+    OATPP_ASSERT(Conversion::int32ToStr(std::numeric_limits<v_int32>::min()) == "-2147483648")
+    OATPP_ASSERT(Conversion::uint32ToStr(std::numeric_limits<v_uint32>::max()) == "4294967295")
+    OATPP_ASSERT(Conversion::int64ToStr(std::numeric_limits<v_int64>::min()) == "-9223372036854775808")
+    OATPP_ASSERT(Conversion::uint64ToStr(std::numeric_limits<v_uint64>::max()) == "18446744073709551615")
+
+    v_char8 buffer[4];
+    OATPP_ASSERT(Conversion::int32ToCharSequence(123, buffer, 4) == 3)
+    OATPP_ASSERT(std::strcmp(reinterpret_cast<const char*>(buffer), "123") == 0)
+    OATPP_ASSERT(Conversion::int32ToCharSequence(12345, buffer, 4) == 0) // doesn't fit
+  }
+
+  { // parse integers
+    bool success;
+    OATPP_ASSERT(Conversion::strToInt32("42") == 42)
+    OATPP_ASSERT(Conversion::strToInt32(" +42") == 42)
+    OATPP_ASSERT(Conversion::strToInt64("100-200") == 100)
+    OATPP_ASSERT(Conversion::strToInt64("-9223372036854775808") == std::numeric_limits<v_int64>::min())
+
+    OATPP_ASSERT(Conversion::strToInt32(oatpp::String("-123"), success) == -123 && success)
+    OATPP_ASSERT(Conversion::strToUInt64(oatpp::String("18446744073709551615"), success) == std::numeric_limits<v_uint64>::max() && success)
+
+    Conversion::strToInt32(oatpp::String("12a"), success);
+    OATPP_ASSERT(!success)
+    Conversion::strToInt32(oatpp::String("2147483648"), success); // out of range
+    OATPP_ASSERT(!success)
+    Conversion::strToUInt32(oatpp::String("-1"), success);
+    OATPP_ASSERT(!success)
+    Conversion::strToInt64(oatpp::String(""), success);
+    OATPP_ASSERT(!success)
+  }
+
+  { // floats - shortest round-trip representation
+    OATPP_ASSERT(Conversion::float64ToStr(0.1) == "0.1")
+    OATPP_ASSERT(Conversion::float64ToStr(-1.5) == "-1.5")
+    OATPP_ASSERT(Conversion::float64ToStr(100) == "100")
+    OATPP_ASSERT(Conversion::float32ToStr(0.1f) == "0.1")
+    OATPP_ASSERT(Conversion::float64ToStr(0.1, "%.3f") == "0.100")
+
+    std::mt19937_64 random(2024);
+    for(v_int32 i = 0; i < 100000; i ++) {
+      v_uint64 bits = random();
+      v_float64 value;
+      std::memcpy(&value, &bits, sizeof(value));
+      if(value != value || value - value != 0) { // skip NaN and inf
+        continue;
+      }
+      bool success;
+      auto str = Conversion::float64ToStr(value);
+      OATPP_ASSERT(Conversion::strToFloat64(str, success) == value && success)
+    }
+
+    for(v_int32 i = 0; i < 100000; i ++) {
+      auto bits = static_cast<v_uint32>(random());
+      v_float32 value;
+      std::memcpy(&value, &bits, sizeof(value));
+      if(value != value || value - value != 0) { // skip NaN and inf
+        continue;
+      }
+      bool success;
+      auto str = Conversion::float32ToStr(value);
+      OATPP_ASSERT(Conversion::strToFloat32(str, success) == value && success)
+    }
+  }
+
+  { // parse floats
+    bool success;
+    OATPP_ASSERT(Conversion::strToFloat64(oatpp::String("1e-3"), success) == 1e-3 && success)
+    OATPP_ASSERT(Conversion::strToFloat64(oatpp::String("+2.5"), success) == 2.5 && success)
+    Conversion::strToFloat64(oatpp::String("2.5x"), success);
+    OATPP_ASSERT(!success)
+  }
+
+  { // caret - data is not null-terminated
+    const char* text = "12345";
+    parser::Caret caret(text, 3);
+    OATPP_ASSERT(caret.parseInt() == 123)
+    OATPP_ASSERT(caret.getPosition() == 3)
+
+    parser::Caret floatCaret("-0.25,1", 5);
+    OATPP_ASSERT(floatCaret.parseFloat64() == -0.25)
+    OATPP_ASSERT(floatCaret.isAtChar(','))
+
+    parser::Caret errorCaret("abc");
+    errorCaret.parseInt();
+    OATPP_ASSERT(errorCaret.hasError())
+    OATPP_ASSERT(errorCaret.getPosition() == 0)
+  }
+
+}
+
+}}
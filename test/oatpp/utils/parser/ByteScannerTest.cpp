@@ -0,0 +1,96 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ByteScannerTest.hpp"
+
+#include "oatpp/utils/parser/ByteScanner.hpp"
+
+#include <random>
+#include <string>
+
+namespace oatpp { namespace utils { namespace parser {
+
+namespace {
+
+void checkAll(const char* data, v_buff_size size) {
+  OATPP_ASSERT(ByteScanner::findChar(data, size, ':') == ByteScanner::Scalar::findChar(data, size, ':'))
+  OATPP_ASSERT(ByteScanner::findChar(data, size, '\r') == ByteScanner::Scalar::findChar(data, size, '\r'))
+  OATPP_ASSERT(ByteScanner::findEitherChar(data, size, ':', ' ') == ByteScanner::Scalar::findEitherChar(data, size, ':', ' '))
+  OATPP_ASSERT(ByteScanner::findEitherChar(data, size, '\r', '\n') == ByteScanner::Scalar::findEitherChar(data, size, '\r', '\n'))
+  OATPP_ASSERT(ByteScanner::findRN(data, size) == ByteScanner::Scalar::findRN(data, size))
+  OATPP_ASSERT(ByteScanner::findRNRN(data, size) == ByteScanner::Scalar::findRNRN(data, size))
+}
+
+}
+
+void ByteScannerTest::onRun() {
+
+  OATPP_LOGd(TAG, "implementation: {}", ByteScanner::getImplementationName())
+
+  { // empty and not found
+    OATPP_ASSERT(ByteScanner::findChar("", 0, 'a') == 0)
+    OATPP_ASSERT(ByteScanner::findRN("\r", 1) == 1)
+    OATPP_ASSERT(ByteScanner::findRNRN("\r\n\r", 3) == 3)
+    OATPP_ASSERT(ByteScanner::findEitherChar("abc", 3, 'x', 'y') == 3)
+  }
+
+  { // single match at every position of the long buffer
+    for(size_t size = 1; size < 100; size ++) {
+      for(size_t pos = 0; pos < size; pos ++) {
+        std::string buffer(size, 'a');
+        buffer[pos] = ':';
+        OATPP_ASSERT(ByteScanner::findChar(buffer.data(), static_cast<v_buff_size>(size), ':') == static_cast<v_buff_size>(pos))
+        OATPP_ASSERT(ByteScanner::findEitherChar(buffer.data(), static_cast<v_buff_size>(size), ' ', ':') == static_cast<v_buff_size>(pos))
+        if(pos + 4 <= size) {
+          buffer.replace(pos, 4, "\r\n\r\n");
+          OATPP_ASSERT(ByteScanner::findRN(buffer.data(), static_cast<v_buff_size>(size)) == static_cast<v_buff_size>(pos))
+          OATPP_ASSERT(ByteScanner::findRNRN(buffer.data(), static_cast<v_buff_size>(size)) == static_cast<v_buff_size>(pos))
+        }
+        checkAll(buffer.data(), static_cast<v_buff_size>(size));
+      }
+    }
+  }
+
+  { // random data - differential against scalar implementation
+    std::mt19937 random(12345);
+    const char alphabet[] = {'a', 'b', ' ', ':', '\r', '\n', '\r', '\n'};
+    std::string buffer(300, 'a');
+    for(v_int32 iteration = 0; iteration < 20000; iteration ++) {
+      auto size = static_cast<v_buff_size>(random() % buffer.size());
+      auto density = random() % 16 + 1;
+      for(auto& c : buffer) {
+        c = (random() % density == 0) ? alphabet[random() % sizeof(alphabet)] : 'x';
+      }
+      auto offset = static_cast<v_buff_size>(random() % 4);
+      if(offset > size) {
+        offset = size;
+      }
+      checkAll(buffer.data() + offset, size - offset);
+    }
+  }
+
+}
+
+}}}
@@ -61,10 +61,12 @@ typedef oatpp::web::protocol::http::outgoing::MultipartBody MultipartBody;
 class TestComponent {
 private:
   v_uint16 m_port;
+  v_int32 m_eventLoopWorkers;
 public:
 
-  TestComponent(v_uint16 port)
+  TestComponent(v_uint16 port, v_int32 eventLoopWorkers)
     : m_port(port)
+    , m_eventLoopWorkers(eventLoopWorkers)
   {}
 
   OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::virtual_::Interface>, virtualInterface)([] {
@@ -90,8 +92,11 @@ public:
     return oatpp::web::server::HttpRouter::createShared();
   }());
 
-  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, serverConnectionHandler)([] {
+  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, serverConnectionHandler)([this] {
     OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router);
+    if(m_eventLoopWorkers > 0) {
+      return oatpp::web::server::HttpConnectionHandler::createShared(router, m_eventLoopWorkers);
+    }
     return oatpp::web::server::HttpConnectionHandler::createShared(router);
   }());
 
@@ -138,7 +143,7 @@ std::shared_ptr<PartList> createMultipart(const std::unordered_map<oatpp::String
   
 void FullTest::onRun() {
 
-  TestComponent component(m_port);
+  TestComponent component(m_port, m_eventLoopWorkers);
 
   oatpp::test::web::ClientServerTestRunner runner;
 
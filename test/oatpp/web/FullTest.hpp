@@ -33,12 +33,14 @@ class FullTest : public UnitTest {
 private:
   v_uint16 m_port;
   v_int32 m_iterationsPerStep;
+  v_int32 m_eventLoopWorkers;
 public:
   
-  FullTest(v_uint16 port, v_int32 iterationsPerStep)
+  FullTest(v_uint16 port, v_int32 iterationsPerStep, v_int32 eventLoopWorkers = 0)
     : UnitTest("TEST[web::FullTest]")
     , m_port(port)
     , m_iterationsPerStep(iterationsPerStep)
+    , m_eventLoopWorkers(eventLoopWorkers)
   {}
 
   void onRun() override;
@@ -50,10 +50,12 @@ namespace {
 class TestComponent {
 private:
   v_uint16 m_port;
+  v_int32 m_eventLoopWorkers;
 public:
 
-  TestComponent(v_uint16 port)
+  TestComponent(v_uint16 port, v_int32 eventLoopWorkers)
     : m_port(port)
+    , m_eventLoopWorkers(eventLoopWorkers)
   {}
 
   OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::virtual_::Interface>, virtualInterface)([] {
@@ -79,8 +81,11 @@ public:
     return oatpp::web::server::HttpRouter::createShared();
   }());
 
-  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, serverConnectionHandler)([] {
+  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, serverConnectionHandler)([this] {
     OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router);
+    if(m_eventLoopWorkers > 0) {
+      return oatpp::web::server::HttpConnectionHandler::createShared(router, m_eventLoopWorkers);
+    }
     return oatpp::web::server::HttpConnectionHandler::createShared(router);
   }());
 
@@ -123,7 +128,7 @@ const char* const SAMPLE_OUT =
 
 void PipelineTest::onRun() {
 
-  TestComponent component(m_port);
+  TestComponent component(m_port, m_eventLoopWorkers);
 
   oatpp::test::web::ClientServerTestRunner runner;
 
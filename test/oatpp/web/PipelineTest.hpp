@@ -33,12 +33,14 @@ class PipelineTest : public UnitTest {
 private:
   v_uint16 m_port;
   v_int32 m_pipelineSize;
+  v_int32 m_eventLoopWorkers;
 public:
 
-  PipelineTest(v_uint16 port, v_int32 pipelineSize)
+  PipelineTest(v_uint16 port, v_int32 pipelineSize, v_int32 eventLoopWorkers = 0)
     : UnitTest("TEST[web::PipelineTest]")
     , m_port(port)
     , m_pipelineSize(pipelineSize)
+    , m_eventLoopWorkers(eventLoopWorkers)
   {}
 
   void onRun() override;
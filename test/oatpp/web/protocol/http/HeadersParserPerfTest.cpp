@@ -0,0 +1,114 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "HeadersParserPerfTest.hpp"
+#include "HeadersCorpus.hpp"
+
+#include "oatpp/web/protocol/http/Http.hpp"
+#include "oatpp/utils/parser/ByteScanner.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+namespace oatpp { namespace test { namespace web { namespace protocol { namespace http {
+
+namespace {
+
+typedef oatpp::utils::parser::ByteScanner ByteScanner;
+typedef v_buff_size (*FindRN)(const char* data, v_buff_size size);
+
+v_int64 parseCorpus(const std::vector<std::string>& corpus, v_int32 iterations) {
+  v_int64 headersCount = 0;
+  oatpp::test::PerformanceChecker checker("Parser::parseHeaders");
+  for(v_int32 i = 0; i < iterations; i ++) {
+    for(auto& block : corpus) {
+      oatpp::utils::parser::Caret caret(block.data(), static_cast<v_buff_size>(block.size()));
+      oatpp::web::protocol::http::RequestStartingLine line;
+      oatpp::web::protocol::http::Headers headers;
+      oatpp::web::protocol::http::Status status;
+      oatpp::web::protocol::http::Parser::parseRequestStartingLine(line, nullptr, caret, status);
+      oatpp::web::protocol::http::Parser::parseHeaders(headers, nullptr, caret, status);
+      OATPP_ASSERT(status.code == 0)
+      headersCount += headers.getSize();
+    }
+  }
+  return headersCount;
+}
+
+v_int64 splitLines(const char* tag, FindRN findRN, const std::vector<std::string>& corpus, v_int32 iterations) {
+  v_int64 linesCount = 0;
+  oatpp::test::PerformanceChecker checker(tag);
+  for(v_int32 i = 0; i < iterations; i ++) {
+    for(auto& block : corpus) {
+      const char* data = block.data();
+      auto size = static_cast<v_buff_size>(block.size());
+      v_buff_size pos = 0;
+      while(pos < size) {
+        pos += findRN(data + pos, size - pos) + 2;
+        linesCount ++;
+      }
+    }
+  }
+  return linesCount;
+}
+
+v_int64 findSectionEnd(const char* tag, FindRN findRNRN, const std::vector<std::string>& corpus, v_int32 iterations) {
+  v_int64 total = 0;
+  oatpp::test::PerformanceChecker checker(tag);
+  for(v_int32 i = 0; i < iterations; i ++) {
+    for(auto& block : corpus) {
+      total += findRNRN(block.data(), static_cast<v_buff_size>(block.size()));
+    }
+  }
+  return total;
+}
+
+}
+
+void HeadersParserPerfTest::onRun() {
+
+  const auto& corpus = getHeadersCorpus();
+  const v_int32 iterations = 10000;
+
+  v_int64 bytes = 0;
+  for(auto& block : corpus) {
+    bytes += static_cast<v_int64>(block.size());
+  }
+
+  OATPP_LOGd(TAG, "scanner={}, blocks={}, bytes per iteration={}, iterations={}",
+             ByteScanner::getImplementationName(), static_cast<v_int64>(corpus.size()), bytes, iterations)
+
+  parseCorpus(corpus, iterations);
+
+  auto lines = splitLines("findRN (selected)", &ByteScanner::findRN, corpus, iterations);
+  auto linesScalar = splitLines("findRN (scalar)", &ByteScanner::Scalar::findRN, corpus, iterations);
+  OATPP_ASSERT(lines == linesScalar)
+
+  auto ends = findSectionEnd("findRNRN (selected)", &ByteScanner::findRNRN, corpus, iterations);
+  auto endsScalar = findSectionEnd("findRNRN (scalar)", &ByteScanner::Scalar::findRNRN, corpus, iterations);
+  OATPP_ASSERT(ends == endsScalar)
+
+}
+
+}}}}}
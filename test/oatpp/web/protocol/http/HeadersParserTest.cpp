@@ -0,0 +1,262 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "HeadersParserTest.hpp"
+#include "HeadersCorpus.hpp"
+
+#include "oatpp/web/protocol/http/incoming/RequestHeadersReader.hpp"
+#include "oatpp/web/protocol/http/Http.hpp"
+#include "oatpp/data/stream/BufferStream.hpp"
+
+#include <algorithm>
+#include <random>
+
+namespace oatpp { namespace test { namespace web { namespace protocol { namespace http {
+
+namespace {
+
+typedef std::vector<std::pair<std::string, std::string>> HeadersList;
+
+struct ParsedRequest {
+  v_int32 status = 0;
+  std::string method;
+  std::string path;
+  std::string protocol;
+  HeadersList headers;
+};
+
+/*
+ * Byte-by-byte parser - same algorithm as http::Parser without vectorized search.
+ */
+class ReferenceParser {
+private:
+  const std::string& m_text;
+  size_t m_pos;
+private:
+
+  bool findChar(char c) {
+    while(m_pos < m_text.size() && m_text[m_pos] != c) {
+      m_pos ++;
+    }
+    return m_pos < m_text.size();
+  }
+
+  bool isAtRN() {
+    return m_pos + 1 < m_text.size() && m_text[m_pos] == '\r' && m_text[m_pos + 1] == '\n';
+  }
+
+  bool findRN() {
+    while(m_pos < m_text.size()) {
+      if(isAtRN()) {
+        return true;
+      }
+      m_pos ++;
+    }
+    return false;
+  }
+
+  void skipChar(char c) {
+    while(m_pos < m_text.size() && m_text[m_pos] == c) {
+      m_pos ++;
+    }
+  }
+
+  bool parseToken(char separator, std::string& token) {
+    auto start = m_pos;
+    if(!findChar(separator)) {
+      return false;
+    }
+    token = m_text.substr(start, m_pos - start);
+    m_pos ++;
+    return true;
+  }
+
+public:
+
+  ReferenceParser(const std::string& text)
+    : m_text(text)
+    , m_pos(0)
+  {}
+
+  ParsedRequest parse() {
+
+    ParsedRequest result;
+
+    if(!parseToken(' ', result.method) || !parseToken(' ', result.path)) {
+      result.status = 400;
+      return result;
+    }
+
+    auto start = m_pos;
+    if(!findRN()) {
+      result.status = 400;
+      return result;
+    }
+    result.protocol = m_text.substr(start, m_pos - start);
+    m_pos += 2;
+
+    while(!isAtRN()) {
+
+      skipChar(' ');
+
+      start = m_pos;
+      while(m_pos < m_text.size() && m_text[m_pos] != ':' && m_text[m_pos] != ' ') {
+        m_pos ++;
+      }
+      if(m_pos >= m_text.size()) {
+        result.status = 431;
+        return result;
+      }
+      auto name = m_text.substr(start, m_pos - start);
+
+      skipChar(' ');
+      if(m_pos >= m_text.size() || m_text[m_pos] != ':') {
+        result.status = 400;
+        return result;
+      }
+      m_pos ++;
+
+      skipChar(' ');
+      start = m_pos;
+      findRN();
+      result.headers.emplace_back(name, m_text.substr(start, m_pos - start));
+      if(isAtRN()) {
+        m_pos += 2;
+      }
+
+    }
+
+    std::sort(result.headers.begin(), result.headers.end());
+    return result;
+
+  }
+
+};
+
+HeadersList toList(const oatpp::web::protocol::http::Headers& headers) {
+  HeadersList result;
+  for(auto& pair : headers.getAll_Unsafe()) {
+    result.emplace_back(pair.first.std_str(), pair.second.std_str());
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+ParsedRequest parse(const std::string& text) {
+
+  ParsedRequest result;
+
+  oatpp::utils::parser::Caret caret(text.data(), static_cast<v_buff_size>(text.size()));
+  oatpp::web::protocol::http::RequestStartingLine line;
+  oatpp::web::protocol::http::Headers headers;
+  oatpp::web::protocol::http::Status status;
+
+  oatpp::web::protocol::http::Parser::parseRequestStartingLine(line, nullptr, caret, status);
+  if(status.code == 0) {
+    result.method = line.method.std_str();
+    result.path = line.path.std_str();
+    result.protocol = line.protocol.std_str();
+    oatpp::web::protocol::http::Parser::parseHeaders(headers, nullptr, caret, status);
+  }
+
+  result.status = status.code;
+  if(status.code == 0) {
+    result.headers = toList(headers);
+  }
+
+  return result;
+
+}
+
+void assertSame(const ParsedRequest& a, const ParsedRequest& b) {
+  OATPP_ASSERT(a.status == b.status)
+  if(a.status == 0) {
+    OATPP_ASSERT(a.method == b.method)
+    OATPP_ASSERT(a.path == b.path)
+    OATPP_ASSERT(a.protocol == b.protocol)
+    OATPP_ASSERT(a.headers == b.headers)
+  }
+}
+
+}
+
+void HeadersParserTest::onRun() {
+
+  const auto& corpus = getHeadersCorpus();
+
+  { // corpus
+    for(auto& block : corpus) {
+      auto expected = ReferenceParser(block).parse();
+      OATPP_ASSERT(expected.status == 0)
+      OATPP_ASSERT(!expected.headers.empty())
+      assertSame(parse(block), expected);
+    }
+  }
+
+  { // mutated corpus - differential against byte-by-byte parser
+    std::mt19937 random(777);
+    const char alphabet[] = {' ', ':', '\r', '\n', 'a', '\0'};
+    for(v_int32 iteration = 0; iteration < 20000; iteration ++) {
+      std::string block = corpus[random() % corpus.size()];
+      auto mutations = random() % 4 + 1;
+      for(size_t i = 0; i < mutations; i ++) {
+        block[random() % block.size()] = alphabet[random() % sizeof(alphabet)];
+      }
+      if(random() % 4 == 0) {
+        block.resize(random() % block.size());
+      }
+      assertSame(parse(block), ReferenceParser(block).parse());
+    }
+  }
+
+  { // RequestHeadersReader - section end split across reads
+    for(auto& block : corpus) {
+      auto expected = ReferenceParser(block).parse();
+      for(v_buff_size chunkSize = 1; chunkSize < 10; chunkSize ++) {
+
+        auto inputStream = std::make_shared<oatpp::data::stream::BufferInputStream>(oatpp::String(block + "BODY"));
+        auto proxy = oatpp::data::stream::InputStreamBufferedProxy::createShared(inputStream, std::make_shared<std::string>(64, 0));
+
+        oatpp::data::stream::BufferOutputStream buffer;
+        oatpp::web::protocol::http::incoming::RequestHeadersReader reader(&buffer, chunkSize, 8192);
+        oatpp::web::protocol::http::HttpError::Info error;
+        auto result = reader.readHeaders(proxy.get(), error);
+
+        OATPP_ASSERT(error.ioStatus > 0)
+        OATPP_ASSERT(result.startingLine.method.std_str() == expected.method)
+        OATPP_ASSERT(result.startingLine.path.std_str() == expected.path)
+        OATPP_ASSERT(toList(result.headers) == expected.headers)
+
+        char body[4];
+        OATPP_ASSERT(proxy->readExactSizeDataSimple(body, 4) == 4)
+        OATPP_ASSERT(std::string(body, 4) == "BODY")
+
+      }
+    }
+  }
+
+}
+
+}}}}}
@@ -0,0 +1,152 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "DeflateTest.hpp"
+
+#include "oatpp/web/protocol/http/encoding/Deflate.hpp"
+#include "oatpp/data/stream/BufferStream.hpp"
+
+namespace oatpp { namespace test { namespace web { namespace protocol { namespace http { namespace encoding {
+
+#ifdef OATPP_ZLIB_SUPPORTED
+
+namespace {
+
+oatpp::String createData() {
+  oatpp::data::stream::BufferOutputStream stream;
+  stream << "[";
+  for(v_int32 i = 0; i < 2000; i ++) {
+    if(i > 0) stream << ",";
+    stream << "{\"id\":" << i << ",\"name\":\"item-" << i << "\",\"price\":" << i * 3 << "}";
+  }
+  stream << "]";
+  return stream.toString();
+}
+
+oatpp::String process(const oatpp::String& data, oatpp::data::buffer::Processor* processor, v_buff_size bufferSize) {
+  oatpp::data::stream::BufferInputStream inStream(data);
+  oatpp::data::stream::BufferOutputStream outStream;
+  std::unique_ptr<v_char8[]> buffer(new v_char8[bufferSize]);
+  auto count = oatpp::data::stream::transfer(&inStream, &outStream, 0, buffer.get(), bufferSize, processor);
+  OATPP_ASSERT(count == static_cast<v_io_size>(data->size()))
+  return outStream.toString();
+}
+
+}
+
+void DeflateTest::onRun() {
+
+  typedef oatpp::web::protocol::http::encoding::DeflateFormat DeflateFormat;
+
+  oatpp::String data = createData();
+
+  for(v_int32 i = 0; i < 2; i ++) {
+
+    auto format = i == 0 ? DeflateFormat::DEFLATE : DeflateFormat::GZIP;
+
+    for(v_buff_size bufferSize : {5, 1024, 65536}) {
+
+      OATPP_LOGd(TAG, "format={}, bufferSize={}", i == 0 ? "deflate" : "gzip", bufferSize)
+
+      oatpp::web::protocol::http::encoding::EncoderDeflate encoder(format);
+      auto encoded = process(data, &encoder, bufferSize);
+
+      OATPP_LOGd(TAG, "size={}, encoded={}", data->size(), encoded->size())
+      OATPP_ASSERT(encoded->size() < data->size() / 4)
+
+      if(format == DeflateFormat::GZIP) {
+        OATPP_ASSERT(static_cast<v_uint8>((*encoded)[0]) == 0x1F && static_cast<v_uint8>((*encoded)[1]) == 0x8B)
+      } else {
+        OATPP_ASSERT(static_cast<v_uint8>((*encoded)[0]) == 0x78)
+      }
+
+      oatpp::web::protocol::http::encoding::DecoderDeflate decoder(format);
+      auto decoded = process(encoded, &decoder, bufferSize);
+      OATPP_ASSERT(decoded == data)
+
+    }
+
+    { // Empty body
+      oatpp::web::protocol::http::encoding::EncoderDeflate encoder(format);
+      auto encoded = process("", &encoder, 1024);
+      OATPP_ASSERT(encoded->size() > 0)
+
+      oatpp::web::protocol::http::encoding::DecoderDeflate decoder(format);
+      auto decoded = process(encoded, &decoder, 1024);
+      OATPP_ASSERT(decoded == "")
+    }
+
+    { // Truncated input
+      oatpp::web::protocol::http::encoding::EncoderDeflate encoder(format);
+      auto encoded = process(data, &encoder, 1024);
+
+      oatpp::web::protocol::http::encoding::DecoderDeflate decoder(format);
+      oatpp::data::buffer::InlineReadData dataIn(encoded->data(), static_cast<v_buff_size>(encoded->size() / 2));
+      oatpp::data::buffer::InlineReadData dataOut;
+
+      v_int32 res;
+      do {
+        res = decoder.iterate(dataIn, dataOut);
+        if(res == oatpp::data::buffer::Processor::Error::FLUSH_DATA_OUT) {
+          dataOut.setEof();
+        } else if(res == oatpp::data::buffer::Processor::Error::PROVIDE_DATA_IN) {
+          dataIn.set(nullptr, 0);
+        }
+      } while(res == oatpp::data::buffer::Processor::Error::OK ||
+              res == oatpp::data::buffer::Processor::Error::FLUSH_DATA_OUT ||
+              res == oatpp::data::buffer::Processor::Error::PROVIDE_DATA_IN);
+
+      OATPP_ASSERT(res == oatpp::web::protocol::http::encoding::DecoderDeflate::ERROR_UNEXPECTED_END)
+    }
+
+  }
+
+  { // Providers - encoder and decoder in one pipeline
+    oatpp::web::protocol::http::encoding::GzipEncoderProvider encoderProvider;
+    oatpp::web::protocol::http::encoding::GzipDecoderProvider decoderProvider;
+
+    OATPP_ASSERT(encoderProvider.getEncodingName() == "gzip")
+    OATPP_ASSERT(decoderProvider.getEncodingName() == "gzip")
+
+    oatpp::data::buffer::ProcessingPipeline pipeline({
+      encoderProvider.getProcessor(),
+      decoderProvider.getProcessor()
+    });
+
+    auto result = process(data, &pipeline, 256);
+    OATPP_ASSERT(result == data)
+  }
+
+}
+
+#else
+
+void DeflateTest::onRun() {
+  OATPP_LOGw(TAG, "zlib is not linked. Skipping.")
+}
+
+#endif
+
+}}}}}}
@@ -0,0 +1,165 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "EncodedBodyCacheTest.hpp"
+
+#include "oatpp/web/protocol/http/encoding/EncodedBodyCache.hpp"
+#include "oatpp/web/protocol/http/encoding/Chunked.hpp"
+
+namespace oatpp { namespace test { namespace web { namespace protocol { namespace http { namespace encoding {
+
+namespace {
+
+typedef oatpp::web::protocol::http::encoding::EncodedBodyCache EncodedBodyCache;
+
+/**
+ * Chunked encoder which counts how many times the body was actually encoded.
+ */
+class CountingEncoderProvider : public oatpp::web::protocol::http::encoding::ChunkedEncoderProvider {
+public:
+
+  v_int32 encodeCount = 0;
+
+  std::shared_ptr<data::buffer::Processor> getProcessor() override {
+    encodeCount ++;
+    return ChunkedEncoderProvider::getProcessor();
+  }
+
+};
+
+oatpp::String createBody(char c, v_buff_size size) {
+  return std::string(static_cast<size_t>(size), c);
+}
+
+oatpp::String toChunked(const oatpp::String& body) {
+  return "64\r\n" + *body + "\r\n0\r\n\r\n";
+}
+
+}
+
+void EncodedBodyCacheTest::onRun() {
+
+  {
+    OATPP_LOGd(TAG, "Cache hits...")
+
+    EncodedBodyCache cache(1024 * 1024, 16);
+    CountingEncoderProvider provider;
+
+    auto body = createBody('a', 100);
+
+    auto encoded1 = cache.get(&provider, nullptr, body->data(), static_cast<v_buff_size>(body->size()));
+    auto encoded2 = cache.get(&provider, nullptr, body->data(), static_cast<v_buff_size>(body->size()));
+
+    OATPP_ASSERT(encoded1)
+    OATPP_ASSERT(encoded1 == toChunked(body))
+    OATPP_ASSERT(encoded2 == encoded1)
+    OATPP_ASSERT(provider.encodeCount == 1)
+    OATPP_ASSERT(cache.getHitsCount() == 1)
+    OATPP_ASSERT(cache.getMissesCount() == 1)
+    OATPP_ASSERT(cache.getEntriesCount() == 1)
+    OATPP_ASSERT(cache.getSize() == static_cast<v_buff_size>(body->size() + encoded1->size()))
+
+    /* Same data in a different buffer */
+    auto copy = createBody('a', 100);
+    OATPP_ASSERT(cache.get(&provider, nullptr, copy->data(), static_cast<v_buff_size>(copy->size())) == encoded1)
+    OATPP_ASSERT(provider.encodeCount == 1)
+
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "Small bodies are not cached...")
+
+    EncodedBodyCache cache(1024 * 1024, 16);
+    CountingEncoderProvider provider;
+
+    auto body = createBody('a', 15);
+    OATPP_ASSERT(!cache.isCacheable(static_cast<v_buff_size>(body->size())))
+    OATPP_ASSERT(!cache.get(&provider, nullptr, body->data(), static_cast<v_buff_size>(body->size())))
+    OATPP_ASSERT(provider.encodeCount == 0)
+    OATPP_ASSERT(cache.getEntriesCount() == 0)
+
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "ETag keys are verified against the content...")
+
+    EncodedBodyCache cache(1024 * 1024, 16);
+    CountingEncoderProvider provider;
+
+    auto body1 = createBody('a', 100);
+    auto body2 = createBody('b', 100);
+
+    auto encoded1 = cache.get(&provider, "\"v1\"", body1->data(), static_cast<v_buff_size>(body1->size()));
+    auto encoded2 = cache.get(&provider, "\"v1\"", body2->data(), static_cast<v_buff_size>(body2->size()));
+
+    OATPP_ASSERT(encoded1 == toChunked(body1))
+    OATPP_ASSERT(encoded2 == toChunked(body2))
+    OATPP_ASSERT(provider.encodeCount == 2)
+    OATPP_ASSERT(cache.getEntriesCount() == 1)
+
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "LRU eviction...")
+
+    EncodedBodyCache cache(1000, 16);
+    CountingEncoderProvider provider;
+
+    auto body1 = createBody('a', 200);
+    auto body2 = createBody('b', 200);
+    auto body3 = createBody('c', 200);
+
+    cache.get(&provider, nullptr, body1->data(), static_cast<v_buff_size>(body1->size()));
+    cache.get(&provider, nullptr, body2->data(), static_cast<v_buff_size>(body2->size()));
+    OATPP_ASSERT(cache.getEntriesCount() == 2)
+
+    /* Touch body1 so body2 becomes the least recently used */
+    cache.get(&provider, nullptr, body1->data(), static_cast<v_buff_size>(body1->size()));
+    OATPP_ASSERT(provider.encodeCount == 2)
+
+    cache.get(&provider, nullptr, body3->data(), static_cast<v_buff_size>(body3->size()));
+    OATPP_ASSERT(provider.encodeCount == 3)
+    OATPP_ASSERT(cache.getEntriesCount() == 2)
+    OATPP_ASSERT(cache.getSize() <= 1000)
+
+    cache.get(&provider, nullptr, body1->data(), static_cast<v_buff_size>(body1->size()));
+    OATPP_ASSERT(provider.encodeCount == 3)
+
+    cache.get(&provider, nullptr, body2->data(), static_cast<v_buff_size>(body2->size()));
+    OATPP_ASSERT(provider.encodeCount == 4)
+
+    cache.clear();
+    OATPP_ASSERT(cache.getEntriesCount() == 0)
+    OATPP_ASSERT(cache.getSize() == 0)
+
+    OATPP_LOGd(TAG, "OK")
+  }
+
+}
+
+}}}}}}
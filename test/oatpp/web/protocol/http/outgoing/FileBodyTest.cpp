@@ -0,0 +1,236 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "FileBodyTest.hpp"
+
+#include "oatpp/web/protocol/http/outgoing/FileBody.hpp"
+#include "oatpp/web/protocol/http/outgoing/Response.hpp"
+#include "oatpp/network/tcp/Connection.hpp"
+#include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/async/Executor.hpp"
+#include "oatpp/utils/Conversion.hpp"
+
+#if !defined(WIN32) && !defined(_WIN32)
+  #include <sys/socket.h>
+  #include <unistd.h>
+  #include <fcntl.h>
+#endif
+
+#include <thread>
+#include <cstdio>
+
+namespace oatpp { namespace test { namespace web { namespace protocol { namespace http { namespace outgoing {
+
+namespace {
+
+typedef oatpp::web::protocol::http::outgoing::FileBody FileBody;
+typedef oatpp::web::protocol::http::outgoing::Response Response;
+typedef oatpp::web::protocol::http::Status Status;
+typedef oatpp::web::protocol::http::Range Range;
+
+const char* const FILE_NAME = "oatpp-FileBodyTest.tmp";
+
+oatpp::String createFileData(v_buff_size size) {
+  std::string data(static_cast<size_t>(size), 'a');
+  for(size_t i = 0; i < data.size(); i ++) {
+    data[i] = static_cast<char>('a' + (i * 7) % 26);
+  }
+  return data;
+}
+
+oatpp::String getResponseBody(const oatpp::String& response) {
+  auto pos = response->find("\r\n\r\n");
+  OATPP_ASSERT(pos != std::string::npos)
+  return response->substr(pos + 4);
+}
+
+#if !defined(WIN32) && !defined(_WIN32)
+
+oatpp::String readUntilClosed(v_io_handle handle) {
+  oatpp::data::stream::BufferOutputStream stream;
+  v_char8 buffer[4096];
+  while(true) {
+    auto res = ::read(handle, buffer, sizeof(buffer));
+    if(res <= 0) {
+      break;
+    }
+    stream.writeSimple(buffer, res);
+  }
+  return stream.toString();
+}
+
+class SendCoroutine : public oatpp::async::Coroutine<SendCoroutine> {
+private:
+  std::shared_ptr<Response> m_response;
+  std::shared_ptr<oatpp::data::stream::OutputStream> m_stream;
+public:
+
+  SendCoroutine(const std::shared_ptr<Response>& response,
+                const std::shared_ptr<oatpp::data::stream::OutputStream>& stream)
+    : m_response(response)
+    , m_stream(stream)
+  {}
+
+  Action act() override {
+    return Response::sendAsync(m_response, m_stream, std::make_shared<oatpp::data::stream::BufferOutputStream>(), nullptr)
+      .next(finish());
+  }
+
+};
+
+oatpp::String sendOverSocket(const std::shared_ptr<Response>& response) {
+
+  int fds[2];
+  OATPP_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0)
+
+  std::thread sender([response, fds]{
+    oatpp::network::tcp::Connection connection(fds[0]);
+    oatpp::data::stream::BufferOutputStream headersBuffer;
+    response->send(&connection, &headersBuffer, nullptr);
+  });
+
+  auto result = readUntilClosed(fds[1]);
+  sender.join();
+  ::close(fds[1]);
+
+  return result;
+
+}
+
+oatpp::String sendOverSocketAsync(const std::shared_ptr<Response>& response) {
+
+  int fds[2];
+  OATPP_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0)
+  fcntl(fds[0], F_SETFL, O_NONBLOCK);
+
+  oatpp::async::Executor executor(1, 1, 1);
+
+  {
+    auto connection = std::make_shared<oatpp::network::tcp::Connection>(fds[0]);
+    executor.execute<SendCoroutine>(response, connection);
+  }
+
+  auto result = readUntilClosed(fds[1]);
+  ::close(fds[1]);
+
+  executor.waitTasksFinished();
+  executor.stop();
+  executor.join();
+
+  return result;
+
+}
+
+#endif
+
+}
+
+void FileBodyTest::onRun() {
+
+  auto data = createFileData(1024 * 1024 + 123);
+  data.saveToFile(FILE_NAME);
+
+  { // read fallback - not a tcp::Connection
+    auto body = FileBody::createShared(FILE_NAME, "application/octet-stream");
+    OATPP_ASSERT(body->getKnownData() == nullptr)
+    OATPP_ASSERT(body->getKnownSize() == static_cast<v_int64>(data->size()))
+
+    auto response = Response::createShared(Status::CODE_200, body);
+    oatpp::data::stream::BufferOutputStream stream;
+    oatpp::data::stream::BufferOutputStream headersBuffer;
+    response->send(&stream, &headersBuffer, nullptr);
+
+    auto result = stream.toString();
+    OATPP_ASSERT(result->find("Content-Type: application/octet-stream\r\n") != std::string::npos)
+    OATPP_ASSERT(getResponseBody(result) == data)
+  }
+
+  { // range
+    auto range = Range::parse("bytes=100-1099");
+    auto body = FileBody::createShared(FILE_NAME, range);
+    OATPP_ASSERT(body->getKnownSize() == 1000)
+    OATPP_ASSERT(body->getContentRange().toString() == "bytes 100-1099/" + oatpp::utils::Conversion::int64ToStr(static_cast<v_int64>(data->size())))
+
+    auto response = Response::createShared(Status::CODE_206, body);
+    oatpp::data::stream::BufferOutputStream stream;
+    oatpp::data::stream::BufferOutputStream headersBuffer;
+    response->send(&stream, &headersBuffer, nullptr);
+
+    auto result = stream.toString();
+    OATPP_ASSERT(result->find("Content-Range: bytes 100-1099/") != std::string::npos)
+    OATPP_ASSERT(getResponseBody(result) == data->substr(100, 1000))
+  }
+
+  { // open-ended range
+    auto range = Range::parse("bytes=1000-");
+    OATPP_ASSERT(range.end == -1)
+    auto body = FileBody::createShared(FILE_NAME, range);
+    OATPP_ASSERT(body->getKnownSize() == static_cast<v_int64>(data->size()) - 1000)
+  }
+
+  { // not satisfiable range
+    bool thrown = false;
+    try {
+      FileBody::createShared(FILE_NAME, Range(Range::UNIT_BYTES, static_cast<v_int64>(data->size()), -1));
+    } catch (const oatpp::web::protocol::http::HttpError& e) {
+      OATPP_ASSERT(e.getInfo().status.code == 416)
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown)
+  }
+
+#if !defined(WIN32) && !defined(_WIN32)
+
+  { // sendfile - sync
+    auto response = Response::createShared(Status::CODE_200, FileBody::createShared(FILE_NAME));
+    auto result = sendOverSocket(response);
+    OATPP_ASSERT(getResponseBody(result) == data)
+  }
+
+  { // sendfile - sync, range
+    auto response = Response::createShared(Status::CODE_206, FileBody::createShared(FILE_NAME, Range::parse("bytes=12345-")));
+    auto result = sendOverSocket(response);
+    OATPP_ASSERT(getResponseBody(result) == data->substr(12345))
+  }
+
+  { // sendfile - async
+    auto response = Response::createShared(Status::CODE_200, FileBody::createShared(FILE_NAME));
+    auto result = sendOverSocketAsync(response);
+    OATPP_ASSERT(getResponseBody(result) == data)
+  }
+
+  { // sendfile - async, range
+    auto response = Response::createShared(Status::CODE_206, FileBody::createShared(FILE_NAME, Range::parse("bytes=7-70000")));
+    auto result = sendOverSocketAsync(response);
+    OATPP_ASSERT(getResponseBody(result) == data->substr(7, 69994))
+  }
+
+#endif
+
+  std::remove(FILE_NAME);
+
+}
+
+}}}}}}
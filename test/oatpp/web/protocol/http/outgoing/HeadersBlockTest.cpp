@@ -0,0 +1,213 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "HeadersBlockTest.hpp"
+
+#include "oatpp/web/protocol/http/outgoing/HeadersBlock.hpp"
+#include "oatpp/web/protocol/http/outgoing/Response.hpp"
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+#include "oatpp/web/server/interceptor/AllowCorsGlobal.hpp"
+#include "oatpp/data/stream/BufferStream.hpp"
+
+namespace oatpp { namespace test { namespace web { namespace protocol { namespace http { namespace outgoing {
+
+namespace {
+
+typedef oatpp::web::protocol::http::outgoing::HeadersBlock HeadersBlock;
+typedef oatpp::web::protocol::http::outgoing::Response Response;
+typedef oatpp::web::protocol::http::outgoing::BufferBody BufferBody;
+typedef oatpp::web::protocol::http::Headers Headers;
+typedef oatpp::web::protocol::http::Header Header;
+typedef oatpp::web::protocol::http::Status Status;
+
+oatpp::String sendToString(const std::shared_ptr<Response>& response) {
+  oatpp::data::stream::BufferOutputStream stream;
+  oatpp::data::stream::BufferOutputStream headersBuffer(2048);
+  response->send(&stream, &headersBuffer, nullptr);
+  return stream.toString();
+}
+
+class OverrideCorsInterceptor : public oatpp::web::server::interceptor::ResponseInterceptor {
+public:
+
+  std::shared_ptr<OutgoingResponse> intercept(const std::shared_ptr<IncomingRequest>& request,
+                                              const std::shared_ptr<OutgoingResponse>& response) override
+  {
+    (void) request;
+    response->putOrReplaceHeader(Header::CORS_ORIGIN, "https://example.com");
+    response->putHeader(Header::CORS_MAX_AGE, "10");
+    return response;
+  }
+
+};
+
+v_int32 countOccurrences(const oatpp::String& str, const char* substr) {
+  v_int32 result = 0;
+  auto pos = str->find(substr);
+  while(pos != std::string::npos) {
+    result ++;
+    pos = str->find(substr, pos + 1);
+  }
+  return result;
+}
+
+}
+
+void HeadersBlockTest::onRun() {
+
+  Headers headers;
+  headers.put("Server", "oatpp-test");
+  headers.put(Header::CONTENT_TYPE, "application/json");
+  headers.put("X-Static", "static-value");
+
+  auto block = HeadersBlock::createShared(headers);
+
+  {
+    OATPP_LOGd(TAG, "serialized block...")
+    oatpp::String data(reinterpret_cast<const char*>(block->getData()), block->getSize());
+    OATPP_ASSERT(countOccurrences(data, "\r\n") == 3)
+    OATPP_ASSERT(countOccurrences(data, "Server: oatpp-test\r\n") == 1)
+    OATPP_ASSERT(countOccurrences(data, "Content-Type: application/json\r\n") == 1)
+    OATPP_ASSERT(countOccurrences(data, "X-Static: static-value\r\n") == 1)
+    OATPP_ASSERT(block->contains("content-type"))
+    OATPP_ASSERT(!block->contains("X-Dynamic"))
+    OATPP_ASSERT(block->get("x-static") == "static-value")
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "forbidden headers...")
+    const char* forbidden[] = {Header::CONTENT_LENGTH, Header::TRANSFER_ENCODING, Header::CONTENT_ENCODING, Header::CONNECTION};
+    for(auto name : forbidden) {
+      Headers h;
+      h.put("X-Static", "static-value");
+      h.put(name, "value");
+      bool thrown = false;
+      try {
+        HeadersBlock b(h);
+      } catch (const std::runtime_error&) {
+        thrown = true;
+      }
+      OATPP_ASSERT(thrown)
+    }
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "response with headers block...")
+
+    auto response = Response::createShared(Status::CODE_200, BufferBody::createShared("{}", "text/plain"));
+    response->setHeadersBlock(block);
+    response->putHeader("X-Dynamic", "dynamic-value");
+
+    OATPP_ASSERT(response->putHeaderIfNotExists("Server", "other") == false)
+    OATPP_ASSERT(response->putHeaderIfNotExists("X-Other", "other") == true)
+    OATPP_ASSERT(response->getHeader("server") == "oatpp-test")
+
+    response->putOrReplaceHeader("X-Static", "overridden-value");
+    OATPP_ASSERT(response->getHeader("x-static") == "overridden-value")
+
+    auto result = sendToString(response);
+    OATPP_LOGd(TAG, "\n{}", result)
+
+    OATPP_ASSERT(result->find("HTTP/1.1 200 OK\r\n") == 0)
+    /* Content-Type declared by the body overrides the one of the block */
+    OATPP_ASSERT(countOccurrences(result, "Content-Type:") == 1)
+    OATPP_ASSERT(countOccurrences(result, "Content-Type: text/plain\r\n") == 1)
+    OATPP_ASSERT(countOccurrences(result, "Server: oatpp-test\r\n") == 1)
+    OATPP_ASSERT(countOccurrences(result, "X-Static:") == 1)
+    OATPP_ASSERT(countOccurrences(result, "X-Static: overridden-value\r\n") == 1)
+    OATPP_ASSERT(countOccurrences(result, "X-Dynamic: dynamic-value\r\n") == 1)
+    OATPP_ASSERT(countOccurrences(result, "X-Other: other\r\n") == 1)
+    OATPP_ASSERT(countOccurrences(result, "Content-Length: 2\r\n") == 1)
+
+    auto pos = result->find("\r\n\r\n");
+    OATPP_ASSERT(pos != std::string::npos)
+    OATPP_ASSERT(result->substr(pos + 4) == "{}")
+
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "AllowCorsGlobal...")
+
+    oatpp::web::server::interceptor::AllowCorsGlobal interceptor;
+
+    auto response = Response::createShared(Status::CODE_200, nullptr);
+    interceptor.intercept(nullptr, response);
+    OATPP_ASSERT(response->getHeadersBlock())
+    OATPP_ASSERT(response->getHeader(Header::CORS_ORIGIN) == "*")
+
+    auto result = sendToString(response);
+    OATPP_ASSERT(countOccurrences(result, "Access-Control-Allow-Origin: *\r\n") == 1)
+    OATPP_ASSERT(countOccurrences(result, "Access-Control-Allow-Methods: GET, POST, OPTIONS\r\n") == 1)
+    OATPP_ASSERT(countOccurrences(result, "Access-Control-Max-Age: 1728000\r\n") == 1)
+    OATPP_ASSERT(countOccurrences(result, "Content-Length: 0\r\n") == 1)
+
+    /* endpoint-defined CORS header is kept */
+    auto customResponse = Response::createShared(Status::CODE_200, nullptr);
+    customResponse->putHeader(Header::CORS_ORIGIN, "http://example.com");
+    interceptor.intercept(nullptr, customResponse);
+    OATPP_ASSERT(customResponse->getHeader(Header::CORS_ORIGIN) == "http://example.com")
+
+    auto customResult = sendToString(customResponse);
+    OATPP_ASSERT(countOccurrences(customResult, "Access-Control-Allow-Origin:") == 1)
+    OATPP_ASSERT(countOccurrences(customResult, "Access-Control-Allow-Origin: http://example.com\r\n") == 1)
+    OATPP_ASSERT(countOccurrences(customResult, "Access-Control-Max-Age: 1728000\r\n") == 1)
+
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "CORS headers overridden by the next interceptor...")
+
+    oatpp::web::server::interceptor::AllowCorsGlobal corsInterceptor;
+    OverrideCorsInterceptor overrideInterceptor;
+
+    auto response = Response::createShared(Status::CODE_200, nullptr);
+    response = corsInterceptor.intercept(nullptr, response);
+    response = overrideInterceptor.intercept(nullptr, response);
+
+    OATPP_ASSERT(response->getHeadersBlock())
+    OATPP_ASSERT(response->getHeader(Header::CORS_ORIGIN) == "https://example.com")
+    OATPP_ASSERT(response->getHeader(Header::CORS_MAX_AGE) == "10")
+    OATPP_ASSERT(response->getHeader(Header::CORS_METHODS) == "GET, POST, OPTIONS")
+
+    auto result = sendToString(response);
+    OATPP_LOGd(TAG, "\n{}", result)
+
+    OATPP_ASSERT(countOccurrences(result, "Access-Control-Allow-Origin:") == 1)
+    OATPP_ASSERT(countOccurrences(result, "Access-Control-Allow-Origin: https://example.com\r\n") == 1)
+    OATPP_ASSERT(countOccurrences(result, "Access-Control-Max-Age:") == 1)
+    OATPP_ASSERT(countOccurrences(result, "Access-Control-Max-Age: 10\r\n") == 1)
+    OATPP_ASSERT(countOccurrences(result, "Access-Control-Allow-Methods: GET, POST, OPTIONS\r\n") == 1)
+    OATPP_ASSERT(countOccurrences(result, "Access-Control-Allow-Headers:") == 1)
+
+    OATPP_LOGd(TAG, "OK")
+  }
+
+}
+
+}}}}}}
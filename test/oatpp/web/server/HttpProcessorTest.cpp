@@ -0,0 +1,449 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "HttpProcessorTest.hpp"
+
+#include "oatpp/web/server/HttpProcessor.hpp"
+#include "oatpp/web/server/metrics/PrometheusExporter.hpp"
+#include "oatpp/web/protocol/http/encoding/Chunked.hpp"
+#include "oatpp/web/protocol/http/incoming/SimpleBodyDecoder.hpp"
+#include "oatpp/async/Executor.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace oatpp { namespace test { namespace web { namespace server {
+
+namespace {
+
+typedef oatpp::web::server::HttpProcessor HttpProcessor;
+
+/**
+ * Stream with predefined input. Records output and counts write calls. <br>
+ * Once the whole input is read the peer is considered gone - writes fail with `BROKEN_PIPE`. <br>
+ * If `idleMicroseconds` is set, requests are read one by one and each request after the first one
+ * is delayed - like a keep-alive client which sends the next request later.
+ */
+class RecordingStream : public oatpp::data::stream::IOStream, public oatpp::base::Countable {
+private:
+  static oatpp::data::stream::DefaultInitializedContext DEFAULT_CONTEXT;
+private:
+  std::string m_input;
+  v_buff_size m_inputPosition;
+  bool m_inputFinished;
+  v_int64 m_idleMicroseconds;
+public:
+
+  RecordingStream(const std::string& input, v_int64 idleMicroseconds = 0)
+    : m_input(input)
+    , m_inputPosition(0)
+    , m_inputFinished(false)
+    , m_idleMicroseconds(idleMicroseconds)
+    , writesCount(0)
+  {}
+
+  std::string output;
+  v_int32 writesCount;
+
+  v_io_size write(const void *buff, v_buff_size count, async::Action& action) override {
+    (void) action;
+    if(m_inputFinished) {
+      return IOError::BROKEN_PIPE;
+    }
+    output.append(reinterpret_cast<const char*>(buff), static_cast<size_t>(count));
+    writesCount ++;
+    return count;
+  }
+
+  v_io_size read(void *buff, v_buff_size count, async::Action& action) override {
+    (void) action;
+    auto end = static_cast<v_buff_size>(m_input.size());
+    if(m_idleMicroseconds > 0) {
+      if(m_inputPosition > 0 && m_inputPosition < end) {
+        std::this_thread::sleep_for(std::chrono::microseconds(m_idleMicroseconds));
+      }
+      auto requestEnd = m_input.find("\r\n\r\n", static_cast<size_t>(m_inputPosition));
+      if(requestEnd != std::string::npos) {
+        end = static_cast<v_buff_size>(requestEnd) + 4;
+      }
+    }
+    auto size = end - m_inputPosition;
+    if(size > count) {
+      size = count;
+    }
+    std::memcpy(buff, m_input.data() + m_inputPosition, static_cast<size_t>(size));
+    m_inputPosition += size;
+    m_inputFinished = (size == 0);
+    return size;
+  }
+
+  void setOutputStreamIOMode(oatpp::data::stream::IOMode ioMode) override {
+    (void) ioMode;
+  }
+
+  oatpp::data::stream::IOMode getOutputStreamIOMode() override {
+    return oatpp::data::stream::IOMode::BLOCKING;
+  }
+
+  oatpp::data::stream::Context& getOutputStreamContext() override {
+    return DEFAULT_CONTEXT;
+  }
+
+  void setInputStreamIOMode(oatpp::data::stream::IOMode ioMode) override {
+    (void) ioMode;
+  }
+
+  oatpp::data::stream::IOMode getInputStreamIOMode() override {
+    return oatpp::data::stream::IOMode::BLOCKING;
+  }
+
+  oatpp::data::stream::Context& getInputStreamContext() override {
+    return DEFAULT_CONTEXT;
+  }
+
+};
+
+oatpp::data::stream::DefaultInitializedContext RecordingStream::DEFAULT_CONTEXT(oatpp::data::stream::StreamType::STREAM_INFINITE);
+
+class Invalidator : public oatpp::provider::Invalidator<oatpp::data::stream::IOStream> {
+public:
+  void invalidate(const std::shared_ptr<oatpp::data::stream::IOStream>& connection) override {
+    (void) connection;
+  }
+};
+
+class TaskListener : public HttpProcessor::TaskProcessingListener {
+public:
+
+  void onTaskStart(const provider::ResourceHandle<data::stream::IOStream>& connection) override {
+    (void) connection;
+  }
+
+  void onTaskEnd(const provider::ResourceHandle<data::stream::IOStream>& connection) override {
+    (void) connection;
+  }
+
+};
+
+class HelloHandler : public oatpp::web::server::HttpRequestHandler {
+public:
+
+  std::shared_ptr<OutgoingResponse> handle(const std::shared_ptr<IncomingRequest>& request) override {
+    (void) request;
+    return ResponseFactory::createResponse(Status::CODE_200, "Hello World!!!");
+  }
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&>
+  handleAsync(const std::shared_ptr<IncomingRequest>& request) override {
+
+    (void) request;
+
+    class HelloCoroutine : public oatpp::async::CoroutineWithResult<HelloCoroutine, const std::shared_ptr<OutgoingResponse>&> {
+    public:
+
+      Action act() override {
+        return _return(ResponseFactory::createResponse(Status::CODE_200, "Hello World!!!"));
+      }
+
+    };
+
+    return HelloCoroutine::startForResult();
+
+  }
+
+};
+
+const char* const SAMPLE_IN =
+  "GET / HTTP/1.1\r\n"
+  "Connection: keep-alive\r\n"
+  "\r\n";
+
+const char* const SAMPLE_IN_CLOSE =
+  "GET / HTTP/1.1\r\n"
+  "Connection: close\r\n"
+  "\r\n";
+
+std::string createPipeline(v_int32 size, bool closeLast) {
+  std::string result;
+  for(v_int32 i = 0; i < size; i ++) {
+    result += (closeLast && i == size - 1) ? SAMPLE_IN_CLOSE : SAMPLE_IN;
+  }
+  return result;
+}
+
+const char* const SAMPLE_IN_ENCODED =
+  "GET / HTTP/1.1\r\n"
+  "Connection: keep-alive\r\n"
+  "Accept-Encoding: chunked\r\n"
+  "\r\n";
+
+const char* const SAMPLE_IN_USER =
+  "GET /users/42 HTTP/1.1\r\n"
+  "Connection: keep-alive\r\n"
+  "\r\n";
+
+const char* const SAMPLE_IN_NOT_FOUND =
+  "GET /not-found HTTP/1.1\r\n"
+  "Connection: keep-alive\r\n"
+  "\r\n";
+
+std::shared_ptr<HttpProcessor::Components> createComponents(v_buff_size flushThreshold,
+                                                            const std::shared_ptr<oatpp::web::protocol::http::encoding::EncodedBodyCache>& cache,
+                                                            const std::shared_ptr<oatpp::web::server::metrics::HttpMetrics>& metrics)
+{
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->route("GET", "/", std::make_shared<HelloHandler>());
+  router->route("GET", "/users/{userId}", std::make_shared<HelloHandler>());
+  auto config = std::make_shared<HttpProcessor::Config>();
+  config->pipelineFlushThreshold = flushThreshold;
+  config->encodedBodyCache = cache;
+  config->metrics = metrics;
+  auto encoders = std::make_shared<oatpp::web::protocol::http::encoding::ProviderCollection>();
+  encoders->add(std::make_shared<oatpp::web::protocol::http::encoding::ChunkedEncoderProvider>());
+  return std::make_shared<HttpProcessor::Components>(router,
+                                                     encoders,
+                                                     std::make_shared<oatpp::web::protocol::http::incoming::SimpleBodyDecoder>(),
+                                                     std::make_shared<oatpp::web::server::handler::DefaultErrorHandler>(),
+                                                     HttpProcessor::RequestInterceptors(),
+                                                     HttpProcessor::ResponseInterceptors(),
+                                                     config);
+}
+
+std::shared_ptr<RecordingStream> processTask(const std::shared_ptr<RecordingStream>& stream, v_buff_size flushThreshold,
+                                             const std::shared_ptr<oatpp::web::protocol::http::encoding::EncodedBodyCache>& cache,
+                                             const std::shared_ptr<oatpp::web::server::metrics::HttpMetrics>& metrics)
+{
+  TaskListener listener;
+  {
+    HttpProcessor::Task task(createComponents(flushThreshold, cache, metrics),
+                             provider::ResourceHandle<data::stream::IOStream>(stream, std::make_shared<Invalidator>()),
+                             &listener);
+    task.run();
+  }
+  return stream;
+}
+
+std::shared_ptr<RecordingStream> processCoroutine(const std::shared_ptr<RecordingStream>& stream, v_buff_size flushThreshold,
+                                                  const std::shared_ptr<oatpp::web::protocol::http::encoding::EncodedBodyCache>& cache,
+                                                  const std::shared_ptr<oatpp::web::server::metrics::HttpMetrics>& metrics)
+{
+  TaskListener listener;
+  oatpp::async::Executor executor(1, 1, 1);
+  executor.execute<HttpProcessor::Coroutine>(createComponents(flushThreshold, cache, metrics),
+                                             provider::ResourceHandle<data::stream::IOStream>(stream, std::make_shared<Invalidator>()),
+                                             &listener);
+  executor.waitTasksFinished();
+  executor.stop();
+  executor.join();
+  return stream;
+}
+
+std::shared_ptr<RecordingStream> runTask(const std::string& input, v_buff_size flushThreshold,
+                                         const std::shared_ptr<oatpp::web::protocol::http::encoding::EncodedBodyCache>& cache,
+                                         const std::shared_ptr<oatpp::web::server::metrics::HttpMetrics>& metrics)
+{
+  return processTask(std::make_shared<RecordingStream>(input), flushThreshold, cache, metrics);
+}
+
+std::shared_ptr<RecordingStream> runCoroutine(const std::string& input, v_buff_size flushThreshold,
+                                              const std::shared_ptr<oatpp::web::protocol::http::encoding::EncodedBodyCache>& cache,
+                                              const std::shared_ptr<oatpp::web::server::metrics::HttpMetrics>& metrics)
+{
+  return processCoroutine(std::make_shared<RecordingStream>(input), flushThreshold, cache, metrics);
+}
+
+v_int32 countOccurrences(const std::string& output, const std::string& substring) {
+  v_int32 result = 0;
+  auto pos = output.find(substring);
+  while(pos != std::string::npos) {
+    result ++;
+    pos = output.find(substring, pos + 1);
+  }
+  return result;
+}
+
+v_int32 countResponses(const std::string& output) {
+  return countOccurrences(output, "HTTP/1.1 200 OK\r\n");
+}
+
+}
+
+void HttpProcessorTest::onRun() {
+
+  const v_int32 pipelineSize = 16;
+
+  for(v_int32 i = 0; i < 2; i ++) {
+
+    bool async = i == 1;
+    auto run = async ? &runCoroutine : &runTask;
+    auto process = async ? &processCoroutine : &processTask;
+
+    {
+      OATPP_LOGd(TAG, "{}: pipelined responses are written at once...", async ? "Coroutine" : "Task")
+
+      auto reference = run(createPipeline(pipelineSize, false), 0, nullptr, nullptr);
+      auto batched = run(createPipeline(pipelineSize, false), 64 * 1024, nullptr, nullptr);
+
+      OATPP_LOGd(TAG, "writes: separate={}, batched={}", reference->writesCount, batched->writesCount)
+
+      OATPP_ASSERT(countResponses(reference->output) == pipelineSize)
+      OATPP_ASSERT(reference->writesCount == pipelineSize)
+      OATPP_ASSERT(batched->output == reference->output)
+      OATPP_ASSERT(batched->writesCount == 1)
+
+      OATPP_LOGd(TAG, "OK")
+    }
+
+    {
+      OATPP_LOGd(TAG, "{}: flush threshold...", async ? "Coroutine" : "Task")
+
+      auto reference = run(createPipeline(pipelineSize, false), 0, nullptr, nullptr);
+      auto batched = run(createPipeline(pipelineSize, false), 256, nullptr, nullptr);
+
+      OATPP_LOGd(TAG, "writes: separate={}, batched={}", reference->writesCount, batched->writesCount)
+
+      OATPP_ASSERT(batched->output == reference->output)
+      OATPP_ASSERT(batched->writesCount > 1)
+      OATPP_ASSERT(batched->writesCount < pipelineSize)
+
+      OATPP_LOGd(TAG, "OK")
+    }
+
+    {
+      OATPP_LOGd(TAG, "{}: closing response flushes accumulated responses...", async ? "Coroutine" : "Task")
+
+      auto reference = run(createPipeline(pipelineSize, true), 0, nullptr, nullptr);
+      auto batched = run(createPipeline(pipelineSize, true), 64 * 1024, nullptr, nullptr);
+
+      OATPP_ASSERT(countResponses(reference->output) == pipelineSize)
+      OATPP_ASSERT(batched->output == reference->output)
+      OATPP_ASSERT(batched->writesCount == 2)
+
+      OATPP_LOGd(TAG, "OK")
+    }
+
+    {
+      OATPP_LOGd(TAG, "{}: encoded bodies are served from cache...", async ? "Coroutine" : "Task")
+
+      std::string input;
+      for(v_int32 j = 0; j < pipelineSize; j ++) {
+        input += SAMPLE_IN_ENCODED;
+      }
+
+      auto reference = run(input, 64 * 1024, nullptr, nullptr);
+      auto cache = std::make_shared<oatpp::web::protocol::http::encoding::EncodedBodyCache>(1024 * 1024, 0);
+      auto cached = run(input, 64 * 1024, cache, nullptr);
+
+      OATPP_ASSERT(countOccurrences(reference->output, "Transfer-Encoding: chunked\r\n") == pipelineSize)
+      OATPP_ASSERT(countOccurrences(reference->output, "Content-Encoding: chunked\r\n") == pipelineSize)
+
+      OATPP_ASSERT(countResponses(cached->output) == pipelineSize)
+      OATPP_ASSERT(countOccurrences(cached->output, "Transfer-Encoding: chunked\r\n") == 0)
+      OATPP_ASSERT(countOccurrences(cached->output, "Content-Encoding: chunked\r\n") == pipelineSize)
+      OATPP_ASSERT(countOccurrences(cached->output, "Content-Length: 24\r\n") == pipelineSize)
+      OATPP_ASSERT(countOccurrences(cached->output, "E\r\nHello World!!!\r\n0\r\n\r\n") == pipelineSize)
+      OATPP_ASSERT(cache->getHitsCount() == pipelineSize - 1)
+
+      /* Known size in-memory bodies can be batched */
+      OATPP_ASSERT(cached->writesCount == 1)
+
+      OATPP_LOGd(TAG, "OK")
+    }
+
+    {
+      OATPP_LOGd(TAG, "{}: request metrics...", async ? "Coroutine" : "Task")
+
+      std::string input;
+      for(v_int32 j = 0; j < pipelineSize; j ++) {
+        input += (j % 2 == 0) ? SAMPLE_IN : SAMPLE_IN_USER;
+      }
+      input += SAMPLE_IN_NOT_FOUND;
+
+      auto metrics = oatpp::web::server::metrics::HttpMetrics::createShared();
+      run(input, 64 * 1024, nullptr, metrics);
+
+      auto snapshot = metrics->getSnapshot();
+      OATPP_ASSERT(snapshot.routes.size() == 3)
+
+      for(auto& route : snapshot.routes) {
+        auto& total = route.phases[oatpp::web::server::metrics::HttpMetrics::PHASE_TOTAL];
+        auto& endpoint = route.phases[oatpp::web::server::metrics::HttpMetrics::PHASE_ENDPOINT];
+        auto& routing = route.phases[oatpp::web::server::metrics::HttpMetrics::PHASE_ROUTING];
+        if(route.route == "/" || route.route == "/users/{userId}") {
+          OATPP_ASSERT(route.method == "GET")
+          OATPP_ASSERT(route.statusClass == 2)
+          OATPP_ASSERT(total.totalCount == pipelineSize / 2)
+          OATPP_ASSERT(endpoint.totalCount == pipelineSize / 2)
+          OATPP_ASSERT(routing.totalCount == pipelineSize / 2)
+        } else {
+          OATPP_ASSERT(route.route == "")
+          OATPP_ASSERT(route.method == "*")
+          OATPP_ASSERT(route.statusClass == 4)
+          OATPP_ASSERT(total.totalCount == 1)
+          OATPP_ASSERT(endpoint.totalCount == 0)
+        }
+      }
+
+      auto text = oatpp::web::server::metrics::PrometheusExporter(metrics).toText();
+
+      OATPP_ASSERT(countOccurrences(text, "oatpp_http_requests_total{method=\"GET\",route=\"/users/{userId}\",status=\"2xx\"} 8\n") == 1)
+      OATPP_ASSERT(countOccurrences(text, "oatpp_http_requests_total{method=\"GET\",route=\"/\",status=\"2xx\"} 8\n") == 1)
+      OATPP_ASSERT(countOccurrences(text, "oatpp_http_requests_total{method=\"*\",route=\"\",status=\"4xx\"} 1\n") == 1)
+      OATPP_ASSERT(countOccurrences(text, "phase=\"endpoint\",quantile=\"0.99\"}") == 2)
+
+      OATPP_LOGd(TAG, "OK")
+    }
+
+    {
+      OATPP_LOGd(TAG, "{}: keep-alive idle time is not measured...", async ? "Coroutine" : "Task")
+
+      const v_int64 idleMicroseconds = 500 * 1000;
+
+      auto metrics = oatpp::web::server::metrics::HttpMetrics::createShared();
+      auto stream = process(std::make_shared<RecordingStream>(std::string(SAMPLE_IN) + SAMPLE_IN, idleMicroseconds), 0, nullptr, metrics);
+      OATPP_ASSERT(countResponses(stream->output) == 2)
+
+      auto snapshot = metrics->getSnapshot();
+      OATPP_ASSERT(snapshot.routes.size() == 1)
+
+      auto& headersRead = snapshot.routes[0].phases[oatpp::web::server::metrics::HttpMetrics::PHASE_HEADERS_READ];
+      auto& total = snapshot.routes[0].phases[oatpp::web::server::metrics::HttpMetrics::PHASE_TOTAL];
+
+      OATPP_LOGd(TAG, "headers_read max={}ns, total max={}ns", headersRead.max, total.max)
+
+      OATPP_ASSERT(headersRead.totalCount == 2)
+      OATPP_ASSERT(total.totalCount == 2)
+      OATPP_ASSERT(headersRead.max < static_cast<v_uint64>(idleMicroseconds / 2) * 1000)
+      OATPP_ASSERT(total.max < static_cast<v_uint64>(idleMicroseconds / 2) * 1000)
+      OATPP_ASSERT(total.max >= headersRead.max)
+
+      OATPP_LOGd(TAG, "OK")
+    }
+
+  }
+
+}
+
+}}}}
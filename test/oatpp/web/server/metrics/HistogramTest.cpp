@@ -0,0 +1,136 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "HistogramTest.hpp"
+
+#include "oatpp/web/server/metrics/Histogram.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace oatpp { namespace test { namespace web { namespace server { namespace metrics {
+
+typedef oatpp::web::server::metrics::Histogram Histogram;
+
+void HistogramTest::onRun() {
+
+  {
+    OATPP_LOGd(TAG, "buckets are contiguous...")
+
+    for(v_int32 i = 0; i < Histogram::BUCKETS_COUNT; i ++) {
+      auto low = Histogram::getBucketLowestValue(i);
+      auto high = Histogram::getBucketHighestValue(i);
+      OATPP_ASSERT(low <= high)
+      OATPP_ASSERT(Histogram::getBucketIndex(low) == i)
+      OATPP_ASSERT(Histogram::getBucketIndex(high) == i)
+      if(i > 0) {
+        OATPP_ASSERT(Histogram::getBucketHighestValue(i - 1) + 1 == low)
+      }
+      /* relative error is bounded by 1 / SUB_BUCKETS_COUNT */
+      OATPP_ASSERT((high - low) * Histogram::SUB_BUCKETS_COUNT <= low + Histogram::SUB_BUCKETS_COUNT)
+    }
+
+    OATPP_ASSERT(Histogram::getBucketHighestValue(Histogram::BUCKETS_COUNT - 1) == Histogram::MAX_VALUE)
+    OATPP_ASSERT(Histogram::getBucketIndex(Histogram::MAX_VALUE + 100) == Histogram::BUCKETS_COUNT - 1)
+
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "percentiles...")
+
+    Histogram histogram;
+
+    auto empty = histogram.getSnapshot();
+    OATPP_ASSERT(empty.totalCount == 0)
+    OATPP_ASSERT(empty.getValueAtPercentile(50) == 0)
+
+    for(v_uint64 i = 1; i <= 1000; i ++) {
+      histogram.record(i * 1000);
+    }
+
+    auto snapshot = histogram.getSnapshot();
+
+    OATPP_ASSERT(snapshot.totalCount == 1000)
+    OATPP_ASSERT(snapshot.min == 1000)
+    OATPP_ASSERT(snapshot.max == 1000000)
+    OATPP_ASSERT(snapshot.sum == 500500000)
+    OATPP_ASSERT(snapshot.getMean() == 500500)
+
+    auto p50 = snapshot.getValueAtPercentile(50);
+    auto p99 = snapshot.getValueAtPercentile(99);
+
+    OATPP_LOGd(TAG, "p50={}, p99={}", p50, p99)
+
+    OATPP_ASSERT(p50 >= 500000 && p50 <= 500000 + 500000 / Histogram::SUB_BUCKETS_COUNT)
+    OATPP_ASSERT(p99 >= 990000 && p99 <= 1000000)
+    OATPP_ASSERT(snapshot.getValueAtPercentile(100) == 1000000)
+    OATPP_ASSERT(snapshot.getValueAtPercentile(0) >= 1000 && snapshot.getValueAtPercentile(0) <= 1000 + 1000 / Histogram::SUB_BUCKETS_COUNT)
+
+    histogram.reset();
+    OATPP_ASSERT(histogram.getTotalCount() == 0)
+    OATPP_ASSERT(histogram.getSnapshot().max == 0)
+
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "concurrent recording...")
+
+    Histogram histogram;
+
+    const v_uint64 threadsCount = 4;
+    const v_uint64 valuesCount = 100000;
+
+    std::vector<std::thread> threads;
+    for(v_uint64 t = 0; t < threadsCount; t ++) {
+      threads.emplace_back([&histogram, t]{
+        for(v_uint64 i = 0; i < valuesCount; i ++) {
+          histogram.record(t * valuesCount + i);
+        }
+      });
+    }
+
+    for(auto& thread : threads) {
+      thread.join();
+    }
+
+    auto snapshot = histogram.getSnapshot();
+
+    v_uint64 countsSum = 0;
+    for(auto count : snapshot.counts) {
+      countsSum += count;
+    }
+
+    OATPP_ASSERT(snapshot.totalCount == threadsCount * valuesCount)
+    OATPP_ASSERT(countsSum == threadsCount * valuesCount)
+    OATPP_ASSERT(snapshot.min == 0)
+    OATPP_ASSERT(snapshot.max == threadsCount * valuesCount - 1)
+
+    OATPP_LOGd(TAG, "OK")
+  }
+
+}
+
+}}}}}
@@ -0,0 +1,144 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "HttpMetricsTest.hpp"
+
+#include "oatpp/web/server/metrics/HttpMetrics.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace oatpp { namespace test { namespace web { namespace server { namespace metrics {
+
+namespace {
+
+typedef oatpp::web::server::metrics::HttpMetrics HttpMetrics;
+typedef oatpp::web::url::mapping::Pattern Pattern;
+
+void record(HttpMetrics& metrics, const char* method, Pattern* pattern, v_int32 statusCode) {
+  HttpMetrics::Measurement measurement;
+  measurement.start();
+  measurement.mark(HttpMetrics::PHASE_HEADERS_READ);
+  measurement.mark(HttpMetrics::PHASE_ROUTING);
+  measurement.pattern = pattern;
+  measurement.mark(HttpMetrics::PHASE_ENDPOINT);
+  measurement.finish();
+  metrics.record(method, statusCode, measurement);
+}
+
+v_uint64 getTotalCount(const HttpMetrics::Snapshot& snapshot, const oatpp::String& route, v_int32 statusClass) {
+  for(auto& r : snapshot.routes) {
+    if(r.route == route && r.statusClass == statusClass) {
+      return r.phases[HttpMetrics::PHASE_TOTAL].totalCount;
+    }
+  }
+  return 0;
+}
+
+}
+
+void HttpMetricsTest::onRun() {
+
+  auto users = Pattern::parse("/users/{userId}");
+  auto root = Pattern::parse("/");
+
+  HttpMetrics metrics;
+  HttpMetrics otherMetrics;
+
+  {
+    OATPP_LOGd(TAG, "routes by status class...")
+
+    for(v_int32 i = 0; i < 3; i ++) {
+      record(metrics, "GET", users.get(), 200);
+    }
+    record(metrics, "GET", users.get(), 404);
+    record(metrics, "GET", root.get(), 204);
+    record(metrics, "GET", root.get(), 299);
+    record(metrics, "GET", nullptr, 404);
+    record(metrics, "GET", nullptr, 999);
+
+    /* other instance attached to the same pattern keeps its own metrics */
+    record(otherMetrics, "GET", users.get(), 500);
+
+    auto snapshot = metrics.getSnapshot();
+    OATPP_ASSERT(snapshot.routes.size() == 5)
+    OATPP_ASSERT(getTotalCount(snapshot, "/users/{userId}", 2) == 3)
+    OATPP_ASSERT(getTotalCount(snapshot, "/users/{userId}", 4) == 1)
+    OATPP_ASSERT(getTotalCount(snapshot, "/users/{userId}", 5) == 0)
+    OATPP_ASSERT(getTotalCount(snapshot, "/", 2) == 2)
+    OATPP_ASSERT(getTotalCount(snapshot, "", 4) == 1)
+    OATPP_ASSERT(getTotalCount(snapshot, "", 0) == 1)
+
+    auto otherSnapshot = otherMetrics.getSnapshot();
+    OATPP_ASSERT(otherSnapshot.routes.size() == 1)
+    OATPP_ASSERT(otherSnapshot.routes[0].method == "GET")
+    OATPP_ASSERT(getTotalCount(otherSnapshot, "/users/{userId}", 5) == 1)
+
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "concurrent recording...")
+
+    const v_int32 threadsCount = 4;
+    const v_int32 iterations = 10000;
+
+    std::vector<std::thread> threads;
+    for(v_int32 t = 0; t < threadsCount; t ++) {
+      threads.emplace_back([&metrics, &users, &root, t]() {
+        for(v_int32 i = 0; i < iterations; i ++) {
+          record(metrics, "GET", (i + t) % 2 == 0 ? users.get() : root.get(), 300 + (i % 2) * 100);
+        }
+      });
+    }
+    for(auto& thread : threads) {
+      thread.join();
+    }
+
+    auto snapshot = metrics.getSnapshot();
+    OATPP_ASSERT(snapshot.routes.size() == 8)
+
+    v_uint64 total = 0;
+    for(auto& r : snapshot.routes) {
+      total += r.phases[HttpMetrics::PHASE_TOTAL].totalCount;
+    }
+    OATPP_ASSERT(total == static_cast<v_uint64>(threadsCount * iterations) + 8)
+
+    OATPP_LOGd(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGd(TAG, "reset...")
+    metrics.reset();
+    auto snapshot = metrics.getSnapshot();
+    OATPP_ASSERT(snapshot.routes.size() == 8)
+    for(auto& r : snapshot.routes) {
+      OATPP_ASSERT(r.phases[HttpMetrics::PHASE_TOTAL].totalCount == 0)
+    }
+    OATPP_LOGd(TAG, "OK")
+  }
+
+}
+
+}}}}}
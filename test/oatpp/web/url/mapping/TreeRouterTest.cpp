@@ -0,0 +1,144 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "TreeRouterTest.hpp"
+
+#include "oatpp/web/url/mapping/Router.hpp"
+#include "oatpp/web/url/mapping/TreeRouter.hpp"
+
+#include <vector>
+
+namespace oatpp { namespace web { namespace url { namespace mapping {
+
+namespace {
+
+typedef Router<v_int32> LinearRouter;
+typedef TreeRouter<v_int32> PrefixTreeRouter;
+
+void checkSame(const oatpp::String& path, LinearRouter& linear, PrefixTreeRouter& tree) {
+
+  auto r1 = linear.getRoute(path);
+  auto r2 = tree.getRoute(path);
+
+  OATPP_ASSERT(r1.isValid() == r2.isValid())
+  if(!r1) {
+    return;
+  }
+
+  OATPP_ASSERT(r1.getEndpoint() == r2.getEndpoint())
+
+  const auto& m1 = r1.getMatchMap();
+  const auto& m2 = r2.getMatchMap();
+
+  OATPP_ASSERT(m1.getTail() == m2.getTail())
+  OATPP_ASSERT(m1.getVariables().size() == m2.getVariables().size())
+  for(auto& pair : m1.getVariables()) {
+    OATPP_ASSERT(m2.getVariable(pair.first) == pair.second.toString())
+  }
+
+}
+
+}
+
+void TreeRouterTest::onRun() {
+
+  std::vector<oatpp::String> patterns = {
+    "ints/1",
+    "ints/2",
+    "ints/all/{value}",
+    "ints/{value}",
+    "ints/{value}/{other}",
+    "ints/{a}/x/{b}",
+    "ints/*",
+    "users/{userId}/posts/{postId}",
+    "users/{userId}/posts",
+    "users/me/posts/{postId}",
+    "users/{userId}/*",
+    "files/*",
+    "files/static/index.html",
+    "{any}/tail",
+    "{a}/{a}",
+    "/",
+    "*"
+  };
+
+  std::vector<oatpp::String> paths = {
+    "", "/", "//", "ints", "ints/", "ints/1", "/ints/1", "ints/1//", "//ints///1//", "ints/1/*", "ints/2", "ints/3",
+    "ints/all", "ints/all/10", "//ints//all//10//", "//ints//all//10//*", "ints/3/10", "ints/3/x/4", "ints/3/x/4/5",
+    "ints/1?q1=1&q2=2", "ints/all/3?q1=1&q2=2", "ints/3?x/4", "ints/3?x/x/4", "ints/?q", "ints?q",
+    "users/10/posts/20", "users/me/posts/20", "users/me/posts", "users/10/posts", "users/10/comments",
+    "users/10/posts/20?sort=asc", "users/me?x/posts/20", "users/me/posts?x/20",
+    "files/static/index.html", "files/static/index.html?v=1", "files/static/other.html", "files",
+    "x/tail", "x/tail/", "x/tail/y", "x/y", "x?q/y", "abc", "abc?def", "?", "/?", "a/b/c/d/e/f"
+  };
+
+  /* Every prefix of the pattern list is tested to vary priority of overlapping routes */
+  for(size_t count = 1; count <= patterns.size(); count ++) {
+
+    LinearRouter linear;
+    PrefixTreeRouter tree;
+
+    for(size_t i = 0; i < count; i ++) {
+      linear.route(patterns[i], static_cast<v_int32>(i));
+      tree.route(patterns[i], static_cast<v_int32>(i));
+    }
+
+    for(auto& path : paths) {
+      checkSame(path, linear, tree);
+    }
+
+  }
+
+  /* Reverse order */
+  {
+
+    LinearRouter linear;
+    PrefixTreeRouter tree;
+
+    for(size_t i = patterns.size(); i > 0; i --) {
+      linear.route(patterns[i - 1], static_cast<v_int32>(i - 1));
+      tree.route(patterns[i - 1], static_cast<v_int32>(i - 1));
+    }
+
+    for(auto& path : paths) {
+      checkSame(path, linear, tree);
+    }
+
+  }
+
+  {
+    PrefixTreeRouter tree;
+    tree.route("users/{userId}/posts/{postId}", 1);
+    auto r = tree.getRoute("users/10/posts/20?x=1");
+    OATPP_ASSERT(r)
+    OATPP_ASSERT(r.getEndpoint() == 1)
+    OATPP_ASSERT(r.getMatchMap().getVariable("userId") == "10")
+    OATPP_ASSERT(r.getMatchMap().getVariable("postId") == "20")
+    OATPP_ASSERT(r.getMatchMap().getTail() == "?x=1")
+  }
+
+}
+
+}}}}